@@ -0,0 +1,122 @@
+/**
+ * @file bench_gemm.cpp
+ * @brief Zero Compiler — Matrix Multiplication Benchmarks
+ *
+ * Usage:
+ *   bench_gemm [max_square]
+ *
+ * Compares the blocked GEMM behind matmul with a naive triple loop on
+ * square shapes up to max_square (default 1024) and on skinny shapes,
+ * for f32 and f64. Reports GFLOP/s (2mnk per product): naive, blocked
+ * on one thread with each supported ISA, and blocked on the whole pool
+ * with the best ISA. Build with optimizations for meaningful numbers.
+ */
+
+#include "tensor/gemm.hpp"
+#include "tensor/kernels.hpp"
+#include "tensor/thread_pool.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace zero::tensor;
+using zero::types::DType;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Run `fn` until at least 0.3 s have passed; returns seconds per call.
+ */
+template <typename Fn>
+double time_per_call(Fn fn) {
+    fn();
+    size_t calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        fn();
+        ++calls;
+        elapsed = seconds_since(start);
+    } while (elapsed < 0.3);
+    return elapsed / static_cast<double>(calls);
+}
+
+template <typename T>
+void naive(const T* a, const T* b, T* c, int64_t m, int64_t n, int64_t k) {
+    for (int64_t i = 0; i < m; ++i) {
+        for (int64_t j = 0; j < n; ++j) {
+            T sum = 0;
+            for (int64_t p = 0; p < k; ++p) sum += a[i * k + p] * b[p * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+template <typename T>
+void bench_shape(DType dtype, int64_t m, int64_t n, int64_t k) {
+    std::vector<T> a(m * k, T(1) / 3), b(k * n, T(2) / 7), c(m * n);
+    const double flops = 2.0 * static_cast<double>(m) * static_cast<double>(n) * static_cast<double>(k);
+
+    std::printf("%-5s %5lldx%-5lldx%5lld", zero::types::dtype_name(dtype),
+                static_cast<long long>(m), static_cast<long long>(k), static_cast<long long>(n));
+
+    double t = time_per_call([&] { naive(a.data(), b.data(), c.data(), m, n, k); });
+    std::printf(" %8.2f", flops / t / 1e9);
+
+    GemmOptions options;
+    options.max_threads = 1;
+    for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (!isa_supported(isa)) {
+            std::printf(" %8s", "-");
+            continue;
+        }
+        options.kernels = &kernel_table(isa);
+        t = time_per_call([&] {
+            gemm(dtype, m, n, k, {a.data(), k, 1}, {b.data(), n, 1}, c.data(), n, options);
+        });
+        std::printf(" %8.2f", flops / t / 1e9);
+    }
+
+    options.kernels = nullptr;
+    options.max_threads = 0;
+    t = time_per_call([&] {
+        gemm(dtype, m, n, k, {a.data(), k, 1}, {b.data(), n, 1}, c.data(), n, options);
+    });
+    std::printf(" %8.2f\n", flops / t / 1e9);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    int64_t max_square = 1024;
+    if (argc > 1) max_square = std::strtoll(argv[1], nullptr, 10);
+    if (max_square <= 0) {
+        std::fprintf(stderr, "usage: bench_gemm [max_square]\n");
+        return 1;
+    }
+
+    std::printf("Best ISA: %s, %zu threads\n", isa_name(detect_isa()), ThreadPool::global().size());
+    std::printf("GFLOP/s; shapes are m x k x n\n\n");
+    std::printf("%-5s %-17s %8s %8s %8s %8s %8s %8s\n", "dtype", "shape", "naive",
+                "scalar", "sse2", "avx2", "avx512", "pool");
+
+    struct Shape { int64_t m, n, k; };
+    std::vector<Shape> shapes;
+    for (int64_t s = 64; s <= max_square; s *= 2) shapes.push_back({s, s, s});
+    // Skinny: matrix-vector, small batches, and tall-and-thin outputs
+    shapes.push_back({1, 1024, 1024});
+    shapes.push_back({16, 1024, 1024});
+    shapes.push_back({1024, 16, 1024});
+    shapes.push_back({4096, 64, 64});
+    shapes.push_back({64, 64, 4096});
+
+    for (const Shape& s : shapes) bench_shape<float>(DType::F32, s.m, s.n, s.k);
+    for (const Shape& s : shapes) bench_shape<double>(DType::F64, s.m, s.n, s.k);
+    return 0;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file bench_tensor.cpp
+ * @brief Zero Compiler — Tensor Kernel Benchmarks
+ *
+ * Usage:
+ *   bench_tensor [elements]
+ *
+ * Runs every elementwise kernel on every instruction set this CPU
+ * supports and reports effective bandwidth: bytes read plus bytes
+ * written per second. Each kernel runs at the given size (default 8M
+ * elements, well past the last-level cache) and at 16K elements, which
+ * stays in L1/L2. Then compares relu(a * b + c) as three separate ops
+ * with the same chain as one fused kernel, at both sizes, and adding a
+ * broadcast bias to a slice of a matrix through views against copying
+ * both operands out first. Last, reductions: the sum kernel per ISA
+ * against a plain running sum, and softmax and layernorm over rows of
+ * 1024. Then the activations per ISA, and last a graph of independent
+ * matmul, gelu and softmax chains run in order against on the
+ * work-stealing pool (ZERO_TENSOR_THREADS threads). Build with
+ * optimizations for meaningful numbers.
+ */
+
+#include "tensor/fused.hpp"
+#include "tensor/kernels.hpp"
+#include "tensor/reduce.hpp"
+#include "tensor/task_graph.hpp"
+#include "tensor/tensor.hpp"
+#include "tensor/thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace zero::tensor;
+using zero::types::DType;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Run `fn` until at least 0.2 s have passed; returns seconds per call.
+ */
+template <typename Fn>
+double time_per_call(Fn fn) {
+    fn();  // Warm up caches and page in the buffers
+    size_t calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do {
+        fn();
+        ++calls;
+        elapsed = seconds_since(start);
+    } while (elapsed < 0.2);
+    return elapsed / static_cast<double>(calls);
+}
+
+void report(const char* kernel, DType dtype, Isa isa, size_t bytes, double seconds) {
+    std::printf("%-6s %-5s %-8s %10.2f\n", kernel, zero::types::dtype_name(dtype),
+                isa_name(isa), static_cast<double>(bytes) / seconds / 1e9);
+}
+
+void bench_size(size_t n) {
+    const struct { const char* name; BinaryOp op; } binary_ops[] = {
+        {"add", BinaryOp::ADD}, {"sub", BinaryOp::SUB}, {"mul", BinaryOp::MUL},
+    };
+
+    std::printf("\n%zu elements\n", n);
+    std::printf("%-6s %-5s %-8s %10s\n", "kernel", "dtype", "isa", "GB/s");
+
+    for (DType dtype : {DType::F32, DType::F64, DType::I64}) {
+        const size_t size = zero::types::dtype_size(dtype);
+        const int64_t len = static_cast<int64_t>(n);
+        Tensor a = Tensor::full({len}, 1.0, dtype);
+        Tensor b = Tensor::full({len}, 2.0, dtype);
+        Tensor out = Tensor::empty({len}, dtype);
+
+        for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            if (!isa_supported(isa)) continue;
+            const KernelTable& table = kernel_table(isa);
+            for (const auto& op : binary_ops) {
+                BinaryKernel k = table.get(op.op, dtype);
+                double t = time_per_call([&] { k(a.raw_data(), b.raw_data(), out.raw_data(), n); });
+                report(op.name, dtype, isa, 3 * n * size, t);
+            }
+            UnaryKernel relu = table.get(UnaryOp::RELU, dtype);
+            double t = time_per_call([&] { relu(a.raw_data(), out.raw_data(), n); });
+            report("relu", dtype, isa, 2 * n * size, t);
+        }
+    }
+}
+
+void bench_fusion(size_t n) {
+    std::printf("\nrelu(a * b + c), %zu elements\n", n);
+    std::printf("%-8s %-5s %10s %10s\n", "version", "dtype", "ms", "GB/s");
+
+    for (DType dtype : {DType::F32, DType::F64}) {
+        const size_t size = zero::types::dtype_size(dtype);
+        const int64_t len = static_cast<int64_t>(n);
+        Tensor a = Tensor::full({len}, 1.5, dtype);
+        Tensor b = Tensor::full({len}, -2.0, dtype);
+        Tensor c = Tensor::full({len}, 4.0, dtype);
+        FusedKernel fused("x0 x1 mul x2 add relu");
+
+        // GB/s counts only the three reads and one write either version needs
+        const size_t bytes = 4 * n * size;
+        double t = time_per_call([&] { relu(add(mul(a, b), c)); });
+        std::printf("%-8s %-5s %10.3f %10.2f\n", "separate", zero::types::dtype_name(dtype),
+                    t * 1e3, static_cast<double>(bytes) / t / 1e9);
+        t = time_per_call([&] { fused.run({&a, &b, &c}); });
+        std::printf("%-8s %-5s %10.3f %10.2f\n", "fused", zero::types::dtype_name(dtype),
+                    t * 1e3, static_cast<double>(bytes) / t / 1e9);
+    }
+}
+
+void bench_views(size_t n) {
+    const int64_t cols = 256;
+    const int64_t rows = std::max<int64_t>(2, static_cast<int64_t>(n) / cols);
+    std::printf("\nx[:%lld] + bias, %lldx%lld matrix\n", static_cast<long long>(rows / 2),
+                static_cast<long long>(rows), static_cast<long long>(cols));
+    std::printf("%-8s %-5s %10s\n", "version", "dtype", "ms");
+
+    for (DType dtype : {DType::F32, DType::F64}) {
+        Tensor x = Tensor::full({rows, cols}, 1.5, dtype);
+        Tensor bias = Tensor::full({cols}, -2.0, dtype);
+        const Tensor::Shape half{rows / 2, cols};
+        double t = time_per_call([&] {
+            add(x.slice(0, 0, rows / 2).contiguous(), bias.broadcast_to(half).contiguous());
+        });
+        std::printf("%-8s %-5s %10.3f\n", "copies", zero::types::dtype_name(dtype), t * 1e3);
+        t = time_per_call([&] { add(x.slice(0, 0, rows / 2), bias); });
+        std::printf("%-8s %-5s %10.3f\n", "views", zero::types::dtype_name(dtype), t * 1e3);
+    }
+}
+
+void bench_reductions(size_t n) {
+    std::printf("\nreductions, %zu elements\n", n);
+    std::printf("%-9s %-5s %-8s %10s\n", "op", "dtype", "isa", "GB/s");
+    auto row = [](const char* op, DType dtype, Isa isa, size_t bytes, double seconds) {
+        std::printf("%-9s %-5s %-8s %10.2f\n", op, zero::types::dtype_name(dtype), isa_name(isa),
+                    static_cast<double>(bytes) / seconds / 1e9);
+    };
+
+    for (DType dtype : {DType::F32, DType::F64}) {
+        const size_t size = zero::types::dtype_size(dtype);
+        const int64_t len = static_cast<int64_t>(n);
+        Tensor a = Tensor::full({len}, 0.1, dtype);
+        const Tensor matrix = Tensor::full({std::max<int64_t>(1, len / 1024), 1024}, 0.5, dtype);
+        const size_t row_bytes = matrix.numel() * size;
+
+        // What the compiler makes of a running sum: one dependent add at a time
+        double naive = time_per_call([&] {
+            volatile double s = 0;
+            if (dtype == DType::F32) {
+                float acc = 0;
+                for (size_t i = 0; i < n; ++i) acc += a.data<float>()[i];
+                s = acc;
+            } else {
+                double acc = 0;
+                for (size_t i = 0; i < n; ++i) acc += a.data<double>()[i];
+                s = acc;
+            }
+            (void)s;
+        });
+        row("naive-sum", dtype, Isa::SCALAR, n * size, naive);
+
+        for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            if (!isa_supported(isa)) continue;
+            ReduceKernel k = kernel_table(isa).get(ReduceOp::SUM, dtype);
+            double t = time_per_call([&] {
+                uint64_t out;
+                k(a.raw_data(), n, &out);
+            });
+            row("sum", dtype, isa, n * size, t);
+
+            set_active_isa(isa);
+            t = time_per_call([&] { softmax(matrix); });
+            row("softmax", dtype, isa, 2 * row_bytes, t);
+            t = time_per_call([&] { layernorm(matrix); });
+            row("layernorm", dtype, isa, 2 * row_bytes, t);
+        }
+        set_active_isa(Isa::AVX512);
+    }
+}
+
+void bench_activations(size_t n) {
+    // Compute-bound: elements per second; the scalar table calls <cmath>
+    std::printf("\nactivations, %zu elements\n", n);
+    std::printf("%-9s %-5s %-8s %10s\n", "op", "dtype", "isa", "Gelem/s");
+    const struct {
+        const char* name;
+        UnaryOp op;
+    } ops[] = {{"exp", UnaryOp::EXP}, {"tanh", UnaryOp::TANH},
+               {"sigmoid", UnaryOp::SIGMOID}, {"gelu", UnaryOp::GELU}};
+
+    for (DType dtype : {DType::F32, DType::F64}) {
+        Tensor a = Tensor::empty({static_cast<int64_t>(n)}, dtype);
+        for (size_t i = 0; i < n; ++i) a.set(i, static_cast<double>(i % 2001) / 100 - 10);
+        Tensor out = Tensor::empty({static_cast<int64_t>(n)}, dtype);
+        for (const auto& op : ops) {
+            for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+                if (!isa_supported(isa)) continue;
+                UnaryKernel k = kernel_table(isa).get(op.op, dtype);
+                double t = time_per_call([&] { k(a.raw_data(), out.raw_data(), n); });
+                std::printf("%-9s %-5s %-8s %10.2f\n", op.name, zero::types::dtype_name(dtype),
+                            isa_name(isa), static_cast<double>(n) / t / 1e9);
+            }
+        }
+    }
+}
+
+void bench_graph() {
+    // Ops too small to fill the cores on their own, but independent of
+    // each other across branches
+    constexpr size_t BRANCHES = 8;
+    const int64_t rows = 64, dim = 256;
+    std::printf("\ngraph of %zu matmul -> gelu -> softmax branches, [%lldx%lld] x [%lldx%lld], %zu threads\n",
+                BRANCHES, static_cast<long long>(rows), static_cast<long long>(dim),
+                static_cast<long long>(dim), static_cast<long long>(dim), ThreadPool::global().size());
+    std::vector<Tensor> x, w, h(BRANCHES), y(BRANCHES);
+    for (size_t b = 0; b < BRANCHES; ++b) {
+        x.push_back(Tensor::empty({rows, dim}));
+        w.push_back(Tensor::empty({dim, dim}));
+        for (size_t i = 0; i < x[b].numel(); ++i) x[b].set(i, static_cast<double>((i + b) % 17) / 17 - 0.5);
+        for (size_t i = 0; i < w[b].numel(); ++i) w[b].set(i, static_cast<double>((i * 7 + b) % 13) / 130);
+    }
+
+    // Node 3b + s is step s of branch b
+    TaskGraph graph;
+    for (size_t b = 0; b < BRANCHES; ++b) {
+        size_t m = graph.add_node(), g = graph.add_node(), s = graph.add_node();
+        graph.add_edge(m, g);
+        graph.add_edge(g, s);
+    }
+    auto step = [&](size_t node) {
+        const size_t b = node / 3;
+        switch (node % 3) {
+            case 0: h[b] = matmul(x[b], w[b]); break;
+            case 1: h[b] = gelu(h[b], h[b]); break;
+            default: y[b] = softmax(h[b], 1); break;
+        }
+    };
+
+    double in_order = time_per_call([&] {
+        for (size_t node = 0; node < graph.size(); ++node) step(node);
+    });
+    double parallel = time_per_call([&] { graph.run(step); });
+    std::printf("%-10s %10.3f ms\n", "in order", in_order * 1e3);
+    std::printf("%-10s %10.3f ms  (%.2fx)\n", "graph", parallel * 1e3, in_order / parallel);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t n = 8u << 20;
+    if (argc > 1) n = std::strtoull(argv[1], nullptr, 10);
+    if (n == 0) {
+        std::fprintf(stderr, "usage: bench_tensor [elements]\n");
+        return 1;
+    }
+
+    std::printf("Best ISA: %s\n", isa_name(detect_isa()));
+    bench_size(n);
+    bench_size(16u << 10);
+    bench_fusion(n);
+    bench_fusion(16u << 10);
+    bench_views(n);
+    bench_reductions(n);
+    bench_activations(n);
+    bench_graph();
+    return 0;
+}
@@ -9,6 +9,7 @@
  */
 
 #include "source/source.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -73,9 +74,22 @@ struct Type {
     TypeKind kind = TypeKind::UNKNOWN;
     source::Span span;
     
-    static Type make_int(source::Span s = {}) { return Type{TypeKind::INT, s}; }
-    static Type make_float(source::Span s = {}) { return Type{TypeKind::FLOAT, s}; }
-    static Type make_void(source::Span s = {}) { return Type{TypeKind::VOID, s}; }
+    // Tensors only: `tensor<f32>[2, _]` sets dtype to "f32" and dims to
+    // {2, -1}; `has_dims` is false when no [...] was written
+    std::string dtype;
+    std::vector<int64_t> dims;
+    bool has_dims = false;
+    
+    static Type make_int(source::Span s = {}) { return make(TypeKind::INT, s); }
+    static Type make_float(source::Span s = {}) { return make(TypeKind::FLOAT, s); }
+    static Type make_void(source::Span s = {}) { return make(TypeKind::VOID, s); }
+    
+    static Type make(TypeKind k, source::Span s = {}) {
+        Type t;
+        t.kind = k;
+        t.span = s;
+        return t;
+    }
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -154,6 +168,22 @@ struct Expr {
     const T& as() const { return std::get<T>(data); }
     
     source::Span span() const;
+    
+    /**
+     * The value of an integer literal, possibly negated or parenthesized.
+     */
+    std::optional<int64_t> int_constant() const {
+        if (auto* lit = std::get_if<IntLiteral>(&data)) return lit->value;
+        if (auto* group = std::get_if<GroupExpr>(&data)) {
+            return group->inner ? group->inner->int_constant() : std::nullopt;
+        }
+        if (auto* unary = std::get_if<UnaryExpr>(&data)) {
+            if (unary->op != UnaryOp::NEG || !unary->operand) return std::nullopt;
+            auto v = unary->operand->int_constant();
+            if (v) return static_cast<int64_t>(0 - static_cast<uint64_t>(*v));
+        }
+        return std::nullopt;
+    }
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -167,6 +197,12 @@ struct LetStmt {
     source::Span span;
 };
 
+struct AssignStmt {
+    std::string name;
+    std::unique_ptr<Expr> value;
+    source::Span span;
+};
+
 struct ReturnStmt {
     std::unique_ptr<Expr> value;  // nullptr for bare return
     source::Span span;
@@ -201,6 +237,7 @@ struct Block {
 
 using StmtVariant = std::variant<
     LetStmt,
+    AssignStmt,
     ReturnStmt,
     ExprStmt,
     IfStmt,
@@ -231,12 +268,25 @@ struct Param {
     source::Span span;
 };
 
+struct Attribute {
+    std::string name;        // `inline` for `@inline`
+    source::Span span;
+};
+
 struct FnDecl {
     std::string name;
+    std::vector<Attribute> attributes;
     std::vector<Param> params;
     std::optional<Type> return_type;
     std::vector<std::unique_ptr<Stmt>> body;
     source::Span span;
+    
+    bool has_attribute(const std::string& attr) const {
+        for (const auto& a : attributes) {
+            if (a.name == attr) return true;
+        }
+        return false;
+    }
 };
 
 struct Program {
@@ -9,8 +9,18 @@
  */
 
 #include "ir/ir.hpp"
+#include "ir/memory_plan.hpp"
+#include "ir/profile.hpp"
+#include "backend/memo.hpp"
+#include "tensor/fused.hpp"
+#include "tensor/task_graph.hpp"
+#include "tensor/tensor.hpp"
 #include "types/types.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -28,24 +38,38 @@ namespace backend {
  * A runtime value during interpretation.
  */
 struct RuntimeValue {
-    std::variant<std::monostate, int64_t, double, void*, std::string> data;
+    using TensorRef = std::shared_ptr<const tensor::Tensor>;
+    
+    std::variant<std::monostate, int64_t, double, void*, std::string, TensorRef> data;
     
     RuntimeValue() : data(std::monostate{}) {}
     explicit RuntimeValue(int64_t v) : data(v) {}
     explicit RuntimeValue(double v) : data(v) {}
     explicit RuntimeValue(void* v) : data(v) {}
     explicit RuntimeValue(const std::string& v) : data(v) {}
+    explicit RuntimeValue(tensor::Tensor t)
+        : data(std::make_shared<const tensor::Tensor>(std::move(t))) {}
     
     bool is_void() const { return std::holds_alternative<std::monostate>(data); }
     bool is_int() const { return std::holds_alternative<int64_t>(data); }
     bool is_float() const { return std::holds_alternative<double>(data); }
     bool is_ptr() const { return std::holds_alternative<void*>(data); }
     bool is_str() const { return std::holds_alternative<std::string>(data); }
+    bool is_tensor() const { return std::holds_alternative<TensorRef>(data); }
     
     int64_t as_int() const { return std::get<int64_t>(data); }
     double as_float() const { return std::get<double>(data); }
     void* as_ptr() const { return std::get<void*>(data); }
     const std::string& as_str() const { return std::get<std::string>(data); }
+    const tensor::Tensor& as_tensor() const { return *std::get<TensorRef>(data); }
+    
+    /**
+     * True for the only reference to a tensor whose storage no other
+     * tensor views: nobody would see it change.
+     */
+    bool owns_tensor() const {
+        return is_tensor() && std::get<TensorRef>(data).use_count() == 1 && as_tensor().unique();
+    }
     
     // Convert to int for comparisons
     int64_t to_int() const {
@@ -65,6 +89,15 @@ struct RuntimeValue {
 // Interpreter
 // ─────────────────────────────────────────────────────────────────────────────
 
+/**
+ * Thrown when a run exceeds the instruction budget or call depth set on
+ * the interpreter.
+ */
+class ExecutionLimitExceeded : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
 /**
  * ZIR Interpreter - executes IR on CPU.
  * 
@@ -83,6 +116,76 @@ public:
      */
     RuntimeValue execute(ir::Module& mod, const std::string& entry = "main");
     
+    /**
+     * Call one function of a module with the given arguments. Does not
+     * touch the exit code.
+     */
+    RuntimeValue call(ir::Module& mod, const std::string& name,
+                      std::vector<RuntimeValue> args);
+    
+    /**
+     * Limit how many instructions a run may execute and how deep calls
+     * may nest; 0 means unlimited. Exceeding either throws
+     * ExecutionLimitExceeded.
+     */
+    void set_instruction_budget(uint64_t budget) { budget_ = budget; }
+    void set_max_call_depth(size_t depth) { max_depth_ = depth; }
+    
+    /**
+     * Count block entries, taken branches and calls into `profile` while
+     * running; nullptr turns counting off.
+     */
+    void set_profile(ir::Profile* profile) { profile_ = profile; }
+    
+    /**
+     * Cache size and eviction policy for functions marked @memo. Caches
+     * start empty on every execute() or call().
+     */
+    void set_memo_options(const MemoOptions& opts) { memo_opts_ = opts; }
+    
+    /**
+     * Release tensors after their last use and run elementwise ops in
+     * place as `plan` directs (see opt::BufferPlanner); nullptr keeps
+     * every value until its function returns. The plan must describe
+     * the module being run, unchanged since planning.
+     */
+    void set_memory_plan(const ir::MemoryPlan* plan) { memory_plan_ = plan; }
+    
+    /**
+     * Elementwise ops that wrote their result over a dying operand.
+     */
+    uint64_t in_place_ops() const { return in_place_ops_.load(std::memory_order_relaxed); }
+    
+    /**
+     * Run independent tensor ops at the same time. Each maximal run of
+     * tensor instructions in a block (constants between them included)
+     * is recorded once into a dependency graph, whose nodes then execute
+     * on the global thread pool as their operands become ready; large
+     * ops still split their own work over the idle threads. Results,
+     * errors and in-place reuse are those of running in order. Off by
+     * default.
+     */
+    void set_graph_mode(bool on) { graph_mode_ = on; }
+    
+    /**
+     * Tensor graphs executed, and the ops they held, since the last
+     * execute() or call().
+     */
+    uint64_t graph_runs() const { return graph_runs_; }
+    uint64_t graph_ops() const { return graph_ops_; }
+    
+    /**
+     * Calls to @memo functions answered from, or missing, their cache
+     * since the last execute() or call().
+     */
+    uint64_t memo_hits() const;
+    uint64_t memo_misses() const;
+    
+    /**
+     * Instructions executed since the last execute() or call().
+     */
+    uint64_t instructions_executed() const { return executed_; }
+    
     /**
      * Register an external function (for FFI).
      */
@@ -102,43 +205,124 @@ private:
     // External functions
     std::unordered_map<std::string, ExternalFn> externals_;
     
-    // Value storage (SSA id -> runtime value)
-    std::unordered_map<uint32_t, RuntimeValue> values_;
-    
-    // Call stack for functions
+    // Call stack for functions. SSA ids are only unique within a
+    // function, so each frame owns its values and stack slots.
     struct CallFrame {
         const ir::Function* fn;
         size_t block_idx;
         size_t instr_idx;
-        std::unordered_map<uint32_t, RuntimeValue> locals;
+        std::unordered_map<uint32_t, RuntimeValue> locals;  // SSA id -> value
+        std::unordered_map<uint32_t, RuntimeValue> slots;   // ALLOCA id -> stored value
+        ir::FunctionProfile* profile = nullptr;             // Set while profiling
+        const ir::FunctionMemoryPlan* plan = nullptr;       // Set when planned
     };
     std::vector<CallFrame> call_stack_;
     
     // Exit code
     int exit_code_ = 0;
     
+    // Limits (0 = unlimited)
+    uint64_t budget_ = 0;
+    size_t max_depth_ = 0;
+    uint64_t executed_ = 0;
+    
+    ir::Profile* profile_ = nullptr;
+    
+    // One cache per @memo function
+    MemoOptions memo_opts_;
+    std::unordered_map<const ir::Function*, MemoCache> memo_;
+    
+    const ir::MemoryPlan* memory_plan_ = nullptr;
+    std::atomic<uint64_t> in_place_ops_{0};     // Counted by graph nodes too
+    
+    // Compiled TENSOR_FUSED programs, by program symbol
+    std::unordered_map<const void*, std::unique_ptr<tensor::FusedKernel>> fused_;
+    
+    // A run of tensor instructions in one block, as a dependency graph
+    struct TensorRegion {
+        size_t end = 0;                     // Index after its last instruction
+        std::vector<uint32_t> constants;    // Instruction indices, run first
+        std::vector<uint32_t> nodes;        // Instruction index of each graph node
+        tensor::TaskGraph graph;
+    };
+    
+    bool graph_mode_ = false;
+    uint64_t graph_runs_ = 0;
+    uint64_t graph_ops_ = 0;
+    
+    // Regions by first instruction; they depend on the memory plan, so
+    // they are rebuilt on every execute() or call()
+    std::unordered_map<const ir::Instruction*, TensorRegion> regions_;
+    
     // ─────────────────────────────────────────────────────────────────────
     // Execution
     // ─────────────────────────────────────────────────────────────────────
     
     RuntimeValue call_function(const ir::Function& fn, 
                                 std::vector<RuntimeValue> args);
+    RuntimeValue call_memoized(const ir::Function& fn,
+                               std::vector<RuntimeValue> args);
     RuntimeValue exec_block(const ir::BasicBlock& bb);
-    RuntimeValue exec_instruction(const ir::Instruction& instr);
+    RuntimeValue exec_instruction(const ir::Instruction& instr, size_t index);
+    
+    /**
+     * The region starting at instruction `start` of `bb`, the current
+     * block, recorded on first use.
+     */
+    const TensorRegion& tensor_region(const ir::BasicBlock& bb, size_t start);
+    
+    /**
+     * Execute `region` of the current block and return the value of its
+     * last instruction.
+     */
+    RuntimeValue run_tensor_region(const TensorRegion& region, const ir::BasicBlock& bb);
     
     // ─────────────────────────────────────────────────────────────────────
     // Value access
     // ─────────────────────────────────────────────────────────────────────
     
     RuntimeValue get_value(const ir::Value& v) {
-        auto it = values_.find(v.id);
-        if (it != values_.end()) return it->second;
+        auto& locals = call_stack_.back().locals;
+        auto it = locals.find(v.id);
+        if (it != locals.end()) return it->second;
         return RuntimeValue{};
     }
     
+    // Assigns to an existing entry where there is one, which graph nodes
+    // rely on: they may not insert into the map while others read it
     void set_value(const ir::Value& v, RuntimeValue rv) {
-        values_[v.id] = rv;
+        auto& locals = call_stack_.back().locals;
+        auto it = locals.find(v.id);
+        if (it != locals.end()) {
+            it->second = std::move(rv);
+        } else {
+            locals.emplace(v.id, std::move(rv));
+        }
     }
+    
+    /**
+     * The tensor held by `v`; throws tensor::TensorError if it holds
+     * something else.
+     */
+    const tensor::Tensor& get_tensor(const ir::Value& v);
+    
+    /**
+     * The buffer elementwise instruction `index` of the current block
+     * may write its result into: its planned in-place operand, if nothing
+     * but that operand holds it. Undefined otherwise.
+     */
+    tensor::Tensor in_place_target(const ir::Instruction& instr, size_t index);
+    
+    /**
+     * Drop the values the plan says are dead here.
+     */
+    void release(ir::FunctionMemoryPlan::Values values);
+    
+    /**
+     * The kernel for a TENSOR_FUSED program, compiled on first use
+     * (which graph nodes never are: regions compile theirs up front).
+     */
+    const tensor::FusedKernel& fused_kernel(const ir::Symbol& program);
 };
 
 } // namespace backend
@@ -0,0 +1,95 @@
+#ifndef ZERO_BACKEND_MEMO_HPP
+#define ZERO_BACKEND_MEMO_HPP
+
+/**
+ * @file memo.hpp
+ * @brief Zero Compiler — Call Memoization Cache
+ *
+ * Results of @memo functions, keyed on the bits of their scalar
+ * arguments. Sema has already checked that such functions are pure and
+ * take only int and float parameters, so a hit can stand in for the call.
+ *
+ * The table is open-addressed with linear probing over a bounded window;
+ * when the window is full the eviction policy decides what happens.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zero {
+namespace backend {
+
+struct RuntimeValue;
+
+enum class MemoEviction {
+    REPLACE,    // Overwrite the entry at the key's home slot
+    KEEP,       // Keep what is cached and drop the new result
+    CLEAR       // Empty the whole table, then insert
+};
+
+struct MemoOptions {
+    size_t capacity = 4096;                     // Entries per function; 0 turns memoization off
+    MemoEviction eviction = MemoEviction::REPLACE;
+};
+
+/**
+ * Usage:
+ *   MemoCache cache(arity, opts);
+ *   RuntimeValue r;
+ *   if (!cache.lookup(args, r)) { r = call(...); cache.insert(args, r); }
+ */
+class MemoCache {
+public:
+    MemoCache(size_t arity, const MemoOptions& opts);
+
+    /**
+     * Find the cached result for `args`. Arguments that are not int or
+     * float are never cached, so they always miss.
+     */
+    bool lookup(const std::vector<RuntimeValue>& args, RuntimeValue& out);
+
+    /**
+     * Remember `result` for `args`; results other than int or float are
+     * not kept.
+     */
+    void insert(const std::vector<RuntimeValue>& args, const RuntimeValue& result);
+
+    void clear();
+
+    size_t size() const { return size_; }
+    size_t slots() const { return slots_.size(); }
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+
+private:
+    static constexpr size_t PROBE_WINDOW = 8;
+
+    struct Slot {
+        uint64_t hash = 0;
+        uint64_t float_args = 0;    // Bit i set when argument i is a float
+        uint64_t result = 0;
+        bool used = false;
+        bool result_is_float = false;
+    };
+
+    size_t arity_;
+    MemoEviction eviction_;
+    std::vector<Slot> slots_;
+    std::vector<uint64_t> keys_;    // arity_ argument words per slot
+    std::vector<uint64_t> scratch_; // Encoded arguments of the current call
+    size_t size_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+
+    bool encode(const std::vector<RuntimeValue>& args, uint64_t& hash, uint64_t& float_args);
+    bool matches(size_t slot, uint64_t hash, uint64_t float_args) const;
+    void store(size_t slot, uint64_t hash, uint64_t float_args, const RuntimeValue& result);
+};
+
+} // namespace backend
+} // namespace zero
+
+#endif // ZERO_BACKEND_MEMO_HPP
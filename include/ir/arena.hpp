@@ -0,0 +1,224 @@
+#ifndef ZERO_IR_ARENA_HPP
+#define ZERO_IR_ARENA_HPP
+
+/**
+ * @file arena.hpp
+ * @brief Zero Compiler — Bump Arena and Stable IR Lists
+ *
+ * IR objects used to live directly in std::vectors, so a reference to a
+ * block went stale as soon as another block was created. ArenaList keeps
+ * its elements in a bump arena instead: they are never moved, references
+ * stay valid for as long as the element is in the list, and the whole
+ * list is released at once.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace zero {
+namespace ir {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Arena
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Bump allocator over a growing list of chunks. Memory is only given back
+ * when the arena is destroyed or reset; running destructors is up to the
+ * owner of the objects.
+ */
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&& o) noexcept { *this = std::move(o); }
+
+    Arena& operator=(Arena&& o) noexcept {
+        chunks_ = std::move(o.chunks_);
+        cur_ = o.cur_;
+        end_ = o.end_;
+        next_chunk_ = o.next_chunk_;
+        bytes_ = o.bytes_;
+        o.cur_ = o.end_ = nullptr;
+        o.next_chunk_ = FIRST_CHUNK;
+        o.bytes_ = 0;
+        return *this;
+    }
+
+    void* allocate(size_t size, size_t align) {
+        uintptr_t p = (reinterpret_cast<uintptr_t>(cur_) + align - 1) & ~(uintptr_t(align) - 1);
+        if (!cur_ || p + size > reinterpret_cast<uintptr_t>(end_)) return allocate_slow(size, align);
+        cur_ = reinterpret_cast<char*>(p + size);
+        bytes_ += size;
+        return reinterpret_cast<void*>(p);
+    }
+
+    /**
+     * Free every chunk at once.
+     */
+    void reset();
+
+    size_t bytes_allocated() const { return bytes_; }
+    size_t chunks() const { return chunks_.size(); }
+
+private:
+    static constexpr size_t FIRST_CHUNK = 1024;
+    static constexpr size_t MAX_CHUNK = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* cur_ = nullptr;
+    char* end_ = nullptr;
+    size_t next_chunk_ = FIRST_CHUNK;
+    size_t bytes_ = 0;
+
+    void* allocate_slow(size_t size, size_t align);
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ArenaList
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * An ordered sequence whose elements never move. Indexing and iteration
+ * work like std::vector; reordering or dropping elements goes through
+ * retain(). Copies are deep and get their own arena.
+ */
+template <typename T>
+class ArenaList {
+public:
+    template <typename Ptr, typename Ref>
+    class Iter {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        Iter() = default;
+        explicit Iter(T* const* p) : p_(p) {}
+
+        Ref operator*() const { return **p_; }
+        Ptr operator->() const { return *p_; }
+        Ref operator[](difference_type n) const { return *p_[n]; }
+        Iter& operator++() { ++p_; return *this; }
+        Iter operator++(int) { Iter t = *this; ++p_; return t; }
+        Iter& operator--() { --p_; return *this; }
+        Iter& operator+=(difference_type n) { p_ += n; return *this; }
+        Iter operator+(difference_type n) const { return Iter(p_ + n); }
+        Iter operator-(difference_type n) const { return Iter(p_ - n); }
+        difference_type operator-(const Iter& o) const { return p_ - o.p_; }
+        bool operator==(const Iter& o) const { return p_ == o.p_; }
+        bool operator!=(const Iter& o) const { return p_ != o.p_; }
+        bool operator<(const Iter& o) const { return p_ < o.p_; }
+
+    private:
+        T* const* p_ = nullptr;
+    };
+
+    using iterator = Iter<T*, T&>;
+    using const_iterator = Iter<const T*, const T&>;
+
+    ArenaList() = default;
+    ArenaList(const ArenaList& o) { append_copies(o); }
+    ArenaList(ArenaList&& o) noexcept
+        : arena_(std::move(o.arena_)), items_(std::move(o.items_)) { o.items_.clear(); }
+    ~ArenaList() { destroy_all(); }
+
+    ArenaList& operator=(const ArenaList& o) {
+        if (this != &o) {
+            clear();
+            append_copies(o);
+        }
+        return *this;
+    }
+
+    ArenaList& operator=(ArenaList&& o) noexcept {
+        if (this != &o) {
+            destroy_all();
+            arena_ = std::move(o.arena_);
+            items_ = std::move(o.items_);
+            o.items_.clear();
+        }
+        return *this;
+    }
+
+    size_t size() const { return items_.size(); }
+    bool empty() const { return items_.empty(); }
+
+    T& operator[](size_t i) { return *items_[i]; }
+    const T& operator[](size_t i) const { return *items_[i]; }
+    T& front() { return *items_.front(); }
+    const T& front() const { return *items_.front(); }
+    T& back() { return *items_.back(); }
+    const T& back() const { return *items_.back(); }
+
+    iterator begin() { return iterator(items_.data()); }
+    iterator end() { return iterator(items_.data() + items_.size()); }
+    const_iterator begin() const { return const_iterator(items_.data()); }
+    const_iterator end() const { return const_iterator(items_.data() + items_.size()); }
+
+    T& push_back(T value) { return emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        void* slot = arena_.allocate(sizeof(T), alignof(T));
+        T* item = new (slot) T(std::forward<Args>(args)...);
+        items_.push_back(item);
+        return *item;
+    }
+
+    /**
+     * Keep only the elements at `order`, in that order; each index may
+     * appear once. The others are destroyed. Survivors stay where they
+     * are, so references to them remain valid.
+     */
+    void retain(const std::vector<size_t>& order) {
+        std::vector<bool> kept(items_.size(), false);
+        std::vector<T*> items;
+        items.reserve(order.size());
+        for (size_t i : order) {
+            kept[i] = true;
+            items.push_back(items_[i]);
+        }
+        for (size_t i = 0; i < items_.size(); ++i) {
+            if (!kept[i]) items_[i]->~T();
+        }
+        items_ = std::move(items);
+    }
+
+    /**
+     * Destroy every element and release the arena.
+     */
+    void clear() {
+        destroy_all();
+        arena_.reset();
+    }
+
+    const Arena& arena() const { return arena_; }
+
+private:
+    Arena arena_;
+    std::vector<T*> items_;
+
+    void append_copies(const ArenaList& o) {
+        items_.reserve(o.size());
+        for (const T& item : o) emplace_back(item);
+    }
+
+    void destroy_all() {
+        for (T* item : items_) item->~T();
+        items_.clear();
+    }
+};
+
+} // namespace ir
+} // namespace zero
+
+#endif // ZERO_IR_ARENA_HPP
@@ -9,6 +9,7 @@
  */
 
 #include "ir/ir.hpp"
+#include "ir/uses.hpp"
 #include "ast/ast.hpp"
 
 namespace zero {
@@ -19,22 +20,47 @@ namespace ir {
  */
 class IRBuilder {
 public:
-    IRBuilder(Function& fn) : fn_(fn), current_block_(&fn.entry()) {}
+    IRBuilder(Function& fn) : fn_(fn), current_(&fn.entry()) {}
     
     // ─────────────────────────────────────────────────────────────────────
     // Block management
+    //
+    // Blocks never move once created, so the builder keeps a pointer to
+    // its insert point and callers may hold BasicBlock references across
+    // create_block().
     // ─────────────────────────────────────────────────────────────────────
     
     void set_insert_point(BasicBlock& bb) {
-        current_block_ = &bb;
+        current_ = &bb;
     }
     
-    BasicBlock& current_block() { return *current_block_; }
+    BasicBlock& current_block() { return *current_; }
+    
+    Function& function() { return fn_; }
+    
+    /**
+     * Record every instruction emitted from now on in `chains`, which
+     * must belong to the function being built. nullptr stops tracking.
+     */
+    void track_uses(UseDefChains* chains) { chains_ = chains; }
     
     BasicBlock& create_block(const std::string& label = "") {
         return fn_.new_block(label);
     }
     
+    /**
+     * Look up a block of the function being built by id.
+     */
+    BasicBlock& block(uint32_t id) {
+        if (id < fn_.blocks.size() && fn_.blocks[id].id == id) {
+            return fn_.blocks[id];
+        }
+        for (auto& bb : fn_.blocks) {
+            if (bb.id == id) return bb;
+        }
+        return *current_;
+    }
+    
     // ─────────────────────────────────────────────────────────────────────
     // Constants
     // ─────────────────────────────────────────────────────────────────────
@@ -86,6 +112,10 @@ public:
         return binary_op(OpCode::DIV, lhs, rhs);
     }
     
+    Value mul_hi(Value lhs, Value rhs) {
+        return binary_op(OpCode::MUL_HI, lhs, rhs);
+    }
+    
     Value neg(Value operand) {
         Instruction instr;
         instr.op = OpCode::NEG;
@@ -95,6 +125,15 @@ public:
         return instr.result;
     }
     
+    // ─────────────────────────────────────────────────────────────────────
+    // Bitwise
+    // ─────────────────────────────────────────────────────────────────────
+    
+    Value shl(Value lhs, Value rhs) { return binary_op(OpCode::SHL, lhs, rhs); }
+    Value shr(Value lhs, Value rhs) { return binary_op(OpCode::SHR, lhs, rhs); }
+    Value bit_and(Value lhs, Value rhs) { return binary_op(OpCode::AND, lhs, rhs); }
+    Value bit_or(Value lhs, Value rhs) { return binary_op(OpCode::OR, lhs, rhs); }
+    
     // ─────────────────────────────────────────────────────────────────────
     // Comparison
     // ─────────────────────────────────────────────────────────────────────
@@ -179,13 +218,133 @@ public:
         instr.operands = {ptr, value};
         emit(instr);
     }
+    
+    // ─────────────────────────────────────────────────────────────────────
+    // Tensors
+    // ─────────────────────────────────────────────────────────────────────
+    
+    /**
+     * `shape` gives the dims known statically (DYNAMIC_DIM elsewhere);
+     * if empty, every dim is dynamic.
+     */
+    Value tensor_alloc(Value fill, const std::vector<Value>& dims,
+                       types::DType dtype = types::DType::F32,
+                       std::vector<int64_t> shape = {}) {
+        if (shape.size() != dims.size()) shape.assign(dims.size(), types::DYNAMIC_DIM);
+        Instruction instr;
+        instr.op = OpCode::TENSOR_ALLOC;
+        instr.result = fn_.new_value(types::Type::make_tensor(dtype, std::move(shape)));
+        instr.operands.push_back(fill);
+        for (const Value& d : dims) instr.operands.push_back(d);
+        instr.imm_int = static_cast<int64_t>(dtype);
+        emit(instr);
+        return instr.result;
+    }
+    
+    Value tensor_add(Value lhs, Value rhs) { return tensor_op(OpCode::TENSOR_ADD, {lhs, rhs}); }
+    Value tensor_sub(Value lhs, Value rhs) { return tensor_op(OpCode::TENSOR_SUB, {lhs, rhs}); }
+    Value tensor_mul(Value lhs, Value rhs) { return tensor_op(OpCode::TENSOR_MUL, {lhs, rhs}); }
+    Value tensor_matmul(Value lhs, Value rhs) { return tensor_op(OpCode::TENSOR_MATMUL, {lhs, rhs}); }
+    Value tensor_relu(Value operand) { return tensor_op(OpCode::TENSOR_RELU, {operand}); }
+    Value tensor_exp(Value operand) { return tensor_op(OpCode::TENSOR_EXP, {operand}); }
+    Value tensor_tanh(Value operand) { return tensor_op(OpCode::TENSOR_TANH, {operand}); }
+    Value tensor_sigmoid(Value operand) { return tensor_op(OpCode::TENSOR_SIGMOID, {operand}); }
+    Value tensor_gelu(Value operand) { return tensor_op(OpCode::TENSOR_GELU, {operand}); }
+    
+    /**
+     * View ops. As for tensor_alloc, `shape` and the constant arguments
+     * give what is known statically; the rest is worked out at run time.
+     */
+    Value tensor_reshape(Value t, const std::vector<Value>& dims, std::vector<int64_t> shape = {}) {
+        if (shape.size() != dims.size()) shape.assign(dims.size(), types::DYNAMIC_DIM);
+        auto type = types::reshape_type(t.type, std::move(shape));
+        return tensor_view(OpCode::TENSOR_RESHAPE, t, dims, type);
+    }
+    
+    Value tensor_broadcast(Value t, const std::vector<Value>& dims, std::vector<int64_t> shape = {}) {
+        if (shape.size() != dims.size()) shape.assign(dims.size(), types::DYNAMIC_DIM);
+        const types::TensorType* tt = t.type.tensor_type();
+        auto type = types::Type::make_tensor(tt ? tt->dtype : types::DType::F32, std::move(shape));
+        return tensor_view(OpCode::TENSOR_BROADCAST, t, dims, type);
+    }
+    
+    Value tensor_transpose(Value t, Value dim0, Value dim1,
+                           std::optional<int64_t> const0 = {}, std::optional<int64_t> const1 = {}) {
+        auto type = types::transpose_type(t.type, const0, const1);
+        return tensor_view(OpCode::TENSOR_TRANSPOSE, t, {dim0, dim1}, type);
+    }
+    
+    /**
+     * `constants` holds dim, start, stop and step where known.
+     */
+    Value tensor_slice(Value t, Value dim, Value start, Value stop, Value step,
+                       std::vector<std::optional<int64_t>> constants = {}) {
+        constants.resize(4);
+        auto type = types::slice_type(t.type, constants[0], constants[1], constants[2], constants[3]);
+        return tensor_view(OpCode::TENSOR_SLICE, t, {dim, start, stop, step}, type);
+    }
+    
+    /**
+     * sum, mean, max or argmax along `axis`, or over every element when
+     * it is invalid; `axis_const` is the axis where it is a literal.
+     */
+    Value tensor_reduce(OpCode op, Value t, Value axis = {}, std::optional<int64_t> axis_const = {}) {
+        auto type = types::reduce_type(t.type, !axis.valid(), axis_const,
+                                       op == OpCode::TENSOR_ARGMAX ? std::optional<types::DType>(types::DType::I64)
+                                                                   : std::nullopt);
+        std::vector<Value> args;
+        if (axis.valid()) args.push_back(axis);
+        return tensor_view(op, t, args, type);
+    }
+    
+    Value tensor_softmax(Value t, Value axis) {
+        return tensor_view(OpCode::TENSOR_SOFTMAX, t, {axis}, t.type.is_tensor() ? t.type : types::Type::make_tensor());
+    }
+    
+    /**
+     * gamma and beta are both given or both left invalid.
+     */
+    Value tensor_layernorm(Value t, Value gamma = {}, Value beta = {}, double eps = 1e-5) {
+        Instruction instr;
+        instr.op = OpCode::TENSOR_LAYERNORM;
+        instr.result = fn_.new_value(t.type.is_tensor() ? t.type : types::Type::make_tensor());
+        instr.operands.push_back(t);
+        if (gamma.valid()) {
+            instr.operands.push_back(gamma);
+            instr.operands.push_back(beta);
+        }
+        instr.imm_float = eps;
+        emit(instr);
+        return instr.result;
+    }
+    
+    /**
+     * A fused elementwise chain; `program` is postfix over `inputs`
+     * (see tensor/fused.hpp). Every input has the result's shape.
+     */
+    Value tensor_fused(const std::string& program, const std::vector<Value>& inputs) {
+        std::optional<types::Type> t;
+        if (!inputs.empty() && inputs[0].type.is_tensor()) t = inputs[0].type;
+        for (size_t i = 1; i < inputs.size() && t; ++i) {
+            t = inputs[i].type.is_tensor() ? types::elementwise_type(*t, inputs[i].type) : std::nullopt;
+        }
+        Instruction instr;
+        instr.op = OpCode::TENSOR_FUSED;
+        instr.result = fn_.new_value(t.value_or(types::Type::make_tensor()));
+        for (const Value& v : inputs) instr.operands.push_back(v);
+        instr.imm_str = program;
+        emit(instr);
+        return instr.result;
+    }
 
 private:
     Function& fn_;
-    BasicBlock* current_block_;
+    BasicBlock* current_;
+    UseDefChains* chains_ = nullptr;
     
     void emit(Instruction instr) {
-        current_block_->add(std::move(instr));
+        current_->add(std::move(instr));
+        if (chains_) chains_->add_instruction(current_->id, current_->instrs.size() - 1);
     }
     
     Value binary_op(OpCode op, Value lhs, Value rhs) {
@@ -197,6 +356,51 @@ private:
         return instr.result;
     }
     
+    Value tensor_view(OpCode op, Value t, const std::vector<Value>& args,
+                      const std::optional<types::Type>& type) {
+        Instruction instr;
+        instr.op = op;
+        instr.result = fn_.new_value(type.value_or(types::Type::make_tensor()));
+        instr.operands.push_back(t);
+        for (const Value& v : args) instr.operands.push_back(v);
+        emit(instr);
+        return instr.result;
+    }
+    
+    Value tensor_op(OpCode op, std::initializer_list<Value> operands) {
+        Instruction instr;
+        instr.op = op;
+        instr.result = fn_.new_value(tensor_result_type(op, operands));
+        instr.operands = operands;
+        emit(instr);
+        return instr.result;
+    }
+    
+    // Shape inference as in Sema; mismatches were reported there, so they
+    // just leave the result's shape unknown here
+    static types::Type tensor_result_type(OpCode op, std::initializer_list<Value> operands) {
+        const Value* v = operands.begin();
+        std::optional<types::Type> t;
+        switch (op) {
+            case OpCode::TENSOR_RELU:
+            case OpCode::TENSOR_EXP:
+            case OpCode::TENSOR_TANH:
+            case OpCode::TENSOR_SIGMOID:
+            case OpCode::TENSOR_GELU:
+                if (v[0].type.is_tensor()) t = v[0].type;
+                break;
+            case OpCode::TENSOR_MATMUL:
+                t = types::matmul_type(v[0].type, v[1].type);
+                break;
+            default:
+                if (v[0].type.is_tensor() && v[1].type.is_tensor()) {
+                    t = types::elementwise_type(v[0].type, v[1].type);
+                }
+                break;
+        }
+        return t.value_or(types::Type::make_tensor());
+    }
+    
     Value cmp(OpCode op, Value lhs, Value rhs) {
         Instruction instr;
         instr.op = op;
@@ -9,10 +9,15 @@
  */
 
 #include "types/types.hpp"
+#include "ir/arena.hpp"
+#include "ir/symbol.hpp"
 #include <string>
 #include <vector>
 #include <memory>
 #include <cstdint>
+#include <algorithm>
+#include <initializer_list>
+#include <unordered_map>
 
 namespace zero {
 namespace ir {
@@ -38,7 +43,7 @@ struct Value {
 // OpCodes
 // ─────────────────────────────────────────────────────────────────────────────
 
-enum class OpCode {
+enum class OpCode : uint8_t {
     // No-op / placeholder
     NOP,
     
@@ -51,9 +56,17 @@ enum class OpCode {
     ADD,            // result = op0 + op1
     SUB,            // result = op0 - op1
     MUL,            // result = op0 * op1
+    MUL_HI,         // result = high 64 bits of the 128-bit product op0 * op1
     DIV,            // result = op0 / op1
+    DIV_NZ,         // result = op0 / op1, op1 proven non-zero (no zero check)
     NEG,            // result = -op0
     
+    // Bitwise (integers only)
+    SHL,            // result = op0 << op1
+    SHR,            // result = op0 >> op1 (arithmetic)
+    AND,            // result = op0 & op1
+    OR,             // result = op0 | op1
+    
     // Comparison
     CMP_EQ,         // result = op0 == op1
     CMP_NE,         // result = op0 != op1
@@ -73,13 +86,32 @@ enum class OpCode {
     LOAD,           // result = *op0
     STORE,          // *op0 = op1
     
-    // Tensor operations (link to core-runtime)
-    TENSOR_ALLOC,   // result = allocate tensor
+    // Tensor operations (CPU tensor runtime)
+    TENSOR_ALLOC,   // result = tensor of shape (op1, op2, ...) filled with op0, dtype imm_int
     TENSOR_ADD,     // result = tensor_add(op0, op1)
     TENSOR_SUB,     // result = tensor_sub(op0, op1)
     TENSOR_MUL,     // result = tensor_mul(op0, op1)
     TENSOR_MATMUL,  // result = tensor_matmul(op0, op1)
     TENSOR_RELU,    // result = tensor_relu(op0)
+    TENSOR_EXP,     // result = tensor_exp(op0)
+    TENSOR_TANH,    // result = tensor_tanh(op0)
+    TENSOR_SIGMOID, // result = tensor_sigmoid(op0)
+    TENSOR_GELU,    // result = tensor_gelu(op0), tanh approximation
+    TENSOR_FUSED,   // result = elementwise program imm_str over op0, op1, ... (tensor/fused.hpp)
+    
+    // Views of op0's storage; nothing is copied
+    TENSOR_RESHAPE,     // result = op0 with shape (op1, op2, ...), one of them may be -1
+    TENSOR_TRANSPOSE,   // result = op0 with dimensions op1 and op2 swapped
+    TENSOR_SLICE,       // result = op0[op2:op3:op4] along dimension op1
+    TENSOR_BROADCAST,   // result = op0 broadcast to shape (op1, op2, ...)
+    
+    // Reductions along dimension op1, or over every element without one
+    TENSOR_SUM,         // result = sum(op0[, op1])
+    TENSOR_MEAN,        // result = mean(op0[, op1])
+    TENSOR_MAX,         // result = max(op0[, op1])
+    TENSOR_ARGMAX,      // result = i64 index of the first max of op0[ along op1]
+    TENSOR_SOFTMAX,     // result = softmax(op0) along dimension op1
+    TENSOR_LAYERNORM,   // result = layernorm(op0[, gamma op1, beta op2]) over the last dimension, eps imm_float
 };
 
 inline const char* opcode_name(OpCode op) {
@@ -91,8 +123,14 @@ inline const char* opcode_name(OpCode op) {
         case OpCode::ADD: return "add";
         case OpCode::SUB: return "sub";
         case OpCode::MUL: return "mul";
+        case OpCode::MUL_HI: return "mulhi";
         case OpCode::DIV: return "div";
+        case OpCode::DIV_NZ: return "div.nz";
         case OpCode::NEG: return "neg";
+        case OpCode::SHL: return "shl";
+        case OpCode::SHR: return "shr";
+        case OpCode::AND: return "and";
+        case OpCode::OR: return "or";
         case OpCode::CMP_EQ: return "eq";
         case OpCode::CMP_NE: return "ne";
         case OpCode::CMP_LT: return "lt";
@@ -112,33 +150,244 @@ inline const char* opcode_name(OpCode op) {
         case OpCode::TENSOR_MUL: return "tensor.mul";
         case OpCode::TENSOR_MATMUL: return "tensor.matmul";
         case OpCode::TENSOR_RELU: return "tensor.relu";
+        case OpCode::TENSOR_EXP: return "tensor.exp";
+        case OpCode::TENSOR_TANH: return "tensor.tanh";
+        case OpCode::TENSOR_SIGMOID: return "tensor.sigmoid";
+        case OpCode::TENSOR_GELU: return "tensor.gelu";
+        case OpCode::TENSOR_FUSED: return "tensor.fused";
+        case OpCode::TENSOR_RESHAPE: return "tensor.reshape";
+        case OpCode::TENSOR_TRANSPOSE: return "tensor.transpose";
+        case OpCode::TENSOR_SLICE: return "tensor.slice";
+        case OpCode::TENSOR_BROADCAST: return "tensor.broadcast";
+        case OpCode::TENSOR_SUM: return "tensor.sum";
+        case OpCode::TENSOR_MEAN: return "tensor.mean";
+        case OpCode::TENSOR_MAX: return "tensor.max";
+        case OpCode::TENSOR_ARGMAX: return "tensor.argmax";
+        case OpCode::TENSOR_SOFTMAX: return "tensor.softmax";
+        case OpCode::TENSOR_LAYERNORM: return "tensor.layernorm";
         default: return "unknown";
     }
 }
 
+/**
+ * Check if an opcode ends a basic block.
+ */
+inline bool is_terminator(OpCode op) {
+    return op == OpCode::RET || op == OpCode::BR || op == OpCode::COND_BR;
+}
+
+/**
+ * Check if an opcode is one of the CMP_* comparisons.
+ */
+inline bool is_compare(OpCode op) {
+    return op >= OpCode::CMP_EQ && op <= OpCode::CMP_GE;
+}
+
+/**
+ * Check if an opcode is one of the TENSOR_* operations.
+ */
+inline bool is_tensor_op(OpCode op) {
+    return op >= OpCode::TENSOR_ALLOC && op <= OpCode::TENSOR_LAYERNORM;
+}
+
+/**
+ * The comparison with its operands exchanged: a < b  <=>  b > a.
+ */
+inline OpCode swap_compare(OpCode op) {
+    switch (op) {
+        case OpCode::CMP_LT: return OpCode::CMP_GT;
+        case OpCode::CMP_LE: return OpCode::CMP_GE;
+        case OpCode::CMP_GT: return OpCode::CMP_LT;
+        case OpCode::CMP_GE: return OpCode::CMP_LE;
+        default: return op;
+    }
+}
+
+/**
+ * The comparison that holds exactly when `op` does not.
+ */
+inline OpCode invert_compare(OpCode op) {
+    switch (op) {
+        case OpCode::CMP_LT: return OpCode::CMP_GE;
+        case OpCode::CMP_LE: return OpCode::CMP_GT;
+        case OpCode::CMP_GT: return OpCode::CMP_LE;
+        case OpCode::CMP_GE: return OpCode::CMP_LT;
+        case OpCode::CMP_EQ: return OpCode::CMP_NE;
+        case OpCode::CMP_NE: return OpCode::CMP_EQ;
+        default: return op;
+    }
+}
+
+/**
+ * Check if an opcode computes its result from its operands alone:
+ * no memory access, no calls, no control flow. Such instructions may be
+ * moved, duplicated or deleted freely as long as operands stay available.
+ */
+inline bool is_pure(OpCode op) {
+    switch (op) {
+        case OpCode::CONST_INT:
+        case OpCode::CONST_FLOAT:
+        case OpCode::CONST_STR:
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MUL:
+        case OpCode::MUL_HI:
+        case OpCode::DIV:
+        case OpCode::DIV_NZ:
+        case OpCode::NEG:
+        case OpCode::SHL:
+        case OpCode::SHR:
+        case OpCode::AND:
+        case OpCode::OR:
+        case OpCode::CMP_EQ:
+        case OpCode::CMP_NE:
+        case OpCode::CMP_LT:
+        case OpCode::CMP_LE:
+        case OpCode::CMP_GT:
+        case OpCode::CMP_GE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Operand List
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * The operands of one instruction. Up to two are stored inline, which
+ * covers everything but calls with more arguments; those spill to the
+ * heap. Supports the subset of std::vector the passes use.
+ */
+class OperandList {
+public:
+    static constexpr uint32_t INLINE = 2;
+    
+    OperandList() : inline_{} {}
+    OperandList(std::initializer_list<Value> values) : OperandList() { assign(values.begin(), values.size()); }
+    OperandList(const std::vector<Value>& values) : OperandList() { assign(values.data(), values.size()); }
+    OperandList(const OperandList& o) : OperandList() { assign(o.data(), o.size_); }
+    OperandList(OperandList&& o) noexcept : OperandList() { take(o); }
+    ~OperandList() { release(); }
+    
+    OperandList& operator=(const OperandList& o) {
+        if (this != &o) {
+            size_ = 0;
+            assign(o.data(), o.size_);
+        }
+        return *this;
+    }
+    
+    OperandList& operator=(OperandList&& o) noexcept {
+        if (this != &o) {
+            release();
+            take(o);
+        }
+        return *this;
+    }
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    Value* data() { return cap_ > INLINE ? heap_ : inline_; }
+    const Value* data() const { return cap_ > INLINE ? heap_ : inline_; }
+    
+    Value& operator[](size_t i) { return data()[i]; }
+    const Value& operator[](size_t i) const { return data()[i]; }
+    Value& back() { return data()[size_ - 1]; }
+    const Value& back() const { return data()[size_ - 1]; }
+    
+    Value* begin() { return data(); }
+    Value* end() { return data() + size_; }
+    const Value* begin() const { return data(); }
+    const Value* end() const { return data() + size_; }
+    
+    void push_back(const Value& v) {
+        if (size_ == cap_) grow(cap_ * 2);
+        data()[size_++] = v;
+    }
+    
+    void clear() { size_ = 0; }
+    
+private:
+    uint32_t size_ = 0;
+    uint32_t cap_ = INLINE;
+    union {
+        Value inline_[INLINE];
+        Value* heap_;
+    };
+    
+    void assign(const Value* values, size_t n) {
+        if (n > cap_) grow(static_cast<uint32_t>(n));
+        std::copy(values, values + n, data());
+        size_ = static_cast<uint32_t>(n);
+    }
+    
+    void grow(uint32_t cap) {
+        Value* bigger = new Value[cap];
+        std::copy(data(), data() + size_, bigger);
+        release();
+        heap_ = bigger;
+        cap_ = cap;
+    }
+    
+    void release() {
+        if (cap_ > INLINE) delete[] heap_;
+        cap_ = INLINE;
+    }
+    
+    void take(OperandList& o) {
+        if (o.cap_ > INLINE) {
+            heap_ = o.heap_;
+            cap_ = o.cap_;
+            o.cap_ = INLINE;
+        } else {
+            std::copy(o.inline_, o.inline_ + o.size_, inline_);
+        }
+        size_ = o.size_;
+        o.size_ = 0;
+    }
+};
+
+inline bool operator==(const OperandList& a, const OperandList& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+inline bool operator!=(const OperandList& a, const OperandList& b) { return !(a == b); }
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Instruction
 // ─────────────────────────────────────────────────────────────────────────────
 
 /**
  * An IR instruction.
+ *
+ * Kept small and free of per-instruction heap allocations, so a block's
+ * instructions sit contiguously in its vector: operands are stored inline
+ * up to two, names and string constants are interned Symbols.
  */
 struct Instruction {
     OpCode op = OpCode::NOP;
     Value result;                    // Result value (if any)
-    std::vector<Value> operands;     // Operand values
+    
+    // For branches
+    uint32_t target_block = 0;       // For BR
+    uint32_t else_block = 0;         // For COND_BR
+    
+    OperandList operands;            // Operand values
     
     // For constants
     int64_t imm_int = 0;
     double imm_float = 0.0;
-    std::string imm_str;
+    Symbol imm_str;
     
     // For calls
-    std::string callee;
+    Symbol callee;
     
-    // For branches
-    uint32_t target_block = 0;       // For BR
-    uint32_t else_block = 0;         // For COND_BR
+    // From a profile: times a BR or the true edge of a COND_BR was taken,
+    // or times a CALL ran. Only meaningful if Function::has_profile.
+    uint64_t profile_count = 0;
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -152,10 +401,22 @@ struct BasicBlock {
     uint32_t id = 0;
     std::string label;
     std::vector<Instruction> instrs;
+    uint64_t profile_count = 0;      // Times entered, from a profile
     
     void add(Instruction instr) {
         instrs.push_back(std::move(instr));
     }
+
+    /**
+     * Index of the first terminator, or instrs.size() if the block falls
+     * through. Anything after the first terminator is unreachable.
+     */
+    size_t terminator_index() const {
+        for (size_t i = 0; i < instrs.size(); ++i) {
+            if (is_terminator(instrs[i].op)) return i;
+        }
+        return instrs.size();
+    }
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -163,13 +424,18 @@ struct BasicBlock {
 // ─────────────────────────────────────────────────────────────────────────────
 
 /**
- * An IR function.
+ * An IR function. Blocks live in the function's own arena, so a
+ * BasicBlock& stays valid while more blocks are created; reordering or
+ * dropping blocks goes through blocks.retain().
  */
 struct Function {
     std::string name;
     std::vector<types::Type> param_types;
+    std::vector<Value> params;               // Incoming argument values
     types::Type return_type;
-    std::vector<BasicBlock> blocks;
+    std::vector<std::string> attributes;     // Source attributes, e.g. "inline"
+    ArenaList<BasicBlock> blocks;
+    bool has_profile = false;                // Block and branch counts are filled in
     
     // SSA value counter
     uint32_t next_value_id = 1;
@@ -186,11 +452,17 @@ struct Function {
      * Create a new basic block.
      */
     BasicBlock& new_block(const std::string& label = "") {
-        BasicBlock bb;
+        BasicBlock& bb = blocks.emplace_back();
         bb.id = next_block_id++;
         bb.label = label.empty() ? ("bb" + std::to_string(bb.id)) : label;
-        blocks.push_back(std::move(bb));
-        return blocks.back();
+        return bb;
+    }
+    
+    bool has_attribute(const std::string& attr) const {
+        for (const auto& a : attributes) {
+            if (a == attr) return true;
+        }
+        return false;
     }
     
     /**
@@ -209,20 +481,20 @@ struct Function {
 // ─────────────────────────────────────────────────────────────────────────────
 
 /**
- * An IR module containing functions.
+ * An IR module containing functions. Like blocks, functions never move:
+ * the Function& from add_function() survives adding more.
  */
 struct Module {
-    std::vector<Function> functions;
+    ArenaList<Function> functions;
     
     Function& add_function(const std::string& name, 
                            const std::vector<types::Type>& params,
                            types::Type ret) {
-        Function fn;
+        Function& fn = functions.emplace_back();
         fn.name = name;
         fn.param_types = params;
         fn.return_type = ret;
-        functions.push_back(std::move(fn));
-        return functions.back();
+        return fn;
     }
     
     Function* get_function(const std::string& name) {
@@ -233,6 +505,29 @@ struct Module {
     }
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+// IR Utilities
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Rewrite every operand of `fn` that refers to `from` to refer to `to`.
+ * Returns the number of operands rewritten.
+ */
+size_t replace_all_uses(Function& fn, const Value& from, const Value& to);
+
+/**
+ * Apply many replacements in one sweep: every operand whose id is a key of
+ * `subst` is rewritten, following chains (a -> b -> c). Returns the number
+ * of operands rewritten. For single replacements with the chains at hand,
+ * see UseDefChains::replace_all_uses_with().
+ */
+size_t replace_uses(Function& fn, const std::unordered_map<uint32_t, Value>& subst);
+
+/**
+ * High 64 bits of the signed 128-bit product a * b (the MUL_HI opcode).
+ */
+int64_t mul_high(int64_t a, int64_t b);
+
 // ─────────────────────────────────────────────────────────────────────────────
 // IR Printer (for debugging)
 // ─────────────────────────────────────────────────────────────────────────────
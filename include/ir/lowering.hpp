@@ -10,7 +10,10 @@
 #include "ir/builder.hpp"
 #include "ast/ast.hpp"
 
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace zero {
 namespace ir {
@@ -23,13 +26,41 @@ public:
     Module lower(ast::Program& prog);
 
 private:
-    // Symbol table (variable name -> Value)
-    std::unordered_map<std::string, Value> symbols_;
+    // What a variable name stands for: its SSA value, or the ALLOCA
+    // holding it if it is a stack slot
+    struct Binding {
+        Value value;
+        bool slot = false;
+    };
+    
+    // Symbol table, one map per open block, innermost last, so an inner
+    // `let` shadows an outer one until its block ends
+    std::vector<std::unordered_map<std::string, Binding>> scopes_;
+    
+    // Return types of every function in the program, for call results
+    std::unordered_map<std::string, types::Type> return_types_;
+    
+    // Declarations (LetStmt or Param) that are assigned after they are
+    // made live in a stack slot each; all others stay plain SSA values.
+    std::unordered_set<const void*> assigned_;
+    size_t entry_allocas_ = 0;
+    
+    Value new_slot(IRBuilder& builder, types::Type type);
+    const Binding* lookup(const std::string& name) const;
     
     void lower_function(Module& mod, ast::FnDecl& fn);
+    void lower_block(IRBuilder& builder, std::vector<std::unique_ptr<ast::Stmt>>& stmts);
     void lower_stmt(IRBuilder& builder, ast::Stmt& stmt);
     Value lower_expr(IRBuilder& builder, ast::Expr& expr);
     
+    // The builtins of Sema::register_tensor_builtins (tensor, fill,
+    // matmul; relu, exp, tanh, sigmoid, gelu; reshape, broadcast,
+    // transpose, slice; sum, mean, max, argmax; softmax, layernorm)
+    // lower to TENSOR_* unless the program defines its own; returns an
+    // invalid value for anything else
+    Value lower_tensor_builtin(IRBuilder& builder, const ast::CallExpr& call,
+                               const std::vector<Value>& args);
+    
     void lower_if(IRBuilder& builder, ast::IfStmt& if_stmt);
     void lower_while(IRBuilder& builder, ast::WhileStmt& while_stmt);
 };
@@ -0,0 +1,131 @@
+#ifndef ZERO_IR_MEMORY_PLAN_HPP
+#define ZERO_IR_MEMORY_PLAN_HPP
+
+/**
+ * @file memory_plan.hpp
+ * @brief Zero Compiler — Tensor Memory Plans
+ *
+ * When each tensor value of a function can be let go, and which
+ * elementwise ops may write their result over an operand that dies
+ * there. Produced by opt::BufferPlanner, followed by the interpreter:
+ * it releases a value right after its last use instead of at return,
+ * so its buffer goes back to the pool for the next op of that size.
+ *
+ * Positions are block positions in Function::blocks and instruction
+ * indices, so a plan only describes the function as it was planned;
+ * plan again after changing it.
+ */
+
+#include "ir/ir.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zero {
+namespace ir {
+
+class FunctionMemoryPlan {
+public:
+    /**
+     * A run of value ids.
+     */
+    struct Values {
+        const uint32_t* first;
+        const uint32_t* last;
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    /**
+     * Tensor values whose last use is the instruction at (block, index),
+     * including results nothing reads.
+     */
+    Values released_after(size_t block, size_t index) const {
+        const size_t k = block_start_[block] + index;
+        return {releases_.data() + release_start_[k], releases_.data() + release_start_[k + 1]};
+    }
+
+    /**
+     * Tensor values live out of some predecessor of `block` but not into
+     * it: on this path they are already dead. For the entry block, the
+     * tensor parameters it never reads.
+     */
+    Values released_on_entry(size_t block) const {
+        return {entry_releases_.data() + entry_start_[block],
+                entry_releases_.data() + entry_start_[block + 1]};
+    }
+
+    /**
+     * The operand whose buffer the instruction's result may reuse, or -1.
+     */
+    int in_place_operand(size_t block, size_t index) const {
+        return in_place_[block_start_[block] + index];
+    }
+
+    size_t release_points() const { return releases_.size() + entry_releases_.size(); }
+    size_t in_place_sites() const { return in_place_sites_; }
+
+private:
+    friend class MemoryPlanBuilder;
+
+    std::vector<uint32_t> block_start_;     // Block -> its first instruction, numbered flat
+    std::vector<uint32_t> release_start_;   // Flat instruction -> offset into releases_
+    std::vector<uint32_t> releases_;
+    std::vector<uint32_t> entry_start_;     // Block -> offset into entry_releases_
+    std::vector<uint32_t> entry_releases_;
+    std::vector<int8_t> in_place_;          // Flat instruction -> operand or -1
+    size_t in_place_sites_ = 0;
+};
+
+/**
+ * Appends a function's plan one block at a time, in block order.
+ */
+class MemoryPlanBuilder {
+public:
+    MemoryPlanBuilder() { plan_.release_start_.push_back(0); plan_.entry_start_.push_back(0); }
+
+    /**
+     * Start the next block; `entry_releases` as for released_on_entry().
+     */
+    void begin_block(const std::vector<uint32_t>& entry_releases) {
+        plan_.block_start_.push_back(static_cast<uint32_t>(plan_.in_place_.size()));
+        plan_.entry_releases_.insert(plan_.entry_releases_.end(), entry_releases.begin(),
+                                     entry_releases.end());
+        plan_.entry_start_.push_back(static_cast<uint32_t>(plan_.entry_releases_.size()));
+    }
+
+    /**
+     * The next instruction of the current block.
+     */
+    void add_instruction(const std::vector<uint32_t>& releases, int in_place) {
+        plan_.releases_.insert(plan_.releases_.end(), releases.begin(), releases.end());
+        plan_.release_start_.push_back(static_cast<uint32_t>(plan_.releases_.size()));
+        plan_.in_place_.push_back(static_cast<int8_t>(in_place));
+        if (in_place >= 0) ++plan_.in_place_sites_;
+    }
+
+    FunctionMemoryPlan finish() { return std::move(plan_); }
+
+private:
+    FunctionMemoryPlan plan_;
+};
+
+/**
+ * Plans for the functions of one module that handle tensors.
+ */
+struct MemoryPlan {
+    std::unordered_map<const Function*, FunctionMemoryPlan> functions;
+
+    const FunctionMemoryPlan* find(const Function& fn) const {
+        auto it = functions.find(&fn);
+        return it == functions.end() ? nullptr : &it->second;
+    }
+};
+
+} // namespace ir
+} // namespace zero
+
+#endif // ZERO_IR_MEMORY_PLAN_HPP
@@ -0,0 +1,88 @@
+#ifndef ZERO_IR_PROFILE_HPP
+#define ZERO_IR_PROFILE_HPP
+
+/**
+ * @file profile.hpp
+ * @brief Zero Compiler — Execution Profiles
+ *
+ * Block, branch and call counts gathered by the interpreter on a training
+ * run (zeroc --profile-generate) and attached to a freshly lowered module
+ * on a later build (zeroc --profile-use) for the optimizer to consult.
+ *
+ * Counts are keyed by block id and instruction index in the unoptimized
+ * IR, so a profile only applies to the same source lowered the same way;
+ * each function carries a structural checksum to catch stale profiles.
+ */
+
+#include "ir/ir.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace zero {
+namespace ir {
+
+struct FunctionProfile {
+    uint64_t checksum = 0;
+    std::map<uint32_t, uint64_t> blocks;                      // Block id -> times entered
+    std::map<std::pair<uint32_t, uint32_t>, uint64_t> sites;  // (block id, index) -> count
+};
+
+/**
+ * Times control left `from` for the block with id `to`, from the counts
+ * on its terminator. A block without a terminator falls through with all
+ * of its count.
+ */
+uint64_t edge_count(const BasicBlock& from, uint32_t to);
+
+/**
+ * Usage:
+ *   Profile profile;
+ *   interp.set_profile(&profile);   // training run
+ *   profile.write(out);
+ *   ...
+ *   Profile::read(in).apply(module);
+ */
+class Profile {
+public:
+    /**
+     * Counters for `fn`, created on first use.
+     */
+    FunctionProfile& function(const Function& fn);
+
+    const std::map<std::string, FunctionProfile>& functions() const { return functions_; }
+
+    /**
+     * Copy the counts onto matching functions of `mod` and mark them
+     * has_profile. Functions whose checksum differs are skipped. Returns
+     * the number of functions annotated.
+     */
+    size_t apply(Module& mod) const;
+
+    /**
+     * Line-based text format; see profile.cpp.
+     */
+    void write(std::ostream& out) const;
+
+    /**
+     * Parse what write() produced. Throws std::runtime_error on malformed
+     * input.
+     */
+    static Profile read(std::istream& in);
+
+    /**
+     * Hash of a function's block and instruction structure.
+     */
+    static uint64_t checksum(const Function& fn);
+
+private:
+    std::map<std::string, FunctionProfile> functions_;
+};
+
+} // namespace ir
+} // namespace zero
+
+#endif // ZERO_IR_PROFILE_HPP
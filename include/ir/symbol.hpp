@@ -0,0 +1,81 @@
+#ifndef ZERO_IR_SYMBOL_HPP
+#define ZERO_IR_SYMBOL_HPP
+
+/**
+ * @file symbol.hpp
+ * @brief Zero Compiler — Interned Strings
+ *
+ * Callee names and string constants repeat across thousands of
+ * instructions. A Symbol is a pointer into a process-wide pool holding
+ * one copy of each distinct spelling, so an instruction carries 8 bytes
+ * instead of a std::string, copying it never allocates, and two symbols
+ * compare by pointer.
+ *
+ * Symbols convert to const std::string& and compare against plain
+ * strings, so most code can treat them as one.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace zero {
+namespace ir {
+
+class Symbol {
+public:
+    Symbol();
+    Symbol(const std::string& s);
+    Symbol(const char* s);
+
+    const std::string& str() const { return *str_; }
+    operator const std::string&() const { return *str_; }
+
+    const char* c_str() const { return str_->c_str(); }
+    size_t size() const { return str_->size(); }
+    bool empty() const { return str_->empty(); }
+    void clear() { *this = Symbol(); }
+
+    friend bool operator==(const Symbol& a, const Symbol& b) { return a.str_ == b.str_; }
+    friend bool operator!=(const Symbol& a, const Symbol& b) { return a.str_ != b.str_; }
+
+    // Plain strings compare by content without interning them
+    friend bool operator==(const Symbol& a, const std::string& b) { return *a.str_ == b; }
+    friend bool operator==(const std::string& a, const Symbol& b) { return a == *b.str_; }
+    friend bool operator==(const Symbol& a, const char* b) { return *a.str_ == b; }
+    friend bool operator==(const char* a, const Symbol& b) { return a == *b.str_; }
+    friend bool operator!=(const Symbol& a, const std::string& b) { return !(a == b); }
+    friend bool operator!=(const std::string& a, const Symbol& b) { return !(a == b); }
+    friend bool operator!=(const Symbol& a, const char* b) { return !(a == b); }
+    friend bool operator!=(const char* a, const Symbol& b) { return !(a == b); }
+
+    /**
+     * Number of distinct strings in the pool.
+     */
+    static size_t pool_size();
+
+    /**
+     * Identity of the pooled string; equal for equal symbols.
+     */
+    const void* id() const { return str_; }
+
+private:
+    const std::string* str_;
+};
+
+std::ostream& operator<<(std::ostream& os, const Symbol& s);
+
+} // namespace ir
+} // namespace zero
+
+namespace std {
+template <>
+struct hash<zero::ir::Symbol> {
+    size_t operator()(const zero::ir::Symbol& s) const {
+        return hash<const void*>()(s.id());
+    }
+};
+} // namespace std
+
+#endif // ZERO_IR_SYMBOL_HPP
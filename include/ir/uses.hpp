@@ -0,0 +1,107 @@
+#ifndef ZERO_IR_USES_HPP
+#define ZERO_IR_USES_HPP
+
+/**
+ * @file uses.hpp
+ * @brief Zero Compiler — Use-Def Chains
+ *
+ * For every SSA value of a function: the instruction that defines it and
+ * every operand slot that reads it. Built once in a single sweep, then
+ * kept current by the edits made through it, so a pass that replaces or
+ * deletes instructions does not have to rescan the function each time.
+ *
+ * Uses are recorded by position (block index, instruction index, operand
+ * index), and each operand slot remembers where it sits in its value's
+ * use list, so dropping a use is a swap with the last one. Erasing an
+ * instruction leaves a NOP in its place so positions stay valid;
+ * compact() sweeps them out at the end. Inserting into the middle of a
+ * block shifts positions: call rebuild() afterwards.
+ */
+
+#include "ir/ir.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace zero {
+namespace ir {
+
+struct Use {
+    uint32_t block;
+    uint32_t index;
+    uint32_t operand;
+};
+
+/**
+ * Usage:
+ *   UseDefChains chains(fn);
+ *   chains.replace_all_uses_with(old_value, new_value);
+ *   chains.erase_instruction(b, i);
+ *   chains.compact();
+ */
+class UseDefChains {
+public:
+    explicit UseDefChains(Function& fn);
+
+    /**
+     * Re-read the whole function, after edits that bypassed the chains.
+     */
+    void rebuild();
+
+    size_t use_count(const Value& v) const;
+    const std::vector<Use>& uses(const Value& v) const;
+
+    /**
+     * The instruction defining `v`, or nullptr for parameters and values
+     * defined nowhere.
+     */
+    Instruction* def(const Value& v);
+    bool def_site(const Value& v, size_t& block, size_t& index) const;
+
+    Instruction& at(const Use& u) { return fn_.blocks[u.block].instrs[u.index]; }
+
+    /**
+     * Point every use of `from` at `to`. Costs the number of uses of
+     * `from`. Returns that number.
+     */
+    size_t replace_all_uses_with(const Value& from, const Value& to);
+
+    /**
+     * Replace the instruction at (block, index) with a NOP, dropping its
+     * operands' uses and its definition. Its own result must be unused.
+     */
+    void erase_instruction(size_t block, size_t index);
+
+    /**
+     * Record the instruction now at (block, index): one appended to a
+     * block or written over a NOP.
+     */
+    void add_instruction(size_t block, size_t index);
+
+    /**
+     * Remove the NOPs left by erase_instruction() and renumber. Returns
+     * the number removed.
+     */
+    size_t compact();
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    Function& fn_;
+    std::vector<std::vector<Use>> uses_;       // Value id -> uses
+    std::vector<uint32_t> def_block_;          // Value id -> defining block, or NONE
+    std::vector<uint32_t> def_index_;
+
+    // Block -> instruction -> operand -> index in that operand's use list
+    std::vector<std::vector<std::vector<uint32_t>>> positions_;
+
+    void ensure(uint32_t id);
+    uint32_t& position(const Use& u) { return positions_[u.block][u.index][u.operand]; }
+    void push_use(uint32_t id, const Use& u);
+    void drop_use(const Value& v, const Use& u);
+};
+
+} // namespace ir
+} // namespace zero
+
+#endif // ZERO_IR_USES_HPP
@@ -58,6 +58,7 @@ enum class TokenType {
     COLON,          // :
     SEMICOLON,      // ;
     ARROW,          // ->
+    AT,             // @
     
     // Special
     NEWLINE,        // \n
@@ -140,6 +141,7 @@ inline const char* Token::type_name(TokenType t) {
         case TokenType::COLON:      return "COLON";
         case TokenType::SEMICOLON:  return "SEMICOLON";
         case TokenType::ARROW:      return "ARROW";
+        case TokenType::AT:         return "AT";
         case TokenType::NEWLINE:    return "NEWLINE";
         case TokenType::EOF_TOKEN:  return "EOF";
         case TokenType::ERROR:      return "ERROR";
@@ -0,0 +1,133 @@
+#ifndef ZERO_OPT_ANALYSIS_HPP
+#define ZERO_OPT_ANALYSIS_HPP
+
+/**
+ * @file analysis.hpp
+ * @brief Zero Compiler — Control-Flow Analyses
+ *
+ * CFG, dominator tree and loop nest for a single ir::Function.
+ * All analyses index blocks by their position in Function::blocks.
+ */
+
+#include "ir/ir.hpp"
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Control-Flow Graph
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Successor/predecessor lists for the blocks of a function.
+ *
+ * A block's successors come from its first terminator. A block without
+ * a terminator falls through to the next block, as in the interpreter.
+ */
+struct CFG {
+    std::vector<std::vector<size_t>> succs;
+    std::vector<std::vector<size_t>> preds;
+    std::vector<size_t> rpo;                        // Reachable blocks, reverse postorder
+    std::unordered_map<uint32_t, size_t> index_of;  // Block id -> index
+
+    size_t size() const { return succs.size(); }
+
+    bool reachable(size_t bb) const { return rpo_index_[bb] != UNREACHABLE; }
+    size_t rpo_number(size_t bb) const { return rpo_index_[bb]; }
+
+    static CFG build(const ir::Function& fn);
+
+private:
+    static constexpr size_t UNREACHABLE = static_cast<size_t>(-1);
+    std::vector<size_t> rpo_index_;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dominator Tree
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Immediate dominators (Cooper, Harvey & Kennedy iterative algorithm).
+ */
+class DominatorTree {
+public:
+    explicit DominatorTree(const CFG& cfg);
+
+    /**
+     * Immediate dominator of a block; the entry block is its own idom.
+     * Unreachable blocks have no idom and report -1.
+     */
+    long idom(size_t bb) const { return idom_[bb]; }
+
+    /**
+     * True if every path from entry to b passes through a.
+     */
+    bool dominates(size_t a, size_t b) const;
+
+private:
+    std::vector<long> idom_;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Loop Nest
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * A natural loop: a header plus every block that reaches a back edge
+ * into the header without passing through it.
+ */
+struct Loop {
+    size_t header = 0;
+    std::vector<size_t> blocks;      // Includes header, sorted by index
+    std::vector<size_t> latches;     // Sources of back edges
+    Loop* parent = nullptr;
+    std::vector<Loop*> children;
+    unsigned depth = 1;
+
+    bool contains(size_t bb) const;
+
+    /**
+     * The unique block outside the loop whose only successor is the
+     * header, or -1 if the loop has no dedicated preheader.
+     */
+    long preheader(const CFG& cfg) const;
+};
+
+/**
+ * All natural loops of a function, organized as a forest.
+ */
+class LoopInfo {
+public:
+    LoopInfo(const CFG& cfg, const DominatorTree& dom);
+
+    /**
+     * Outermost loops.
+     */
+    const std::vector<Loop*>& top_level() const { return top_level_; }
+
+    /**
+     * Every loop, innermost first (children before their parents).
+     */
+    std::vector<Loop*> postorder() const;
+
+    /**
+     * Innermost loop containing a block, or nullptr.
+     */
+    Loop* loop_for(size_t bb) const { return block_loop_[bb]; }
+
+    bool empty() const { return loops_.empty(); }
+
+private:
+    std::vector<std::unique_ptr<Loop>> loops_;
+    std::vector<Loop*> top_level_;
+    std::vector<Loop*> block_loop_;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_ANALYSIS_HPP
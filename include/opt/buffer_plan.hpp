@@ -0,0 +1,55 @@
+#ifndef ZERO_OPT_BUFFER_PLAN_HPP
+#define ZERO_OPT_BUFFER_PLAN_HPP
+
+/**
+ * @file buffer_plan.hpp
+ * @brief Zero Compiler — Tensor Buffer Planning
+ *
+ * Liveness of every tensor value, turned into an ir::MemoryPlan: where
+ * each value dies, and which elementwise ops (add, sub, mul, the
+ * activations, fused) can take the buffer of an operand dying at them. The
+ * interpreter then frees tensors as soon as they are dead and runs
+ * those ops in place, so a chain of layers keeps only the tensors it
+ * still needs rather than every intermediate result.
+ *
+ * Liveness is the usual backward dataflow over the CFG, on SSA values
+ * only: a tensor stored in a slot stays alive through the slot, and the
+ * interpreter only writes in place when nothing else holds the buffer.
+ */
+
+#include "ir/ir.hpp"
+#include "ir/memory_plan.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * Usage:
+ *   BufferPlanner planner;
+ *   ir::MemoryPlan plan = planner.plan(module);
+ *   interp.set_memory_plan(&plan);
+ */
+class BufferPlanner {
+public:
+    /**
+     * Plan every function that handles tensors.
+     */
+    ir::MemoryPlan plan(const ir::Module& mod);
+
+    /**
+     * Plan one function.
+     */
+    ir::FunctionMemoryPlan plan(const ir::Function& fn);
+
+    size_t tensor_values() const { return tensor_values_; }
+    size_t in_place_sites() const { return in_place_sites_; }
+
+private:
+    size_t tensor_values_ = 0;
+    size_t in_place_sites_ = 0;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_BUFFER_PLAN_HPP
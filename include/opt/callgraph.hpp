@@ -0,0 +1,68 @@
+#ifndef ZERO_OPT_CALLGRAPH_HPP
+#define ZERO_OPT_CALLGRAPH_HPP
+
+/**
+ * @file callgraph.hpp
+ * @brief Zero Compiler — Call Graph
+ *
+ * Direct-call graph of an ir::Module. Functions are identified by their
+ * index in Module::functions; callees not defined in the module (built-ins
+ * and FFI functions) are tracked by name as externals.
+ */
+
+#include "ir/ir.hpp"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+class CallGraph {
+public:
+    explicit CallGraph(const ir::Module& mod);
+
+    size_t size() const { return callees_.size(); }
+
+    /**
+     * Module functions called directly by function `fn` (deduplicated).
+     */
+    const std::vector<size_t>& callees(size_t fn) const { return callees_[fn]; }
+
+    /**
+     * Names of called functions that are not defined in the module.
+     */
+    const std::vector<std::string>& external_callees(size_t fn) const {
+        return externals_[fn];
+    }
+
+    /**
+     * Index of a module function by name, or -1.
+     */
+    long index_of(const std::string& name) const;
+
+    /**
+     * Strongly connected components, callees before callers.
+     */
+    const std::vector<std::vector<size_t>>& sccs() const { return sccs_; }
+
+    /**
+     * True if the function can reach itself through calls.
+     */
+    bool is_recursive(size_t fn) const { return recursive_[fn]; }
+
+private:
+    std::vector<std::vector<size_t>> callees_;
+    std::vector<std::vector<std::string>> externals_;
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<std::vector<size_t>> sccs_;
+    std::vector<bool> recursive_;
+
+    void compute_sccs();
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_CALLGRAPH_HPP
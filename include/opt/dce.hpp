@@ -0,0 +1,49 @@
+#ifndef ZERO_OPT_DCE_HPP
+#define ZERO_OPT_DCE_HPP
+
+/**
+ * @file dce.hpp
+ * @brief Zero Compiler — Dead Code Elimination
+ *
+ * Removes instructions whose results are never used and that have no
+ * side effects, stack slots that are written but never read, and
+ * anything after a block's first terminator. Unused calls go too when the
+ * module-level purity analysis shows the callee writes nothing, returns
+ * and cannot throw.
+ */
+
+#include "ir/ir.hpp"
+#include "opt/purity.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * Usage:
+ *   DeadCodeElimination dce;
+ *   dce.run(module);
+ */
+class DeadCodeElimination {
+public:
+    /**
+     * Run on every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    /**
+     * Run on one function. Returns true if anything changed. Without a
+     * module to analyse, every call is kept.
+     */
+    bool run(ir::Function& fn);
+
+    size_t removed() const { return removed_; }
+
+private:
+    size_t removed_ = 0;
+    const PurityAnalysis* purity_ = nullptr;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_DCE_HPP
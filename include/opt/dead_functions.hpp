@@ -0,0 +1,47 @@
+#ifndef ZERO_OPT_DEAD_FUNCTIONS_HPP
+#define ZERO_OPT_DEAD_FUNCTIONS_HPP
+
+/**
+ * @file dead_functions.hpp
+ * @brief Zero Compiler — Dead Function Elimination
+ *
+ * Drops module functions that no call chain from an entry point reaches.
+ * Lowering emits every declared function, and after inlining many are
+ * left without callers; the backend should not pay for them.
+ */
+
+#include "ir/ir.hpp"
+
+#include <string>
+
+namespace zero {
+namespace opt {
+
+/**
+ * Roots are the entry function plus every function marked @export. A
+ * module with neither is a library and is left alone.
+ *
+ * Usage:
+ *   DeadFunctionElimination dfe;
+ *   dfe.run(module);
+ */
+class DeadFunctionElimination {
+public:
+    explicit DeadFunctionElimination(std::string entry = "main") : entry_(std::move(entry)) {}
+
+    /**
+     * Remove unreachable functions. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    size_t removed() const { return removed_; }
+
+private:
+    std::string entry_;
+    size_t removed_ = 0;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_DEAD_FUNCTIONS_HPP
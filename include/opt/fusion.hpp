@@ -0,0 +1,56 @@
+#ifndef ZERO_OPT_FUSION_HPP
+#define ZERO_OPT_FUSION_HPP
+
+/**
+ * @file fusion.hpp
+ * @brief Zero Compiler — Elementwise Tensor Fusion
+ *
+ * Merges chains of elementwise tensor ops (tensor.add, .sub, .mul, the
+ * activations .relu, .exp, .tanh, .sigmoid and .gelu, and earlier fused
+ * ops) into one tensor.fused instruction, so that relu(a * b + c) makes a
+ * single pass over its inputs and allocates only its result, and an
+ * activation costs no extra pass over the layer output it follows. An op is folded into its consumer when:
+ *
+ *   - the consumer is elementwise and in the same block
+ *   - the consumer is its only use
+ *   - their static shapes are compatible
+ *   - no call lies between them, so a shape error still surfaces before
+ *     anything the program prints after the original op
+ *
+ * The fused op takes the place of the last op of the chain.
+ */
+
+#include "ir/ir.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * Usage:
+ *   TensorFusion fusion;
+ *   fusion.run(module);
+ */
+class TensorFusion {
+public:
+    /**
+     * Run on every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    /**
+     * Run on one function. Returns true if anything changed.
+     */
+    bool run(ir::Function& fn);
+
+    size_t fused() const { return fused_; }       // Ops folded into another
+    size_t kernels() const { return kernels_; }   // tensor.fused ops created or grown
+
+private:
+    size_t fused_ = 0;
+    size_t kernels_ = 0;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_FUSION_HPP
@@ -0,0 +1,115 @@
+#ifndef ZERO_OPT_INDUCTION_HPP
+#define ZERO_OPT_INDUCTION_HPP
+
+/**
+ * @file induction.hpp
+ * @brief Zero Compiler — Induction Variables and Strength Reduction
+ *
+ * ZIR has no phi, so loop-carried variables live in ALLOCA slots. An
+ * induction variable is a slot that holds `init` on loop entry and is
+ * bumped by a constant step exactly once per iteration; from that and the
+ * header's exit test the loop's trip count can often be computed.
+ */
+
+#include "ir/ir.hpp"
+#include "opt/analysis.hpp"
+
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+/**
+ * A basic induction variable: slot = init; each iteration slot += step.
+ */
+struct InductionVariable {
+    ir::Value slot;              // ALLOCA holding the variable
+    ir::Value init;              // Value stored before entering the loop
+    int64_t step = 0;
+    bool init_is_const = false;
+    int64_t init_const = 0;
+
+    size_t update_block = 0;     // Block of the in-loop STORE
+    size_t update_index = 0;     // Index of the STORE in that block
+};
+
+/**
+ * The header's exit test, normalized so that the loop keeps running
+ * while `iv <pred> bound` holds.
+ */
+struct ExitTest {
+    const InductionVariable* iv = nullptr;
+    ir::OpCode pred = ir::OpCode::CMP_LT;
+    ir::Value bound;
+    bool bound_is_const = false;
+    int64_t bound_const = 0;
+    size_t body = 0;             // In-loop successor of the header
+    size_t exit = 0;             // Out-of-loop successor of the header
+};
+
+/**
+ * Induction variables and exit test of one loop.
+ *
+ * Usage:
+ *   InductionAnalysis ind(fn, cfg, dom, loop);
+ *   if (ind.exit_test()) ... ind.trip_count() ...
+ */
+class InductionAnalysis {
+public:
+    InductionAnalysis(const ir::Function& fn, const CFG& cfg,
+                      const DominatorTree& dom, const Loop& loop);
+
+    const std::vector<InductionVariable>& variables() const { return ivs_; }
+
+    /**
+     * The induction variable held in `slot`, or nullptr.
+     */
+    const InductionVariable* find(const ir::Value& slot) const;
+
+    /**
+     * The header's exit test if it compares an induction variable against
+     * a loop-invariant bound and the header is the loop's only exit.
+     */
+    const ExitTest* exit_test() const { return has_exit_ ? &exit_ : nullptr; }
+
+    /**
+     * Number of times the body runs, or -1 if it is not a compile-time
+     * constant. Early returns from the body may end the loop sooner.
+     */
+    long trip_count() const { return trip_count_; }
+
+private:
+    std::vector<InductionVariable> ivs_;
+    ExitTest exit_;
+    bool has_exit_ = false;
+    long trip_count_ = -1;
+
+    void find_variables(const ir::Function& fn, const CFG& cfg,
+                        const DominatorTree& dom, const Loop& loop);
+    void find_exit_test(const ir::Function& fn, const CFG& cfg, const Loop& loop);
+    void compute_trip_count();
+};
+
+/**
+ * Replace `iv * c` inside a loop (c loop-invariant) with a second
+ * variable that starts at init * c and is bumped by step * c alongside
+ * the original, turning a multiply per use into an add per iteration.
+ */
+class StrengthReduction {
+public:
+    bool run(ir::Module& mod);
+    bool run(ir::Function& fn);
+
+    size_t reduced() const { return reduced_; }
+
+private:
+    size_t reduced_ = 0;
+
+    bool reduce(ir::Function& fn, const CFG& cfg, const DominatorTree& dom,
+                const Loop& loop);
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_INDUCTION_HPP
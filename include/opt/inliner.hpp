@@ -0,0 +1,86 @@
+#ifndef ZERO_OPT_INLINER_HPP
+#define ZERO_OPT_INLINER_HPP
+
+/**
+ * @file inliner.hpp
+ * @brief Zero Compiler — Function Inliner
+ *
+ * Replaces CALLs to module functions with a copy of the callee's blocks,
+ * removing the interpreter's per-call frame, argument vector and name
+ * lookup, and exposing the callee body to the caller's optimizations.
+ */
+
+#include "ir/ir.hpp"
+
+#include <string>
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+/**
+ * Cost model knobs. Sizes count non-branch instructions.
+ */
+struct InlineOptions {
+    size_t threshold = 24;              // Max callee size at a call site outside loops
+    size_t loop_bonus = 24;             // Extra budget per enclosing loop
+    size_t always_inline_size = 4;      // Callees this small are always inlined
+    unsigned max_recursive_inlines = 2; // Per caller, for each recursive callee
+    size_t max_function_size = 2000;    // Stop growing a caller past this
+    uint64_t hot_call_count = 100;      // With a profile: call sites run this often...
+    size_t hot_bonus = 48;              // ...get this much extra budget
+};
+
+/**
+ * Inline cost of a function body.
+ */
+size_t inline_cost(const ir::Function& fn);
+
+/**
+ * Bottom-up inliner over a module.
+ *
+ * Honours @inline (always, subject to the recursion limit) and @noinline
+ * (never); @memo functions are never inlined either. Everything else is decided by size against a budget that grows
+ * with the loop depth of the call site. With a profile, call sites that
+ * never ran are left alone and hot ones get a larger budget.
+ *
+ * Usage:
+ *   Inliner inliner;
+ *   inliner.run(module);
+ */
+class Inliner {
+public:
+    explicit Inliner(InlineOptions opts = {}) : opts_(opts) {}
+
+    /**
+     * Inline eligible calls in every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    size_t inlined() const { return inlined_; }
+
+private:
+    InlineOptions opts_;
+    size_t inlined_ = 0;
+
+    // Call results to replace by the callee's returned value, applied in
+    // one sweep per caller rather than one per inlined call
+    std::unordered_map<uint32_t, ir::Value> pending_;
+
+    bool should_inline(const ir::Function& caller, const ir::Instruction& call,
+                       const ir::Function& callee, size_t callee_cost,
+                       size_t caller_cost, unsigned loop_depth,
+                       bool recursive, unsigned recursive_count) const;
+
+    /**
+     * Splice `callee` in place of the CALL at fn.blocks[bb].instrs[idx].
+     * Returns the number of blocks appended to `fn`.
+     */
+    size_t inline_call(ir::Function& fn, size_t bb, size_t idx,
+                       const ir::Function& callee);
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_INLINER_HPP
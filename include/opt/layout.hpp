@@ -0,0 +1,61 @@
+#ifndef ZERO_OPT_LAYOUT_HPP
+#define ZERO_OPT_LAYOUT_HPP
+
+/**
+ * @file layout.hpp
+ * @brief Zero Compiler — Basic Block Layout
+ *
+ * Reorders the blocks of a function so that likely successors follow
+ * their predecessor, and moves cold blocks (error paths, code a training
+ * run never reached) to the end of the function. Branches to the next
+ * block are then dropped in favour of fall-through.
+ *
+ * Edge weights come from the profile when the function has one, and
+ * otherwise from static heuristics:
+ *
+ *   - edges that stay in a loop are likely, loop exits unlikely
+ *   - a successor that makes a call is unlikely
+ *   - a successor that returns is unlikely
+ *   - x == y is usually false
+ *
+ * Blocks are chained greedily along the heaviest edges, loop back edges
+ * excluded, and the chains are laid out entry first. Run last: other
+ * passes expect explicit branches.
+ */
+
+#include "ir/ir.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * Usage:
+ *   BlockLayout layout;
+ *   layout.run(module);
+ */
+class BlockLayout {
+public:
+    /**
+     * Lay out every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    /**
+     * Lay out one function. Returns true if anything changed.
+     */
+    bool run(ir::Function& fn);
+
+    size_t blocks_moved() const { return blocks_moved_; }
+    size_t cold_blocks() const { return cold_blocks_; }
+    size_t fall_throughs() const { return fall_throughs_; }
+
+private:
+    size_t blocks_moved_ = 0;
+    size_t cold_blocks_ = 0;
+    size_t fall_throughs_ = 0;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_LAYOUT_HPP
@@ -0,0 +1,56 @@
+#ifndef ZERO_OPT_LICM_HPP
+#define ZERO_OPT_LICM_HPP
+
+/**
+ * @file licm.hpp
+ * @brief Zero Compiler — Loop-Invariant Code Motion
+ *
+ * Moves pure instructions whose operands do not change inside a loop
+ * into the loop's preheader, so they run once instead of per iteration.
+ * Calls to pure functions that cannot throw move like arithmetic;
+ * read-only ones move when nothing in the loop can write what they read.
+ */
+
+#include "ir/ir.hpp"
+#include "opt/analysis.hpp"
+#include "opt/purity.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * LICM over the loop nest of each function.
+ *
+ * Usage:
+ *   LoopInvariantCodeMotion licm;
+ *   licm.run(module);
+ */
+class LoopInvariantCodeMotion {
+public:
+    /**
+     * Run on every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    /**
+     * Run on one function. Returns true if anything changed. Without a
+     * module to analyse, calls stay in the loop.
+     */
+    bool run(ir::Function& fn);
+
+    size_t hoisted() const { return hoisted_; }
+    size_t preheaders_created() const { return preheaders_created_; }
+
+private:
+    size_t hoisted_ = 0;
+    size_t preheaders_created_ = 0;
+    const PurityAnalysis* purity_ = nullptr;
+
+    bool insert_preheaders(ir::Function& fn);
+    bool hoist(ir::Function& fn, const CFG& cfg, const Loop& loop);
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_LICM_HPP
@@ -0,0 +1,75 @@
+#ifndef ZERO_OPT_PARTIAL_EVAL_HPP
+#define ZERO_OPT_PARTIAL_EVAL_HPP
+
+/**
+ * @file partial_eval.hpp
+ * @brief Zero Compiler — Compile-Time Evaluation of Calls
+ *
+ * Runs calls to pure functions whose arguments are all constants in a
+ * sandboxed interpreter while compiling, and replaces each call with the
+ * constant it returned. Work a program would redo on every start moves
+ * into the compiler.
+ */
+
+#include "ir/ir.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+struct PartialEvalOptions {
+    /**
+     * Instructions one call may execute before it is given up on and left
+     * for run time. Bounds compile time for loops that never finish.
+     */
+    uint64_t instruction_budget = 100000;
+
+    /**
+     * Deepest call nesting allowed inside one evaluation; keeps runaway
+     * recursion off the compiler's own stack.
+     */
+    size_t max_call_depth = 256;
+};
+
+/**
+ * Only calls the purity analysis proves pure are evaluated, so the sandbox
+ * never reaches an external, and of those none that may throw: they run
+ * tensor operations, whose size the instruction budget does not bound
+ * and whose results never fold to a scalar anyway. Results, including failures, are cached per
+ * (callee, arguments) for the module.
+ *
+ * Usage:
+ *   PartialEvaluator evaluator;
+ *   evaluator.run(module);
+ */
+class PartialEvaluator {
+public:
+    explicit PartialEvaluator(PartialEvalOptions opts = {}) : opts_(opts) {}
+
+    /**
+     * Fold calls until no more have constant arguments. Returns true if
+     * anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    size_t evaluated() const { return evaluated_; }
+    size_t cache_hits() const { return cache_hits_; }
+    size_t gave_up() const { return gave_up_; }
+
+private:
+    PartialEvalOptions opts_;
+    size_t evaluated_ = 0;
+    size_t cache_hits_ = 0;
+    size_t gave_up_ = 0;
+
+    // Encoded (callee, args) -> folded constant; NOP marks a failed call
+    std::unordered_map<std::string, ir::Instruction> cache_;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_PARTIAL_EVAL_HPP
@@ -0,0 +1,43 @@
+#ifndef ZERO_OPT_PIPELINE_HPP
+#define ZERO_OPT_PIPELINE_HPP
+
+/**
+ * @file pipeline.hpp
+ * @brief Zero Compiler — Optimization Pipeline
+ *
+ * Runs the ZIR optimization passes in a fixed order.
+ */
+
+#include "ir/ir.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * Knobs for the default pipeline.
+ */
+struct PipelineOptions {
+    bool partial_eval = false;      // Run pure calls with constant arguments
+    bool inline_functions = true;
+    bool simplify = true;
+    bool expand_division = false;   // See SimplifyOptions
+    bool simplify_cfg = true;
+    bool licm = true;
+    bool strength_reduce = false;   // Trades a multiply for a slot update
+    unsigned unroll_factor = 0;     // 0 or 1 disables unrolling
+    bool eliminate_guards = true;   // Drop checks range analysis proves redundant
+    bool fuse_tensors = true;       // One loop per chain of elementwise tensor ops
+    bool dce = true;
+    bool layout_blocks = true;      // Likely successors fall through, cold blocks last
+    bool remove_dead_functions = true;  // Keep only what main and @export reach
+};
+
+/**
+ * Optimize every function in a module in place.
+ */
+void optimize(ir::Module& mod, const PipelineOptions& opts = {});
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_PIPELINE_HPP
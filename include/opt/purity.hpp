@@ -0,0 +1,94 @@
+#ifndef ZERO_OPT_PURITY_HPP
+#define ZERO_OPT_PURITY_HPP
+
+/**
+ * @file purity.hpp
+ * @brief Zero Compiler — Interprocedural Side-Effect Analysis
+ *
+ * Classifies every function of a module, and every external it calls, by
+ * what a call may do to state outside the callee's own frame. Passes use
+ * the result to treat calls to pure functions like arithmetic.
+ */
+
+#include "ir/ir.hpp"
+
+#include <string>
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+/**
+ * Ordered from weakest to strongest effect; combining two takes the max.
+ */
+enum class Effect {
+    PURE,        // Result depends only on the arguments; no observable effects
+    READONLY,    // May read outside state (e.g. an external query), writes none
+    EFFECTFUL,   // May write outside state: I/O, FFI, unknown externals
+};
+
+inline const char* effect_name(Effect e) {
+    switch (e) {
+        case Effect::PURE: return "pure";
+        case Effect::READONLY: return "readonly";
+        case Effect::EFFECTFUL: return "effectful";
+    }
+    return "unknown";
+}
+
+/**
+ * Bottom-up over the call graph's SCCs: a function's effect is the
+ * strongest effect among its instructions and callees. Stack slots are
+ * frame-local, so ALLOCA/LOAD/STORE do not make a function impure.
+ *
+ * Externals default to effectful; `print` and `log` are known effectful,
+ * and callers can declare others (e.g. a pure math built-in).
+ *
+ * Separately, a function may throw if it runs a tensor operation, which
+ * fails on mismatched shapes, or an integer division whose divisor is
+ * not a non-zero constant, which a native backend may trap on.
+ *
+ * Usage:
+ *   PurityAnalysis purity(module);
+ *   if (purity.is_removable_call(instr)) ...
+ */
+class PurityAnalysis {
+public:
+    explicit PurityAnalysis(const ir::Module& mod,
+                            const std::unordered_map<std::string, Effect>& externals = {});
+
+    /**
+     * Effect of calling `name`, a module function or an external.
+     */
+    Effect effect(const std::string& name) const;
+
+    /**
+     * True if a call to `name` is known to come back: the callee has no
+     * loops, is not recursive, and only calls functions that return.
+     * Externals are assumed to return.
+     */
+    bool will_return(const std::string& name) const;
+
+    /**
+     * True if a call to `name` may fail at run time, itself or in a
+     * function it calls. Externals are assumed not to.
+     */
+    bool may_throw(const std::string& name) const;
+
+    /**
+     * A CALL that may be deleted when its result is unused, or executed
+     * speculatively: it writes nothing, always returns and cannot throw.
+     */
+    bool is_removable_call(const ir::Instruction& instr) const;
+
+private:
+    std::unordered_map<std::string, Effect> effects_;
+    std::unordered_map<std::string, bool> returns_;
+    std::unordered_map<std::string, bool> throws_;
+    std::unordered_map<std::string, Effect> externals_;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_PURITY_HPP
@@ -0,0 +1,139 @@
+#ifndef ZERO_OPT_RANGE_HPP
+#define ZERO_OPT_RANGE_HPP
+
+/**
+ * @file range.hpp
+ * @brief Zero Compiler — Value Range Analysis and Guard Elimination
+ *
+ * Tracks an interval [lo, hi] for every integer value of a function
+ * through arithmetic, stack slots and comparisons, and narrows it at a
+ * given block by the branch conditions that must have held to get there.
+ * Runtime guards the intervals prove redundant can then be dropped: today
+ * the divide-by-zero check, later array bounds checks.
+ */
+
+#include "ir/ir.hpp"
+#include "opt/analysis.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace zero {
+namespace opt {
+
+/**
+ * A closed interval of int64 values. lo > hi is the empty range (no value
+ * reaches here yet, or the code is unreachable).
+ */
+struct Range {
+    int64_t lo = std::numeric_limits<int64_t>::min();
+    int64_t hi = std::numeric_limits<int64_t>::max();
+
+    static Range full() { return {}; }
+    static Range empty() { return {std::numeric_limits<int64_t>::max(),
+                                   std::numeric_limits<int64_t>::min()}; }
+    static Range constant(int64_t v) { return {v, v}; }
+
+    bool is_empty() const { return lo > hi; }
+    bool is_full() const { return *this == full(); }
+    bool is_constant() const { return lo == hi; }
+    bool contains(int64_t v) const { return lo <= v && v <= hi; }
+
+    bool operator==(const Range& o) const { return lo == o.lo && hi == o.hi; }
+    bool operator!=(const Range& o) const { return !(*this == o); }
+};
+
+/**
+ * Smallest range holding both.
+ */
+Range join(const Range& a, const Range& b);
+
+/**
+ * Values in both.
+ */
+Range meet(const Range& a, const Range& b);
+
+/**
+ * Intervals for one function.
+ *
+ * Slots are tracked flow-insensitively: a load sees the join of every
+ * value stored to its slot, plus the slot's initial 0 unless every load
+ * is dominated by a store. Loops are solved by iteration with widening.
+ *
+ * Usage:
+ *   RangeAnalysis ranges(fn, cfg, dom);
+ *   if (ranges.is_nonzero(divisor, block)) ...
+ */
+class RangeAnalysis {
+public:
+    RangeAnalysis(const ir::Function& fn, const CFG& cfg, const DominatorTree& dom);
+
+    /**
+     * Interval of `v` wherever it is used.
+     */
+    Range range(const ir::Value& v) const;
+
+    /**
+     * Interval of `v` at a use in `block`, narrowed by the conditions on
+     * the branches that dominate the block.
+     */
+    Range range_at(const ir::Value& v, size_t block) const;
+
+    /**
+     * True if `v` cannot be zero at a use in `block`.
+     */
+    bool is_nonzero(const ir::Value& v, size_t block) const;
+
+    /**
+     * True if 0 <= index < length at a use in `block`.
+     */
+    bool in_bounds(const ir::Value& index, const ir::Value& length, size_t block) const;
+
+private:
+    struct DefSite {
+        const ir::Instruction* instr;
+        size_t block;
+        size_t index;
+    };
+
+    const ir::Function& fn_;
+    const CFG& cfg_;
+    const DominatorTree& dom_;
+    std::unordered_map<uint32_t, Range> ranges_;   // SSA id -> interval
+    std::unordered_map<uint32_t, Range> slots_;    // ALLOCA id -> stored values
+    std::unordered_set<uint32_t> escaped_;         // Slots used other than by load/store
+    std::unordered_map<uint32_t, DefSite> defs_;
+
+    void solve();
+    Range refine(const ir::Value& v, size_t block, unsigned depth, bool& nonzero) const;
+    Range narrow(const ir::Value& v, size_t block, Range r, bool& nonzero) const;
+    bool same_value(const ir::Value& a, const ir::Value& v, size_t pred, size_t entry) const;
+    bool slot_unchanged(const ir::Value& slot, const DefSite& first, size_t pred,
+                        size_t entry, const DefSite& second) const;
+};
+
+/**
+ * Rewrite integer DIV whose divisor is proven non-zero into DIV_NZ, which
+ * backends execute without the zero check.
+ *
+ * Usage:
+ *   GuardElimination guards;
+ *   guards.run(module);
+ */
+class GuardElimination {
+public:
+    bool run(ir::Module& mod);
+    bool run(ir::Function& fn);
+
+    size_t eliminated() const { return eliminated_; }
+
+private:
+    size_t eliminated_ = 0;
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_RANGE_HPP
@@ -0,0 +1,72 @@
+#ifndef ZERO_OPT_SIMPLIFY_HPP
+#define ZERO_OPT_SIMPLIFY_HPP
+
+/**
+ * @file simplify.hpp
+ * @brief Zero Compiler — Algebraic Simplifier
+ *
+ * Peephole rewrites of single instructions: constant folding, algebraic
+ * identities (x+0, x*1, x*0, x-x, -(-x), ...) and strength reduction of
+ * multiplication and division by constants. The identities are listed in
+ * a declarative rule table in simplify.cpp; adding one is a table row.
+ */
+
+#include "ir/ir.hpp"
+
+namespace zero {
+namespace opt {
+
+struct SimplifyOptions {
+    /**
+     * Rewrite integer division by a constant into shifts (powers of two)
+     * or a multiply-high sequence. Cheaper on hardware, but several
+     * interpreter dispatches instead of one, so off by default.
+     */
+    bool expand_division = false;
+};
+
+/**
+ * Usage:
+ *   AlgebraicSimplifier simplifier;
+ *   simplifier.run(module);
+ */
+class AlgebraicSimplifier {
+public:
+    explicit AlgebraicSimplifier(SimplifyOptions opts = {}) : opts_(opts) {}
+
+    /**
+     * Run on every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    /**
+     * Run on one function until no rule applies. Returns true if anything
+     * changed. Replaced instructions are removed; constants they leave
+     * unused are left for dead code elimination.
+     */
+    bool run(ir::Function& fn);
+
+    size_t folded() const { return folded_; }
+    size_t rewritten() const { return rewritten_; }
+
+private:
+    SimplifyOptions opts_;
+    size_t folded_ = 0;
+    size_t rewritten_ = 0;
+};
+
+/**
+ * Magic multiplier and shift for signed division by `d` (|d| >= 2), after
+ * Hacker's Delight §10-1:  n / d == (mulhi(n, M) [+/- n]) >> s, rounded
+ * toward zero.
+ */
+struct DivisionMagic {
+    int64_t multiplier = 0;
+    unsigned shift = 0;
+};
+DivisionMagic signed_division_magic(int64_t d);
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_SIMPLIFY_HPP
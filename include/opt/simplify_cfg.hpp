@@ -0,0 +1,64 @@
+#ifndef ZERO_OPT_SIMPLIFY_CFG_HPP
+#define ZERO_OPT_SIMPLIFY_CFG_HPP
+
+/**
+ * @file simplify_cfg.hpp
+ * @brief Zero Compiler — CFG Simplification
+ *
+ * Cleans up the block structure left by lowering and by other passes,
+ * so the interpreter dispatches fewer branches:
+ *
+ *   - cond_br with identical successors, or on a constant or a condition
+ *     already decided on the way in, becomes br
+ *   - edges into a block that only branches on go straight to its target
+ *   - a block is merged into its only predecessor when that predecessor
+ *     has no other successor
+ *   - unreachable blocks are removed
+ *
+ * Blocks are renumbered afterwards so that ids stay equal to indices.
+ */
+
+#include "ir/ir.hpp"
+
+namespace zero {
+namespace opt {
+
+/**
+ * Usage:
+ *   CFGSimplifier simplify;
+ *   simplify.run(module);
+ */
+class CFGSimplifier {
+public:
+    /**
+     * Run on every function. Returns true if anything changed.
+     */
+    bool run(ir::Module& mod);
+
+    /**
+     * Run on one function until nothing changes. Returns true if anything
+     * changed.
+     */
+    bool run(ir::Function& fn);
+
+    size_t branches_folded() const { return branches_folded_; }
+    size_t jumps_threaded() const { return jumps_threaded_; }
+    size_t blocks_merged() const { return blocks_merged_; }
+    size_t blocks_removed() const { return blocks_removed_; }
+
+private:
+    size_t branches_folded_ = 0;
+    size_t jumps_threaded_ = 0;
+    size_t blocks_merged_ = 0;
+    size_t blocks_removed_ = 0;
+
+    bool fold_branches(ir::Function& fn);
+    bool thread_jumps(ir::Function& fn);
+    bool merge_blocks(ir::Function& fn);
+    bool remove_unreachable(ir::Function& fn);
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_SIMPLIFY_CFG_HPP
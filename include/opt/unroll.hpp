@@ -0,0 +1,59 @@
+#ifndef ZERO_OPT_UNROLL_HPP
+#define ZERO_OPT_UNROLL_HPP
+
+/**
+ * @file unroll.hpp
+ * @brief Zero Compiler — Loop Unrolling
+ *
+ * Runs `factor` iterations of a counted loop per trip through a single
+ * guard test, dropping the per-iteration compare and branch. The original
+ * loop stays behind as the remainder loop for the last few iterations.
+ */
+
+#include "ir/ir.hpp"
+#include "opt/analysis.hpp"
+
+namespace zero {
+namespace opt {
+
+struct UnrollOptions {
+    unsigned factor = 4;              // Iterations per unrolled trip
+    size_t max_unrolled_size = 256;   // Instruction budget for the copies
+};
+
+/**
+ * Unrolls innermost loops whose only exit is an induction variable test
+ * in the header (see InductionAnalysis).
+ *
+ *   preheader -> guard: if iv + (factor-1)*step passes the test
+ *                         -> body.u0 -> ... -> body.u<factor-1> -> guard
+ *                       else
+ *                         -> original loop (remainder) -> exit
+ *
+ * Loops with a known trip count below the factor are left alone.
+ *
+ * Usage:
+ *   LoopUnroller unroller({8});
+ *   unroller.run(module);
+ */
+class LoopUnroller {
+public:
+    explicit LoopUnroller(UnrollOptions opts = {}) : opts_(opts) {}
+
+    bool run(ir::Module& mod);
+    bool run(ir::Function& fn);
+
+    size_t unrolled() const { return unrolled_; }
+
+private:
+    UnrollOptions opts_;
+    size_t unrolled_ = 0;
+
+    bool unroll(ir::Function& fn, const CFG& cfg, const DominatorTree& dom,
+                const Loop& loop);
+};
+
+} // namespace opt
+} // namespace zero
+
+#endif // ZERO_OPT_UNROLL_HPP
@@ -91,12 +91,15 @@ private:
     
     // Top-level
     ast::FnDecl parse_fn_decl();
+    std::vector<ast::Attribute> parse_attributes();
     std::vector<ast::Param> parse_params();
     ast::Type parse_type();
+    void parse_tensor_type(ast::Type& t);
     
     // Statements
     std::unique_ptr<ast::Stmt> parse_stmt();
     std::unique_ptr<ast::Stmt> parse_let_stmt();
+    std::unique_ptr<ast::Stmt> parse_assign_stmt();
     std::unique_ptr<ast::Stmt> parse_return_stmt();
     std::unique_ptr<ast::Stmt> parse_if_stmt();
     std::unique_ptr<ast::Stmt> parse_while_stmt();
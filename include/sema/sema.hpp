@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <optional>
 
 namespace zero {
@@ -30,7 +31,8 @@ enum class ErrorKind {
     WRONG_ARG_COUNT,
     TYPE_MISMATCH,
     RETURN_TYPE_MISMATCH,
-    DUPLICATE_DEFINITION
+    DUPLICATE_DEFINITION,
+    INVALID_ATTRIBUTE
 };
 
 struct SemanticError {
@@ -48,6 +50,7 @@ struct FnSignature {
     std::vector<types::Type> param_types;
     types::Type return_type;
     bool is_variadic = false;  // For built-ins that accept any number of args
+    bool has_effects = false;  // Built-ins with observable effects (print, log)
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -88,6 +91,8 @@ public:
         errors_.clear();
         scopes_.clear();
         functions_.clear();
+        calls_.clear();
+        tensor_builtins_.clear();
     }
 
 private:
@@ -97,9 +102,21 @@ private:
     // Function signatures
     std::unordered_map<std::string, FnSignature> functions_;
     
+    // tensor, fill, relu, matmul and the other tensor builtins, unless
+    // the program defines its own
+    std::unordered_set<std::string> tensor_builtins_;
+    
     // Current function return type (for checking return statements)
     types::Type current_return_type_;
     
+    // Calls made by each function body, for the @memo purity check
+    struct CallSite {
+        std::string callee;
+        source::Span span;
+    };
+    std::unordered_map<std::string, std::vector<CallSite>> calls_;
+    std::string current_fn_;
+    
     // Collected errors
     std::vector<SemanticError> errors_;
     
@@ -118,10 +135,21 @@ private:
     
     void collect_functions(ast::Program& prog);
     void register_builtins();
+    void register_tensor_builtins();
     void check_fn(ast::FnDecl& fn);
+    void check_attributes(ast::FnDecl& fn);
+    void check_memo(ast::Program& prog);
     void check_stmt(ast::Stmt& stmt);
+    void check_type(const ast::Type& t);
     types::Type check_expr(ast::Expr& expr);
     
+    // Result types of tensor operations, reporting shape mismatches
+    types::Type check_tensor_binary(ast::BinaryExpr& e, const types::Type& left,
+                                    const types::Type& right);
+    types::Type check_tensor_builtin(ast::CallExpr& e, const std::vector<types::Type>& args);
+    types::Type check_tensor_view(ast::CallExpr& e, const std::vector<types::Type>& args);
+    types::Type check_tensor_reduce(ast::CallExpr& e, const std::vector<types::Type>& args);
+    
     // ─────────────────────────────────────────────────────────────────────
     // Error reporting
     // ─────────────────────────────────────────────────────────────────────
@@ -0,0 +1,85 @@
+#ifndef ZERO_TENSOR_BUFFER_POOL_HPP
+#define ZERO_TENSOR_BUFFER_POOL_HPP
+
+/**
+ * @file buffer_pool.hpp
+ * @brief Zero Compiler — Tensor Buffer Pool
+ *
+ * Where tensor storage comes from. Freed buffers are kept, bucketed by
+ * size, and handed to the next request of the same size, so a program
+ * that allocates the same shapes over and over (every step of a batch
+ * loop) stops going back to the system allocator. The pool also counts
+ * the bytes tensors hold, for peak-memory reports.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+struct MemoryStats {
+    size_t live_bytes = 0;      // Held by tensor storage now
+    size_t peak_bytes = 0;      // Most live_bytes since the last reset_peak()
+    size_t pooled_bytes = 0;    // Freed buffers kept for reuse
+    uint64_t allocations = 0;   // Buffers handed out
+    uint64_t reused = 0;        // ... of which came from the pool
+};
+
+/**
+ * Usage:
+ *   void* p = BufferPool::global().acquire(bytes);
+ *   ...
+ *   BufferPool::global().release(p, bytes);
+ */
+class BufferPool {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+     * Keeps at most `max_pooled_bytes` of freed buffers; beyond that,
+     * released buffers go straight back to the system.
+     */
+    explicit BufferPool(size_t max_pooled_bytes);
+    ~BufferPool();
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * A 64-byte-aligned, uninitialized buffer of at least `bytes`.
+     */
+    void* acquire(size_t bytes);
+
+    /**
+     * Return a buffer from acquire(); `bytes` is the size asked for.
+     */
+    void release(void* p, size_t bytes);
+
+    /**
+     * Free every pooled buffer.
+     */
+    void trim();
+
+    MemoryStats stats() const;
+    void reset_peak();
+
+    /**
+     * The pool behind tensor storage. Its cap comes from the
+     * ZERO_TENSOR_POOL_MB environment variable (default 256).
+     */
+    static BufferPool& global();
+
+private:
+    size_t max_pooled_;
+    mutable std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<void*>> free_;   // Rounded size -> buffers
+    MemoryStats stats_;
+};
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_BUFFER_POOL_HPP
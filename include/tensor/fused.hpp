@@ -0,0 +1,82 @@
+#ifndef ZERO_TENSOR_FUSED_HPP
+#define ZERO_TENSOR_FUSED_HPP
+
+/**
+ * @file fused.hpp
+ * @brief Zero Compiler — Fused Elementwise Kernels
+ *
+ * A chain of elementwise operations run as one loop. The chain is a
+ * postfix program over the inputs, e.g. "x0 x1 mul x2 add relu" for
+ * relu(a * b + c): `xK` pushes input K, `add`, `sub` and `mul` pop two
+ * operands and `relu`, `exp`, `tanh`, `sigmoid` and `gelu` one (the last
+ * four on floating-point inputs only). The output is walked a block at a time; the
+ * intermediate values of a block stay in a small scratch buffer that
+ * fits in L1, and only the last step writes to memory, so no temporary
+ * tensor is ever allocated. Broadcast and strided inputs are gathered
+ * into scratch a block at a time as well.
+ */
+
+#include "tensor/kernels.hpp"
+#include "tensor/tensor.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+/**
+ * Usage:
+ *   FusedKernel k("x0 x1 mul x2 add relu");
+ *   Tensor y = k.run({&a, &b, &c});
+ */
+class FusedKernel {
+public:
+    /**
+     * Compile a program; throws TensorError if it is malformed.
+     */
+    explicit FusedKernel(const std::string& program);
+
+    const std::string& program() const { return program_; }
+
+    /**
+     * Number of inputs the program reads (one more than its largest xK).
+     */
+    size_t inputs() const { return inputs_; }
+
+    /**
+     * Number of operations the program performs.
+     */
+    size_t steps() const { return steps_.size(); }
+
+    /**
+     * Run on `inputs`, which must share one dtype; their shapes
+     * broadcast as for add(). Returns a contiguous tensor: `dst` if it
+     * fits (see tensor.hpp; it may be an input), otherwise a new one.
+     * `kernels` defaults to active_kernels().
+     */
+    Tensor run(const std::vector<const Tensor*>& inputs,
+               const KernelTable* kernels = nullptr, Tensor dst = {}) const;
+
+private:
+    // One operation on block-sized slots: inputs first, then scratch
+    struct Step {
+        bool unary;
+        uint8_t op;         // BinaryOp or UnaryOp
+        uint32_t dst;       // OUTPUT for the last step
+        uint32_t a;
+        uint32_t b;
+    };
+    static constexpr uint32_t OUTPUT = UINT32_MAX;
+
+    std::string program_;
+    std::vector<Step> steps_;
+    size_t inputs_ = 0;
+    size_t scratch_ = 0;
+};
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_FUSED_HPP
@@ -0,0 +1,55 @@
+#ifndef ZERO_TENSOR_GEMM_HPP
+#define ZERO_TENSOR_GEMM_HPP
+
+/**
+ * @file gemm.hpp
+ * @brief Zero Compiler — Blocked Matrix Multiplication
+ *
+ * C = A * B in the usual three levels of cache blocking: B is packed a
+ * KC x NC block at a time into NR-wide column panels, A an MC x KC block
+ * at a time into MR-tall row panels, and the ISA's micro-kernel keeps an
+ * MR x NR tile of C in registers while it runs along k. Packing reads
+ * any strides, so transposed or sliced operands need no copy first.
+ *
+ * Output tiles (MC rows by a run of B panels) are split across the
+ * thread pool; small products stay on the calling thread.
+ */
+
+#include "tensor/kernels.hpp"
+#include "types/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zero {
+namespace tensor {
+
+class ThreadPool;
+
+/**
+ * A read-only matrix: element (i, j) is at data[i * row_stride + j * col_stride].
+ */
+struct MatrixView {
+    const void* data;
+    int64_t row_stride;
+    int64_t col_stride;
+};
+
+struct GemmOptions {
+    const KernelTable* kernels = nullptr;   // nullptr: active_kernels()
+    ThreadPool* pool = nullptr;             // nullptr: ThreadPool::global()
+    size_t max_threads = 0;                 // 0: the whole pool
+};
+
+/**
+ * c[m x n] = a[m x k] * b[k x n] for f32 or f64; c is row-major with row
+ * stride ldc and must not overlap a or b.
+ */
+void gemm(types::DType dtype, int64_t m, int64_t n, int64_t k,
+          const MatrixView& a, const MatrixView& b, void* c, int64_t ldc,
+          const GemmOptions& options = {});
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_GEMM_HPP
@@ -0,0 +1,141 @@
+#ifndef ZERO_TENSOR_KERNELS_HPP
+#define ZERO_TENSOR_KERNELS_HPP
+
+/**
+ * @file kernels.hpp
+ * @brief Zero Compiler — Tensor Kernels
+ *
+ * Elementwise loops over contiguous runs of elements, reductions of a run
+ * to one value and the register-blocked GEMM micro-kernels behind matmul,
+ * one table per instruction set.
+ * The SIMD tables are compiled in their own translation units with the
+ * matching target flags and are only used when CPUID reports support, so
+ * the library still runs on any x86-64 (and, scalar only, elsewhere).
+ *
+ * The active table is chosen once, at first use: the best supported ISA,
+ * or the one named by the ZERO_TENSOR_ISA environment variable
+ * (scalar, sse2, avx2, avx512) if the CPU has it.
+ */
+
+#include "types/types.hpp"
+
+#include <cstddef>
+
+namespace zero {
+namespace tensor {
+
+enum class Isa {
+    SCALAR,
+    SSE2,
+    AVX2,       // With FMA
+    AVX512      // AVX-512F
+};
+
+const char* isa_name(Isa isa);
+
+enum class BinaryOp { ADD, SUB, MUL, MAX, COUNT };
+enum class UnaryOp { RELU, EXP, TANH, SIGMOID, GELU, COUNT };
+enum class ReduceOp { SUM, SUM_SQUARES, MAX, COUNT };
+
+// out[i] = a[i] op b[i] / out[i] = op(a[i]) for i < n; the pointers need
+// no particular alignment and out may alias an input exactly.
+// EXP, TANH, SIGMOID and GELU (the tanh approximation) are floating-point
+// only, with null i64 entries. The SIMD tables evaluate them with the
+// polynomials of vector_math.hpp, to within (measured against a long
+// double reference, f32 and f64 alike) 1 ulp for exp, 1.5 for tanh, 2.5
+// for sigmoid and 3 for gelu at x >= -1. For exp that is 0.9 ulp over
+// every f32 input and 4M random f64 ones. Below -1 gelu shrinks faster
+// than the rounding error of its argument does; there the error is under
+// 2^-24 |x| (f32) or 2^-53 |x| (f64). The scalar table calls <cmath>,
+// whose tanh is good to 2.5 ulp.
+using BinaryKernel = void (*)(const void* a, const void* b, void* out, size_t n);
+using UnaryKernel = void (*)(const void* a, void* out, size_t n);
+
+// *out = a[0] op ... op a[n - 1], one element of a's dtype, for n >= 1.
+// The sums are pairwise: runs of a few hundred elements go through
+// several vector accumulators and longer runs are split in half and
+// the halves added, so rounding error grows with log n rather than n.
+// BinaryOp::MAX keeps the first operand unless the second is greater;
+// which NaN, if any, a MAX over data holding NaNs returns is unspecified.
+using ReduceKernel = void (*)(const void* a, size_t n, void* out);
+
+// out[i] = (a[i] + shift) * scale; floating-point dtypes only
+using AffineKernel = void (*)(const void* a, void* out, size_t n, double shift, double scale);
+
+constexpr size_t DTYPE_COUNT = 3;
+
+// Floating-point dtypes only; index 0 is f32, 1 f64
+constexpr size_t FLOAT_DTYPE_COUNT = 2;
+
+// c[mr x nr] = a * b, or c += a * b when `accumulate`, where a is a packed
+// kc x mr panel (mr values per step of k) and b a packed kc x nr panel;
+// c is row-major with row stride ldc. See gemm.hpp.
+using GemmKernel = void (*)(size_t kc, const void* a, const void* b, void* c,
+                            size_t ldc, bool accumulate);
+
+struct GemmMicroKernel {
+    GemmKernel fn;
+    size_t mr;
+    size_t nr;
+};
+
+constexpr size_t GEMM_DTYPE_COUNT = FLOAT_DTYPE_COUNT;
+
+struct KernelTable {
+    Isa isa;
+    BinaryKernel binary[static_cast<size_t>(BinaryOp::COUNT)][DTYPE_COUNT];
+    UnaryKernel unary[static_cast<size_t>(UnaryOp::COUNT)][DTYPE_COUNT];
+    GemmMicroKernel gemm[GEMM_DTYPE_COUNT];
+    ReduceKernel reduce[static_cast<size_t>(ReduceOp::COUNT)][DTYPE_COUNT];
+    AffineKernel affine[FLOAT_DTYPE_COUNT];
+
+    BinaryKernel get(BinaryOp op, types::DType d) const {
+        return binary[static_cast<size_t>(op)][static_cast<size_t>(d)];
+    }
+    UnaryKernel get(UnaryOp op, types::DType d) const {
+        return unary[static_cast<size_t>(op)][static_cast<size_t>(d)];
+    }
+    const GemmMicroKernel& get_gemm(types::DType d) const {
+        return gemm[static_cast<size_t>(d)];
+    }
+    ReduceKernel get(ReduceOp op, types::DType d) const {
+        return reduce[static_cast<size_t>(op)][static_cast<size_t>(d)];
+    }
+    AffineKernel get_affine(types::DType d) const {
+        return affine[static_cast<size_t>(d)];
+    }
+};
+
+/**
+ * The best instruction set this CPU and OS support.
+ */
+Isa detect_isa();
+
+bool isa_supported(Isa isa);
+
+/**
+ * The table for `isa`, which must be supported.
+ */
+const KernelTable& kernel_table(Isa isa);
+
+/**
+ * The table used by the tensor operations.
+ */
+const KernelTable& active_kernels();
+
+/**
+ * Switch the tensor operations to `isa`, or to the best supported ISA
+ * below it. Returns the ISA now in use.
+ */
+Isa set_active_isa(Isa isa);
+
+// Per-ISA tables; the SIMD ones exist only in x86-64 builds
+const KernelTable& scalar_kernels();
+const KernelTable& sse2_kernels();
+const KernelTable& avx2_kernels();
+const KernelTable& avx512_kernels();
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_KERNELS_HPP
@@ -0,0 +1,62 @@
+#ifndef ZERO_TENSOR_REDUCE_HPP
+#define ZERO_TENSOR_REDUCE_HPP
+
+/**
+ * @file reduce.hpp
+ * @brief Zero Compiler — Tensor Reductions, Softmax and Layer Norm
+ *
+ * Reductions along one axis, seen as [outer, len, inner]: with inner == 1
+ * each output element is a contiguous run handed to the ISA's reduce
+ * kernel; otherwise whole rows of `inner` elements are combined with the
+ * elementwise kernels, so the SIMD lanes run across the kept dimension.
+ * Sums are pairwise either way. Outer rows (and, for one long run, parts
+ * of it) are spread over the thread pool once there is enough work.
+ *
+ * softmax and layernorm make one pass per row over data that is still in
+ * cache: the max (or mean) and the normalizing sum are found and applied
+ * to the row before the next one is read.
+ */
+
+#include "tensor/tensor.hpp"
+
+#include <cstdint>
+
+namespace zero {
+namespace tensor {
+
+/**
+ * Along `axis` (negative counts from the end), which is dropped from the
+ * result unless `keepdims`. mean needs a floating-point dtype, max and
+ * argmax a non-empty axis; argmax returns i64 indices of the first
+ * maximum.
+ */
+Tensor sum(const Tensor& a, int64_t axis, bool keepdims = false);
+Tensor mean(const Tensor& a, int64_t axis, bool keepdims = false);
+Tensor max(const Tensor& a, int64_t axis, bool keepdims = false);
+Tensor argmax(const Tensor& a, int64_t axis, bool keepdims = false);
+
+/**
+ * Over every element, as a 0-d tensor; argmax gives the row-major index.
+ */
+Tensor sum(const Tensor& a);
+Tensor mean(const Tensor& a);
+Tensor max(const Tensor& a);
+Tensor argmax(const Tensor& a);
+
+/**
+ * exp(x - max) / sum(exp(x - max)) along `axis`; floating-point only.
+ */
+Tensor softmax(const Tensor& a, int64_t axis = -1);
+
+/**
+ * (x - mean) / sqrt(var + eps) over the last dimension, then times
+ * `gamma` and plus `beta` when they are given; both must broadcast to
+ * [last dimension]. Floating-point only.
+ */
+Tensor layernorm(const Tensor& a, const Tensor& gamma = {}, const Tensor& beta = {},
+                 double eps = 1e-5);
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_REDUCE_HPP
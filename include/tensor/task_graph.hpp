@@ -0,0 +1,72 @@
+#ifndef ZERO_TENSOR_TASK_GRAPH_HPP
+#define ZERO_TENSOR_TASK_GRAPH_HPP
+
+/**
+ * @file task_graph.hpp
+ * @brief Zero Compiler — Dependency Graphs of Tasks
+ *
+ * Nodes numbered in an order that could run them one after another,
+ * each depending on some earlier ones. run() starts a node as soon as
+ * all it depends on has finished, on the work-stealing ThreadPool, so
+ * independent nodes run at the same time while each can still split its
+ * own work with parallel_for. The graph holds structure only and can run
+ * any number of times.
+ */
+
+#include "tensor/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+/**
+ * Usage:
+ *   TaskGraph graph;
+ *   size_t a = graph.add_node(), b = graph.add_node(), c = graph.add_node();
+ *   graph.add_edge(a, c);
+ *   graph.add_edge(b, c);
+ *   graph.run([&](size_t node) { ... });    // a and b may overlap
+ */
+class TaskGraph {
+public:
+    /**
+     * Add a node; its number is the old size().
+     */
+    size_t add_node();
+
+    /**
+     * Make `node` wait for `before`, which must be an earlier node.
+     * Repeated edges are ignored.
+     */
+    void add_edge(size_t before, size_t node);
+
+    size_t size() const { return successors_.size(); }
+    size_t edge_count() const { return edges_; }
+
+    /**
+     * Call fn(node) for every node, each after the nodes it waits for,
+     * and return when all are done. When a node throws, the nodes that
+     * wait for it are skipped, and once the others are done the exception
+     * of the lowest-numbered node that threw is rethrown: the one running
+     * them in order would have stopped at. A pool of size 1 runs the
+     * nodes in order.
+     */
+    void run(const std::function<void(size_t)>& fn, ThreadPool& pool = ThreadPool::global()) const;
+
+private:
+    struct RunState;
+    void run_from(size_t node, RunState& state) const;
+
+    std::vector<std::vector<uint32_t>> successors_;
+    std::vector<uint32_t> inputs_;      // Edges into each node
+    size_t edges_ = 0;
+};
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_TASK_GRAPH_HPP
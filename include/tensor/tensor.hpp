@@ -0,0 +1,241 @@
+#ifndef ZERO_TENSOR_TENSOR_HPP
+#define ZERO_TENSOR_TENSOR_HPP
+
+/**
+ * @file tensor.hpp
+ * @brief Zero Compiler — CPU Tensor Runtime
+ *
+ * Dense n-dimensional arrays for the TENSOR_* opcodes. A tensor is a
+ * view: shape, strides and an offset into shared, 64-byte-aligned
+ * storage. Strides are in elements; row-major tensors fresh from empty()
+ * are contiguous, but every operation also accepts strided inputs.
+ * reshape(), transpose(), slice() and broadcast_to() make new views of
+ * the same storage without copying; a broadcast dimension has stride 0.
+ */
+
+#include "types/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+using types::DType;
+
+/**
+ * Thrown on shape or dtype mismatches and invalid dimensions.
+ */
+class TensorError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Storage
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * An aligned, uninitialized byte buffer shared by the tensors viewing it,
+ * drawn from and returned to BufferPool::global().
+ */
+class Storage {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit Storage(size_t bytes);
+    ~Storage();
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    void* data() { return data_; }
+    const void* data() const { return data_; }
+    size_t bytes() const { return bytes_; }
+
+private:
+    void* data_;
+    size_t bytes_;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Usage:
+ *   Tensor a = Tensor::full({2, 3}, 1.0);
+ *   Tensor b = add(a, a);
+ *   float* p = b.data<float>();
+ */
+class Tensor {
+public:
+    using Shape = std::vector<int64_t>;
+
+    Tensor() = default;
+
+    /**
+     * A contiguous tensor with uninitialized elements.
+     */
+    static Tensor empty(const Shape& shape, DType dtype = DType::F32);
+    static Tensor full(const Shape& shape, double value, DType dtype = DType::F32);
+    static Tensor zeros(const Shape& shape, DType dtype = DType::F32) {
+        return full(shape, 0.0, dtype);
+    }
+
+    DType dtype() const { return dtype_; }
+    const Shape& shape() const { return shape_; }
+    const Shape& strides() const { return strides_; }
+    size_t ndim() const { return shape_.size(); }
+    int64_t dim(size_t i) const { return shape_[i]; }
+    size_t numel() const { return numel_; }
+    int64_t offset() const { return offset_; }
+    bool defined() const { return storage_ != nullptr; }
+
+    /**
+     * True when the elements are laid out row-major with no gaps.
+     */
+    bool is_contiguous() const;
+
+    /**
+     * Pointer to the first element (storage plus offset).
+     */
+    template <typename T>
+    T* data() { return static_cast<T*>(raw_data()); }
+    template <typename T>
+    const T* data() const { return static_cast<const T*>(raw_data()); }
+    void* raw_data();
+    const void* raw_data() const;
+
+    /**
+     * Element `i` in row-major order, whatever the strides, converted
+     * to or from double.
+     */
+    double get(size_t i) const;
+    void set(size_t i, double value);
+
+    /**
+     * A contiguous copy of this tensor's elements.
+     */
+    Tensor contiguous() const;
+
+    /**
+     * A view of the same storage with the given shape, strides (in
+     * elements) and offset from this tensor's first element. Throws if
+     * the view would reach outside the storage.
+     */
+    Tensor as_strided(const Shape& shape, const Shape& strides, int64_t offset = 0) const;
+
+    /**
+     * The same elements in row-major order under a new shape; one
+     * dimension may be -1 and is inferred. A view whenever the strides
+     * allow it (always, for contiguous tensors), otherwise a copy.
+     */
+    Tensor reshape(const Shape& shape) const;
+
+    /**
+     * A view with dimensions `dim0` and `dim1` swapped. Negative
+     * dimensions count from the end.
+     */
+    Tensor transpose(int64_t dim0, int64_t dim1) const;
+
+    /**
+     * A view of elements start, start + step, ... before stop along
+     * `dim`. As in Python, negative indices count from the end and out
+     * of range ones are clamped; `step` must be positive.
+     */
+    Tensor slice(int64_t dim, int64_t start, int64_t stop, int64_t step = 1) const;
+
+    /**
+     * A view repeating this tensor to `shape` under NumPy's broadcasting
+     * rules: dimensions are matched from the right, and size-1 or
+     * missing ones get stride 0.
+     */
+    Tensor broadcast_to(const Shape& shape) const;
+
+    bool same_shape(const Tensor& other) const { return shape_ == other.shape_; }
+    
+    /**
+     * True when no other tensor views this one's storage.
+     */
+    bool unique() const { return storage_.use_count() == 1; }
+
+    /**
+     * e.g. "tensor<f32>[2x2] [[1, 2], [3, 4]]"; long tensors are elided.
+     */
+    std::string to_string(size_t max_elements = 64) const;
+
+    /**
+     * Offset in elements of row-major element `i` from data<T>().
+     */
+    int64_t element_offset(size_t i) const;
+
+private:
+    Shape shape_;
+    Shape strides_;
+    int64_t offset_ = 0;
+    size_t numel_ = 0;
+    DType dtype_ = DType::F32;
+    std::shared_ptr<Storage> storage_;
+};
+
+std::string shape_string(const Tensor::Shape& shape);
+
+/**
+ * The shape two operands of an elementwise op broadcast to; throws if
+ * a pair of dimensions differs and neither is 1.
+ */
+Tensor::Shape broadcast_shapes(const Tensor::Shape& a, const Tensor::Shape& b);
+
+/**
+ * True when a tensor of shape `from` broadcasts to `to` unchanged.
+ */
+bool broadcasts_to(const Tensor::Shape& from, const Tensor::Shape& to);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Operations
+//
+// Each returns a new contiguous tensor. Elementwise operations need equal
+// dtypes and broadcast their operands' shapes; matmul takes [m, k] x [k, n].
+// exp, tanh, sigmoid and gelu (tanh approximation) need a floating-point
+// dtype; see kernels.hpp for their accuracy.
+// ─────────────────────────────────────────────────────────────────────────────
+
+Tensor add(const Tensor& a, const Tensor& b);
+Tensor sub(const Tensor& a, const Tensor& b);
+Tensor mul(const Tensor& a, const Tensor& b);
+Tensor relu(const Tensor& a);
+Tensor exp(const Tensor& a);
+Tensor tanh(const Tensor& a);
+Tensor sigmoid(const Tensor& a);
+Tensor gelu(const Tensor& a);
+Tensor matmul(const Tensor& a, const Tensor& b);
+
+/**
+ * As above, but the result is written over `dst` when it is a contiguous
+ * tensor of the result's (broadcast) shape and dtype; otherwise a new
+ * one is made.
+ * `dst` may be one of the inputs: that is how a dying operand is reused
+ * in place. The caller makes sure nothing else still reads it.
+ */
+Tensor add(const Tensor& a, const Tensor& b, Tensor dst);
+Tensor sub(const Tensor& a, const Tensor& b, Tensor dst);
+Tensor mul(const Tensor& a, const Tensor& b, Tensor dst);
+Tensor relu(const Tensor& a, Tensor dst);
+Tensor exp(const Tensor& a, Tensor dst);
+Tensor tanh(const Tensor& a, Tensor dst);
+Tensor sigmoid(const Tensor& a, Tensor dst);
+Tensor gelu(const Tensor& a, Tensor dst);
+
+/**
+ * True when `dst` can hold a result of this shape and dtype in place.
+ */
+bool fits(const Tensor& dst, const Tensor::Shape& shape, DType dtype);
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_TENSOR_HPP
@@ -0,0 +1,124 @@
+#ifndef ZERO_TENSOR_THREAD_POOL_HPP
+#define ZERO_TENSOR_THREAD_POOL_HPP
+
+/**
+ * @file thread_pool.hpp
+ * @brief Zero Compiler — Work-Stealing Thread Pool for Tensor Kernels
+ *
+ * A fixed set of worker threads, each with its own deque of tasks. A
+ * worker takes back the tasks it spawned newest first, while the other
+ * threads steal the oldest ones, so a thread tends to stay on data it
+ * just touched. Threads outside the pool spawn into a shared queue.
+ *
+ * A thread waiting for a group of tasks runs queued tasks meanwhile, its
+ * own first, so tasks may spawn and wait for tasks of their own: a
+ * parallel_for inside a task spreads over whichever threads are idle and
+ * nothing deadlocks. The calling thread works too, so a pool of size 1
+ * has no workers and runs everything inline.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+/**
+ * Usage:
+ *   ThreadPool::global().parallel_for(tiles, [&](size_t t) { ... });
+ *
+ *   ThreadPool::TaskGroup group;
+ *   pool.spawn(group, [&] { ... });
+ *   pool.wait(group);
+ */
+class ThreadPool {
+public:
+    /**
+     * Tasks spawned together and waited for together.
+     */
+    class TaskGroup {
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+    private:
+        friend class ThreadPool;
+        std::atomic<size_t> pending_{0};
+        std::mutex mutex_;              // Guards error_
+        std::exception_ptr error_;
+    };
+
+    /**
+     * `threads` counts the caller; 0 means one per hardware thread.
+     */
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    /**
+     * Queue `task` as part of `group`. It runs on some thread of the
+     * pool, at the latest on the one that waits for the group.
+     */
+    void spawn(TaskGroup& group, std::function<void()> task);
+
+    /**
+     * Return once every task of `group` has finished, running queued
+     * tasks meanwhile. The first exception a task of the group threw is
+     * rethrown here.
+     */
+    void wait(TaskGroup& group);
+
+    /**
+     * Call fn(0) .. fn(n - 1), spread over at most `max_threads` threads
+     * (0 for all of them), and return once every call has finished. The
+     * first exception thrown by fn is rethrown here and the calls not yet
+     * started are skipped. May be called from inside a task.
+     */
+    void parallel_for(size_t n, const std::function<void(size_t)>& fn, size_t max_threads = 0);
+
+    /**
+     * The pool shared by the tensor operations, sized by the
+     * ZERO_TENSOR_THREADS environment variable or the hardware.
+     */
+    static ThreadPool& global();
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(size_t index);
+    size_t own_queue() const;
+    bool take(size_t self, Task& task);
+    bool run_one(size_t self);
+
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<Queue>> queues_;    // One per worker, then the shared one
+
+    std::mutex sleep_mutex_;            // Guards stop_; sleepers wait on wake_
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};     // Tasks in all queues
+    bool stop_ = false;
+};
+
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_THREAD_POOL_HPP
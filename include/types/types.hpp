@@ -5,9 +5,18 @@
  * @file types.hpp
  * @brief Zero Compiler — Type System
  * 
- * Minimal type system for MPP: Int, Float, Void, Tensor.
+ * Minimal type system for MPP: Int, Float, Void, Tensor. Tensor types
+ * may also carry an element type and a (partially) static shape.
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <memory>
@@ -20,7 +29,7 @@ namespace types {
 // Type Kinds
 // ─────────────────────────────────────────────────────────────────────────────
 
-enum class TypeKind {
+enum class TypeKind : uint8_t {
     INT,        // i64
     FLOAT,      // f32
     VOID,       // No value
@@ -29,6 +38,149 @@ enum class TypeKind {
     UNKNOWN     // Placeholder / unresolved
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor element types
+// ─────────────────────────────────────────────────────────────────────────────
+
+enum class DType : uint8_t {
+    F32,
+    F64,
+    I64
+};
+
+inline const char* dtype_name(DType d) {
+    switch (d) {
+        case DType::F32: return "f32";
+        case DType::F64: return "f64";
+        case DType::I64: return "i64";
+        default:         return "?";
+    }
+}
+
+inline size_t dtype_size(DType d) {
+    return d == DType::F32 ? 4 : 8;
+}
+
+inline std::optional<DType> parse_dtype(const std::string& name) {
+    if (name == "f32") return DType::F32;
+    if (name == "f64") return DType::F64;
+    if (name == "i64") return DType::I64;
+    return std::nullopt;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor types
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * A dimension whose size is only known at run time.
+ */
+constexpr int64_t DYNAMIC_DIM = -1;
+
+/**
+ * What is statically known about a tensor: its element type and, if
+ * `ranked`, its rank and each dimension (or DYNAMIC_DIM).
+ */
+struct TensorType {
+    DType dtype = DType::F32;
+    bool ranked = true;
+    std::vector<int64_t> dims;
+    
+    bool operator<(const TensorType& o) const {
+        if (dtype != o.dtype) return dtype < o.dtype;
+        if (ranked != o.ranked) return ranked < o.ranked;
+        return dims < o.dims;
+    }
+    
+    /**
+     * e.g. "tensor<f32>[2x?]" or "tensor<f64>".
+     */
+    std::string to_string() const {
+        std::string s = std::string("tensor<") + dtype_name(dtype) + ">";
+        if (!ranked) return s;
+        s += "[";
+        for (size_t i = 0; i < dims.size(); ++i) {
+            if (i) s += "x";
+            s += dims[i] == DYNAMIC_DIM ? "?" : std::to_string(dims[i]);
+        }
+        return s + "]";
+    }
+};
+
+namespace detail {
+
+/**
+ * Interned tensor types, so a Type refers to one by a small id. Id 0 is
+ * "nothing known" and is never stored.
+ *
+ * Entries live in segments that double in size and never move: id in
+ * [2^k, 2^(k+1)) is entry id - 2^k of segment k. Interning locks; get()
+ * does not, as whoever holds an id got it after its entry was written.
+ */
+class TensorTypeTable {
+public:
+    static constexpr uint32_t MAX_ID = 0xFFFFFF;    // What fits in a Type
+    
+    explicit TensorTypeTable(uint32_t max_id = MAX_ID) : max_id_(max_id) {}
+    ~TensorTypeTable() {
+        for (auto& segment : segments_) delete[] segment.load(std::memory_order_relaxed);
+    }
+    TensorTypeTable(const TensorTypeTable&) = delete;
+    TensorTypeTable& operator=(const TensorTypeTable&) = delete;
+    
+    /**
+     * Throws std::length_error once max_id types are interned.
+     */
+    uint32_t intern(const TensorType& t) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(t);
+        if (it != ids_.end()) return it->second;
+        if (size_ >= max_id_) {
+            throw std::length_error("more than " + std::to_string(max_id_) + " tensor types");
+        }
+        uint32_t id = size_ + 1;
+        unsigned k = segment_of(id);
+        TensorType* segment = segments_[k].load(std::memory_order_relaxed);
+        if (!segment) {
+            segment = new TensorType[size_t(1) << k];
+            segments_[k].store(segment, std::memory_order_release);
+        }
+        segment[id - (uint32_t(1) << k)] = t;
+        ids_.emplace(t, id);
+        size_ = id;
+        return id;
+    }
+    
+    const TensorType& get(uint32_t id) const {
+        unsigned k = segment_of(id);
+        return segments_[k].load(std::memory_order_acquire)[id - (uint32_t(1) << k)];
+    }
+
+private:
+    static unsigned segment_of(uint32_t id) {
+#if defined(__GNUC__)
+        return 31 - static_cast<unsigned>(__builtin_clz(id));
+#else
+        unsigned k = 0;
+        while (id >>= 1) ++k;
+        return k;
+#endif
+    }
+    
+    std::mutex mutex_;                  // Guards ids_ and size_
+    std::map<TensorType, uint32_t> ids_;
+    uint32_t size_ = 0;
+    const uint32_t max_id_;
+    std::array<std::atomic<TensorType*>, 32> segments_{};
+};
+
+inline TensorTypeTable& tensor_types() {
+    static TensorTypeTable table;
+    return table;
+}
+
+} // namespace detail
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Type
 // ─────────────────────────────────────────────────────────────────────────────
@@ -36,18 +188,19 @@ enum class TypeKind {
 /**
  * Type representation.
  * 
- * For MPP, types are simple tags. Tensor shape tracking and 
- * function types can be added later.
+ * For MPP, types are simple tags. A tensor type may also refer to an
+ * interned TensorType; the reference packs into the tag's spare bytes,
+ * so with GCC and Clang a Type stays four bytes and ir::Value eight.
  */
 struct Type {
-    TypeKind kind = TypeKind::UNKNOWN;
+    TypeKind kind;
     
     // ─────────────────────────────────────────────────────────────────────
     // Constructors
     // ─────────────────────────────────────────────────────────────────────
     
-    Type() = default;
-    explicit Type(TypeKind k) : kind(k) {}
+    Type() : kind(TypeKind::UNKNOWN), tensor_(0) {}
+    explicit Type(TypeKind k) : kind(k), tensor_(0) {}
     
     // ─────────────────────────────────────────────────────────────────────
     // Factory methods
@@ -57,6 +210,14 @@ struct Type {
     static Type make_float() { return Type(TypeKind::FLOAT); }
     static Type make_void() { return Type(TypeKind::VOID); }
     static Type make_tensor() { return Type(TypeKind::TENSOR); }
+    static Type make_tensor(const TensorType& t) {
+        Type type(TypeKind::TENSOR);
+        type.tensor_ = detail::tensor_types().intern(t);
+        return type;
+    }
+    static Type make_tensor(DType dtype, std::vector<int64_t> dims) {
+        return make_tensor(TensorType{dtype, true, std::move(dims)});
+    }
     static Type make_unknown() { return Type(TypeKind::UNKNOWN); }
     
     // ─────────────────────────────────────────────────────────────────────
@@ -70,12 +231,19 @@ struct Type {
     bool is_numeric() const { return is_int() || is_float(); }
     bool is_unknown() const { return kind == TypeKind::UNKNOWN; }
     
+    /**
+     * Dtype and shape of a tensor type; nullptr if nothing is known.
+     */
+    const TensorType* tensor_type() const {
+        return kind == TypeKind::TENSOR && tensor_ ? &detail::tensor_types().get(tensor_) : nullptr;
+    }
+    
     // ─────────────────────────────────────────────────────────────────────
     // Equality
     // ─────────────────────────────────────────────────────────────────────
     
     bool operator==(const Type& other) const {
-        return kind == other.kind;
+        return kind == other.kind && tensor_ == other.tensor_;
     }
     
     bool operator!=(const Type& other) const {
@@ -99,20 +267,210 @@ struct Type {
     }
     
     std::string to_string() const {
+        if (const TensorType* t = tensor_type()) return t->to_string();
         return name();
     }
+
+private:
+    uint32_t tensor_ : 24;              // Interned TensorType id, 0 if none
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor shape rules
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * The most precise tensor type consistent with both `a` and `b`: each
+ * dimension comes from whichever side knows it. nullopt if their dtypes,
+ * ranks or static dimensions disagree.
+ */
+inline std::optional<Type> unify_tensor(const Type& a, const Type& b) {
+    const TensorType* ta = a.tensor_type();
+    const TensorType* tb = b.tensor_type();
+    if (!ta) return tb ? b : a;
+    if (!tb) return a;
+    if (ta->dtype != tb->dtype) return std::nullopt;
+    if (!ta->ranked) return b;
+    if (!tb->ranked) return a;
+    if (ta->dims.size() != tb->dims.size()) return std::nullopt;
+    
+    TensorType merged = *ta;
+    for (size_t i = 0; i < merged.dims.size(); ++i) {
+        int64_t db = tb->dims[i];
+        if (merged.dims[i] == DYNAMIC_DIM) merged.dims[i] = db;
+        else if (db != DYNAMIC_DIM && db != merged.dims[i]) return std::nullopt;
+    }
+    return Type::make_tensor(merged);
+}
+
+/**
+ * Result of an elementwise op (+, -, *) on two tensors: equal dtypes,
+ * shapes broadcast NumPy-style from the right. A dynamic dimension
+ * against a static one other than 1 must be that size (or 1), so the
+ * result takes the static size. nullopt if the dtypes or two static
+ * dimensions other than 1 disagree.
+ */
+inline std::optional<Type> elementwise_type(const Type& a, const Type& b) {
+    const TensorType* ta = a.tensor_type();
+    const TensorType* tb = b.tensor_type();
+    if (!ta) return tb ? Type::make_tensor(TensorType{tb->dtype, false, {}}) : a;
+    if (!tb) return Type::make_tensor(TensorType{ta->dtype, false, {}});
+    if (ta->dtype != tb->dtype) return std::nullopt;
+    if (!ta->ranked || !tb->ranked) return Type::make_tensor(TensorType{ta->dtype, false, {}});
+    
+    const size_t n = std::max(ta->dims.size(), tb->dims.size());
+    std::vector<int64_t> dims(n);
+    for (size_t i = 0; i < n; ++i) {
+        int64_t da = i < ta->dims.size() ? ta->dims[ta->dims.size() - 1 - i] : 1;
+        int64_t db = i < tb->dims.size() ? tb->dims[tb->dims.size() - 1 - i] : 1;
+        int64_t& d = dims[n - 1 - i];
+        if (da == db) d = da;
+        else if (da == 1) d = db;
+        else if (db == 1) d = da;
+        else if (da == DYNAMIC_DIM) d = db;
+        else if (db == DYNAMIC_DIM) d = da;
+        else return std::nullopt;
+    }
+    return Type::make_tensor(ta->dtype, std::move(dims));
+}
+
+/**
+ * Result of reshape to `dims` (DYNAMIC_DIM where not a constant; -1
+ * asks the runtime to infer, which is the same). A single unknown
+ * dimension is worked out when every other size is known. nullopt if
+ * the element counts provably differ.
+ */
+inline std::optional<Type> reshape_type(const Type& a, std::vector<int64_t> dims) {
+    const TensorType* ta = a.tensor_type();
+    const DType dtype = ta ? ta->dtype : DType::F32;
+    if (!ta || !ta->ranked) return Type::make_tensor(TensorType{dtype, ta != nullptr, dims});
+    
+    int64_t numel = 1;
+    for (int64_t d : ta->dims) numel = d == DYNAMIC_DIM || numel == DYNAMIC_DIM ? DYNAMIC_DIM : numel * d;
+    int64_t known = 1;
+    size_t unknown = 0, at = 0;
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (dims[i] == DYNAMIC_DIM) {
+            ++unknown;
+            at = i;
+        } else {
+            known *= dims[i];
+        }
+    }
+    if (numel != DYNAMIC_DIM) {
+        if (unknown == 0 && known != numel) return std::nullopt;
+        if (unknown > 0 && known != 0 && numel % known) return std::nullopt;
+        if (unknown == 1 && known != 0) dims[at] = numel / known;
+    }
+    return Type::make_tensor(dtype, std::move(dims));
+}
+
+/**
+ * Result of transpose(a, d0, d1); a dimension that is not a constant is
+ * passed as nullopt and leaves the rank but not the sizes known.
+ * nullopt if a constant dimension is out of range.
+ */
+inline std::optional<Type> transpose_type(const Type& a, std::optional<int64_t> d0,
+                                          std::optional<int64_t> d1) {
+    const TensorType* ta = a.tensor_type();
+    if (!ta || !ta->ranked) return a.is_tensor() ? a : Type::make_tensor();
+    const int64_t rank = static_cast<int64_t>(ta->dims.size());
+    for (auto* d : {&d0, &d1}) {
+        if (!*d) continue;
+        if (**d < -rank || **d >= rank) return std::nullopt;
+        if (**d < 0) **d += rank;
+    }
+    std::vector<int64_t> dims = ta->dims;
+    if (d0 && d1) std::swap(dims[*d0], dims[*d1]);
+    else dims.assign(dims.size(), DYNAMIC_DIM);
+    return Type::make_tensor(ta->dtype, std::move(dims));
+}
+
+/**
+ * Result of slice(a, dim, start, stop, step), with Python's clamping;
+ * arguments that are not constants are nullopt. nullopt if a constant
+ * dimension is out of range or the step is not positive.
+ */
+inline std::optional<Type> slice_type(const Type& a, std::optional<int64_t> dim,
+                                      std::optional<int64_t> start, std::optional<int64_t> stop,
+                                      std::optional<int64_t> step) {
+    const TensorType* ta = a.tensor_type();
+    if (step && *step <= 0) return std::nullopt;
+    if (!ta || !ta->ranked) return a.is_tensor() ? a : Type::make_tensor();
+    const int64_t rank = static_cast<int64_t>(ta->dims.size());
+    std::vector<int64_t> dims = ta->dims;
+    if (!dim) {
+        dims.assign(dims.size(), DYNAMIC_DIM);
+        return Type::make_tensor(ta->dtype, std::move(dims));
+    }
+    if (*dim < -rank || *dim >= rank) return std::nullopt;
+    int64_t& d = dims[*dim < 0 ? *dim + rank : *dim];
+    if (d == DYNAMIC_DIM || !start || !stop || !step) {
+        d = DYNAMIC_DIM;
+    } else {
+        auto clamp = [n = d](int64_t i) { return std::min(std::max(i < 0 ? i + n : i, int64_t(0)), n); };
+        const int64_t lo = clamp(*start), hi = clamp(*stop);
+        d = hi > lo ? (hi - lo + *step - 1) / *step : 0;
+    }
+    return Type::make_tensor(ta->dtype, std::move(dims));
+}
+
+/**
+ * Result of reducing `a` (sum, mean, max, argmax) along `axis`, which
+ * is dropped, or over every element to a 0-d tensor when `whole`. A
+ * non-constant axis is nullopt and leaves only the rank known. The
+ * dtype is a's unless `dtype` is given. nullopt if a constant axis is
+ * out of range or a known rank is 0.
+ */
+inline std::optional<Type> reduce_type(const Type& a, bool whole, std::optional<int64_t> axis,
+                                       std::optional<DType> dtype = std::nullopt) {
+    const TensorType* ta = a.tensor_type();
+    const DType result = dtype ? *dtype : ta ? ta->dtype : DType::F32;
+    if (whole) return Type::make_tensor(result, {});
+    if (!ta || !ta->ranked) return Type::make_tensor(TensorType{result, false, {}});
+    const int64_t rank = static_cast<int64_t>(ta->dims.size());
+    if (rank == 0 || (axis && (*axis < -rank || *axis >= rank))) return std::nullopt;
+    std::vector<int64_t> dims = ta->dims;
+    if (axis) dims.erase(dims.begin() + (*axis < 0 ? *axis + rank : *axis));
+    else dims.assign(dims.size() - 1, DYNAMIC_DIM);
+    return Type::make_tensor(result, std::move(dims));
+}
+
+/**
+ * Result of matmul: [m, k] x [k, n] -> [m, n]. nullopt if a known rank
+ * is not 2 or the dtypes or static inner dimensions disagree.
+ */
+inline std::optional<Type> matmul_type(const Type& a, const Type& b) {
+    const TensorType* ta = a.tensor_type();
+    const TensorType* tb = b.tensor_type();
+    if ((ta && ta->ranked && ta->dims.size() != 2) || (tb && tb->ranked && tb->dims.size() != 2)) {
+        return std::nullopt;
+    }
+    if (ta && tb && ta->dtype != tb->dtype) return std::nullopt;
+    if (!ta && !tb) return Type::make_tensor();
+    
+    const DType dtype = ta ? ta->dtype : tb->dtype;
+    const bool ranked_a = ta && ta->ranked, ranked_b = tb && tb->ranked;
+    if (ranked_a && ranked_b) {
+        int64_t ka = ta->dims[1], kb = tb->dims[0];
+        if (ka != DYNAMIC_DIM && kb != DYNAMIC_DIM && ka != kb) return std::nullopt;
+    }
+    return Type::make_tensor(dtype, {ranked_a ? ta->dims[0] : DYNAMIC_DIM,
+                                     ranked_b ? tb->dims[1] : DYNAMIC_DIM});
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Type utilities
 // ─────────────────────────────────────────────────────────────────────────────
 
 /**
  * Check if two types are compatible for assignment.
- * For MPP, this is just equality.
+ * For MPP, this is equality, except that tensors only need to agree
+ * on what both sides know.
  */
 inline bool types_compatible(const Type& a, const Type& b) {
     if (a.is_unknown() || b.is_unknown()) return true;
+    if (a.is_tensor() && b.is_tensor()) return unify_tensor(a, b).has_value();
     return a == b;
 }
 
@@ -128,6 +486,10 @@ inline Type binary_result_type(const Type& left, const Type& right) {
     // Same types -> same result
     if (left == right) return left;
     
+    if (left.is_tensor() && right.is_tensor()) {
+        return elementwise_type(left, right).value_or(Type::make_unknown());
+    }
+    
     // Int + Float -> Float (promotion)
     if (left.is_numeric() && right.is_numeric()) {
         if (left.is_float() || right.is_float()) {
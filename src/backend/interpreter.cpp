@@ -4,6 +4,9 @@
  */
 
 #include "backend/interpreter.hpp"
+#include "tensor/reduce.hpp"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 
@@ -18,8 +21,12 @@ using namespace ir;
 
 RuntimeValue Interpreter::execute(Module& mod, const std::string& entry) {
     module_ = &mod;
-    values_.clear();
     call_stack_.clear();
+    memo_.clear();
+    regions_.clear();
+    executed_ = 0;
+    graph_runs_ = 0;
+    graph_ops_ = 0;
     
     // Find entry function
     Function* entry_fn = mod.get_function(entry);
@@ -38,6 +45,193 @@ RuntimeValue Interpreter::execute(Module& mod, const std::string& entry) {
     return result;
 }
 
+RuntimeValue Interpreter::call(Module& mod, const std::string& name,
+                               std::vector<RuntimeValue> args) {
+    module_ = &mod;
+    call_stack_.clear();
+    memo_.clear();
+    regions_.clear();
+    executed_ = 0;
+    graph_runs_ = 0;
+    graph_ops_ = 0;
+    
+    Function* fn = mod.get_function(name);
+    if (!fn) {
+        throw std::runtime_error("Function not found: " + name);
+    }
+    if (fn->has_attribute("memo")) return call_memoized(*fn, std::move(args));
+    return call_function(*fn, std::move(args));
+}
+
+RuntimeValue Interpreter::call_memoized(const Function& fn, std::vector<RuntimeValue> args) {
+    if (memo_opts_.capacity == 0) return call_function(fn, std::move(args));
+    
+    auto it = memo_.find(&fn);
+    if (it == memo_.end()) {
+        it = memo_.emplace(&fn, MemoCache(fn.params.size(), memo_opts_)).first;
+    }
+    
+    // Map nodes do not move when nested calls add caches
+    MemoCache& cache = it->second;
+    
+    RuntimeValue result;
+    if (cache.lookup(args, result)) return result;
+    result = call_function(fn, args);
+    cache.insert(args, result);
+    return result;
+}
+
+const tensor::Tensor& Interpreter::get_tensor(const Value& v) {
+    auto& locals = call_stack_.back().locals;
+    auto it = locals.find(v.id);
+    if (it == locals.end() || !it->second.is_tensor()) {
+        throw tensor::TensorError("Tensor operand %" + std::to_string(v.id) + " is not a tensor");
+    }
+    return it->second.as_tensor();
+}
+
+tensor::Tensor Interpreter::in_place_target(const Instruction& instr, size_t index) {
+    const CallFrame& frame = call_stack_.back();
+    if (!frame.plan) return {};
+    int k = frame.plan->in_place_operand(frame.block_idx, index);
+    if (k < 0) return {};
+    auto it = frame.locals.find(instr.operands[k].id);
+    if (it == frame.locals.end() || !it->second.owns_tensor()) return {};
+    // In graph mode a view of the buffer may have just been dropped by
+    // another thread; its reads must be done before ours overwrite it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const tensor::Tensor& target = it->second.as_tensor();
+    if (!target.is_contiguous()) return {};
+    // A broadcast operand smaller than the result cannot hold it
+    for (const Value& v : instr.operands) {
+        if (!tensor::broadcasts_to(get_tensor(v).shape(), target.shape())) return {};
+    }
+    in_place_ops_.fetch_add(1, std::memory_order_relaxed);
+    return target;
+}
+
+void Interpreter::release(ir::FunctionMemoryPlan::Values values) {
+    auto& locals = call_stack_.back().locals;
+    for (uint32_t id : values) locals.erase(id);
+}
+
+const tensor::FusedKernel& Interpreter::fused_kernel(const Symbol& program) {
+    auto it = fused_.find(program.id());
+    if (it == fused_.end()) {
+        it = fused_.emplace(program.id(), std::make_unique<tensor::FusedKernel>(program.str())).first;
+    }
+    return *it->second;
+}
+
+const Interpreter::TensorRegion& Interpreter::tensor_region(const BasicBlock& bb, size_t start) {
+    auto [it, inserted] = regions_.try_emplace(&bb.instrs[start]);
+    TensorRegion& region = it->second;
+    if (!inserted) return region;
+    
+    for (size_t i = start; i < bb.instrs.size(); ++i) {
+        OpCode op = bb.instrs[i].op;
+        if (is_tensor_op(op)) {
+            region.nodes.push_back(static_cast<uint32_t>(i));
+        } else if (op == OpCode::CONST_INT || op == OpCode::CONST_FLOAT) {
+            region.constants.push_back(static_cast<uint32_t>(i));
+        } else {
+            break;
+        }
+    }
+    while (!region.constants.empty() && region.constants.back() > region.nodes.back()) {
+        region.constants.pop_back();
+    }
+    region.end = region.nodes.back() + 1;
+    if (region.nodes.size() < 2) return region;
+    
+    // Nodes may not compile their kernels: that inserts into fused_
+    for (uint32_t i : region.nodes) {
+        if (bb.instrs[i].op != OpCode::TENSOR_FUSED) continue;
+        try {
+            fused_kernel(bb.instrs[i].imm_str);
+        } catch (const tensor::TensorError&) {
+            // Run in order, so the op reports it where it should
+            region.nodes.resize(1);
+            return region;
+        }
+    }
+    
+    // A node waits for the nodes defining its operands, and a node a
+    // value dies at (which drops it, or overwrites it in place) for the
+    // value's other readers
+    const CallFrame& frame = call_stack_.back();
+    std::unordered_map<uint32_t, uint32_t> producer;                // Value id -> node
+    std::unordered_map<uint32_t, std::vector<uint32_t>> readers;    // Value id -> nodes
+    for (uint32_t n = 0; n < region.nodes.size(); ++n) {
+        const Instruction& instr = bb.instrs[region.nodes[n]];
+        region.graph.add_node();
+        for (const Value& v : instr.operands) {
+            auto p = producer.find(v.id);
+            if (p != producer.end()) region.graph.add_edge(p->second, n);
+            readers[v.id].push_back(n);
+        }
+        if (frame.plan) {
+            for (uint32_t id : frame.plan->released_after(frame.block_idx, region.nodes[n])) {
+                auto r = readers.find(id);
+                if (r == readers.end()) continue;
+                for (uint32_t reader : r->second) {
+                    if (reader != n) region.graph.add_edge(reader, n);
+                }
+            }
+        }
+        if (instr.result.valid()) producer[instr.result.id] = n;
+    }
+    return region;
+}
+
+RuntimeValue Interpreter::run_tensor_region(const TensorRegion& region, const BasicBlock& bb) {
+    CallFrame& frame = call_stack_.back();
+    for (uint32_t i : region.constants) exec_instruction(bb.instrs[i], i);
+    
+    // Every result gets its entry now: while the graph runs, nodes only
+    // look entries up and assign to them, and each entry is touched by
+    // one node at a time
+    for (uint32_t i : region.nodes) {
+        if (bb.instrs[i].result.valid()) frame.locals[bb.instrs[i].result.id];
+    }
+    
+    const ir::FunctionMemoryPlan* plan = frame.plan;
+    const size_t block = frame.block_idx;
+    RuntimeValue last;
+    region.graph.run([&](size_t node) {
+        const size_t i = region.nodes[node];
+        RuntimeValue value = exec_instruction(bb.instrs[i], i);
+        if (plan) {
+            for (uint32_t id : plan->released_after(block, i)) {
+                auto it = frame.locals.find(id);
+                if (it != frame.locals.end()) it->second = RuntimeValue{};
+            }
+        }
+        if (node + 1 == region.nodes.size()) last = std::move(value);
+    });
+    
+    if (plan) {
+        for (size_t i = region.nodes.front(); i < region.end; ++i) {
+            release(plan->released_after(block, i));
+        }
+    }
+    ++graph_runs_;
+    graph_ops_ += region.nodes.size();
+    return last;
+}
+
+uint64_t Interpreter::memo_hits() const {
+    uint64_t n = 0;
+    for (const auto& [fn, cache] : memo_) n += cache.hits();
+    return n;
+}
+
+uint64_t Interpreter::memo_misses() const {
+    uint64_t n = 0;
+    for (const auto& [fn, cache] : memo_) n += cache.misses();
+    return n;
+}
+
 RuntimeValue Interpreter::call_function(const Function& fn, 
                                           std::vector<RuntimeValue> args) {
     // Check for external function
@@ -46,31 +240,51 @@ RuntimeValue Interpreter::call_function(const Function& fn,
         return ext_it->second(args);
     }
     
+    if (max_depth_ && call_stack_.size() >= max_depth_) {
+        throw ExecutionLimitExceeded("Call depth limit exceeded in " + fn.name);
+    }
+    
     // Push call frame
     CallFrame frame;
     frame.fn = &fn;
     frame.block_idx = 0;
     frame.instr_idx = 0;
-    call_stack_.push_back(frame);
+    if (profile_) frame.profile = &profile_->function(fn);
+    if (memory_plan_) frame.plan = memory_plan_->find(fn);
     
-    // TODO: Bind arguments to parameter values
-    // For now, we don't pass arguments through IR
+    // Bind arguments to parameter values
+    for (size_t i = 0; i < args.size() && i < fn.params.size(); ++i) {
+        frame.locals[fn.params[i].id] = std::move(args[i]);
+    }
+    call_stack_.push_back(std::move(frame));
+    
+    // Nested calls may grow call_stack_, so address our frame by index
+    const size_t frame_idx = call_stack_.size() - 1;
     
     // Execute blocks
     RuntimeValue result;
     
-    while (!call_stack_.empty() && call_stack_.back().fn == &fn) {
-        auto& current = call_stack_.back();
-        
-        if (current.block_idx >= fn.blocks.size()) {
+    while (call_stack_.size() > frame_idx) {
+        if (call_stack_[frame_idx].block_idx >= fn.blocks.size()) {
             break;
         }
         
-        const BasicBlock& bb = fn.blocks[current.block_idx];
+        const BasicBlock& bb = fn.blocks[call_stack_[frame_idx].block_idx];
+        if (ir::FunctionProfile* fp = call_stack_[frame_idx].profile) {
+            ++fp->blocks[bb.id];
+        }
+        if (const ir::FunctionMemoryPlan* plan = call_stack_[frame_idx].plan) {
+            release(plan->released_on_entry(call_stack_[frame_idx].block_idx));
+        }
         
-        while (current.instr_idx < bb.instrs.size()) {
+        while (call_stack_[frame_idx].instr_idx < bb.instrs.size()) {
+            auto& current = call_stack_[frame_idx];
             const Instruction& instr = bb.instrs[current.instr_idx];
             
+            if (++executed_ > budget_ && budget_) {
+                throw ExecutionLimitExceeded("Instruction budget exceeded in " + fn.name);
+            }
+            
             // Check for return
             if (instr.op == OpCode::RET) {
                 if (!instr.operands.empty()) {
@@ -82,6 +296,9 @@ RuntimeValue Interpreter::call_function(const Function& fn,
             
             // Check for branch
             if (instr.op == OpCode::BR) {
+                if (current.profile) {
+                    ++current.profile->sites[{bb.id, static_cast<uint32_t>(current.instr_idx)}];
+                }
                 current.block_idx = instr.target_block;
                 current.instr_idx = 0;
                 break;
@@ -90,6 +307,9 @@ RuntimeValue Interpreter::call_function(const Function& fn,
             if (instr.op == OpCode::COND_BR) {
                 RuntimeValue cond = get_value(instr.operands[0]);
                 if (cond.to_int() != 0) {
+                    if (current.profile) {
+                        ++current.profile->sites[{bb.id, static_cast<uint32_t>(current.instr_idx)}];
+                    }
                     current.block_idx = instr.target_block;
                 } else {
                     current.block_idx = instr.else_block;
@@ -98,11 +318,31 @@ RuntimeValue Interpreter::call_function(const Function& fn,
                 break;
             }
             
-            // Execute instruction
-            result = exec_instruction(instr);
-            current.instr_idx++;
+            // In graph mode a run of tensor ops executes as one graph,
+            // unless the budget would run out inside it
+            if (graph_mode_ && is_tensor_op(instr.op)) {
+                const TensorRegion& region = tensor_region(bb, current.instr_idx);
+                const uint64_t rest = region.end - current.instr_idx - 1;
+                if (region.nodes.size() >= 2 && !(budget_ && executed_ + rest > budget_)) {
+                    executed_ += rest;
+                    result = RuntimeValue{};
+                    result = run_tensor_region(region, bb);
+                    call_stack_[frame_idx].instr_idx = region.end;
+                    continue;
+                }
+            }
+            
+            // Execute instruction. The previous result goes first, so the
+            // tensor it may hold can be reused in place.
+            result = RuntimeValue{};
+            result = exec_instruction(instr, current.instr_idx);
+            auto& after = call_stack_[frame_idx];
+            if (after.plan) release(after.plan->released_after(after.block_idx, after.instr_idx));
+            after.instr_idx++;
         }
         
+        auto& current = call_stack_[frame_idx];
+        
         // If we finished the block without a branch, move to next
         if (current.instr_idx >= bb.instrs.size() && 
             current.block_idx < fn.blocks.size() - 1) {
@@ -114,14 +354,14 @@ RuntimeValue Interpreter::call_function(const Function& fn,
     }
     
     // Pop frame if still on stack
-    if (!call_stack_.empty() && call_stack_.back().fn == &fn) {
+    if (call_stack_.size() > frame_idx) {
         call_stack_.pop_back();
     }
     
     return result;
 }
 
-RuntimeValue Interpreter::exec_instruction(const Instruction& instr) {
+RuntimeValue Interpreter::exec_instruction(const Instruction& instr, size_t index) {
     RuntimeValue result;
     
     switch (instr.op) {
@@ -185,6 +425,53 @@ RuntimeValue Interpreter::exec_instruction(const Instruction& instr) {
             break;
         }
             
+        case OpCode::DIV_NZ: {
+            // Range analysis proved the divisor non-zero
+            auto lhs = get_value(instr.operands[0]);
+            auto rhs = get_value(instr.operands[1]);
+            if (lhs.is_float() || rhs.is_float()) {
+                result = RuntimeValue(lhs.to_float() / rhs.to_float());
+            } else {
+                result = RuntimeValue(lhs.to_int() / rhs.to_int());
+            }
+            break;
+        }
+            
+        case OpCode::MUL_HI: {
+            int64_t lhs = get_value(instr.operands[0]).to_int();
+            int64_t rhs = get_value(instr.operands[1]).to_int();
+            result = RuntimeValue(mul_high(lhs, rhs));
+            break;
+        }
+            
+        case OpCode::SHL: {
+            uint64_t lhs = static_cast<uint64_t>(get_value(instr.operands[0]).to_int());
+            int64_t rhs = get_value(instr.operands[1]).to_int();
+            result = RuntimeValue(static_cast<int64_t>(lhs << (rhs & 63)));
+            break;
+        }
+            
+        case OpCode::SHR: {
+            int64_t lhs = get_value(instr.operands[0]).to_int();
+            int64_t rhs = get_value(instr.operands[1]).to_int();
+            result = RuntimeValue(lhs >> (rhs & 63));
+            break;
+        }
+            
+        case OpCode::AND: {
+            int64_t lhs = get_value(instr.operands[0]).to_int();
+            int64_t rhs = get_value(instr.operands[1]).to_int();
+            result = RuntimeValue(lhs & rhs);
+            break;
+        }
+            
+        case OpCode::OR: {
+            int64_t lhs = get_value(instr.operands[0]).to_int();
+            int64_t rhs = get_value(instr.operands[1]).to_int();
+            result = RuntimeValue(lhs | rhs);
+            break;
+        }
+            
         case OpCode::NEG: {
             auto operand = get_value(instr.operands[0]);
             if (operand.is_float()) {
@@ -238,10 +525,30 @@ RuntimeValue Interpreter::exec_instruction(const Instruction& instr) {
         }
             
         case OpCode::CALL: {
-            // Gather arguments
+            const CallFrame& caller = call_stack_.back();
+            if (caller.profile) {
+                uint32_t block_id = caller.fn->blocks[caller.block_idx].id;
+                ++caller.profile->sites[{block_id, static_cast<uint32_t>(caller.instr_idx)}];
+            }
+            
+            // Gather arguments; tensors last used here are handed over
+            // rather than shared, so the callee may update them in place
             std::vector<RuntimeValue> args;
-            for (const auto& op : instr.operands) {
-                args.push_back(get_value(op));
+            ir::FunctionMemoryPlan::Values dying{nullptr, nullptr};
+            if (caller.plan) dying = caller.plan->released_after(caller.block_idx, caller.instr_idx);
+            for (size_t k = 0; k < instr.operands.size(); ++k) {
+                const Value& op = instr.operands[k];
+                bool last = std::find(dying.begin(), dying.end(), op.id) != dying.end();
+                for (size_t j = k + 1; last && j < instr.operands.size(); ++j) {
+                    last = instr.operands[j].id != op.id;
+                }
+                auto& locals = call_stack_.back().locals;
+                auto it = last ? locals.find(op.id) : locals.end();
+                if (it != locals.end()) {
+                    args.push_back(std::move(it->second));
+                } else {
+                    args.push_back(get_value(op));
+                }
             }
             
             // Check externals first
@@ -251,36 +558,156 @@ RuntimeValue Interpreter::exec_instruction(const Instruction& instr) {
             } else {
                 // Find function in module
                 Function* callee = module_->get_function(instr.callee);
-                if (callee) {
-                    result = call_function(*callee, args);
+                if (callee && callee->has_attribute("memo")) {
+                    result = call_memoized(*callee, std::move(args));
+                } else if (callee) {
+                    result = call_function(*callee, std::move(args));
                 }
             }
             break;
         }
             
         case OpCode::ALLOCA:
-            // For now, just create a placeholder
-            result = RuntimeValue(static_cast<int64_t>(0));
+            // Slots are addressed by the ALLOCA's own SSA id
+            call_stack_.back().slots[instr.result.id] = RuntimeValue(static_cast<int64_t>(0));
+            result = RuntimeValue(static_cast<int64_t>(instr.result.id));
             break;
             
-        case OpCode::LOAD:
-            // Simplified: return the operand value
-            result = get_value(instr.operands[0]);
+        case OpCode::LOAD: {
+            auto& slots = call_stack_.back().slots;
+            auto it = slots.find(instr.operands[0].id);
+            if (it != slots.end()) result = it->second;
             break;
+        }
             
         case OpCode::STORE:
-            // For now, no-op
+            call_stack_.back().slots[instr.operands[0].id] = get_value(instr.operands[1]);
+            break;
+            
+        // Tensor ops run on the in-tree CPU runtime
+        case OpCode::TENSOR_ALLOC: {
+            tensor::Tensor::Shape shape;
+            for (size_t i = 1; i < instr.operands.size(); ++i) {
+                shape.push_back(get_value(instr.operands[i]).to_int());
+            }
+            if (instr.imm_int < 0 || instr.imm_int > static_cast<int64_t>(types::DType::I64)) {
+                throw tensor::TensorError("tensor.alloc: unknown dtype " + std::to_string(instr.imm_int));
+            }
+            double fill = instr.operands.empty() ? 0.0 : get_value(instr.operands[0]).to_float();
+            result = RuntimeValue(tensor::Tensor::full(
+                shape, fill, static_cast<types::DType>(instr.imm_int)));
             break;
+        }
             
-        // Tensor ops - placeholders for core-runtime integration
-        case OpCode::TENSOR_ALLOC:
         case OpCode::TENSOR_ADD:
+            result = RuntimeValue(tensor::add(get_tensor(instr.operands[0]),
+                                              get_tensor(instr.operands[1]),
+                                              in_place_target(instr, index)));
+            break;
+            
         case OpCode::TENSOR_SUB:
+            result = RuntimeValue(tensor::sub(get_tensor(instr.operands[0]),
+                                              get_tensor(instr.operands[1]),
+                                              in_place_target(instr, index)));
+            break;
+            
         case OpCode::TENSOR_MUL:
+            result = RuntimeValue(tensor::mul(get_tensor(instr.operands[0]),
+                                              get_tensor(instr.operands[1]),
+                                              in_place_target(instr, index)));
+            break;
+            
         case OpCode::TENSOR_MATMUL:
+            result = RuntimeValue(tensor::matmul(get_tensor(instr.operands[0]),
+                                                 get_tensor(instr.operands[1])));
+            break;
+            
         case OpCode::TENSOR_RELU:
-            // TODO: Link to core-runtime
-            result = RuntimeValue(static_cast<void*>(nullptr));
+            result = RuntimeValue(tensor::relu(get_tensor(instr.operands[0]),
+                                               in_place_target(instr, index)));
+            break;
+            
+        case OpCode::TENSOR_EXP:
+            result = RuntimeValue(tensor::exp(get_tensor(instr.operands[0]),
+                                              in_place_target(instr, index)));
+            break;
+            
+        case OpCode::TENSOR_TANH:
+            result = RuntimeValue(tensor::tanh(get_tensor(instr.operands[0]),
+                                               in_place_target(instr, index)));
+            break;
+            
+        case OpCode::TENSOR_SIGMOID:
+            result = RuntimeValue(tensor::sigmoid(get_tensor(instr.operands[0]),
+                                                  in_place_target(instr, index)));
+            break;
+            
+        case OpCode::TENSOR_GELU:
+            result = RuntimeValue(tensor::gelu(get_tensor(instr.operands[0]),
+                                               in_place_target(instr, index)));
+            break;
+            
+        case OpCode::TENSOR_FUSED: {
+            const tensor::FusedKernel& kernel = fused_kernel(instr.imm_str);
+            std::vector<const tensor::Tensor*> inputs;
+            for (const Value& v : instr.operands) inputs.push_back(&get_tensor(v));
+            result = RuntimeValue(kernel.run(inputs, nullptr, in_place_target(instr, index)));
+            break;
+        }
+            
+        case OpCode::TENSOR_RESHAPE:
+        case OpCode::TENSOR_BROADCAST: {
+            tensor::Tensor::Shape shape;
+            for (size_t i = 1; i < instr.operands.size(); ++i) {
+                shape.push_back(get_value(instr.operands[i]).to_int());
+            }
+            const tensor::Tensor& t = get_tensor(instr.operands[0]);
+            result = RuntimeValue(instr.op == OpCode::TENSOR_RESHAPE ? t.reshape(shape)
+                                                                     : t.broadcast_to(shape));
+            break;
+        }
+            
+        case OpCode::TENSOR_TRANSPOSE:
+            result = RuntimeValue(get_tensor(instr.operands[0]).transpose(
+                get_value(instr.operands[1]).to_int(), get_value(instr.operands[2]).to_int()));
+            break;
+            
+        case OpCode::TENSOR_SLICE:
+            result = RuntimeValue(get_tensor(instr.operands[0]).slice(
+                get_value(instr.operands[1]).to_int(), get_value(instr.operands[2]).to_int(),
+                get_value(instr.operands[3]).to_int(), get_value(instr.operands[4]).to_int()));
+            break;
+            
+        case OpCode::TENSOR_SUM:
+        case OpCode::TENSOR_MEAN:
+        case OpCode::TENSOR_MAX:
+        case OpCode::TENSOR_ARGMAX: {
+            // Without an axis, over every element
+            const tensor::Tensor& t = get_tensor(instr.operands[0]);
+            const bool whole = instr.operands.size() == 1;
+            const int64_t axis = whole ? 0 : get_value(instr.operands[1]).to_int();
+            if (instr.op == OpCode::TENSOR_SUM) {
+                result = RuntimeValue(whole ? tensor::sum(t) : tensor::sum(t, axis));
+            } else if (instr.op == OpCode::TENSOR_MEAN) {
+                result = RuntimeValue(whole ? tensor::mean(t) : tensor::mean(t, axis));
+            } else if (instr.op == OpCode::TENSOR_MAX) {
+                result = RuntimeValue(whole ? tensor::max(t) : tensor::max(t, axis));
+            } else {
+                result = RuntimeValue(whole ? tensor::argmax(t) : tensor::argmax(t, axis));
+            }
+            break;
+        }
+            
+        case OpCode::TENSOR_SOFTMAX:
+            result = RuntimeValue(tensor::softmax(get_tensor(instr.operands[0]),
+                                                  get_value(instr.operands[1]).to_int()));
+            break;
+            
+        case OpCode::TENSOR_LAYERNORM:
+            result = RuntimeValue(instr.operands.size() == 3
+                ? tensor::layernorm(get_tensor(instr.operands[0]), get_tensor(instr.operands[1]),
+                                    get_tensor(instr.operands[2]), instr.imm_float)
+                : tensor::layernorm(get_tensor(instr.operands[0]), {}, {}, instr.imm_float));
             break;
             
         default:
@@ -0,0 +1,155 @@
+/**
+ * @file memo.cpp
+ * @brief Zero Compiler — Call Memoization Cache Implementation
+ */
+
+#include "backend/memo.hpp"
+#include "backend/interpreter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace zero {
+namespace backend {
+
+namespace {
+
+uint64_t mix(uint64_t x) {
+    // splitmix64 finalizer
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t float_bits(double d) {
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof bits);
+    return bits;
+}
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // anonymous namespace
+
+MemoCache::MemoCache(size_t arity, const MemoOptions& opts)
+    : arity_(arity), eviction_(opts.eviction) {
+    size_t n = opts.capacity ? round_up_pow2(opts.capacity) : 0;
+    slots_.resize(n);
+    keys_.resize(n * arity_);
+    scratch_.resize(arity_);
+}
+
+bool MemoCache::encode(const std::vector<RuntimeValue>& args, uint64_t& hash,
+                       uint64_t& float_args) {
+    if (slots_.empty() || args.size() != arity_ || arity_ > 64) return false;
+    hash = mix(arity_);
+    float_args = 0;
+    for (size_t i = 0; i < arity_; ++i) {
+        const RuntimeValue& a = args[i];
+        if (a.is_int()) {
+            scratch_[i] = static_cast<uint64_t>(a.as_int());
+        } else if (a.is_float()) {
+            // Keyed on the bits: 0.0 and -0.0 are different arguments
+            scratch_[i] = float_bits(a.as_float());
+            float_args |= uint64_t(1) << i;
+        } else {
+            return false;
+        }
+        hash = mix(hash ^ scratch_[i]);
+    }
+    hash = mix(hash ^ float_args);
+    return true;
+}
+
+bool MemoCache::matches(size_t slot, uint64_t hash, uint64_t float_args) const {
+    const Slot& s = slots_[slot];
+    if (!s.used || s.hash != hash || s.float_args != float_args) return false;
+    const uint64_t* key = keys_.data() + slot * arity_;
+    for (size_t i = 0; i < arity_; ++i) {
+        if (key[i] != scratch_[i]) return false;
+    }
+    return true;
+}
+
+bool MemoCache::lookup(const std::vector<RuntimeValue>& args, RuntimeValue& out) {
+    uint64_t hash, float_args;
+    if (!encode(args, hash, float_args)) return false;
+
+    const size_t mask = slots_.size() - 1;
+    const size_t window = std::min(PROBE_WINDOW, slots_.size());
+    for (size_t k = 0; k < window; ++k) {
+        size_t slot = (hash + k) & mask;
+        if (!slots_[slot].used) break;
+        if (matches(slot, hash, float_args)) {
+            const Slot& s = slots_[slot];
+            if (s.result_is_float) {
+                double d;
+                std::memcpy(&d, &s.result, sizeof d);
+                out = RuntimeValue(d);
+            } else {
+                out = RuntimeValue(static_cast<int64_t>(s.result));
+            }
+            ++hits_;
+            return true;
+        }
+    }
+    ++misses_;
+    return false;
+}
+
+void MemoCache::store(size_t slot, uint64_t hash, uint64_t float_args,
+                      const RuntimeValue& result) {
+    Slot& s = slots_[slot];
+    if (!s.used) ++size_;
+    s.used = true;
+    s.hash = hash;
+    s.float_args = float_args;
+    s.result_is_float = result.is_float();
+    s.result = s.result_is_float ? float_bits(result.as_float())
+                                 : static_cast<uint64_t>(result.as_int());
+    std::memcpy(keys_.data() + slot * arity_, scratch_.data(), arity_ * sizeof(uint64_t));
+}
+
+void MemoCache::insert(const std::vector<RuntimeValue>& args, const RuntimeValue& result) {
+    if (!result.is_int() && !result.is_float()) return;
+    uint64_t hash, float_args;
+    if (!encode(args, hash, float_args)) return;
+
+    const size_t mask = slots_.size() - 1;
+    const size_t window = std::min(PROBE_WINDOW, slots_.size());
+    for (size_t k = 0; k < window; ++k) {
+        size_t slot = (hash + k) & mask;
+        if (!slots_[slot].used || matches(slot, hash, float_args)) {
+            store(slot, hash, float_args, result);
+            return;
+        }
+    }
+
+    // Every slot in the key's window is taken
+    switch (eviction_) {
+        case MemoEviction::REPLACE:
+            ++evictions_;
+            store(hash & mask, hash, float_args, result);
+            break;
+        case MemoEviction::KEEP:
+            break;
+        case MemoEviction::CLEAR:
+            evictions_ += size_;
+            clear();
+            store(hash & mask, hash, float_args, result);
+            break;
+    }
+}
+
+void MemoCache::clear() {
+    for (Slot& s : slots_) s.used = false;
+    size_ = 0;
+}
+
+} // namespace backend
+} // namespace zero
@@ -5,6 +5,15 @@
  * Usage:
  *   zeroc <file.zero>           Compile and run
  *   zeroc --dump-ir <file.zero> Dump IR
+ *   zeroc -O <file.zero>        Optimize, then run
+ *   zeroc --unroll=4 <file.zero> Optimize with loop unrolling, then run
+ *   zeroc --partial-eval <file.zero> Optimize, evaluating constant calls at compile time
+ *   zeroc --strength-reduce <file.zero> Optimize, turning loop multiplies into additions
+ *   zeroc --profile-generate=<out> <file.zero> Run unoptimized, recording counts
+ *   zeroc --profile-use=<in> <file.zero> Optimize guided by recorded counts
+ *   zeroc --memo-capacity=<n> <file.zero> Cache size for @memo functions
+ *   zeroc --mem-stats <file.zero> Report peak tensor memory after the run
+ *   zeroc --parallel-graph <file.zero> Run independent tensor ops concurrently
  *   zeroc --help                Show help
  */
 
@@ -14,8 +23,13 @@
 #include "sema/sema.hpp"
 #include "ir/ir.hpp"
 #include "ir/lowering.hpp"
+#include "ir/profile.hpp"
+#include "opt/buffer_plan.hpp"
+#include "opt/pipeline.hpp"
 #include "backend/interpreter.hpp"
+#include "tensor/buffer_pool.hpp"
 
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -28,6 +42,17 @@ void print_help() {
     std::cout << "Usage:\n";
     std::cout << "  zeroc <file.zero>           Compile and execute\n";
     std::cout << "  zeroc --dump-ir <file.zero> Dump IR\n";
+    std::cout << "  zeroc -O <file.zero>        Optimize IR before running/dumping\n";
+    std::cout << "  zeroc --unroll=<n> <file.zero> Optimize and unroll counted loops n times\n";
+    std::cout << "  zeroc --partial-eval <file.zero> Optimize and run constant pure calls at compile time\n";
+    std::cout << "  zeroc --strength-reduce <file.zero> Optimize and replace multiplies by loop counters with additions\n";
+    std::cout << "  zeroc --profile-generate=<out> <file.zero> Run unoptimized and write a profile\n";
+    std::cout << "  zeroc --profile-use=<in> <file.zero> Optimize using a profile from a training run\n";
+    std::cout << "  zeroc --memo-capacity=<n> <file.zero> Entries cached per @memo function (0 = off)\n";
+    std::cout << "  zeroc --memo-eviction=<replace|keep|clear> <file.zero> What a full @memo cache does\n";
+    std::cout << "  zeroc --mem-stats <file.zero> Report peak tensor memory and buffer reuse after running\n";
+    std::cout << "  zeroc --parallel-graph <file.zero> Run independent tensor ops concurrently\n";
+    std::cout << "                              (ZERO_TENSOR_THREADS sets the thread count)\n";
     std::cout << "  zeroc --dump-ast <file.zero> Dump AST (placeholder)\n";
     std::cout << "  zeroc --help                Show this help\n";
     std::cout << "  zeroc --version             Show version\n";
@@ -41,12 +66,42 @@ void print_error(const std::string& msg) {
     std::cerr << "\033[31merror:\033[0m " << msg << "\n";
 }
 
+std::string format_bytes(size_t bytes) {
+    const char* units[] = {"B", "KiB", "MiB", "GiB"};
+    double v = static_cast<double>(bytes);
+    size_t u = 0;
+    while (v >= 1024 && u + 1 < sizeof(units) / sizeof(units[0])) {
+        v /= 1024;
+        ++u;
+    }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), u ? "%.2f %s" : "%.0f %s", v, units[u]);
+    return buf;
+}
+
+void print_mem_stats(const zero::opt::BufferPlanner& planner,
+                     const zero::backend::Interpreter& interp) {
+    zero::tensor::MemoryStats stats = zero::tensor::BufferPool::global().stats();
+    std::cout.flush();
+    std::cerr << "Tensor memory:\n"
+              << "  peak            " << format_bytes(stats.peak_bytes) << "\n"
+              << "  buffers         " << stats.allocations << ", " << stats.reused
+              << " reused from the pool\n"
+              << "  in-place ops    " << interp.in_place_ops() << "\n"
+              << "  in-place sites  " << planner.in_place_sites() << " of "
+              << planner.tensor_values() << " tensor values\n";
+}
+
 bool file_exists(const std::string& path) {
     std::ifstream f(path);
     return f.good();
 }
 
-int compile_and_run(const std::string& filename, bool dump_ir) {
+int compile_and_run(const std::string& filename, bool dump_ir, bool optimize,
+                    const zero::opt::PipelineOptions& opt_opts,
+                    const std::string& profile_out, const std::string& profile_in,
+                    const zero::backend::MemoOptions& memo_opts, bool mem_stats,
+                    bool parallel_graph) {
     using namespace zero;
     
     // ─────────────────────────────────────────────────────────────────────
@@ -90,6 +145,26 @@ int compile_and_run(const std::string& filename, bool dump_ir) {
     ir::Lowering lowering;
     ir::Module mod = lowering.lower(prog);
     
+    // Counts are keyed to the IR as lowered, so attach them before any
+    // pass reshapes it
+    if (!profile_in.empty()) {
+        std::ifstream in(profile_in);
+        if (!in) {
+            print_error("Cannot read profile: " + profile_in);
+            return 1;
+        }
+        try {
+            ir::Profile::read(in).apply(mod);
+        } catch (const std::exception& e) {
+            print_error(e.what());
+            return 1;
+        }
+    }
+    
+    if (optimize) {
+        opt::optimize(mod, opt_opts);
+    }
+    
     // ─────────────────────────────────────────────────────────────────────
     // 5. Dump IR if requested
     // ─────────────────────────────────────────────────────────────────────
@@ -112,6 +187,8 @@ int compile_and_run(const std::string& filename, bool dump_ir) {
                 std::cout << arg.as_float();
             } else if (arg.is_str()) {
                 std::cout << arg.as_str();
+            } else if (arg.is_tensor()) {
+                std::cout << arg.as_tensor().to_string();
             }
         }
         std::cout << "\n";
@@ -147,11 +224,32 @@ int compile_and_run(const std::string& filename, bool dump_ir) {
         return backend::RuntimeValue{};
     });
     
+    ir::Profile profile;
+    if (!profile_out.empty()) interp.set_profile(&profile);
+    interp.set_memo_options(memo_opts);
+    
+    // Tensors are freed after their last use, and overwritten there by
+    // elementwise ops when nothing else holds them
+    opt::BufferPlanner planner;
+    ir::MemoryPlan memory_plan = planner.plan(mod);
+    interp.set_memory_plan(&memory_plan);
+    interp.set_graph_mode(parallel_graph);
+    
     try {
         interp.execute(mod, "main");
+        if (mem_stats) print_mem_stats(planner, interp);
+        if (!profile_out.empty()) {
+            std::ofstream out(profile_out);
+            profile.write(out);
+            if (!out) {
+                print_error("Cannot write profile: " + profile_out);
+                return 1;
+            }
+        }
         return interp.exit_code();
     } catch (const std::exception& e) {
         print_error(e.what());
+        if (mem_stats) print_mem_stats(planner, interp);
         return 1;
     }
 }
@@ -169,6 +267,13 @@ int main(int argc, char* argv[]) {
     // Parse arguments
     std::string filename;
     bool dump_ir = false;
+    bool optimize = false;
+    zero::opt::PipelineOptions opt_opts;
+    std::string profile_out;
+    std::string profile_in;
+    zero::backend::MemoOptions memo_opts;
+    bool mem_stats = false;
+    bool parallel_graph = false;
     
     for (size_t i = 0; i < args.size(); ++i) {
         const std::string& arg = args[i];
@@ -188,6 +293,77 @@ int main(int argc, char* argv[]) {
             continue;
         }
         
+        if (arg == "-O" || arg == "--optimize") {
+            optimize = true;
+            continue;
+        }
+        
+        if (arg.rfind("--unroll=", 0) == 0) {
+            try {
+                opt_opts.unroll_factor = static_cast<unsigned>(std::stoul(arg.substr(9)));
+            } catch (const std::exception&) {
+                print_error("Invalid unroll factor: " + arg);
+                return 1;
+            }
+            optimize = true;
+            continue;
+        }
+        
+        if (arg == "--partial-eval") {
+            opt_opts.partial_eval = true;
+            optimize = true;
+            continue;
+        }
+        
+        if (arg == "--strength-reduce") {
+            opt_opts.strength_reduce = true;
+            optimize = true;
+            continue;
+        }
+        
+        if (arg.rfind("--profile-generate=", 0) == 0) {
+            profile_out = arg.substr(19);
+            continue;
+        }
+        
+        if (arg.rfind("--profile-use=", 0) == 0) {
+            profile_in = arg.substr(14);
+            optimize = true;
+            continue;
+        }
+        
+        if (arg.rfind("--memo-capacity=", 0) == 0) {
+            try {
+                memo_opts.capacity = std::stoul(arg.substr(16));
+            } catch (const std::exception&) {
+                print_error("Invalid memo capacity: " + arg);
+                return 1;
+            }
+            continue;
+        }
+        
+        if (arg.rfind("--memo-eviction=", 0) == 0) {
+            std::string policy = arg.substr(16);
+            if (policy == "replace") memo_opts.eviction = zero::backend::MemoEviction::REPLACE;
+            else if (policy == "keep") memo_opts.eviction = zero::backend::MemoEviction::KEEP;
+            else if (policy == "clear") memo_opts.eviction = zero::backend::MemoEviction::CLEAR;
+            else {
+                print_error("Invalid memo eviction policy: " + policy);
+                return 1;
+            }
+            continue;
+        }
+        
+        if (arg == "--mem-stats") {
+            mem_stats = true;
+            continue;
+        }
+        
+        if (arg == "--parallel-graph") {
+            parallel_graph = true;
+            continue;
+        }
+        
         if (arg == "--dump-ast") {
             // TODO: Implement AST dump
             std::cout << "AST dump not yet implemented\n";
@@ -212,5 +388,12 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    return compile_and_run(filename, dump_ir);
+    if (!profile_out.empty() && optimize) {
+        // The profile must describe the IR as lowered
+        print_error("--profile-generate runs unoptimized; drop -O and other optimization flags");
+        return 1;
+    }
+    
+    return compile_and_run(filename, dump_ir, optimize, opt_opts, profile_out, profile_in,
+                           memo_opts, mem_stats, parallel_graph);
 }
@@ -0,0 +1,32 @@
+/**
+ * @file arena.cpp
+ * @brief Zero Compiler — Bump Arena Implementation
+ */
+
+#include "ir/arena.hpp"
+
+#include <algorithm>
+
+namespace zero {
+namespace ir {
+
+void* Arena::allocate_slow(size_t size, size_t align) {
+    // Chunks double up to MAX_CHUNK; anything bigger gets a chunk of its own
+    size_t chunk = std::max(next_chunk_, size + align);
+    next_chunk_ = std::min(next_chunk_ * 2, MAX_CHUNK);
+
+    chunks_.emplace_back(new char[chunk]);
+    cur_ = chunks_.back().get();
+    end_ = cur_ + chunk;
+    return allocate(size, align);
+}
+
+void Arena::reset() {
+    chunks_.clear();
+    cur_ = end_ = nullptr;
+    next_chunk_ = FIRST_CHUNK;
+    bytes_ = 0;
+}
+
+} // namespace ir
+} // namespace zero
@@ -1,6 +1,6 @@
 /**
  * @file ir.cpp
- * @brief Zero Compiler — IR Printer Implementation
+ * @brief Zero Compiler — IR Utilities and Printer Implementation
  */
 
 #include "ir/ir.hpp"
@@ -9,6 +9,73 @@
 namespace zero {
 namespace ir {
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Utilities
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t replace_all_uses(Function& fn, const Value& from, const Value& to) {
+    size_t count = 0;
+    for (auto& bb : fn.blocks) {
+        for (auto& instr : bb.instrs) {
+            for (auto& op : instr.operands) {
+                if (op.id == from.id) {
+                    op = to;
+                    ++count;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+size_t replace_uses(Function& fn, const std::unordered_map<uint32_t, Value>& subst) {
+    if (subst.empty()) return 0;
+    size_t count = 0;
+    for (auto& bb : fn.blocks) {
+        for (auto& instr : bb.instrs) {
+            for (auto& op : instr.operands) {
+                auto it = subst.find(op.id);
+                if (it == subst.end()) continue;
+                // Bounded, in case the map holds a cycle
+                Value v = it->second;
+                for (size_t hops = 0; hops < subst.size(); ++hops) {
+                    auto next = subst.find(v.id);
+                    if (next == subst.end()) break;
+                    v = next->second;
+                }
+                op = v;
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+int64_t mul_high(int64_t a, int64_t b) {
+    // Unsigned 64x64 -> 128 from 32-bit partial products
+    uint64_t ua = static_cast<uint64_t>(a);
+    uint64_t ub = static_cast<uint64_t>(b);
+    uint64_t a_lo = ua & 0xffffffffu, a_hi = ua >> 32;
+    uint64_t b_lo = ub & 0xffffffffu, b_hi = ub >> 32;
+
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+    uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+
+    // Signed correction: subtract the other operand for each negative one
+    if (a < 0) high -= ub;
+    if (b < 0) high -= ua;
+    return static_cast<int64_t>(high);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Printer
+// ─────────────────────────────────────────────────────────────────────────────
+
 std::string print_value(const Value& v) {
     if (!v.valid()) return "void";
     return "%" + std::to_string(v.id);
@@ -42,6 +109,18 @@ std::string print_instruction(const Instruction& instr) {
         case OpCode::BR:
             ss << " bb" << instr.target_block;
             break;
+        case OpCode::TENSOR_ALLOC:
+            ss << " " << types::dtype_name(static_cast<types::DType>(instr.imm_int));
+            for (size_t i = 0; i < instr.operands.size(); ++i) {
+                ss << (i ? ", " : " ") << print_value(instr.operands[i]);
+            }
+            break;
+        case OpCode::TENSOR_FUSED:
+            ss << " \"" << instr.imm_str << "\"";
+            for (size_t i = 0; i < instr.operands.size(); ++i) {
+                ss << (i ? ", " : " ") << print_value(instr.operands[i]);
+            }
+            break;
         case OpCode::COND_BR:
             ss << " " << print_value(instr.operands[0])
                << ", bb" << instr.target_block
@@ -55,6 +134,11 @@ std::string print_instruction(const Instruction& instr) {
             break;
     }
     
+    // Tensor results show what is known of their dtype and shape
+    if (instr.result.type.tensor_type()) {
+        ss << " : " << instr.result.type.to_string();
+    }
+    
     return ss.str();
 }
 
@@ -69,12 +153,15 @@ std::string print_block(const BasicBlock& bb) {
 
 std::string print_function(const Function& fn) {
     std::ostringstream ss;
+    for (const auto& attr : fn.attributes) {
+        ss << "@" << attr << " ";
+    }
     ss << "fn @" << fn.name << "(";
     for (size_t i = 0; i < fn.param_types.size(); ++i) {
         if (i > 0) ss << ", ";
-        ss << fn.param_types[i].name();
+        ss << fn.param_types[i].to_string();
     }
-    ss << ") -> " << fn.return_type.name() << " {\n";
+    ss << ") -> " << fn.return_type.to_string() << " {\n";
     
     for (const auto& bb : fn.blocks) {
         ss << print_block(bb);
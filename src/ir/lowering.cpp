@@ -10,19 +10,76 @@ namespace zero {
 namespace ir {
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Helper to convert ast::TypeKind to types::Type
+// Helper to convert ast::Type to types::Type
 // ─────────────────────────────────────────────────────────────────────────────
 
-static types::Type ast_to_type(ast::TypeKind kind) {
-    switch (kind) {
+static types::Type ast_to_type(const ast::Type& t) {
+    switch (t.kind) {
         case ast::TypeKind::INT: return types::Type::make_int();
         case ast::TypeKind::FLOAT: return types::Type::make_float();
         case ast::TypeKind::VOID: return types::Type::make_void();
-        case ast::TypeKind::TENSOR: return types::Type::make_tensor();
+        case ast::TypeKind::TENSOR: {
+            auto dtype = types::parse_dtype(t.dtype);
+            if (!dtype) return types::Type::make_tensor();
+            return types::Type::make_tensor(types::TensorType{*dtype, t.has_dims, t.dims});
+        }
         default: return types::Type::make_unknown();
     }
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Helper to find variables that are reassigned in a statement list
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Name -> declaring LetStmt or Param, one map per open block
+using DeclScopes = std::vector<std::unordered_map<std::string, const void*>>;
+
+/**
+ * Add to `out` the declaration each assignment in `stmts` refers to,
+ * resolving names the way lowering will. An assignment to a name that
+ * was never declared is recorded as nullptr.
+ */
+static void collect_assigned(const std::vector<std::unique_ptr<ast::Stmt>>& stmts,
+                             DeclScopes& scopes, std::unordered_set<const void*>& out) {
+    auto nested = [&](const std::vector<std::unique_ptr<ast::Stmt>>& body) {
+        scopes.emplace_back();
+        collect_assigned(body, scopes, out);
+        scopes.pop_back();
+    };
+    
+    for (const auto& stmt : stmts) {
+        if (!stmt) continue;
+        std::visit([&](const auto& s) {
+            using T = std::decay_t<decltype(s)>;
+            
+            if constexpr (std::is_same_v<T, ast::LetStmt>) {
+                scopes.back()[s.name] = &s;
+            }
+            else if constexpr (std::is_same_v<T, ast::AssignStmt>) {
+                const void* decl = nullptr;
+                for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+                    auto found = it->find(s.name);
+                    if (found != it->end()) {
+                        decl = found->second;
+                        break;
+                    }
+                }
+                out.insert(decl);
+            }
+            else if constexpr (std::is_same_v<T, ast::IfStmt>) {
+                nested(s.then_branch);
+                nested(s.else_branch);
+            }
+            else if constexpr (std::is_same_v<T, ast::WhileStmt>) {
+                nested(s.body);
+            }
+            else if constexpr (std::is_same_v<T, ast::Block>) {
+                nested(s.stmts);
+            }
+        }, stmt->data);
+    }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Lowering Implementation
 // ─────────────────────────────────────────────────────────────────────────────
@@ -30,6 +87,14 @@ static types::Type ast_to_type(ast::TypeKind kind) {
 Module Lowering::lower(ast::Program& prog) {
     Module mod;
     
+    // Collect signatures first so calls know their result type
+    return_types_.clear();
+    for (auto& fn_ast : prog.functions) {
+        return_types_[fn_ast.name] = fn_ast.return_type
+            ? ast_to_type(*fn_ast.return_type)
+            : types::Type::make_void();
+    }
+    
     // Lower each function
     for (auto& fn_ast : prog.functions) {
         lower_function(mod, fn_ast);
@@ -42,23 +107,42 @@ void Lowering::lower_function(Module& mod, ast::FnDecl& fn_ast) {
     // Get parameter types
     std::vector<types::Type> param_types;
     for (const auto& p : fn_ast.params) {
-        param_types.push_back(ast_to_type(p.type.kind));
+        param_types.push_back(ast_to_type(p.type));
     }
     
     // Get return type
     types::Type ret_type = fn_ast.return_type 
-        ? ast_to_type(fn_ast.return_type->kind)
+        ? ast_to_type(*fn_ast.return_type)
         : types::Type::make_void();
     
     // Create function
     Function& fn = mod.add_function(fn_ast.name, param_types, ret_type);
+    for (const auto& attr : fn_ast.attributes) {
+        fn.attributes.push_back(attr.name);
+    }
     IRBuilder builder(fn);
     
+    // Parameters share the body's scope
+    DeclScopes decls(1);
+    for (const auto& p : fn_ast.params) decls.back()[p.name] = &p;
+    assigned_.clear();
+    entry_allocas_ = 0;
+    collect_assigned(fn_ast.body, decls, assigned_);
+    
     // Create parameter values and add to symbol table
-    symbols_.clear();
+    scopes_.assign(1, {});
     for (size_t i = 0; i < fn_ast.params.size(); ++i) {
         Value param_val = fn.new_value(param_types[i]);
-        symbols_[fn_ast.params[i].name] = param_val;
+        fn.params.push_back(param_val);
+        
+        // Reassigned parameters get a slot seeded with the argument
+        if (assigned_.count(&fn_ast.params[i])) {
+            Value slot = new_slot(builder, param_types[i]);
+            builder.store(slot, param_val);
+            scopes_.back()[fn_ast.params[i].name] = {slot, true};
+        } else {
+            scopes_.back()[fn_ast.params[i].name] = {param_val, false};
+        }
     }
     
     // Lower body statements
@@ -73,14 +157,63 @@ void Lowering::lower_function(Module& mod, ast::FnDecl& fn_ast) {
     }
 }
 
+Value Lowering::new_slot(IRBuilder& builder, types::Type type) {
+    // Allocas are grouped at the top of the entry block so every slot
+    // dominates all of its loads and stores, including those in loops.
+    Function& fn = builder.function();
+    Instruction instr;
+    instr.op = OpCode::ALLOCA;
+    instr.result = fn.new_value(type);
+    auto& entry = fn.entry().instrs;
+    entry.insert(entry.begin() + static_cast<long>(entry_allocas_++), instr);
+    return instr.result;
+}
+
+const Lowering::Binding* Lowering::lookup(const std::string& name) const {
+    // Search from innermost to outermost scope
+    for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
+        auto found = it->find(name);
+        if (found != it->end()) return &found->second;
+    }
+    return nullptr;
+}
+
+void Lowering::lower_block(IRBuilder& builder, std::vector<std::unique_ptr<ast::Stmt>>& stmts) {
+    scopes_.emplace_back();
+    for (auto& stmt : stmts) {
+        lower_stmt(builder, *stmt);
+    }
+    scopes_.pop_back();
+}
+
 void Lowering::lower_stmt(IRBuilder& builder, ast::Stmt& stmt) {
     std::visit([this, &builder](auto& s) {
         using T = std::decay_t<decltype(s)>;
         
         if constexpr (std::is_same_v<T, ast::LetStmt>) {
-            if (s.init) {
-                Value init_val = lower_expr(builder, *s.init);
-                symbols_[s.name] = init_val;
+            // The initializer still sees any outer variable of the same name
+            Value init_val = s.init ? lower_expr(builder, *s.init) : Value{};
+            if (assigned_.count(&s)) {
+                types::Type type = init_val.valid() ? init_val.type
+                    : s.type_annot ? ast_to_type(*s.type_annot) : types::Type::make_unknown();
+                Value slot = new_slot(builder, type);
+                if (init_val.valid()) builder.store(slot, init_val);
+                scopes_.back()[s.name] = {slot, true};
+            } else {
+                scopes_.back()[s.name] = {init_val, false};
+            }
+        }
+        else if constexpr (std::is_same_v<T, ast::AssignStmt>) {
+            if (s.value) {
+                Value val = lower_expr(builder, *s.value);
+                const Binding* binding = lookup(s.name);
+                if (!binding || !binding->slot) {
+                    // Never declared: a slot for the rest of the function
+                    Value slot = new_slot(builder, val.type);
+                    scopes_.front()[s.name] = {slot, true};
+                    binding = &scopes_.front()[s.name];
+                }
+                builder.store(binding->value, val);
             }
         }
         else if constexpr (std::is_same_v<T, ast::ReturnStmt>) {
@@ -103,9 +236,7 @@ void Lowering::lower_stmt(IRBuilder& builder, ast::Stmt& stmt) {
             lower_while(builder, s);
         }
         else if constexpr (std::is_same_v<T, ast::Block>) {
-            for (auto& inner : s.stmts) {
-                lower_stmt(builder, *inner);
-            }
+            lower_block(builder, s.stmts);
         }
     }, stmt.data);
 }
@@ -115,12 +246,12 @@ Value Lowering::lower_expr(IRBuilder& builder, ast::Expr& expr) {
         using T = std::decay_t<decltype(e)>;
         
         if constexpr (std::is_same_v<T, ast::Identifier>) {
-            auto it = symbols_.find(e.name);
-            if (it != symbols_.end()) {
-                return it->second;
+            const Binding* binding = lookup(e.name);
+            if (!binding) {
+                // Undefined variable - return invalid value
+                return Value{};
             }
-            // Undefined variable - return invalid value
-            return Value{};
+            return binding->slot ? builder.load(binding->value) : binding->value;
         }
         else if constexpr (std::is_same_v<T, ast::IntLiteral>) {
             return builder.const_int(e.value);
@@ -135,6 +266,15 @@ Value Lowering::lower_expr(IRBuilder& builder, ast::Expr& expr) {
             Value lhs = e.left ? lower_expr(builder, *e.left) : Value{};
             Value rhs = e.right ? lower_expr(builder, *e.right) : Value{};
             
+            if (lhs.type.is_tensor() && rhs.type.is_tensor()) {
+                switch (e.op) {
+                    case ast::BinOp::ADD: return builder.tensor_add(lhs, rhs);
+                    case ast::BinOp::SUB: return builder.tensor_sub(lhs, rhs);
+                    case ast::BinOp::MUL: return builder.tensor_mul(lhs, rhs);
+                    default: return Value{};
+                }
+            }
+            
             switch (e.op) {
                 case ast::BinOp::ADD: return builder.add(lhs, rhs);
                 case ast::BinOp::SUB: return builder.sub(lhs, rhs);
@@ -161,8 +301,16 @@ Value Lowering::lower_expr(IRBuilder& builder, ast::Expr& expr) {
             for (auto& arg : e.args) {
                 args.push_back(lower_expr(builder, *arg));
             }
-            // For now, assume void return type
-            return builder.call(e.callee, args, types::Type::make_void());
+            // Built-ins such as print/log are not in the table and return void
+            auto it = return_types_.find(e.callee);
+            if (it == return_types_.end()) {
+                Value t = lower_tensor_builtin(builder, e, args);
+                if (t.valid()) return t;
+            }
+            types::Type ret_type = it != return_types_.end()
+                ? it->second
+                : types::Type::make_void();
+            return builder.call(e.callee, args, ret_type);
         }
         else if constexpr (std::is_same_v<T, ast::GroupExpr>) {
             return e.inner ? lower_expr(builder, *e.inner) : Value{};
@@ -173,9 +321,73 @@ Value Lowering::lower_expr(IRBuilder& builder, ast::Expr& expr) {
     }, expr.data);
 }
 
+Value Lowering::lower_tensor_builtin(IRBuilder& builder, const ast::CallExpr& call,
+                                     const std::vector<Value>& args) {
+    const std::string& name = call.callee;
+    if (name == "tensor" || name == "fill") {
+        // Literal dimensions give the result a static shape
+        const size_t first = name == "fill" ? 1 : 0;
+        if (args.size() < first) return Value{};
+        std::vector<int64_t> shape;
+        for (size_t i = first; i < args.size(); ++i) {
+            auto size = call.args[i]->int_constant();
+            shape.push_back(size && *size >= 0 ? *size : types::DYNAMIC_DIM);
+        }
+        Value fill = first ? args[0] : builder.const_float(0.0);
+        return builder.tensor_alloc(fill, std::vector<Value>(args.begin() + first, args.end()),
+                                    types::DType::F32, shape);
+    }
+    if (name == "relu" && args.size() == 1) return builder.tensor_relu(args[0]);
+    if (name == "exp" && args.size() == 1) return builder.tensor_exp(args[0]);
+    if (name == "tanh" && args.size() == 1) return builder.tensor_tanh(args[0]);
+    if (name == "sigmoid" && args.size() == 1) return builder.tensor_sigmoid(args[0]);
+    if (name == "gelu" && args.size() == 1) return builder.tensor_gelu(args[0]);
+    if (name == "matmul" && args.size() == 2) return builder.tensor_matmul(args[0], args[1]);
+    
+    // View arguments that are literals give the result a static shape
+    std::vector<std::optional<int64_t>> constants;
+    for (size_t i = 1; i < call.args.size(); ++i) constants.push_back(call.args[i]->int_constant());
+    if ((name == "reshape" || name == "broadcast") && args.size() >= 2) {
+        std::vector<int64_t> shape;
+        for (const auto& c : constants) shape.push_back(c && *c >= 0 ? *c : types::DYNAMIC_DIM);
+        std::vector<Value> dims(args.begin() + 1, args.end());
+        return name == "reshape" ? builder.tensor_reshape(args[0], dims, std::move(shape))
+                                 : builder.tensor_broadcast(args[0], dims, std::move(shape));
+    }
+    if (name == "transpose" && args.size() == 1) {
+        // The last two dimensions
+        return builder.tensor_transpose(args[0], builder.const_int(-2), builder.const_int(-1), -2, -1);
+    }
+    if (name == "transpose" && args.size() == 3) {
+        return builder.tensor_transpose(args[0], args[1], args[2], constants[0], constants[1]);
+    }
+    if (name == "slice" && (args.size() == 4 || args.size() == 5)) {
+        Value step = args.size() == 5 ? args[4] : builder.const_int(1);
+        if (args.size() == 4) constants.push_back(1);
+        return builder.tensor_slice(args[0], args[1], args[2], args[3], step, constants);
+    }
+    
+    if ((name == "sum" || name == "mean" || name == "max" || name == "argmax") &&
+        (args.size() == 1 || args.size() == 2)) {
+        const OpCode op = name == "sum" ? OpCode::TENSOR_SUM
+                        : name == "mean" ? OpCode::TENSOR_MEAN
+                        : name == "max" ? OpCode::TENSOR_MAX : OpCode::TENSOR_ARGMAX;
+        return args.size() == 1 ? builder.tensor_reduce(op, args[0])
+                                : builder.tensor_reduce(op, args[0], args[1], constants[0]);
+    }
+    if (name == "softmax" && (args.size() == 1 || args.size() == 2)) {
+        // The last dimension unless told otherwise
+        return builder.tensor_softmax(args[0], args.size() == 2 ? args[1] : builder.const_int(-1));
+    }
+    if (name == "layernorm" && args.size() == 1) return builder.tensor_layernorm(args[0]);
+    if (name == "layernorm" && args.size() == 3) return builder.tensor_layernorm(args[0], args[1], args[2]);
+    return Value{};
+}
+
 void Lowering::lower_if(IRBuilder& builder, ast::IfStmt& if_stmt) {
     Value cond = if_stmt.condition ? lower_expr(builder, *if_stmt.condition) : Value{};
     
+    // Blocks never move, so these stay valid while the branches add more
     BasicBlock& then_bb = builder.create_block("if.then");
     BasicBlock& merge_bb = builder.create_block("if.end");
     
@@ -186,16 +398,12 @@ void Lowering::lower_if(IRBuilder& builder, ast::IfStmt& if_stmt) {
         builder.cond_br(cond, then_bb, else_bb);
         
         builder.set_insert_point(else_bb);
-        for (auto& stmt : if_stmt.else_branch) {
-            lower_stmt(builder, *stmt);
-        }
+        lower_block(builder, if_stmt.else_branch);
         builder.br(merge_bb);
     }
     
     builder.set_insert_point(then_bb);
-    for (auto& stmt : if_stmt.then_branch) {
-        lower_stmt(builder, *stmt);
-    }
+    lower_block(builder, if_stmt.then_branch);
     builder.br(merge_bb);
     
     builder.set_insert_point(merge_bb);
@@ -213,9 +421,7 @@ void Lowering::lower_while(IRBuilder& builder, ast::WhileStmt& while_stmt) {
     builder.cond_br(cond, body_bb, end_bb);
     
     builder.set_insert_point(body_bb);
-    for (auto& stmt : while_stmt.body) {
-        lower_stmt(builder, *stmt);
-    }
+    lower_block(builder, while_stmt.body);
     builder.br(cond_bb);
     
     builder.set_insert_point(end_bb);
@@ -0,0 +1,158 @@
+/**
+ * @file profile.cpp
+ * @brief Zero Compiler — Execution Profiles Implementation
+ *
+ * File format, one record per line:
+ *
+ *   zero-profile 1
+ *   fn <name> <checksum>
+ *   block <block id> <times entered>
+ *   site <block id> <instruction index> <count>
+ *
+ * block and site lines belong to the preceding fn line.
+ */
+
+#include "ir/profile.hpp"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace zero {
+namespace ir {
+
+namespace {
+
+constexpr const char* kMagic = "zero-profile";
+constexpr int kVersion = 1;
+
+} // namespace
+
+uint64_t edge_count(const BasicBlock& from, uint32_t to) {
+    size_t t = from.terminator_index();
+    if (t == from.instrs.size()) return from.profile_count;
+
+    const Instruction& term = from.instrs[t];
+    if (term.op == OpCode::BR) return term.target_block == to ? term.profile_count : 0;
+    if (term.op != OpCode::COND_BR) return 0;
+
+    uint64_t taken = std::min(term.profile_count, from.profile_count);
+    uint64_t count = 0;
+    if (term.target_block == to) count += taken;
+    if (term.else_block == to) count += from.profile_count - taken;
+    return count;
+}
+
+FunctionProfile& Profile::function(const Function& fn) {
+    auto it = functions_.find(fn.name);
+    if (it == functions_.end()) {
+        it = functions_.emplace(fn.name, FunctionProfile{}).first;
+        it->second.checksum = checksum(fn);
+    }
+    return it->second;
+}
+
+uint64_t Profile::checksum(const Function& fn) {
+    // FNV-1a over block ids and opcodes
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+    for (const auto& bb : fn.blocks) {
+        mix(bb.id);
+        for (const auto& instr : bb.instrs) mix(static_cast<uint64_t>(instr.op) + 1);
+        mix(0xff);
+    }
+    return h;
+}
+
+size_t Profile::apply(Module& mod) const {
+    size_t applied = 0;
+    for (auto& fn : mod.functions) {
+        auto it = functions_.find(fn.name);
+        if (it == functions_.end() || it->second.checksum != checksum(fn)) continue;
+        const FunctionProfile& fp = it->second;
+
+        for (auto& bb : fn.blocks) {
+            auto b = fp.blocks.find(bb.id);
+            bb.profile_count = b != fp.blocks.end() ? b->second : 0;
+            for (size_t i = 0; i < bb.instrs.size(); ++i) {
+                auto s = fp.sites.find({bb.id, static_cast<uint32_t>(i)});
+                bb.instrs[i].profile_count = s != fp.sites.end() ? s->second : 0;
+            }
+        }
+        fn.has_profile = true;
+        ++applied;
+    }
+    return applied;
+}
+
+void Profile::write(std::ostream& out) const {
+    out << kMagic << " " << kVersion << "\n";
+    for (const auto& [name, fp] : functions_) {
+        out << "fn " << name << " " << fp.checksum << "\n";
+        for (const auto& [id, count] : fp.blocks) {
+            out << "block " << id << " " << count << "\n";
+        }
+        for (const auto& [site, count] : fp.sites) {
+            out << "site " << site.first << " " << site.second << " " << count << "\n";
+        }
+    }
+}
+
+Profile Profile::read(std::istream& in) {
+    Profile profile;
+    FunctionProfile* current = nullptr;
+
+    std::string line;
+    size_t line_no = 0;
+    auto fail = [&](const std::string& what) {
+        throw std::runtime_error("Profile line " + std::to_string(line_no) + ": " + what);
+    };
+
+    if (!std::getline(in, line)) fail("empty profile");
+    ++line_no;
+    {
+        std::istringstream header(line);
+        std::string magic;
+        int version = 0;
+        if (!(header >> magic >> version) || magic != kMagic) fail("not a zero profile");
+        if (version != kVersion) fail("unsupported version " + std::to_string(version));
+    }
+
+    while (std::getline(in, line)) {
+        ++line_no;
+        std::istringstream rec(line);
+        std::string kind;
+        if (!(rec >> kind)) continue;
+
+        if (kind == "fn") {
+            std::string name;
+            uint64_t sum = 0;
+            if (!(rec >> name >> sum)) fail("malformed fn record");
+            current = &profile.functions_[name];
+            current->checksum = sum;
+        } else if (kind == "block") {
+            uint32_t id = 0;
+            uint64_t count = 0;
+            if (!current) fail("block record before any fn");
+            if (!(rec >> id >> count)) fail("malformed block record");
+            current->blocks[id] = count;
+        } else if (kind == "site") {
+            uint32_t id = 0, index = 0;
+            uint64_t count = 0;
+            if (!current) fail("site record before any fn");
+            if (!(rec >> id >> index >> count)) fail("malformed site record");
+            current->sites[{id, index}] = count;
+        } else {
+            fail("unknown record '" + kind + "'");
+        }
+    }
+    return profile;
+}
+
+} // namespace ir
+} // namespace zero
@@ -0,0 +1,60 @@
+/**
+ * @file symbol.cpp
+ * @brief Zero Compiler — Interned Strings Implementation
+ */
+
+#include "ir/symbol.hpp"
+
+#include <mutex>
+#include <ostream>
+#include <unordered_set>
+
+namespace zero {
+namespace ir {
+
+namespace {
+
+// Elements of an unordered_set never move, so the pointers handed out
+// stay valid as the pool grows. Never freed: symbols may outlive any
+// module that created them.
+struct Pool {
+    std::mutex mutex;
+    std::unordered_set<std::string> strings;
+};
+
+Pool& pool() {
+    static Pool* p = new Pool();
+    return *p;
+}
+
+const std::string* intern(const std::string& s) {
+    Pool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    return &*p.strings.insert(s).first;
+}
+
+const std::string* empty_string() {
+    static const std::string* e = intern(std::string());
+    return e;
+}
+
+} // namespace
+
+Symbol::Symbol() : str_(empty_string()) {}
+
+Symbol::Symbol(const std::string& s) : str_(s.empty() ? empty_string() : intern(s)) {}
+
+Symbol::Symbol(const char* s) : Symbol(std::string(s)) {}
+
+size_t Symbol::pool_size() {
+    Pool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    return p.strings.size();
+}
+
+std::ostream& operator<<(std::ostream& os, const Symbol& s) {
+    return os << s.str();
+}
+
+} // namespace ir
+} // namespace zero
@@ -0,0 +1,137 @@
+/**
+ * @file uses.cpp
+ * @brief Zero Compiler — Use-Def Chains Implementation
+ */
+
+#include "ir/uses.hpp"
+
+#include <algorithm>
+
+namespace zero {
+namespace ir {
+
+UseDefChains::UseDefChains(Function& fn) : fn_(fn) {
+    rebuild();
+}
+
+void UseDefChains::rebuild() {
+    uses_.clear();
+    def_block_.clear();
+    def_index_.clear();
+    positions_.clear();
+    ensure(fn_.next_value_id);
+    for (size_t b = 0; b < fn_.blocks.size(); ++b) {
+        for (size_t i = 0; i < fn_.blocks[b].instrs.size(); ++i) add_instruction(b, i);
+    }
+}
+
+void UseDefChains::ensure(uint32_t id) {
+    if (id < uses_.size()) return;
+    size_t n = std::max<size_t>(id + 1, uses_.size() * 2);
+    uses_.resize(n);
+    def_block_.resize(n, NONE);
+    def_index_.resize(n, NONE);
+}
+
+size_t UseDefChains::use_count(const Value& v) const {
+    return v.id < uses_.size() ? uses_[v.id].size() : 0;
+}
+
+const std::vector<Use>& UseDefChains::uses(const Value& v) const {
+    static const std::vector<Use> none;
+    return v.id < uses_.size() ? uses_[v.id] : none;
+}
+
+Instruction* UseDefChains::def(const Value& v) {
+    size_t b = 0, i = 0;
+    return def_site(v, b, i) ? &fn_.blocks[b].instrs[i] : nullptr;
+}
+
+bool UseDefChains::def_site(const Value& v, size_t& block, size_t& index) const {
+    if (!v.valid() || v.id >= def_block_.size() || def_block_[v.id] == NONE) return false;
+    block = def_block_[v.id];
+    index = def_index_[v.id];
+    return true;
+}
+
+size_t UseDefChains::replace_all_uses_with(const Value& from, const Value& to) {
+    if (from.id == to.id || from.id >= uses_.size()) return 0;
+    ensure(to.id);
+
+    std::vector<Use> moved = std::move(uses_[from.id]);
+    uses_[from.id].clear();
+    for (const Use& u : moved) {
+        at(u).operands[u.operand] = to;
+        push_use(to.id, u);
+    }
+    return moved.size();
+}
+
+void UseDefChains::push_use(uint32_t id, const Use& u) {
+    position(u) = static_cast<uint32_t>(uses_[id].size());
+    uses_[id].push_back(u);
+}
+
+void UseDefChains::drop_use(const Value& v, const Use& u) {
+    if (v.id >= uses_.size()) return;
+    auto& list = uses_[v.id];
+    const uint32_t k = position(u);
+    if (k >= list.size()) return;
+    list[k] = list.back();
+    position(list[k]) = k;
+    list.pop_back();
+    position(u) = NONE;
+}
+
+void UseDefChains::erase_instruction(size_t block, size_t index) {
+    Instruction& instr = fn_.blocks[block].instrs[index];
+    for (uint32_t k = 0; k < instr.operands.size(); ++k) {
+        drop_use(instr.operands[k], {static_cast<uint32_t>(block), static_cast<uint32_t>(index), k});
+    }
+    if (instr.result.valid() && instr.result.id < def_block_.size()) {
+        def_block_[instr.result.id] = NONE;
+    }
+    instr = Instruction();
+}
+
+void UseDefChains::add_instruction(size_t block, size_t index) {
+    const Instruction& instr = fn_.blocks[block].instrs[index];
+    const uint32_t b = static_cast<uint32_t>(block);
+    const uint32_t i = static_cast<uint32_t>(index);
+    if (positions_.size() < fn_.blocks.size()) positions_.resize(fn_.blocks.size());
+    auto& slots = positions_[b];
+    if (slots.size() < fn_.blocks[b].instrs.size()) slots.resize(fn_.blocks[b].instrs.size());
+    slots[i].assign(instr.operands.size(), NONE);
+    for (uint32_t k = 0; k < instr.operands.size(); ++k) {
+        const Value& v = instr.operands[k];
+        if (!v.valid()) continue;
+        ensure(v.id);
+        push_use(v.id, {b, i, k});
+    }
+    if (instr.result.valid()) {
+        ensure(instr.result.id);
+        def_block_[instr.result.id] = b;
+        def_index_[instr.result.id] = i;
+    }
+}
+
+size_t UseDefChains::compact() {
+    size_t removed = 0;
+    for (auto& bb : fn_.blocks) {
+        size_t out = 0;
+        for (size_t i = 0; i < bb.instrs.size(); ++i) {
+            if (bb.instrs[i].op == OpCode::NOP) {
+                ++removed;
+                continue;
+            }
+            if (out != i) bb.instrs[out] = std::move(bb.instrs[i]);
+            ++out;
+        }
+        bb.instrs.resize(out);
+    }
+    if (removed) rebuild();
+    return removed;
+}
+
+} // namespace ir
+} // namespace zero
@@ -168,6 +168,7 @@ Token Lexer::scan_token() {
         case ',': return make_token(TokenType::COMMA);
         case ':': return make_token(TokenType::COLON);
         case ';': return make_token(TokenType::SEMICOLON);
+        case '@': return make_token(TokenType::AT);
         case '\n': return make_token(TokenType::NEWLINE);
         
         // Operators
@@ -0,0 +1,251 @@
+/**
+ * @file analysis.cpp
+ * @brief Zero Compiler — Control-Flow Analyses Implementation
+ */
+
+#include "opt/analysis.hpp"
+
+#include <algorithm>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CFG
+// ─────────────────────────────────────────────────────────────────────────────
+
+CFG CFG::build(const Function& fn) {
+    CFG cfg;
+    size_t n = fn.blocks.size();
+    cfg.succs.resize(n);
+    cfg.preds.resize(n);
+    cfg.rpo_index_.assign(n, UNREACHABLE);
+
+    for (size_t i = 0; i < n; ++i) {
+        cfg.index_of[fn.blocks[i].id] = i;
+    }
+
+    auto add_edge = [&cfg](size_t from, size_t to) {
+        auto& s = cfg.succs[from];
+        if (std::find(s.begin(), s.end(), to) != s.end()) return;
+        s.push_back(to);
+        cfg.preds[to].push_back(from);
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        const BasicBlock& bb = fn.blocks[i];
+        size_t t = bb.terminator_index();
+
+        if (t == bb.instrs.size()) {
+            if (i + 1 < n) add_edge(i, i + 1);
+            continue;
+        }
+
+        const Instruction& term = bb.instrs[t];
+        if (term.op == OpCode::BR || term.op == OpCode::COND_BR) {
+            auto it = cfg.index_of.find(term.target_block);
+            if (it != cfg.index_of.end()) add_edge(i, it->second);
+        }
+        if (term.op == OpCode::COND_BR) {
+            auto it = cfg.index_of.find(term.else_block);
+            if (it != cfg.index_of.end()) add_edge(i, it->second);
+        }
+    }
+
+    // Iterative DFS from entry for reverse postorder
+    if (n > 0) {
+        std::vector<bool> visited(n, false);
+        std::vector<std::pair<size_t, size_t>> stack;  // (block, next succ)
+        std::vector<size_t> postorder;
+
+        stack.push_back({0, 0});
+        visited[0] = true;
+        while (!stack.empty()) {
+            auto& [bb, next] = stack.back();
+            if (next < cfg.succs[bb].size()) {
+                size_t s = cfg.succs[bb][next++];
+                if (!visited[s]) {
+                    visited[s] = true;
+                    stack.push_back({s, 0});
+                }
+            } else {
+                postorder.push_back(bb);
+                stack.pop_back();
+            }
+        }
+
+        cfg.rpo.assign(postorder.rbegin(), postorder.rend());
+        for (size_t i = 0; i < cfg.rpo.size(); ++i) {
+            cfg.rpo_index_[cfg.rpo[i]] = i;
+        }
+    }
+
+    return cfg;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dominator Tree
+// ─────────────────────────────────────────────────────────────────────────────
+
+DominatorTree::DominatorTree(const CFG& cfg) : idom_(cfg.size(), -1) {
+    if (cfg.rpo.empty()) return;
+
+    size_t entry = cfg.rpo[0];
+    idom_[entry] = static_cast<long>(entry);
+
+    auto intersect = [&](size_t a, size_t b) {
+        while (a != b) {
+            while (cfg.rpo_number(a) > cfg.rpo_number(b)) a = static_cast<size_t>(idom_[a]);
+            while (cfg.rpo_number(b) > cfg.rpo_number(a)) b = static_cast<size_t>(idom_[b]);
+        }
+        return a;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < cfg.rpo.size(); ++i) {
+            size_t bb = cfg.rpo[i];
+            long new_idom = -1;
+            for (size_t p : cfg.preds[bb]) {
+                if (idom_[p] < 0) continue;
+                new_idom = new_idom < 0
+                    ? static_cast<long>(p)
+                    : static_cast<long>(intersect(p, static_cast<size_t>(new_idom)));
+            }
+            if (new_idom != idom_[bb]) {
+                idom_[bb] = new_idom;
+                changed = true;
+            }
+        }
+    }
+}
+
+bool DominatorTree::dominates(size_t a, size_t b) const {
+    if (idom_[a] < 0 || idom_[b] < 0) return false;
+    while (true) {
+        if (a == b) return true;
+        size_t up = static_cast<size_t>(idom_[b]);
+        if (up == b) return false;  // Reached entry
+        b = up;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Loops
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool Loop::contains(size_t bb) const {
+    return std::binary_search(blocks.begin(), blocks.end(), bb);
+}
+
+long Loop::preheader(const CFG& cfg) const {
+    long candidate = -1;
+    for (size_t p : cfg.preds[header]) {
+        if (contains(p)) continue;
+        if (candidate >= 0) return -1;
+        candidate = static_cast<long>(p);
+    }
+    if (candidate < 0) return -1;
+    if (cfg.succs[static_cast<size_t>(candidate)].size() != 1) return -1;
+    return candidate;
+}
+
+LoopInfo::LoopInfo(const CFG& cfg, const DominatorTree& dom)
+    : block_loop_(cfg.size(), nullptr) {
+    // Collect back edges grouped by header, in RPO for determinism
+    for (size_t header : cfg.rpo) {
+        std::vector<size_t> latches;
+        for (size_t p : cfg.preds[header]) {
+            if (cfg.reachable(p) && dom.dominates(header, p)) {
+                latches.push_back(p);
+            }
+        }
+        if (latches.empty()) continue;
+
+        auto loop = std::make_unique<Loop>();
+        loop->header = header;
+        loop->latches = latches;
+
+        // Walk backwards from the latches until we hit the header
+        std::vector<bool> in_loop(cfg.size(), false);
+        in_loop[header] = true;
+        std::vector<size_t> worklist;
+        for (size_t l : latches) {
+            if (!in_loop[l]) {
+                in_loop[l] = true;
+                worklist.push_back(l);
+            }
+        }
+        while (!worklist.empty()) {
+            size_t bb = worklist.back();
+            worklist.pop_back();
+            for (size_t p : cfg.preds[bb]) {
+                if (!in_loop[p] && cfg.reachable(p)) {
+                    in_loop[p] = true;
+                    worklist.push_back(p);
+                }
+            }
+        }
+        for (size_t i = 0; i < cfg.size(); ++i) {
+            if (in_loop[i]) loop->blocks.push_back(i);
+        }
+
+        loops_.push_back(std::move(loop));
+    }
+
+    // Nest loops: the parent is the smallest strictly larger loop that
+    // contains our header.
+    std::vector<Loop*> by_size;
+    for (auto& l : loops_) by_size.push_back(l.get());
+    std::stable_sort(by_size.begin(), by_size.end(), [](Loop* a, Loop* b) {
+        return a->blocks.size() < b->blocks.size();
+    });
+
+    for (size_t i = 0; i < by_size.size(); ++i) {
+        Loop* inner = by_size[i];
+        for (size_t j = i + 1; j < by_size.size(); ++j) {
+            Loop* outer = by_size[j];
+            if (outer->header != inner->header && outer->contains(inner->header)) {
+                inner->parent = outer;
+                outer->children.push_back(inner);
+                break;
+            }
+        }
+        if (!inner->parent) top_level_.push_back(inner);
+
+        for (size_t bb : inner->blocks) {
+            if (!block_loop_[bb]) block_loop_[bb] = inner;
+        }
+    }
+
+    for (Loop* l : postorder()) {
+        unsigned depth = 1;
+        for (Loop* p = l->parent; p; p = p->parent) ++depth;
+        l->depth = depth;
+    }
+}
+
+std::vector<Loop*> LoopInfo::postorder() const {
+    std::vector<Loop*> order;
+    std::vector<std::pair<Loop*, size_t>> stack;
+    for (Loop* root : top_level_) {
+        stack.push_back({root, 0});
+        while (!stack.empty()) {
+            auto& [loop, next] = stack.back();
+            if (next < loop->children.size()) {
+                Loop* child = loop->children[next++];
+                stack.push_back({child, 0});
+            } else {
+                order.push_back(loop);
+                stack.pop_back();
+            }
+        }
+    }
+    return order;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,206 @@
+/**
+ * @file buffer_plan.cpp
+ * @brief Zero Compiler — Tensor Buffer Planning Implementation
+ */
+
+#include "opt/buffer_plan.hpp"
+#include "opt/analysis.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+constexpr uint32_t NONE = UINT32_MAX;
+
+// Operand indices are stored in an int8_t
+constexpr size_t MAX_IN_PLACE_OPERAND = 127;
+
+bool is_tensor(const Value& v) {
+    return v.valid() && v.type.is_tensor();
+}
+
+/**
+ * Elementwise ops: their result may share a buffer with an input of the
+ * same shape.
+ */
+bool can_run_in_place(OpCode op) {
+    switch (op) {
+        case OpCode::TENSOR_ADD:
+        case OpCode::TENSOR_SUB:
+        case OpCode::TENSOR_MUL:
+        case OpCode::TENSOR_RELU:
+        case OpCode::TENSOR_EXP:
+        case OpCode::TENSOR_TANH:
+        case OpCode::TENSOR_SIGMOID:
+        case OpCode::TENSOR_GELU:
+        case OpCode::TENSOR_FUSED:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * A set of densely numbered values.
+ */
+class ValueSet {
+public:
+    explicit ValueSet(size_t n = 0) : words_((n + 63) / 64, 0) {}
+
+    bool test(uint32_t i) const { return words_[i / 64] >> (i % 64) & 1; }
+    void set(uint32_t i) { words_[i / 64] |= uint64_t(1) << (i % 64); }
+    void reset(uint32_t i) { words_[i / 64] &= ~(uint64_t(1) << (i % 64)); }
+
+    void unite(const ValueSet& other) {
+        for (size_t w = 0; w < words_.size(); ++w) words_[w] |= other.words_[w];
+    }
+
+    /**
+     * this = use | (out & ~def)
+     */
+    void assign_transfer(const ValueSet& use, const ValueSet& out, const ValueSet& def) {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            words_[w] = use.words_[w] | (out.words_[w] & ~def.words_[w]);
+        }
+    }
+
+    bool operator!=(const ValueSet& other) const { return words_ != other.words_; }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+} // anonymous namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// BufferPlanner
+// ─────────────────────────────────────────────────────────────────────────────
+
+MemoryPlan BufferPlanner::plan(const Module& mod) {
+    MemoryPlan result;
+    for (const auto& fn : mod.functions) {
+        const size_t before = tensor_values_;
+        FunctionMemoryPlan fp = plan(fn);
+        if (tensor_values_ > before) result.functions.emplace(&fn, std::move(fp));
+    }
+    return result;
+}
+
+FunctionMemoryPlan BufferPlanner::plan(const Function& fn) {
+    // Number the tensor values densely
+    std::vector<uint32_t> index(fn.next_value_id + 1, NONE);
+    std::vector<uint32_t> ids;
+    auto number = [&](const Value& v) {
+        if (is_tensor(v) && v.id < index.size() && index[v.id] == NONE) {
+            index[v.id] = static_cast<uint32_t>(ids.size());
+            ids.push_back(v.id);
+        }
+    };
+    for (const Value& p : fn.params) number(p);
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            number(instr.result);
+            for (const Value& v : instr.operands) number(v);
+        }
+    }
+    tensor_values_ += ids.size();
+
+    auto tensor_index = [&](const Value& v) {
+        return is_tensor(v) && v.id < index.size() ? index[v.id] : NONE;
+    };
+
+    const size_t n = fn.blocks.size();
+    const size_t values = ids.size();
+    std::vector<ValueSet> use(n, ValueSet(values)), def(n, ValueSet(values));
+    for (size_t b = 0; b < n; ++b) {
+        for (const auto& instr : fn.blocks[b].instrs) {
+            for (const Value& v : instr.operands) {
+                uint32_t t = tensor_index(v);
+                if (t != NONE && !def[b].test(t)) use[b].set(t);
+            }
+            uint32_t r = tensor_index(instr.result);
+            if (r != NONE) def[b].set(r);
+        }
+    }
+
+    // Backward dataflow to a fixed point; later blocks first converges fast
+    CFG cfg = CFG::build(fn);
+    std::vector<ValueSet> live_in(n, ValueSet(values)), live_out(n, ValueSet(values));
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t b = n; b-- > 0;) {
+            ValueSet out(values);
+            for (size_t s : cfg.succs[b]) out.unite(live_in[s]);
+            ValueSet in(values);
+            in.assign_transfer(use[b], out, def[b]);
+            live_out[b] = out;
+            if (in != live_in[b]) {
+                live_in[b] = in;
+                changed = true;
+            }
+        }
+    }
+
+    MemoryPlanBuilder builder;
+    for (size_t b = 0; b < n; ++b) {
+        const BasicBlock& bb = fn.blocks[b];
+
+        std::vector<uint32_t> on_entry;
+        if (b == 0) {
+            for (const Value& p : fn.params) {
+                uint32_t t = tensor_index(p);
+                if (t != NONE && !live_in[0].test(t)) on_entry.push_back(p.id);
+            }
+        }
+        ValueSet incoming(values);
+        for (size_t p : cfg.preds[b]) incoming.unite(live_out[p]);
+        for (uint32_t t = 0; t < values; ++t) {
+            if (incoming.test(t) && !live_in[b].test(t)) on_entry.push_back(ids[t]);
+        }
+        builder.begin_block(on_entry);
+
+        // Walk backwards: an operand not live below its use dies there
+        std::vector<std::vector<uint32_t>> releases(bb.instrs.size());
+        std::vector<int> in_place(bb.instrs.size(), -1);
+        ValueSet live = live_out[b];
+        for (size_t i = bb.instrs.size(); i-- > 0;) {
+            const Instruction& instr = bb.instrs[i];
+            uint32_t r = tensor_index(instr.result);
+            if (r != NONE) {
+                if (!live.test(r)) releases[i].push_back(instr.result.id);
+                live.reset(r);
+            }
+            for (size_t k = 0; k < instr.operands.size(); ++k) {
+                const Value& v = instr.operands[k];
+                uint32_t t = tensor_index(v);
+                if (t == NONE || live.test(t)) continue;
+                live.set(t);
+                releases[i].push_back(v.id);
+                if (r != NONE && in_place[i] < 0 && can_run_in_place(instr.op) &&
+                    k <= MAX_IN_PLACE_OPERAND) {
+                    in_place[i] = static_cast<int>(k);
+                }
+            }
+        }
+        for (size_t i = 0; i < bb.instrs.size(); ++i) {
+            builder.add_instruction(releases[i], in_place[i]);
+            if (in_place[i] >= 0) ++in_place_sites_;
+        }
+    }
+
+    return builder.finish();
+}
+
+} // namespace opt
+} // namespace zero
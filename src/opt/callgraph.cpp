@@ -0,0 +1,116 @@
+/**
+ * @file callgraph.cpp
+ * @brief Zero Compiler — Call Graph Implementation
+ */
+
+#include "opt/callgraph.hpp"
+
+#include <algorithm>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+CallGraph::CallGraph(const Module& mod)
+    : callees_(mod.functions.size()),
+      externals_(mod.functions.size()),
+      recursive_(mod.functions.size(), false) {
+    for (size_t i = 0; i < mod.functions.size(); ++i) {
+        index_.emplace(mod.functions[i].name, i);
+    }
+
+    for (size_t i = 0; i < mod.functions.size(); ++i) {
+        for (const auto& bb : mod.functions[i].blocks) {
+            for (const auto& instr : bb.instrs) {
+                if (instr.op != OpCode::CALL) continue;
+
+                auto it = index_.find(instr.callee);
+                if (it == index_.end()) {
+                    auto& ext = externals_[i];
+                    if (std::find(ext.begin(), ext.end(), instr.callee) == ext.end()) {
+                        ext.push_back(instr.callee);
+                    }
+                    continue;
+                }
+
+                auto& out = callees_[i];
+                if (std::find(out.begin(), out.end(), it->second) == out.end()) {
+                    out.push_back(it->second);
+                }
+                if (it->second == i) recursive_[i] = true;
+            }
+        }
+    }
+
+    compute_sccs();
+}
+
+long CallGraph::index_of(const std::string& name) const {
+    auto it = index_.find(name);
+    return it != index_.end() ? static_cast<long>(it->second) : -1;
+}
+
+// Tarjan's algorithm; emits each SCC after all SCCs it calls into.
+void CallGraph::compute_sccs() {
+    const size_t n = callees_.size();
+    const size_t unvisited = static_cast<size_t>(-1);
+    std::vector<size_t> index(n, unvisited), lowlink(n, 0);
+    std::vector<bool> on_stack(n, false);
+    std::vector<size_t> stack;
+    size_t counter = 0;
+
+    struct Frame { size_t fn; size_t next; };
+    std::vector<Frame> work;
+
+    for (size_t root = 0; root < n; ++root) {
+        if (index[root] != unvisited) continue;
+
+        work.push_back({root, 0});
+        index[root] = lowlink[root] = counter++;
+        stack.push_back(root);
+        on_stack[root] = true;
+
+        while (!work.empty()) {
+            Frame& f = work.back();
+            if (f.next < callees_[f.fn].size()) {
+                size_t c = callees_[f.fn][f.next++];
+                if (index[c] == unvisited) {
+                    index[c] = lowlink[c] = counter++;
+                    stack.push_back(c);
+                    on_stack[c] = true;
+                    work.push_back({c, 0});
+                } else if (on_stack[c]) {
+                    lowlink[f.fn] = std::min(lowlink[f.fn], index[c]);
+                }
+                continue;
+            }
+
+            size_t fn = f.fn;
+            work.pop_back();
+            if (!work.empty()) {
+                size_t parent = work.back().fn;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[fn]);
+            }
+
+            if (lowlink[fn] == index[fn]) {
+                std::vector<size_t> scc;
+                size_t member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    on_stack[member] = false;
+                    scc.push_back(member);
+                } while (member != fn);
+
+                if (scc.size() > 1) {
+                    for (size_t m : scc) recursive_[m] = true;
+                }
+                sccs_.push_back(std::move(scc));
+            }
+        }
+    }
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,115 @@
+/**
+ * @file dce.cpp
+ * @brief Zero Compiler — Dead Code Elimination Implementation
+ */
+
+#include "opt/dce.hpp"
+#include "ir/uses.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+bool DeadCodeElimination::run(Module& mod) {
+    PurityAnalysis purity(mod);
+    purity_ = &purity;
+
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+
+    purity_ = nullptr;
+    return changed;
+}
+
+bool DeadCodeElimination::run(Function& fn) {
+    bool changed = false;
+
+    // Unreachable tails after the first terminator
+    for (auto& bb : fn.blocks) {
+        size_t t = bb.terminator_index();
+        if (t + 1 < bb.instrs.size()) {
+            removed_ += bb.instrs.size() - t - 1;
+            bb.instrs.resize(t + 1);
+            changed = true;
+        }
+    }
+
+    // Deleting an instruction can make its operands dead: a worklist over
+    // the use-def chains revisits just those, so the pass stays linear
+    UseDefChains chains(fn);
+
+    // Reads of each value; a STORE's address operand is a write
+    std::vector<size_t> reads(fn.next_value_id + 1, 0);
+    std::vector<bool> is_slot(fn.next_value_id + 1, false);
+    std::vector<std::pair<size_t, size_t>> work;
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        for (size_t i = 0; i < fn.blocks[b].instrs.size(); ++i) {
+            const Instruction& instr = fn.blocks[b].instrs[i];
+            for (size_t k = 0; k < instr.operands.size(); ++k) {
+                if (instr.op == OpCode::STORE && k == 0) continue;
+                ++reads[instr.operands[k].id];
+            }
+            if (instr.op == OpCode::ALLOCA) is_slot[instr.result.id] = true;
+            work.push_back({b, i});
+        }
+    }
+
+    auto dead = [&](const Instruction& instr) {
+        if (instr.op == OpCode::STORE) {
+            // Stores into a local slot that is never loaded or passed on
+            const Value& slot = instr.operands[0];
+            return is_slot[slot.id] && reads[slot.id] == 0;
+        }
+        if (instr.op == OpCode::ALLOCA) {
+            return reads[instr.result.id] == 0;
+        }
+        if (instr.op == OpCode::CALL) {
+            if (!purity_ || !purity_->is_removable_call(instr)) return false;
+            return !instr.result.valid() || reads[instr.result.id] == 0;
+        }
+        if (!is_pure(instr.op) && instr.op != OpCode::LOAD) return false;
+        return reads[instr.result.id] == 0;
+    };
+
+    size_t erased = 0;
+    while (!work.empty()) {
+        auto [b, i] = work.back();
+        work.pop_back();
+        const Instruction& instr = fn.blocks[b].instrs[i];
+        if (instr.op == OpCode::NOP || !dead(instr)) continue;
+
+        const OperandList operands = instr.operands;
+        const bool store = instr.op == OpCode::STORE;
+        chains.erase_instruction(b, i);
+        ++erased;
+
+        for (size_t k = 0; k < operands.size(); ++k) {
+            const Value& v = operands[k];
+            if (!(store && k == 0)) --reads[v.id];
+
+            size_t db = 0, di = 0;
+            if (chains.def_site(v, db, di)) work.push_back({db, di});
+            // A slot that lost its last read takes its stores with it
+            if (is_slot[v.id] && reads[v.id] == 0) {
+                for (const Use& u : chains.uses(v)) work.push_back({u.block, u.index});
+            }
+        }
+    }
+
+    if (erased) {
+        chains.compact();
+        removed_ += erased;
+        changed = true;
+    }
+
+    return changed;
+}
+
+} // namespace opt
+} // namespace zero
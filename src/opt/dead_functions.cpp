@@ -0,0 +1,56 @@
+/**
+ * @file dead_functions.cpp
+ * @brief Zero Compiler — Dead Function Elimination Implementation
+ */
+
+#include "opt/dead_functions.hpp"
+#include "opt/callgraph.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+bool DeadFunctionElimination::run(Module& mod) {
+    CallGraph cg(mod);
+
+    std::vector<size_t> work;
+    for (size_t i = 0; i < mod.functions.size(); ++i) {
+        const Function& fn = mod.functions[i];
+        if (fn.name == entry_ || fn.has_attribute("export")) work.push_back(i);
+    }
+    if (work.empty()) return false;
+
+    std::vector<bool> live(mod.functions.size(), false);
+    for (size_t root : work) live[root] = true;
+    while (!work.empty()) {
+        size_t fn = work.back();
+        work.pop_back();
+        for (size_t callee : cg.callees(fn)) {
+            if (!live[callee]) {
+                live[callee] = true;
+                work.push_back(callee);
+            }
+        }
+    }
+
+    size_t dead = static_cast<size_t>(std::count(live.begin(), live.end(), false));
+    if (dead == 0) return false;
+
+    // Keep the survivors in their original order
+    std::vector<size_t> kept;
+    kept.reserve(mod.functions.size() - dead);
+    for (size_t i = 0; i < mod.functions.size(); ++i) {
+        if (live[i]) kept.push_back(i);
+    }
+
+    mod.functions.retain(kept);
+    removed_ += dead;
+    return true;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,236 @@
+/**
+ * @file fusion.cpp
+ * @brief Zero Compiler — Elementwise Tensor Fusion Implementation
+ */
+
+#include "opt/fusion.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+constexpr uint32_t NONE = UINT32_MAX;
+
+/**
+ * The fused-program token of a one-operand elementwise op, or nullptr.
+ */
+const char* unary_token(OpCode op) {
+    switch (op) {
+        case OpCode::TENSOR_RELU: return "relu";
+        case OpCode::TENSOR_EXP: return "exp";
+        case OpCode::TENSOR_TANH: return "tanh";
+        case OpCode::TENSOR_SIGMOID: return "sigmoid";
+        case OpCode::TENSOR_GELU: return "gelu";
+        default: return nullptr;
+    }
+}
+
+bool is_elementwise(OpCode op) {
+    switch (op) {
+        case OpCode::TENSOR_ADD:
+        case OpCode::TENSOR_SUB:
+        case OpCode::TENSOR_MUL:
+        case OpCode::TENSOR_FUSED:
+            return true;
+        default:
+            return unary_token(op) != nullptr;
+    }
+}
+
+std::vector<std::string> tokens(const Symbol& program) {
+    std::vector<std::string> out;
+    std::istringstream in(program.str());
+    for (std::string t; in >> t;) out.push_back(t);
+    return out;
+}
+
+/**
+ * Operand index of an "xK" token, or NONE.
+ */
+uint32_t input_index(const std::string& token) {
+    if (token.size() < 2 || token[0] != 'x') return NONE;
+    uint32_t k = 0;
+    for (size_t i = 1; i < token.size(); ++i) {
+        if (token[i] < '0' || token[i] > '9') return NONE;
+        k = k * 10 + static_cast<uint32_t>(token[i] - '0');
+    }
+    return k;
+}
+
+/**
+ * Builds the program for one root, pulling in the producers it absorbs.
+ */
+class FusionBuilder {
+public:
+    FusionBuilder(BasicBlock& bb, size_t root, const std::vector<size_t>& reads,
+                  const std::vector<uint32_t>& def_index, const std::vector<size_t>& calls_before,
+                  std::vector<bool>& absorbed)
+        : bb_(bb), root_(root), reads_(reads), def_index_(def_index),
+          calls_before_(calls_before), absorbed_(absorbed) {}
+
+    void node(const Instruction& instr) {
+        switch (instr.op) {
+            case OpCode::TENSOR_FUSED:
+                // Re-emit the inner program with its inputs resolved here
+                for (const std::string& t : tokens(instr.imm_str)) {
+                    uint32_t k = input_index(t);
+                    if (k == NONE) {
+                        append(t);
+                    } else {
+                        operand(instr.operands[k]);
+                    }
+                }
+                break;
+            case OpCode::TENSOR_ADD:
+            case OpCode::TENSOR_SUB:
+            case OpCode::TENSOR_MUL:
+                operand(instr.operands[0]);
+                operand(instr.operands[1]);
+                append(instr.op == OpCode::TENSOR_ADD ? "add"
+                       : instr.op == OpCode::TENSOR_SUB ? "sub" : "mul");
+                break;
+            default:
+                operand(instr.operands[0]);
+                append(unary_token(instr.op));
+                break;
+        }
+    }
+
+    const std::string& program() const { return program_; }
+    const std::vector<Value>& inputs() const { return inputs_; }
+    size_t absorbed_count() const { return absorbed_count_; }
+
+private:
+    BasicBlock& bb_;
+    size_t root_;
+    const std::vector<size_t>& reads_;
+    const std::vector<uint32_t>& def_index_;
+    const std::vector<size_t>& calls_before_;
+    std::vector<bool>& absorbed_;
+
+    std::string program_;
+    std::vector<Value> inputs_;
+    size_t absorbed_count_ = 0;
+
+    void append(const std::string& token) {
+        if (!program_.empty()) program_ += ' ';
+        program_ += token;
+    }
+
+    void operand(const Value& v) {
+        const uint32_t j = v.id < def_index_.size() ? def_index_[v.id] : NONE;
+        if (absorbable(v, j)) {
+            absorbed_[j] = true;
+            ++absorbed_count_;
+            node(bb_.instrs[j]);
+            return;
+        }
+        size_t k = 0;
+        while (k < inputs_.size() && inputs_[k].id != v.id) ++k;
+        if (k == inputs_.size()) inputs_.push_back(v);
+        append("x" + std::to_string(k));
+    }
+
+    bool absorbable(const Value& v, uint32_t j) const {
+        if (j == NONE || j >= root_ || absorbed_[j]) return false;
+        const Instruction& def = bb_.instrs[j];
+        if (!is_elementwise(def.op) || reads_[v.id] != 1) return false;
+        if (calls_before_[j + 1] != calls_before_[root_]) return false;
+        return types::types_compatible(def.result.type, bb_.instrs[root_].result.type);
+    }
+};
+
+} // anonymous namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TensorFusion
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool TensorFusion::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool TensorFusion::run(Function& fn) {
+    // Reads of each value; a fused op reads an input once per reference
+    // in its program, so folding it elsewhere never duplicates work
+    std::vector<size_t> reads(fn.next_value_id + 1, 0);
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::TENSOR_FUSED) {
+                for (const std::string& t : tokens(instr.imm_str)) {
+                    uint32_t k = input_index(t);
+                    if (k < instr.operands.size()) ++reads[instr.operands[k].id];
+                }
+                continue;
+            }
+            for (const Value& v : instr.operands) ++reads[v.id];
+        }
+    }
+
+    bool changed = false;
+    std::vector<uint32_t> def_index(fn.next_value_id + 1, NONE);
+    for (auto& bb : fn.blocks) {
+        // Defining index within this block, and calls seen before each index
+        std::vector<size_t> calls_before(bb.instrs.size() + 1, 0);
+        for (size_t i = 0; i < bb.instrs.size(); ++i) {
+            const Instruction& instr = bb.instrs[i];
+            if (instr.result.valid()) def_index[instr.result.id] = static_cast<uint32_t>(i);
+            calls_before[i + 1] = calls_before[i] + (instr.op == OpCode::CALL);
+        }
+
+        // Roots last to first, so each takes the longest chain ending at it
+        std::vector<bool> absorbed(bb.instrs.size(), false);
+        size_t absorbed_here = 0;
+        for (size_t i = bb.instrs.size(); i-- > 0;) {
+            if (absorbed[i] || !is_elementwise(bb.instrs[i].op)) continue;
+
+            FusionBuilder builder(bb, i, reads, def_index, calls_before, absorbed);
+            builder.node(bb.instrs[i]);
+            if (builder.absorbed_count() == 0) continue;
+
+            Instruction& root = bb.instrs[i];
+            root.op = OpCode::TENSOR_FUSED;
+            root.operands.clear();
+            for (const Value& v : builder.inputs()) root.operands.push_back(v);
+            root.imm_str = builder.program();
+            absorbed_here += builder.absorbed_count();
+            ++kernels_;
+        }
+
+        for (const auto& instr : bb.instrs) {
+            if (instr.result.valid()) def_index[instr.result.id] = NONE;
+        }
+        if (absorbed_here == 0) continue;
+
+        size_t out = 0;
+        for (size_t i = 0; i < bb.instrs.size(); ++i) {
+            if (absorbed[i]) continue;
+            if (out != i) bb.instrs[out] = std::move(bb.instrs[i]);
+            ++out;
+        }
+        bb.instrs.resize(out);
+        fused_ += absorbed_here;
+        changed = true;
+    }
+
+    return changed;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,478 @@
+/**
+ * @file induction.cpp
+ * @brief Zero Compiler — Induction Variables and Strength Reduction Implementation
+ */
+
+#include "opt/induction.hpp"
+
+#include <limits>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+struct DefSite {
+    size_t block = 0;
+    size_t index = 0;
+    const Instruction* instr = nullptr;
+};
+
+/**
+ * Defining instruction of every value in a function. Parameters have none.
+ */
+std::unordered_map<uint32_t, DefSite> collect_defs(const Function& fn) {
+    std::unordered_map<uint32_t, DefSite> defs;
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        const auto& instrs = fn.blocks[b].instrs;
+        for (size_t i = 0; i < instrs.size(); ++i) {
+            if (instrs[i].result.valid()) {
+                defs[instrs[i].result.id] = {b, i, &instrs[i]};
+            }
+        }
+    }
+    return defs;
+}
+
+bool const_int(const std::unordered_map<uint32_t, DefSite>& defs,
+               const Value& v, int64_t& out) {
+    auto it = defs.find(v.id);
+    if (it == defs.end() || it->second.instr->op != OpCode::CONST_INT) return false;
+    out = it->second.instr->imm_int;
+    return true;
+}
+
+Instruction make_const(Function& fn, int64_t v) {
+    Instruction c;
+    c.op = OpCode::CONST_INT;
+    c.result = fn.new_value(types::Type::make_int());
+    c.imm_int = v;
+    return c;
+}
+
+Instruction make_binary(Function& fn, OpCode op, const Value& a, const Value& b) {
+    Instruction instr;
+    instr.op = op;
+    instr.result = fn.new_value(types::Type::make_int());
+    instr.operands = {a, b};
+    return instr;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Induction analysis
+// ─────────────────────────────────────────────────────────────────────────────
+
+InductionAnalysis::InductionAnalysis(const Function& fn, const CFG& cfg,
+                                     const DominatorTree& dom, const Loop& loop) {
+    find_variables(fn, cfg, dom, loop);
+    if (!ivs_.empty()) find_exit_test(fn, cfg, loop);
+    if (has_exit_) compute_trip_count();
+}
+
+const InductionVariable* InductionAnalysis::find(const Value& slot) const {
+    for (const auto& iv : ivs_) {
+        if (iv.slot == slot) return &iv;
+    }
+    return nullptr;
+}
+
+void InductionAnalysis::find_variables(const Function& fn, const CFG& cfg,
+                                       const DominatorTree& dom, const Loop& loop) {
+    long ph = loop.preheader(cfg);
+    if (ph < 0) return;
+
+    auto defs = collect_defs(fn);
+
+    // Stores per slot; slots used any other way than LOAD/STORE address escape
+    struct SlotUses {
+        std::vector<std::pair<size_t, size_t>> stores;
+        bool escapes = false;
+    };
+    std::map<uint32_t, SlotUses> slots;
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::ALLOCA) slots[instr.result.id];
+        }
+    }
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        const auto& instrs = fn.blocks[b].instrs;
+        for (size_t i = 0; i < instrs.size(); ++i) {
+            const Instruction& instr = instrs[i];
+            for (size_t o = 0; o < instr.operands.size(); ++o) {
+                auto it = slots.find(instr.operands[o].id);
+                if (it == slots.end()) continue;
+                bool address = o == 0 && (instr.op == OpCode::LOAD || instr.op == OpCode::STORE);
+                if (!address) it->second.escapes = true;
+                else if (instr.op == OpCode::STORE) it->second.stores.push_back({b, i});
+            }
+        }
+    }
+
+    for (const auto& [slot_id, uses] : slots) {
+        if (uses.escapes) continue;
+
+        std::vector<std::pair<size_t, size_t>> inside, outside;
+        for (const auto& s : uses.stores) {
+            (loop.contains(s.first) ? inside : outside).push_back(s);
+        }
+        if (inside.size() != 1 || outside.size() != 1) continue;
+
+        // The update runs exactly once per iteration: after the header's
+        // test, not in a nested loop, and on every path to the back edge.
+        auto [ub, ui] = inside[0];
+        if (ub == loop.header) continue;
+        bool nested = false;
+        for (const Loop* child : loop.children) nested |= child->contains(ub);
+        if (nested) continue;
+        bool every_iteration = true;
+        for (size_t latch : loop.latches) every_iteration &= dom.dominates(ub, latch);
+        if (!every_iteration) continue;
+
+        // Update value: load(slot) + c, c + load(slot) or load(slot) - c
+        const Instruction& store = fn.blocks[ub].instrs[ui];
+        auto vd = defs.find(store.operands[1].id);
+        if (vd == defs.end() || vd->second.block != ub) continue;
+        const Instruction& upd = *vd->second.instr;
+        if (upd.op != OpCode::ADD && upd.op != OpCode::SUB) continue;
+
+        auto is_slot_load = [&](const Value& v) {
+            auto d = defs.find(v.id);
+            return d != defs.end() && d->second.block == ub && d->second.index < ui &&
+                   d->second.instr->op == OpCode::LOAD &&
+                   d->second.instr->operands[0].id == slot_id;
+        };
+        int64_t c = 0;
+        int64_t step = 0;
+        if (is_slot_load(upd.operands[0]) && const_int(defs, upd.operands[1], c)) {
+            step = upd.op == OpCode::ADD ? c : -c;
+        } else if (upd.op == OpCode::ADD && is_slot_load(upd.operands[1]) &&
+                   const_int(defs, upd.operands[0], c)) {
+            step = c;
+        } else {
+            continue;
+        }
+        if (step == 0) continue;
+
+        // The initial store must run before every entry into the loop: it
+        // dominates the preheader and sits inside every enclosing loop.
+        auto [ob, oi] = outside[0];
+        if (!dom.dominates(ob, static_cast<size_t>(ph))) continue;
+        bool reinitialized = true;
+        for (const Loop* p = loop.parent; p; p = p->parent) reinitialized &= p->contains(ob);
+        if (!reinitialized) continue;
+
+        InductionVariable iv;
+        iv.slot = defs[slot_id].instr->result;
+        iv.init = fn.blocks[ob].instrs[oi].operands[1];
+        iv.init_is_const = const_int(defs, iv.init, iv.init_const);
+        iv.step = step;
+        iv.update_block = ub;
+        iv.update_index = ui;
+        ivs_.push_back(iv);
+    }
+}
+
+void InductionAnalysis::find_exit_test(const Function& fn, const CFG& cfg, const Loop& loop) {
+    // The header must be the only way out of the loop
+    for (size_t b : loop.blocks) {
+        if (b == loop.header) continue;
+        for (size_t s : cfg.succs[b]) {
+            if (!loop.contains(s)) return;
+        }
+    }
+
+    const BasicBlock& header = fn.blocks[loop.header];
+    size_t t = header.terminator_index();
+    if (t == header.instrs.size() || header.instrs[t].op != OpCode::COND_BR) return;
+    const Instruction& term = header.instrs[t];
+
+    auto defs = collect_defs(fn);
+    auto cd = defs.find(term.operands[0].id);
+    if (cd == defs.end() || cd->second.block != loop.header) return;
+    const Instruction& cmp = *cd->second.instr;
+    if (!is_compare(cmp.op)) return;
+
+    auto iv_of = [&](const Value& v) -> const InductionVariable* {
+        auto d = defs.find(v.id);
+        if (d == defs.end() || d->second.block != loop.header ||
+            d->second.instr->op != OpCode::LOAD) {
+            return nullptr;
+        }
+        return find(d->second.instr->operands[0]);
+    };
+    auto invariant = [&](const Value& v) {
+        auto d = defs.find(v.id);
+        if (d == defs.end()) return true;
+        return d->second.instr->op == OpCode::CONST_INT || !loop.contains(d->second.block);
+    };
+
+    ExitTest test;
+    if ((test.iv = iv_of(cmp.operands[0])) && invariant(cmp.operands[1])) {
+        test.pred = cmp.op;
+        test.bound = cmp.operands[1];
+    } else if ((test.iv = iv_of(cmp.operands[1])) && invariant(cmp.operands[0])) {
+        test.pred = swap_compare(cmp.op);
+        test.bound = cmp.operands[0];
+    } else {
+        return;
+    }
+    test.bound_is_const = const_int(defs, test.bound, test.bound_const);
+
+    size_t on_true = cfg.index_of.at(term.target_block);
+    size_t on_false = cfg.index_of.at(term.else_block);
+    if (loop.contains(on_true) && !loop.contains(on_false)) {
+        test.body = on_true;
+        test.exit = on_false;
+    } else if (!loop.contains(on_true) && loop.contains(on_false)) {
+        test.pred = invert_compare(test.pred);
+        test.body = on_false;
+        test.exit = on_true;
+    } else {
+        return;
+    }
+
+    exit_ = test;
+    has_exit_ = true;
+}
+
+void InductionAnalysis::compute_trip_count() {
+    const InductionVariable& iv = *exit_.iv;
+    if (!iv.init_is_const || !exit_.bound_is_const) return;
+
+    // Iteration k tests init + k*step; count the leading k that pass.
+    // Distances and |step| are unsigned, so no difference can overflow;
+    // a count too large for trip_count_ stays unknown.
+    int64_t init = iv.init_const;
+    int64_t bound = exit_.bound_const;
+    int64_t step = iv.step;
+    if (step == 0) return;
+    uint64_t up = static_cast<uint64_t>(bound) - static_cast<uint64_t>(init);
+    uint64_t down = static_cast<uint64_t>(init) - static_cast<uint64_t>(bound);
+    uint64_t stride = step > 0 ? static_cast<uint64_t>(step) : 0 - static_cast<uint64_t>(step);
+    const uint64_t unknown = std::numeric_limits<uint64_t>::max();
+    uint64_t trips = unknown;
+    auto plus_one = [&](uint64_t n) { return n == unknown ? unknown : n + 1; };
+
+    switch (exit_.pred) {
+        case OpCode::CMP_LT:
+            if (step > 0) trips = init < bound ? (up - 1) / stride + 1 : 0;
+            break;
+        case OpCode::CMP_LE:
+            if (step > 0) trips = init <= bound ? plus_one(up / stride) : 0;
+            break;
+        case OpCode::CMP_GT:
+            if (step < 0) trips = init > bound ? (down - 1) / stride + 1 : 0;
+            break;
+        case OpCode::CMP_GE:
+            if (step < 0) trips = init >= bound ? plus_one(down / stride) : 0;
+            break;
+        case OpCode::CMP_NE:
+            if (step > 0 && init <= bound && up % stride == 0) trips = up / stride;
+            if (step < 0 && init >= bound && down % stride == 0) trips = down / stride;
+            break;
+        default:
+            break;
+    }
+
+    if (trips <= static_cast<uint64_t>(std::numeric_limits<long>::max())) {
+        trip_count_ = static_cast<long>(trips);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Strength reduction
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool StrengthReduction::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool StrengthReduction::run(Function& fn) {
+    if (fn.blocks.empty()) return false;
+
+    // Only instructions are inserted, so the block-level analyses stay valid
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    LoopInfo loops(cfg, dom);
+
+    bool changed = false;
+    for (Loop* loop : loops.postorder()) {
+        changed |= reduce(fn, cfg, dom, *loop);
+    }
+    return changed;
+}
+
+bool StrengthReduction::reduce(Function& fn, const CFG& cfg, const DominatorTree& dom,
+                               const Loop& loop) {
+    InductionAnalysis ind(fn, cfg, dom, loop);
+    if (ind.variables().empty()) return false;
+    size_t ph = static_cast<size_t>(loop.preheader(cfg));
+
+    auto defs = collect_defs(fn);
+
+    // Candidate multiplies, grouped by (variable, factor)
+    struct Group {
+        const InductionVariable* iv = nullptr;
+        Value factor;
+        bool factor_is_const = false;
+        int64_t factor_const = 0;
+        std::vector<std::pair<uint32_t, uint32_t>> muls;   // (mul result, load of iv)
+    };
+    std::map<std::tuple<uint32_t, bool, int64_t>, Group> groups;
+
+    for (size_t b : loop.blocks) {
+        for (const auto& instr : fn.blocks[b].instrs) {
+            if (instr.op != OpCode::MUL || !instr.result.type.is_int()) continue;
+
+            for (size_t o = 0; o < 2; ++o) {
+                const Value& x = instr.operands[o];
+                const Value& c = instr.operands[1 - o];
+
+                auto xd = defs.find(x.id);
+                if (xd == defs.end() || xd->second.instr->op != OpCode::LOAD ||
+                    !loop.contains(xd->second.block)) {
+                    continue;
+                }
+                const InductionVariable* iv = ind.find(xd->second.instr->operands[0]);
+                if (!iv) continue;
+
+                int64_t k = 0;
+                bool is_const = const_int(defs, c, k);
+                if (!is_const) {
+                    auto cd = defs.find(c.id);
+                    bool outside = cd == defs.end() || !loop.contains(cd->second.block);
+                    if (!outside || !c.type.is_int()) continue;
+                }
+
+                // Constants group by value, other factors by SSA id
+                Group& g = groups[{iv->slot.id, is_const, is_const ? k : c.id}];
+                g.iv = iv;
+                g.factor = c;
+                g.factor_is_const = is_const;
+                g.factor_const = k;
+                g.muls.push_back({instr.result.id, x.id});
+                break;
+            }
+        }
+    }
+    if (groups.empty()) return false;
+
+    // Products to rewrite, and loads of t to place after the variable's
+    // loads, all in one sweep over the loop at the end
+    std::unordered_map<uint32_t, Value> replaced;
+    std::unordered_map<uint32_t, std::vector<Instruction>> reloads;     // After load id
+
+    for (auto& [key, g] : groups) {
+        const InductionVariable& iv = *g.iv;
+
+        // Preheader: t = init * c; dt = step * c
+        std::vector<Instruction> pre;
+        Value init_val, step_val;
+        if (g.factor_is_const && iv.init_is_const) {
+            pre.push_back(make_const(fn, iv.init_const * g.factor_const));
+            init_val = pre.back().result;
+        } else {
+            Value factor = g.factor;
+            if (g.factor_is_const) {
+                pre.push_back(make_const(fn, g.factor_const));
+                factor = pre.back().result;
+            }
+            pre.push_back(make_binary(fn, OpCode::MUL, iv.init, factor));
+            init_val = pre.back().result;
+        }
+        if (g.factor_is_const) {
+            pre.push_back(make_const(fn, iv.step * g.factor_const));
+            step_val = pre.back().result;
+        } else {
+            pre.push_back(make_const(fn, iv.step));
+            pre.push_back(make_binary(fn, OpCode::MUL, pre.back().result, g.factor));
+            step_val = pre.back().result;
+        }
+
+        Instruction alloca;
+        alloca.op = OpCode::ALLOCA;
+        alloca.result = fn.new_value(types::Type::make_int());
+        Value slot = alloca.result;
+
+        Instruction init_store;
+        init_store.op = OpCode::STORE;
+        init_store.operands = {slot, init_val};
+        pre.push_back(std::move(init_store));
+
+        auto& ph_instrs = fn.blocks[ph].instrs;
+        size_t at = fn.blocks[ph].terminator_index();
+        ph_instrs.insert(ph_instrs.begin() + static_cast<long>(at),
+                         std::make_move_iterator(pre.begin()),
+                         std::make_move_iterator(pre.end()));
+        auto& entry = fn.blocks[0].instrs;
+        entry.insert(entry.begin(), std::move(alloca));
+
+        // Bump t right after the variable's own update
+        auto& upd_instrs = fn.blocks[iv.update_block].instrs;
+        for (size_t i = 0; i < upd_instrs.size(); ++i) {
+            const Instruction& s = upd_instrs[i];
+            if (s.op != OpCode::STORE || s.operands[0] != iv.slot) continue;
+
+            Instruction load;
+            load.op = OpCode::LOAD;
+            load.result = fn.new_value(types::Type::make_int());
+            load.operands = {slot};
+            Instruction add = make_binary(fn, OpCode::ADD, load.result, step_val);
+            Instruction store;
+            store.op = OpCode::STORE;
+            store.operands = {slot, add.result};
+
+            auto pos = upd_instrs.begin() + static_cast<long>(i) + 1;
+            pos = upd_instrs.insert(pos, std::move(store));
+            pos = upd_instrs.insert(pos, std::move(add));
+            upd_instrs.insert(pos, std::move(load));
+            break;
+        }
+
+        // Each multiply becomes a load of t next to the load of the variable
+        for (const auto& [mul_id, load_id] : g.muls) {
+            Instruction reload;
+            reload.op = OpCode::LOAD;
+            reload.result = fn.new_value(types::Type::make_int());
+            reload.operands = {slot};
+            replaced[mul_id] = reload.result;
+            reloads[load_id].push_back(std::move(reload));
+            ++reduced_;
+        }
+    }
+
+    for (size_t b : loop.blocks) {
+        std::vector<Instruction> out;
+        out.reserve(fn.blocks[b].instrs.size());
+        for (auto& instr : fn.blocks[b].instrs) {
+            const uint32_t id = instr.result.valid() ? instr.result.id : 0;
+            if (id && replaced.count(id)) continue;
+            out.push_back(std::move(instr));
+            auto it = id ? reloads.find(id) : reloads.end();
+            if (it == reloads.end()) continue;
+            for (auto& reload : it->second) out.push_back(std::move(reload));
+        }
+        fn.blocks[b].instrs = std::move(out);
+    }
+
+    replace_uses(fn, replaced);
+    return true;
+}
+
+} // namespace opt
+} // namespace zero
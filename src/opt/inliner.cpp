@@ -0,0 +1,308 @@
+/**
+ * @file inliner.cpp
+ * @brief Zero Compiler — Function Inliner Implementation
+ */
+
+#include "opt/inliner.hpp"
+#include "opt/analysis.hpp"
+#include "opt/callgraph.hpp"
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Cost model
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t inline_cost(const Function& fn) {
+    size_t cost = 0;
+    for (const auto& bb : fn.blocks) {
+        size_t end = bb.terminator_index();
+        for (size_t i = 0; i < end; ++i) {
+            if (bb.instrs[i].op != OpCode::NOP) ++cost;
+        }
+    }
+    return cost;
+}
+
+bool Inliner::should_inline(const Function& caller, const Instruction& call,
+                            const Function& callee, size_t callee_cost,
+                            size_t caller_cost, unsigned loop_depth,
+                            bool recursive, unsigned recursive_count) const {
+    if (callee.blocks.empty()) return false;
+    // Inlining a @memo function would bypass its cache
+    if (callee.has_attribute("noinline") || callee.has_attribute("memo")) return false;
+    if (recursive && recursive_count >= opts_.max_recursive_inlines) return false;
+    if (callee.has_attribute("inline")) return true;
+
+    if (caller_cost + callee_cost > opts_.max_function_size) return false;
+    if (callee_cost <= opts_.always_inline_size) return true;
+
+    size_t budget = opts_.threshold + loop_depth * opts_.loop_bonus;
+    if (caller.has_profile) {
+        if (call.profile_count == 0) return false;
+        if (call.profile_count >= opts_.hot_call_count) budget += opts_.hot_bonus;
+    }
+    return callee_cost <= budget;
+}
+
+/**
+ * c * num / den without overflowing the product.
+ */
+static uint64_t scale_count(uint64_t c, uint64_t num, uint64_t den) {
+    if (den == 0) return num;
+    return static_cast<uint64_t>(static_cast<long double>(c) * num / den);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool Inliner::run(Module& mod) {
+    CallGraph cg(mod);
+    bool changed = false;
+
+    // Callees first, so each caller sees already-inlined callee bodies
+    for (const auto& scc : cg.sccs()) {
+        for (size_t fi : scc) {
+            Function& fn = mod.functions[fi];
+            if (fn.blocks.empty()) continue;
+
+            CFG cfg = CFG::build(fn);
+            DominatorTree dom(cfg);
+            LoopInfo loops(cfg, dom);
+
+            std::vector<unsigned> depth(fn.blocks.size(), 0);
+            for (size_t b = 0; b < fn.blocks.size(); ++b) {
+                if (Loop* l = loops.loop_for(b)) depth[b] = l->depth;
+            }
+
+            std::unordered_map<std::string, unsigned> recursive_counts;
+            size_t caller_cost = inline_cost(fn);
+
+            for (size_t b = 0; b < fn.blocks.size(); ++b) {
+                size_t end = fn.blocks[b].terminator_index();
+                for (size_t i = 0; i < end; ++i) {
+                    const Instruction& instr = fn.blocks[b].instrs[i];
+                    if (instr.op != OpCode::CALL) continue;
+
+                    long ci = cg.index_of(instr.callee);
+                    if (ci < 0) continue;
+                    const Function& callee = mod.functions[static_cast<size_t>(ci)];
+                    if (instr.operands.size() != callee.params.size()) continue;
+
+                    bool recursive = cg.is_recursive(static_cast<size_t>(ci));
+                    size_t callee_cost = inline_cost(callee);
+                    if (!should_inline(fn, instr, callee, callee_cost, caller_cost, depth[b],
+                                       recursive, recursive_counts[callee.name])) {
+                        continue;
+                    }
+
+                    if (recursive) ++recursive_counts[callee.name];
+                    // A copy of fn itself must not see stale call results
+                    if (&callee == &fn) {
+                        replace_uses(fn, pending_);
+                        pending_.clear();
+                    }
+                    size_t added = inline_call(fn, b, i, callee);
+                    depth.resize(depth.size() + added, depth[b]);
+                    caller_cost += callee_cost;
+                    ++inlined_;
+                    changed = true;
+
+                    // The rest of this block moved to the continuation,
+                    // which is scanned when the loop reaches it.
+                    break;
+                }
+            }
+
+            replace_uses(fn, pending_);
+            pending_.clear();
+        }
+    }
+
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Cloning
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t Inliner::inline_call(Function& fn, size_t bb, size_t idx,
+                            const Function& callee_ref) {
+    // Recursive inlining appends to the function we are copying from
+    const Function callee = callee_ref;
+    const size_t first_new = fn.blocks.size();
+
+    Instruction call = std::move(fn.blocks[bb].instrs[idx]);
+    std::vector<Instruction> tail(
+        std::make_move_iterator(fn.blocks[bb].instrs.begin() + static_cast<long>(idx) + 1),
+        std::make_move_iterator(fn.blocks[bb].instrs.end()));
+    fn.blocks[bb].instrs.resize(idx);
+
+    // Block map: callee block id -> new block id in the caller
+    std::unordered_map<uint32_t, uint32_t> block_map;
+    for (const auto& src : callee.blocks) {
+        block_map[src.id] = fn.new_block(callee.name + "." + src.label).id;
+    }
+    uint32_t cont_id = fn.new_block(fn.blocks[bb].label + ".cont").id;
+
+    // Value map: parameters bind to the call arguments, everything else
+    // gets a fresh caller value on first sight.
+    std::unordered_map<uint32_t, Value> value_map;
+    for (size_t i = 0; i < callee.params.size(); ++i) {
+        value_map[callee.params[i].id] = call.operands[i];
+    }
+    auto remap = [&](const Value& v) -> Value {
+        if (!v.valid()) return v;
+        auto it = value_map.find(v.id);
+        if (it != value_map.end()) return it->second;
+        Value nv = fn.new_value(v.type);
+        value_map[v.id] = nv;
+        return nv;
+    };
+
+    // Returned values; a single return is forwarded directly, several are
+    // merged through a stack slot since ZIR has no phi.
+    size_t value_returns = 0;
+    for (const auto& src : callee.blocks) {
+        size_t t = src.terminator_index();
+        if (t < src.instrs.size() && src.instrs[t].op == OpCode::RET &&
+            !src.instrs[t].operands.empty()) {
+            ++value_returns;
+        }
+    }
+    bool wants_result = call.result.valid() && value_returns > 0;
+    // Stack slots, the merge slot and the callee's own, go to the caller's
+    // entry block: the call may sit in a loop, and a slot must dominate
+    // every use of it.
+    std::vector<Instruction> allocas;
+    Value slot;
+    if (wants_result && value_returns > 1) {
+        Instruction alloca;
+        alloca.op = OpCode::ALLOCA;
+        alloca.result = fn.new_value(call.result.type);
+        slot = alloca.result;
+        allocas.push_back(std::move(alloca));
+    }
+    Value single_ret;
+
+    for (size_t s = 0; s < callee.blocks.size(); ++s) {
+        const BasicBlock& src = callee.blocks[s];
+        std::vector<Instruction> out;
+        size_t end = src.terminator_index();
+
+        for (size_t i = 0; i < end; ++i) {
+            Instruction copy = src.instrs[i];
+            for (auto& op : copy.operands) op = remap(op);
+            copy.result = remap(copy.result);
+            if (copy.op == OpCode::ALLOCA) {
+                allocas.push_back(std::move(copy));
+            } else {
+                out.push_back(std::move(copy));
+            }
+        }
+
+        Instruction br;
+        br.op = OpCode::BR;
+        if (end == src.instrs.size()) {
+            // Fall-through: to the next callee block, or out of the callee
+            br.target_block = s + 1 < callee.blocks.size()
+                ? block_map[callee.blocks[s + 1].id]
+                : cont_id;
+            out.push_back(br);
+        } else {
+            const Instruction& term = src.instrs[end];
+            if (term.op == OpCode::RET) {
+                if (wants_result && !term.operands.empty()) {
+                    Value rv = remap(term.operands[0]);
+                    if (slot.valid()) {
+                        Instruction store;
+                        store.op = OpCode::STORE;
+                        store.operands = {slot, rv};
+                        out.push_back(std::move(store));
+                    } else {
+                        single_ret = rv;
+                    }
+                }
+                br.target_block = cont_id;
+                out.push_back(br);
+            } else {
+                Instruction copy = term;
+                for (auto& op : copy.operands) op = remap(op);
+                copy.target_block = block_map[term.target_block];
+                if (term.op == OpCode::COND_BR) {
+                    copy.else_block = block_map[term.else_block];
+                }
+                out.push_back(std::move(copy));
+            }
+        }
+
+        fn.blocks[first_new + s].instrs = std::move(out);
+    }
+
+    // The callee's counts cover all its callers; this site's share is in
+    // proportion to its call count. An unprofiled callee runs each block
+    // once per call as far as anyone can tell.
+    if (fn.has_profile) {
+        uint64_t calls = call.profile_count;
+        uint64_t entries = callee.has_profile ? callee.blocks[0].profile_count : 0;
+        for (size_t s = 0; s < callee.blocks.size(); ++s) {
+            BasicBlock& copy = fn.blocks[first_new + s];
+            if (!callee.has_profile) {
+                copy.profile_count = calls;
+                for (auto& instr : copy.instrs) {
+                    instr.profile_count = instr.op == OpCode::COND_BR ? calls / 2 : calls;
+                }
+                continue;
+            }
+            copy.profile_count = scale_count(callee.blocks[s].profile_count, calls, entries);
+            for (auto& instr : copy.instrs) {
+                instr.profile_count = scale_count(instr.profile_count, calls, entries);
+            }
+            // Returns became branches, which run whenever the block does
+            if (copy.instrs.back().op == OpCode::BR) {
+                copy.instrs.back().profile_count = copy.profile_count;
+            }
+        }
+    }
+
+    // Enter the inlined body
+    Instruction enter;
+    enter.op = OpCode::BR;
+    enter.target_block = block_map[callee.blocks[0].id];
+    enter.profile_count = call.profile_count;
+    fn.blocks[bb].add(enter);
+
+    // After the allocas already there, which keeps them grouped
+    auto& entry = fn.blocks[0].instrs;
+    size_t at = 0;
+    while (at < entry.size() && entry[at].op == OpCode::ALLOCA) ++at;
+    for (auto& alloca : allocas) alloca.profile_count = fn.blocks[0].profile_count;
+    entry.insert(entry.begin() + static_cast<long>(at),
+                 std::make_move_iterator(allocas.begin()),
+                 std::make_move_iterator(allocas.end()));
+
+    // Continue with the rest of the original block
+    BasicBlock& cont = fn.blocks.back();
+    cont.profile_count = fn.blocks[bb].profile_count;
+    if (slot.valid()) {
+        Instruction load;
+        load.op = OpCode::LOAD;
+        load.result = call.result;
+        load.operands = {slot};
+        cont.add(std::move(load));
+    }
+    for (auto& instr : tail) cont.add(std::move(instr));
+
+    if (single_ret.valid()) {
+        pending_[call.result.id] = single_ret;
+    }
+
+    return fn.blocks.size() - first_new;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,291 @@
+/**
+ * @file layout.cpp
+ * @brief Zero Compiler — Basic Block Layout Implementation
+ */
+
+#include "opt/layout.hpp"
+#include "opt/analysis.hpp"
+#include "ir/profile.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+// Static estimates: how often a loop body runs per entry, how likely the
+// unlikely side of each heuristic is, and the relative frequency below
+// which a block counts as cold
+constexpr double LOOP_SCALE = 8.0;
+constexpr double LOOP_EXIT = 1.0 / 8;
+constexpr double CALL_TAKEN = 1.0 / 16;
+constexpr double RETURN_TAKEN = 1.0 / 4;
+constexpr double EQUAL_TAKEN = 1.0 / 4;
+constexpr double COLD_FREQ = 1.0 / 10;
+
+Instruction* terminator(BasicBlock& bb) {
+    size_t t = bb.terminator_index();
+    return t < bb.instrs.size() ? &bb.instrs[t] : nullptr;
+}
+
+bool makes_call(const BasicBlock& bb) {
+    for (const auto& instr : bb.instrs) {
+        if (instr.op == OpCode::CALL) return true;
+    }
+    return false;
+}
+
+bool returns(const BasicBlock& bb) {
+    size_t t = bb.terminator_index();
+    return t < bb.instrs.size() && bb.instrs[t].op == OpCode::RET;
+}
+
+/**
+ * Probability that the cond_br ending block `b` takes its true edge.
+ */
+double true_probability(const Function& fn, const CFG& cfg, const LoopInfo& loops,
+                        size_t b, const Instruction& term) {
+    size_t t = cfg.index_of.at(term.target_block);
+    size_t e = cfg.index_of.at(term.else_block);
+
+    // Loop exits
+    if (Loop* loop = loops.loop_for(b)) {
+        bool t_in = loop->contains(t);
+        bool e_in = loop->contains(e);
+        if (t_in != e_in) return t_in ? 1 - LOOP_EXIT : LOOP_EXIT;
+    }
+
+    // The rest only judge blocks this branch alone leads to; a join is
+    // reached either way
+    bool t_own = cfg.preds[t].size() == 1;
+    bool e_own = cfg.preds[e].size() == 1;
+
+    bool t_call = t_own && makes_call(fn.blocks[t]);
+    bool e_call = e_own && makes_call(fn.blocks[e]);
+    if (t_call != e_call) return t_call ? CALL_TAKEN : 1 - CALL_TAKEN;
+
+    bool t_ret = t_own && returns(fn.blocks[t]);
+    bool e_ret = e_own && returns(fn.blocks[e]);
+    if (t_ret != e_ret) return t_ret ? RETURN_TAKEN : 1 - RETURN_TAKEN;
+
+    for (const auto& instr : fn.blocks[b].instrs) {
+        if (instr.result.valid() && instr.result == term.operands[0]) {
+            if (instr.op == OpCode::CMP_EQ) return EQUAL_TAKEN;
+            if (instr.op == OpCode::CMP_NE) return 1 - EQUAL_TAKEN;
+            break;
+        }
+    }
+    return 0.5;
+}
+
+struct Edge {
+    size_t from;
+    size_t to;
+    double weight;
+};
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool BlockLayout::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool BlockLayout::run(Function& fn) {
+    const size_t n = fn.blocks.size();
+    if (n < 2) return false;
+
+    // Moving blocks changes what falls through where, so spell fall-through
+    // out as br first; a function that runs off its last block cannot be
+    // reordered
+    if (!terminator(fn.blocks.back())) return false;
+    size_t spelled_out = 0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        BasicBlock& bb = fn.blocks[i];
+        size_t t = bb.terminator_index();
+        if (t < bb.instrs.size()) {
+            bb.instrs.resize(t + 1);
+        } else {
+            Instruction br;
+            br.op = OpCode::BR;
+            br.target_block = fn.blocks[i + 1].id;
+            br.profile_count = bb.profile_count;
+            bb.add(br);
+            ++spelled_out;
+        }
+    }
+
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    LoopInfo loops(cfg, dom);
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Edge weights and cold blocks
+    // ─────────────────────────────────────────────────────────────────────
+    std::vector<Edge> edges;
+    std::vector<bool> cold(n, false);
+
+    if (fn.has_profile && fn.blocks[0].profile_count > 0) {
+        for (size_t b = 0; b < n; ++b) {
+            cold[b] = fn.blocks[b].profile_count == 0;
+            for (size_t s : cfg.succs[b]) {
+                uint64_t count = edge_count(fn.blocks[b], fn.blocks[s].id);
+                edges.push_back({b, s, static_cast<double>(count)});
+            }
+        }
+    } else {
+        // Relative frequencies, entry = 1: forward edges in reverse
+        // postorder, scaled up at each loop header
+        std::vector<double> freq(n, 0.0);
+        std::vector<std::unordered_map<size_t, double>> prob(n);
+        for (size_t b : cfg.rpo) {
+            const Instruction* term = terminator(fn.blocks[b]);
+            if (term && term->op == OpCode::COND_BR && cfg.succs[b].size() == 2) {
+                double p = true_probability(fn, cfg, loops, b, *term);
+                prob[b][cfg.index_of.at(term->target_block)] = p;
+                prob[b][cfg.index_of.at(term->else_block)] = 1 - p;
+            } else {
+                for (size_t s : cfg.succs[b]) prob[b][s] = 1.0;
+            }
+        }
+
+        freq[0] = 1.0;
+        for (size_t b : cfg.rpo) {
+            if (b == 0) continue;
+            double f = 0.0;
+            for (size_t p : cfg.preds[b]) {
+                if (cfg.reachable(p) && !dom.dominates(b, p)) f += freq[p] * prob[p][b];
+            }
+            Loop* loop = loops.loop_for(b);
+            if (loop && loop->header == b) f *= LOOP_SCALE;
+            freq[b] = f;
+        }
+
+        for (size_t b = 0; b < n; ++b) {
+            cold[b] = !cfg.reachable(b) || freq[b] < COLD_FREQ;
+            for (size_t s : cfg.succs[b]) {
+                edges.push_back({b, s, cfg.reachable(b) ? freq[b] * prob[b][s] : 0.0});
+            }
+        }
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Chains: join tail to head along the heaviest edges first
+    // ─────────────────────────────────────────────────────────────────────
+    std::stable_sort(edges.begin(), edges.end(),
+                     [](const Edge& a, const Edge& b) { return a.weight > b.weight; });
+
+    std::vector<std::vector<size_t>> chains(n);
+    std::vector<size_t> chain_of(n);
+    for (size_t b = 0; b < n; ++b) {
+        chains[b] = {b};
+        chain_of[b] = b;
+    }
+
+    for (const Edge& e : edges) {
+        // Back edges would put a loop header below its body
+        if (e.to == 0 || dom.dominates(e.to, e.from)) continue;
+        if (cold[e.from] != cold[e.to]) continue;
+        size_t ca = chain_of[e.from];
+        size_t cb = chain_of[e.to];
+        if (ca == cb || chains[ca].back() != e.from || chains[cb].front() != e.to) continue;
+
+        for (size_t b : chains[cb]) chain_of[b] = ca;
+        chains[ca].insert(chains[ca].end(), chains[cb].begin(), chains[cb].end());
+        chains[cb].clear();
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Chain order: entry first, then whatever the placed blocks branch to
+    // most, cold chains last in their original order
+    // ─────────────────────────────────────────────────────────────────────
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<bool> placed_chain(n, false);
+    auto place = [&](size_t c) {
+        placed_chain[c] = true;
+        order.insert(order.end(), chains[c].begin(), chains[c].end());
+    };
+    place(chain_of[0]);
+
+    while (true) {
+        std::vector<double> pull(n, 0.0);
+        for (const Edge& e : edges) {
+            size_t c = chain_of[e.to];
+            if (placed_chain[chain_of[e.from]] && !placed_chain[c]) pull[c] += e.weight;
+        }
+
+        long best = -1;
+        for (size_t c = 0; c < n; ++c) {
+            if (chains[c].empty() || placed_chain[c] || cold[chains[c].front()]) continue;
+            if (best < 0 || pull[c] > pull[best]) best = static_cast<long>(c);
+        }
+        if (best < 0) break;
+        place(static_cast<size_t>(best));
+    }
+
+    for (size_t c = 0; c < n; ++c) {
+        if (chains[c].empty() || placed_chain[c]) continue;
+        cold_blocks_ += chains[c].size();
+        place(c);
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Apply: renumber, then let br to the next block fall through
+    // ─────────────────────────────────────────────────────────────────────
+    bool changed = false;
+    std::unordered_map<uint32_t, uint32_t> new_id;
+    for (size_t i = 0; i < n; ++i) {
+        new_id[fn.blocks[order[i]].id] = static_cast<uint32_t>(i);
+        if (order[i] != i) {
+            ++blocks_moved_;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        fn.blocks.retain(order);
+        for (auto& bb : fn.blocks) {
+            bb.id = new_id.at(bb.id);
+            Instruction* term = terminator(bb);
+            if (term && (term->op == OpCode::BR || term->op == OpCode::COND_BR)) {
+                term->target_block = new_id.at(term->target_block);
+            }
+            if (term && term->op == OpCode::COND_BR) {
+                term->else_block = new_id.at(term->else_block);
+            }
+        }
+    }
+
+    size_t dropped = 0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        BasicBlock& bb = fn.blocks[i];
+        if (!bb.instrs.empty() && bb.instrs.back().op == OpCode::BR &&
+            bb.instrs.back().target_block == fn.blocks[i + 1].id) {
+            bb.instrs.pop_back();
+            ++dropped;
+        }
+    }
+    // Fall-through we only spelled out above does not count
+    if (dropped > spelled_out) fall_throughs_ += dropped - spelled_out;
+    return changed || dropped != spelled_out;
+}
+
+} // namespace opt
+} // namespace zero
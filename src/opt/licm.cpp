@@ -0,0 +1,231 @@
+/**
+ * @file licm.cpp
+ * @brief Zero Compiler — Loop-Invariant Code Motion Implementation
+ */
+
+#include "opt/licm.hpp"
+#include "ir/profile.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * Hoisting executes an instruction even when the loop body would not have
+ * run it. Every pure opcode is safe to run early except integer division,
+ * which a native backend may trap on; allow it only for a known non-zero
+ * constant divisor.
+ */
+static bool safe_to_speculate(const Instruction& instr,
+                              const std::unordered_map<uint32_t, int64_t>& int_consts) {
+    // A divisor proven non-zero by a guard inside the loop is not safe
+    // ahead of that guard, so div.nz is treated like div
+    if (instr.op != OpCode::DIV && instr.op != OpCode::DIV_NZ) return true;
+    if (instr.result.type.is_float()) return true;
+
+    auto it = int_consts.find(instr.operands[1].id);
+    return it != int_consts.end() && it->second != 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool LoopInvariantCodeMotion::run(Module& mod) {
+    PurityAnalysis purity(mod);
+    purity_ = &purity;
+
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+
+    purity_ = nullptr;
+    return changed;
+}
+
+bool LoopInvariantCodeMotion::run(Function& fn) {
+    if (fn.blocks.empty()) return false;
+
+    bool changed = insert_preheaders(fn);
+
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    LoopInfo loops(cfg, dom);
+
+    // Innermost first: code hoisted into an inner preheader lands inside
+    // the parent loop and gets another chance to move outward.
+    for (Loop* loop : loops.postorder()) {
+        changed |= hoist(fn, cfg, *loop);
+    }
+
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Preheader insertion
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool LoopInvariantCodeMotion::insert_preheaders(Function& fn) {
+    bool changed = false;
+
+    while (true) {
+        CFG cfg = CFG::build(fn);
+        DominatorTree dom(cfg);
+        LoopInfo loops(cfg, dom);
+
+        const Loop* missing = nullptr;
+        for (Loop* loop : loops.postorder()) {
+            // A loop headed by the entry block has no outside edge to split
+            if (loop->header == 0) continue;
+            if (loop->preheader(cfg) < 0) {
+                missing = loop;
+                break;
+            }
+        }
+        if (!missing) break;
+
+        uint32_t header_id = fn.blocks[missing->header].id;
+        std::string label = fn.blocks[missing->header].label + ".preheader";
+        uint32_t ph_id = fn.new_block(label).id;
+
+        uint64_t entries = 0;
+        for (size_t p : cfg.preds[missing->header]) {
+            if (!missing->contains(p)) entries += edge_count(fn.blocks[p], header_id);
+        }
+        fn.blocks.back().profile_count = entries;
+
+        // Redirect every edge entering the loop from outside
+        for (size_t p : cfg.preds[missing->header]) {
+            if (missing->contains(p)) continue;
+
+            BasicBlock& pred = fn.blocks[p];
+            size_t t = pred.terminator_index();
+            if (t == pred.instrs.size()) {
+                Instruction br;
+                br.op = OpCode::BR;
+                br.target_block = ph_id;
+                br.profile_count = pred.profile_count;
+                pred.add(br);
+                continue;
+            }
+
+            Instruction& term = pred.instrs[t];
+            if (term.target_block == header_id) term.target_block = ph_id;
+            if (term.op == OpCode::COND_BR && term.else_block == header_id) {
+                term.else_block = ph_id;
+            }
+        }
+
+        Instruction br;
+        br.op = OpCode::BR;
+        br.target_block = header_id;
+        br.profile_count = entries;
+        fn.blocks.back().add(br);
+
+        ++preheaders_created_;
+        changed = true;
+    }
+
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Hoisting
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool LoopInvariantCodeMotion::hoist(Function& fn, const CFG& cfg, const Loop& loop) {
+    long ph = loop.preheader(cfg);
+    if (ph < 0) return false;
+
+    // Values produced inside the loop; anything else is invariant
+    std::unordered_set<uint32_t> defined_in_loop;
+    for (size_t bb : loop.blocks) {
+        for (const auto& instr : fn.blocks[bb].instrs) {
+            if (instr.result.valid()) defined_in_loop.insert(instr.result.id);
+        }
+    }
+
+    std::unordered_map<uint32_t, int64_t> int_consts;
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::CONST_INT) int_consts[instr.result.id] = instr.imm_int;
+        }
+    }
+
+    // A read-only call may move only if no call in the loop can write
+    // the state it reads
+    bool loop_writes = false;
+    for (size_t bb : loop.blocks) {
+        for (const auto& instr : fn.blocks[bb].instrs) {
+            if (instr.op == OpCode::CALL &&
+                (!purity_ || purity_->effect(instr.callee) == Effect::EFFECTFUL)) {
+                loop_writes = true;
+            }
+        }
+    }
+
+    auto movable = [&](const Instruction& instr) {
+        if (is_pure(instr.op)) return safe_to_speculate(instr, int_consts);
+        if (instr.op != OpCode::CALL || !purity_ || !instr.result.valid()) return false;
+        if (!purity_->is_removable_call(instr)) return false;
+        return purity_->effect(instr.callee) == Effect::PURE || !loop_writes;
+    };
+
+    // Visit in RPO so definitions are seen before their uses
+    std::vector<size_t> order = loop.blocks;
+    std::sort(order.begin(), order.end(), [&cfg](size_t a, size_t b) {
+        return cfg.rpo_number(a) < cfg.rpo_number(b);
+    });
+
+    std::vector<Instruction> hoisted;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (size_t bb : order) {
+            auto& instrs = fn.blocks[bb].instrs;
+            size_t end = fn.blocks[bb].terminator_index();
+
+            for (size_t i = 0; i < end;) {
+                const Instruction& instr = instrs[i];
+                bool invariant = movable(instr) &&
+                    std::none_of(instr.operands.begin(), instr.operands.end(),
+                                 [&](const Value& v) { return defined_in_loop.count(v.id) > 0; });
+
+                if (!invariant) {
+                    ++i;
+                    continue;
+                }
+
+                defined_in_loop.erase(instr.result.id);
+                hoisted.push_back(std::move(instrs[i]));
+                instrs.erase(instrs.begin() + static_cast<long>(i));
+                --end;
+                progress = true;
+            }
+        }
+    }
+
+    if (hoisted.empty()) return false;
+
+    auto& ph_instrs = fn.blocks[static_cast<size_t>(ph)].instrs;
+    size_t at = fn.blocks[static_cast<size_t>(ph)].terminator_index();
+    ph_instrs.insert(ph_instrs.begin() + static_cast<long>(at),
+                     std::make_move_iterator(hoisted.begin()),
+                     std::make_move_iterator(hoisted.end()));
+
+    hoisted_ += hoisted.size();
+    return true;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,157 @@
+/**
+ * @file partial_eval.cpp
+ * @brief Zero Compiler — Compile-Time Evaluation of Calls Implementation
+ */
+
+#include "opt/partial_eval.hpp"
+#include "opt/purity.hpp"
+#include "backend/interpreter.hpp"
+
+#include <cstring>
+#include <exception>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+using backend::RuntimeValue;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+bool is_constant(OpCode op) {
+    return op == OpCode::CONST_INT || op == OpCode::CONST_FLOAT || op == OpCode::CONST_STR;
+}
+
+RuntimeValue to_runtime(const Instruction& c) {
+    switch (c.op) {
+        case OpCode::CONST_INT: return RuntimeValue(c.imm_int);
+        case OpCode::CONST_FLOAT: return RuntimeValue(c.imm_float);
+        default: return RuntimeValue(c.imm_str);
+    }
+}
+
+/**
+ * Cache key; floats by bit pattern so -0.0 and NaN payloads stay distinct.
+ */
+std::string encode_call(const std::string& callee, const std::vector<const Instruction*>& args) {
+    std::string key = callee + "(";
+    for (const Instruction* c : args) {
+        switch (c->op) {
+            case OpCode::CONST_INT:
+                key += "i" + std::to_string(c->imm_int);
+                break;
+            case OpCode::CONST_FLOAT: {
+                uint64_t bits = 0;
+                std::memcpy(&bits, &c->imm_float, sizeof(bits));
+                key += "f" + std::to_string(bits);
+                break;
+            }
+            default:
+                key += "s" + std::to_string(c->imm_str.size()) + ":" + c->imm_str.str();
+                break;
+        }
+        key += ",";
+    }
+    return key + ")";
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool PartialEvaluator::run(Module& mod) {
+    PurityAnalysis purity(mod);
+    cache_.clear();
+
+    backend::Interpreter sandbox;
+    sandbox.set_instruction_budget(opts_.instruction_budget);
+    sandbox.set_max_call_depth(opts_.max_call_depth);
+
+    bool changed = false;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        for (auto& fn : mod.functions) {
+            std::unordered_map<uint32_t, const Instruction*> consts;
+            for (const auto& bb : fn.blocks) {
+                for (const auto& instr : bb.instrs) {
+                    if (is_constant(instr.op)) consts[instr.result.id] = &instr;
+                }
+            }
+
+            // Folded calls become constants in place, so `consts` pointers
+            // into other instructions stay valid
+            for (auto& bb : fn.blocks) {
+                for (auto& instr : bb.instrs) {
+                    if (instr.op != OpCode::CALL || !instr.result.valid()) continue;
+                    if (!mod.get_function(instr.callee)) continue;
+                    if (purity.effect(instr.callee) != Effect::PURE) continue;
+                    if (purity.may_throw(instr.callee)) continue;
+
+                    std::vector<const Instruction*> args;
+                    for (const auto& op : instr.operands) {
+                        auto it = consts.find(op.id);
+                        if (it == consts.end()) break;
+                        args.push_back(it->second);
+                    }
+                    if (args.size() != instr.operands.size()) continue;
+
+                    std::string key = encode_call(instr.callee, args);
+                    auto hit = cache_.find(key);
+                    if (hit != cache_.end()) {
+                        ++cache_hits_;
+                    } else {
+                        std::vector<RuntimeValue> values;
+                        for (const Instruction* c : args) values.push_back(to_runtime(*c));
+
+                        Instruction folded;
+                        folded.op = OpCode::NOP;
+                        try {
+                            RuntimeValue rv = sandbox.call(mod, instr.callee, std::move(values));
+                            if (rv.is_int()) {
+                                folded.op = OpCode::CONST_INT;
+                                folded.imm_int = rv.as_int();
+                            } else if (rv.is_float()) {
+                                folded.op = OpCode::CONST_FLOAT;
+                                folded.imm_float = rv.as_float();
+                            }
+                            ++evaluated_;
+                        } catch (const backend::ExecutionLimitExceeded&) {
+                            ++gave_up_;
+                        } catch (const std::exception&) {
+                            // Left for run time, where the call may never happen
+                            ++gave_up_;
+                        }
+                        hit = cache_.emplace(std::move(key), folded).first;
+                    }
+
+                    // Only fold a value of the type the call site expects
+                    const Instruction& folded = hit->second;
+                    bool fits = (folded.op == OpCode::CONST_INT && instr.result.type.is_int()) ||
+                                (folded.op == OpCode::CONST_FLOAT && instr.result.type.is_float());
+                    if (!fits) continue;
+
+                    instr.op = folded.op;
+                    instr.imm_int = folded.imm_int;
+                    instr.imm_float = folded.imm_float;
+                    instr.operands.clear();
+                    instr.callee.clear();
+                    consts[instr.result.id] = &instr;
+                    changed = progress = true;
+                }
+            }
+        }
+    }
+
+    return changed;
+}
+
+} // namespace opt
+} // namespace zero
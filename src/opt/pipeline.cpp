@@ -0,0 +1,103 @@
+/**
+ * @file pipeline.cpp
+ * @brief Zero Compiler — Optimization Pipeline Implementation
+ */
+
+#include "opt/pipeline.hpp"
+#include "opt/dce.hpp"
+#include "opt/dead_functions.hpp"
+#include "opt/fusion.hpp"
+#include "opt/induction.hpp"
+#include "opt/inliner.hpp"
+#include "opt/layout.hpp"
+#include "opt/licm.hpp"
+#include "opt/partial_eval.hpp"
+#include "opt/range.hpp"
+#include "opt/simplify.hpp"
+#include "opt/simplify_cfg.hpp"
+#include "opt/unroll.hpp"
+
+namespace zero {
+namespace opt {
+
+void optimize(ir::Module& mod, const PipelineOptions& opts) {
+    // Before inlining, while the calls are still whole
+    if (opts.partial_eval) {
+        PartialEvaluator evaluator;
+        evaluator.run(mod);
+    }
+    
+    if (opts.inline_functions) {
+        Inliner inliner;
+        inliner.run(mod);
+    }
+    
+    if (opts.simplify) {
+        SimplifyOptions simplify_opts;
+        simplify_opts.expand_division = opts.expand_division;
+        AlgebraicSimplifier simplifier(simplify_opts);
+        simplifier.run(mod);
+    }
+    
+    // Merge the inlined and lowered block chains before the loop passes
+    // look at them, and again at the end for what those passes leave
+    if (opts.simplify_cfg) {
+        CFGSimplifier cfg_simplifier;
+        cfg_simplifier.run(mod);
+    }
+    
+    if (opts.licm) {
+        LoopInvariantCodeMotion licm;
+        licm.run(mod);
+    }
+    
+    if (opts.strength_reduce) {
+        StrengthReduction sr;
+        sr.run(mod);
+    }
+    
+    if (opts.unroll_factor > 1) {
+        UnrollOptions unroll_opts;
+        unroll_opts.factor = opts.unroll_factor;
+        LoopUnroller unroller(unroll_opts);
+        unroller.run(mod);
+    }
+    
+    // Last rewrite before cleanup: div.nz must not move above the branch
+    // that proved its divisor non-zero
+    if (opts.eliminate_guards) {
+        GuardElimination guards;
+        guards.run(mod);
+    }
+    
+    // After inlining and block merging have put whole chains side by side
+    if (opts.fuse_tensors) {
+        TensorFusion fusion;
+        fusion.run(mod);
+    }
+    
+    if (opts.dce) {
+        DeadCodeElimination dce;
+        dce.run(mod);
+    }
+    
+    if (opts.simplify_cfg) {
+        CFGSimplifier cfg_simplifier;
+        cfg_simplifier.run(mod);
+    }
+    
+    // Last block-level pass: it leaves fall-through implicit
+    if (opts.layout_blocks) {
+        BlockLayout layout;
+        layout.run(mod);
+    }
+    
+    // Inlining and DCE leave functions nobody calls any more
+    if (opts.remove_dead_functions) {
+        DeadFunctionElimination dfe;
+        dfe.run(mod);
+    }
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,117 @@
+/**
+ * @file purity.cpp
+ * @brief Zero Compiler — Interprocedural Side-Effect Analysis Implementation
+ */
+
+#include "opt/purity.hpp"
+#include "opt/analysis.hpp"
+#include "opt/callgraph.hpp"
+
+#include <algorithm>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+/**
+ * The instructions of `fn` that can fail by themselves; the same rule
+ * LICM applies before running a division early.
+ */
+static bool has_throwing_instruction(const Function& fn) {
+    std::unordered_map<uint32_t, int64_t> int_consts;
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::CONST_INT) int_consts[instr.result.id] = instr.imm_int;
+        }
+    }
+
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (is_tensor_op(instr.op)) return true;
+            if (instr.op != OpCode::DIV || instr.result.type.is_float()) continue;
+            auto it = int_consts.find(instr.operands[1].id);
+            if (it == int_consts.end() || it->second == 0) return true;
+        }
+    }
+    return false;
+}
+
+PurityAnalysis::PurityAnalysis(const Module& mod,
+                               const std::unordered_map<std::string, Effect>& externals)
+    : externals_(externals) {
+    // Built-ins registered by the driver
+    externals_.emplace("print", Effect::EFFECTFUL);
+    externals_.emplace("log", Effect::EFFECTFUL);
+
+    CallGraph cg(mod);
+
+    // Callees first: by the time an SCC is visited, everything it calls
+    // outside itself is final. Members of one SCC share a result.
+    for (const auto& scc : cg.sccs()) {
+        Effect effect = Effect::PURE;
+        bool returns = scc.size() == 1 && !cg.is_recursive(scc[0]);
+        bool throws = false;
+
+        for (size_t fi : scc) {
+            const Function& fn = mod.functions[fi];
+            throws = throws || has_throwing_instruction(fn);
+
+            if (returns && !fn.blocks.empty()) {
+                CFG cfg = CFG::build(fn);
+                DominatorTree dom(cfg);
+                LoopInfo loops(cfg, dom);
+                if (!loops.empty()) returns = false;
+            }
+
+            for (const auto& bb : fn.blocks) {
+                for (const auto& instr : bb.instrs) {
+                    if (instr.op != OpCode::CALL) continue;
+
+                    bool in_scc = std::any_of(scc.begin(), scc.end(), [&](size_t m) {
+                        return mod.functions[m].name == instr.callee;
+                    });
+                    if (in_scc) continue;
+
+                    effect = std::max(effect, this->effect(instr.callee));
+                    returns = returns && will_return(instr.callee);
+                    throws = throws || may_throw(instr.callee);
+                }
+            }
+        }
+
+        for (size_t fi : scc) {
+            effects_[mod.functions[fi].name] = effect;
+            returns_[mod.functions[fi].name] = returns;
+            throws_[mod.functions[fi].name] = throws;
+        }
+    }
+}
+
+Effect PurityAnalysis::effect(const std::string& name) const {
+    auto it = effects_.find(name);
+    if (it != effects_.end()) return it->second;
+
+    auto ext = externals_.find(name);
+    return ext != externals_.end() ? ext->second : Effect::EFFECTFUL;
+}
+
+bool PurityAnalysis::will_return(const std::string& name) const {
+    auto it = returns_.find(name);
+    return it == returns_.end() || it->second;
+}
+
+bool PurityAnalysis::may_throw(const std::string& name) const {
+    auto it = throws_.find(name);
+    return it != throws_.end() && it->second;
+}
+
+bool PurityAnalysis::is_removable_call(const Instruction& instr) const {
+    return instr.op == OpCode::CALL &&
+           effect(instr.callee) != Effect::EFFECTFUL &&
+           will_return(instr.callee) &&
+           !may_throw(instr.callee);
+}
+
+} // namespace opt
+} // namespace zero
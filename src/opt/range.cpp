@@ -0,0 +1,549 @@
+/**
+ * @file range.cpp
+ * @brief Zero Compiler — Value Range Analysis and Guard Elimination Implementation
+ */
+
+#include "opt/range.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Interval arithmetic
+// ─────────────────────────────────────────────────────────────────────────────
+
+Range join(const Range& a, const Range& b) {
+    if (a.is_empty()) return b;
+    if (b.is_empty()) return a;
+    return {std::min(a.lo, b.lo), std::max(a.hi, b.hi)};
+}
+
+Range meet(const Range& a, const Range& b) {
+    return {std::max(a.lo, b.lo), std::min(a.hi, b.hi)};
+}
+
+namespace {
+
+constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+
+// A bound that moves more often than this jumps to infinity
+constexpr unsigned kWidenAfter = 3;
+
+bool add_ok(int64_t a, int64_t b, int64_t& out) {
+    if ((b > 0 && a > kMax - b) || (b < 0 && a < kMin - b)) return false;
+    out = a + b;
+    return true;
+}
+
+bool sub_ok(int64_t a, int64_t b, int64_t& out) {
+    if ((b < 0 && a > kMax + b) || (b > 0 && a < kMin + b)) return false;
+    out = a - b;
+    return true;
+}
+
+bool mul_ok(int64_t a, int64_t b, int64_t& out) {
+    // Fits iff the high half is the sign extension of the low half
+    int64_t low = static_cast<int64_t>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+    if (mul_high(a, b) != (low < 0 ? -1 : 0)) return false;
+    out = low;
+    return true;
+}
+
+Range add_range(const Range& a, const Range& b) {
+    Range r;
+    if (!add_ok(a.lo, b.lo, r.lo) || !add_ok(a.hi, b.hi, r.hi)) return Range::full();
+    return r;
+}
+
+Range sub_range(const Range& a, const Range& b) {
+    Range r;
+    if (!sub_ok(a.lo, b.hi, r.lo) || !sub_ok(a.hi, b.lo, r.hi)) return Range::full();
+    return r;
+}
+
+Range mul_range(const Range& a, const Range& b) {
+    int64_t p[4];
+    if (!mul_ok(a.lo, b.lo, p[0]) || !mul_ok(a.lo, b.hi, p[1]) ||
+        !mul_ok(a.hi, b.lo, p[2]) || !mul_ok(a.hi, b.hi, p[3])) {
+        return Range::full();
+    }
+    return {*std::min_element(p, p + 4), *std::max_element(p, p + 4)};
+}
+
+/**
+ * Truncating division, with x / 0 == 0 as in the interpreter. For a
+ * divisor of one sign the quotient is monotone in both operands, so the
+ * extremes sit at the corners of each sign's piece.
+ */
+Range div_range(const Range& a, const Range& b) {
+    if (a.contains(kMin) && b.contains(-1)) return Range::full();
+
+    Range r = b.contains(0) ? Range::constant(0) : Range::empty();
+    auto corners = [&](int64_t d_lo, int64_t d_hi) {
+        int64_t q[4] = {a.lo / d_lo, a.lo / d_hi, a.hi / d_lo, a.hi / d_hi};
+        r = join(r, {*std::min_element(q, q + 4), *std::max_element(q, q + 4)});
+    };
+    if (b.lo <= -1) corners(b.lo, std::min<int64_t>(b.hi, -1));
+    if (b.hi >= 1) corners(std::max<int64_t>(b.lo, 1), b.hi);
+    return r;
+}
+
+/**
+ * Result of a comparison: 1 or 0 when the intervals decide it.
+ */
+Range compare_range(OpCode op, const Range& a, const Range& b) {
+    bool always = false;
+    bool never = false;
+    switch (op) {
+        case OpCode::CMP_LT: always = a.hi < b.lo; never = a.lo >= b.hi; break;
+        case OpCode::CMP_LE: always = a.hi <= b.lo; never = a.lo > b.hi; break;
+        case OpCode::CMP_GT: always = a.lo > b.hi; never = a.hi <= b.lo; break;
+        case OpCode::CMP_GE: always = a.lo >= b.hi; never = a.hi < b.lo; break;
+        case OpCode::CMP_EQ:
+            always = a.is_constant() && a == b;
+            never = meet(a, b).is_empty();
+            break;
+        case OpCode::CMP_NE:
+            always = meet(a, b).is_empty();
+            never = a.is_constant() && a == b;
+            break;
+        default: break;
+    }
+    if (always) return Range::constant(1);
+    if (never) return Range::constant(0);
+    return {0, 1};
+}
+
+/**
+ * All ones up to the highest set bit of v (v >= 0).
+ */
+int64_t smear_bits(int64_t v) {
+    uint64_t x = static_cast<uint64_t>(v);
+    for (unsigned s = 1; s < 64; s <<= 1) x |= x >> s;
+    return static_cast<int64_t>(x);
+}
+
+/**
+ * Interval of `instr`'s result given its operands' intervals. Arithmetic
+ * that may overflow int64 wraps at run time, so it yields the full range.
+ */
+template <typename OperandRange>
+Range evaluate(const Instruction& instr, OperandRange&& operand) {
+    if (instr.op == OpCode::CONST_INT) return Range::constant(instr.imm_int);
+    if (!is_compare(instr.op) && !instr.result.type.is_int()) return Range::full();
+
+    switch (instr.op) {
+        case OpCode::ADD: case OpCode::SUB: case OpCode::MUL:
+        case OpCode::DIV: case OpCode::DIV_NZ:
+        case OpCode::SHL: case OpCode::SHR: case OpCode::AND: case OpCode::OR:
+        case OpCode::CMP_EQ: case OpCode::CMP_NE: case OpCode::CMP_LT:
+        case OpCode::CMP_LE: case OpCode::CMP_GT: case OpCode::CMP_GE: {
+            Range a = operand(instr.operands[0]);
+            Range b = operand(instr.operands[1]);
+            if (a.is_empty() || b.is_empty()) return Range::empty();
+
+            switch (instr.op) {
+                case OpCode::ADD: return add_range(a, b);
+                case OpCode::SUB: return sub_range(a, b);
+                case OpCode::MUL: return mul_range(a, b);
+                case OpCode::DIV:
+                case OpCode::DIV_NZ: return div_range(a, b);
+                case OpCode::SHL: {
+                    if (!b.is_constant() || (b.lo & 63) >= 63) return Range::full();
+                    return mul_range(a, Range::constant(int64_t(1) << (b.lo & 63)));
+                }
+                case OpCode::SHR: {
+                    if (b.is_constant()) return {a.lo >> (b.lo & 63), a.hi >> (b.lo & 63)};
+                    if (a.lo >= 0) return {0, a.hi};
+                    return Range::full();
+                }
+                case OpCode::AND: {
+                    if (a.lo >= 0 && b.lo >= 0) return {0, std::min(a.hi, b.hi)};
+                    if (a.lo >= 0) return {0, a.hi};
+                    if (b.lo >= 0) return {0, b.hi};
+                    return Range::full();
+                }
+                case OpCode::OR: {
+                    if (a.lo < 0 || b.lo < 0) return Range::full();
+                    return {std::max(a.lo, b.lo), smear_bits(std::max(a.hi, b.hi))};
+                }
+                default:
+                    return compare_range(instr.op, a, b);
+            }
+        }
+
+        case OpCode::NEG: {
+            Range a = operand(instr.operands[0]);
+            if (a.is_empty()) return a;
+            if (a.lo == kMin) return Range::full();
+            return {-a.hi, -a.lo};
+        }
+
+        default:
+            return Range::full();
+    }
+}
+
+bool is_arithmetic(OpCode op) {
+    return is_pure(op) && op != OpCode::CONST_INT && op != OpCode::CONST_FLOAT &&
+           op != OpCode::CONST_STR;
+}
+
+/**
+ * Narrow `r`, the range of a value known to satisfy `value <pred> other`.
+ */
+Range constrain(Range r, OpCode pred, const Range& other, bool& nonzero) {
+    if (other.is_empty()) return r;
+    switch (pred) {
+        case OpCode::CMP_LT:
+            if (other.hi == kMin) return Range::empty();
+            r.hi = std::min(r.hi, other.hi - 1);
+            break;
+        case OpCode::CMP_LE:
+            r.hi = std::min(r.hi, other.hi);
+            break;
+        case OpCode::CMP_GT:
+            if (other.lo == kMax) return Range::empty();
+            r.lo = std::max(r.lo, other.lo + 1);
+            break;
+        case OpCode::CMP_GE:
+            r.lo = std::max(r.lo, other.lo);
+            break;
+        case OpCode::CMP_EQ:
+            r = meet(r, other);
+            break;
+        case OpCode::CMP_NE:
+            if (!other.is_constant()) break;
+            if (other.lo == 0) nonzero = true;
+            if (r.lo == other.lo && r.lo != kMax) ++r.lo;
+            else if (r.hi == other.lo && r.hi != kMin) --r.hi;
+            break;
+        default:
+            break;
+    }
+    return r;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Range analysis
+// ─────────────────────────────────────────────────────────────────────────────
+
+RangeAnalysis::RangeAnalysis(const Function& fn, const CFG& cfg, const DominatorTree& dom)
+    : fn_(fn), cfg_(cfg), dom_(dom) {
+    solve();
+}
+
+Range RangeAnalysis::range(const Value& v) const {
+    auto it = ranges_.find(v.id);
+    return it != ranges_.end() ? it->second : Range::full();
+}
+
+void RangeAnalysis::solve() {
+    std::unordered_set<uint32_t> allocas;
+    for (size_t b = 0; b < fn_.blocks.size(); ++b) {
+        const auto& instrs = fn_.blocks[b].instrs;
+        for (size_t i = 0; i < instrs.size(); ++i) {
+            const Instruction& instr = instrs[i];
+            if (!instr.result.valid()) continue;
+            defs_[instr.result.id] = {&instr, b, i};
+            if (instr.op == OpCode::ALLOCA) allocas.insert(instr.result.id);
+        }
+    }
+
+    // A slot whose address goes anywhere but a load or store is not ours
+    // to track
+    std::unordered_map<uint32_t, std::vector<std::pair<size_t, size_t>>> stores, loads;
+    for (size_t b = 0; b < fn_.blocks.size(); ++b) {
+        const auto& instrs = fn_.blocks[b].instrs;
+        for (size_t i = 0; i < instrs.size(); ++i) {
+            const Instruction& instr = instrs[i];
+            for (size_t k = 0; k < instr.operands.size(); ++k) {
+                uint32_t id = instr.operands[k].id;
+                if (!allocas.count(id)) continue;
+                if (k == 0 && instr.op == OpCode::STORE) {
+                    stores[id].push_back({b, i});
+                } else if (k == 0 && instr.op == OpCode::LOAD) {
+                    loads[id].push_back({b, i});
+                } else {
+                    escaped_.insert(id);
+                }
+            }
+        }
+    }
+
+    // Slots start at 0; leave that out when no load can run before a store
+    for (uint32_t slot : allocas) {
+        if (escaped_.count(slot)) {
+            slots_[slot] = Range::full();
+            continue;
+        }
+        bool covered = true;
+        for (const auto& ld : loads[slot]) {
+            bool dominated = std::any_of(stores[slot].begin(), stores[slot].end(),
+                [&](const std::pair<size_t, size_t>& st) {
+                    if (st.first == ld.first) return st.second < ld.second;
+                    return cfg_.reachable(ld.first) && dom_.dominates(st.first, ld.first);
+                });
+            if (!dominated) covered = false;
+        }
+        slots_[slot] = covered ? Range::empty() : Range::constant(0);
+    }
+
+    for (const auto& [id, def] : defs_) {
+        ranges_[id] = Range::empty();
+    }
+
+    // Without phi, every cycle of values runs through a slot, so only
+    // slots need widening to make loops converge
+    std::unordered_map<uint32_t, unsigned> slot_updates;
+    auto widen = [](Range& cur, Range next, unsigned& count) {
+        next = join(cur, next);
+        if (next == cur) return false;
+        if (++count > kWidenAfter) {
+            if (next.lo < cur.lo) next.lo = kMin;
+            if (next.hi > cur.hi) next.hi = kMax;
+        }
+        cur = next;
+        return true;
+    };
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (size_t b : cfg_.rpo) {
+            const BasicBlock& bb = fn_.blocks[b];
+            size_t end = bb.terminator_index();
+            for (size_t i = 0; i < end; ++i) {
+                const Instruction& instr = bb.instrs[i];
+
+                if (instr.op == OpCode::STORE) {
+                    uint32_t slot = instr.operands[0].id;
+                    if (!slots_.count(slot) || escaped_.count(slot)) continue;
+                    progress |= widen(slots_[slot], range(instr.operands[1]), slot_updates[slot]);
+                    continue;
+                }
+                if (!instr.result.valid()) continue;
+
+                Range next;
+                if (instr.op == OpCode::LOAD) {
+                    auto it = slots_.find(instr.operands[0].id);
+                    next = it != slots_.end() && instr.result.type.is_int() ? it->second
+                                                                            : Range::full();
+                } else {
+                    next = evaluate(instr, [this](const Value& v) { return range(v); });
+                }
+
+                // Narrow by the branches taken to get here, so a loop test
+                // bounds the value stored back by the latch
+                bool nonzero = false;
+                next = narrow(instr.result, b, next, nonzero);
+                Range& cur = ranges_[instr.result.id];
+                if (next != cur) {
+                    cur = next;
+                    progress = true;
+                }
+            }
+        }
+    }
+}
+
+Range RangeAnalysis::range_at(const Value& v, size_t block) const {
+    bool nonzero = false;
+    return refine(v, block, 3, nonzero);
+}
+
+bool RangeAnalysis::is_nonzero(const Value& v, size_t block) const {
+    bool nonzero = false;
+    Range r = refine(v, block, 3, nonzero);
+    return nonzero || !r.contains(0);
+}
+
+bool RangeAnalysis::in_bounds(const Value& index, const Value& length, size_t block) const {
+    Range i = range_at(index, block);
+    if (i.is_empty()) return true;
+    return i.lo >= 0 && i.hi < range_at(length, block).lo;
+}
+
+Range RangeAnalysis::refine(const Value& v, size_t block, unsigned depth, bool& nonzero) const {
+    Range r = range(v);
+
+    // Recompute from operands narrowed where v is defined
+    auto def = defs_.find(v.id);
+    if (depth > 0 && def != defs_.end() && is_arithmetic(def->second.instr->op)) {
+        size_t def_block = def->second.block;
+        r = meet(r, evaluate(*def->second.instr, [&](const Value& op) {
+            bool nz = false;
+            Range o = refine(op, def_block, depth - 1, nz);
+            if (nz && o.lo == 0) o.lo = 1;
+            if (nz && o.hi == 0) o.hi = -1;
+            return o;
+        }));
+    }
+
+    return narrow(v, block, r, nonzero);
+}
+
+Range RangeAnalysis::narrow(const Value& v, size_t block, Range r, bool& nonzero) const {
+    // Every branch edge into a single-predecessor block on the dominator
+    // path was taken to get here. The entry block is also entered from
+    // outside, so a back edge into it proves nothing.
+    size_t x = block;
+    while (true) {
+        if (x != 0 && cfg_.preds[x].size() == 1) {
+            size_t p = cfg_.preds[x][0];
+            const BasicBlock& pb = fn_.blocks[p];
+            size_t t = pb.terminator_index();
+            if (t < pb.instrs.size() && pb.instrs[t].op == OpCode::COND_BR &&
+                pb.instrs[t].target_block != pb.instrs[t].else_block) {
+                const Instruction& term = pb.instrs[t];
+                bool taken = cfg_.index_of.at(term.target_block) == x;
+                const Value& cond = term.operands[0];
+
+                auto cd = defs_.find(cond.id);
+                if (same_value(cond, v, p, x)) {
+                    if (taken) nonzero = true;
+                    else r = meet(r, Range::constant(0));
+                } else if (cd != defs_.end() && is_compare(cd->second.instr->op)) {
+                    const Instruction& cmp = *cd->second.instr;
+                    OpCode pred = taken ? cmp.op : invert_compare(cmp.op);
+                    if (same_value(cmp.operands[0], v, p, x)) {
+                        r = constrain(r, pred, range(cmp.operands[1]), nonzero);
+                    } else if (same_value(cmp.operands[1], v, p, x)) {
+                        r = constrain(r, swap_compare(pred), range(cmp.operands[0]), nonzero);
+                    }
+                }
+            }
+        }
+
+        long up = dom_.idom(x);
+        if (up < 0 || static_cast<size_t>(up) == x) break;
+        x = static_cast<size_t>(up);
+    }
+    return r;
+}
+
+/**
+ * True if `a`, tested at the end of `pred`, holds the same value as `v`
+ * below the edge into `entry`: the same SSA value, or loads of a slot that
+ * nothing stores to between the two loads.
+ */
+bool RangeAnalysis::same_value(const Value& a, const Value& v, size_t pred, size_t entry) const {
+    if (a == v) return true;
+
+    auto da = defs_.find(a.id);
+    auto dv = defs_.find(v.id);
+    if (da == defs_.end() || dv == defs_.end()) return false;
+
+    const Instruction& la = *da->second.instr;
+    const Instruction& lv = *dv->second.instr;
+    if (la.op != OpCode::LOAD || lv.op != OpCode::LOAD) return false;
+    if (la.operands[0] != lv.operands[0] || escaped_.count(la.operands[0].id)) return false;
+    if (da->second.block != pred || !dom_.dominates(entry, dv->second.block)) return false;
+
+    return slot_unchanged(la.operands[0], da->second, pred, entry, dv->second);
+}
+
+bool RangeAnalysis::slot_unchanged(const Value& slot, const DefSite& first, size_t pred,
+                                   size_t entry, const DefSite& second) const {
+    auto stores_in = [&](size_t b, size_t from, size_t to) {
+        const auto& instrs = fn_.blocks[b].instrs;
+        for (size_t i = from; i < to && i < instrs.size(); ++i) {
+            if (instrs[i].op == OpCode::STORE && instrs[i].operands[0] == slot) return true;
+        }
+        return false;
+    };
+
+    // Blocks reachable from `from` without passing back through pred
+    const size_t n = fn_.blocks.size();
+    auto forward = [&](const std::vector<size_t>& from) {
+        std::vector<bool> seen(n, false);
+        seen[pred] = true;
+        std::vector<size_t> work;
+        for (size_t f : from) {
+            if (!seen[f]) { seen[f] = true; work.push_back(f); }
+        }
+        while (!work.empty()) {
+            size_t b = work.back();
+            work.pop_back();
+            for (size_t s : cfg_.succs[b]) {
+                if (!seen[s]) { seen[s] = true; work.push_back(s); }
+            }
+        }
+        seen[pred] = false;
+        return seen;
+    };
+
+    if (stores_in(pred, first.index + 1, fn_.blocks[pred].instrs.size())) return false;
+
+    std::vector<bool> after_entry = forward({entry});
+    if (!after_entry[second.block]) return false;
+
+    // Blocks between the edge and the second load
+    std::vector<bool> between(n, false);
+    std::vector<size_t> work = {second.block};
+    between[second.block] = true;
+    while (!work.empty()) {
+        size_t b = work.back();
+        work.pop_back();
+        for (size_t p : cfg_.preds[b]) {
+            if (p == pred || between[p] || !after_entry[p]) continue;
+            between[p] = true;
+            work.push_back(p);
+        }
+    }
+    for (size_t b = 0; b < n; ++b) {
+        if (between[b] && b != second.block && stores_in(b, 0, fn_.blocks[b].instrs.size())) {
+            return false;
+        }
+    }
+
+    // The load's own block counts in full if it can run again first
+    bool cycles = forward(cfg_.succs[second.block])[second.block];
+    size_t limit = cycles ? fn_.blocks[second.block].instrs.size() : second.index;
+    return !stores_in(second.block, 0, limit);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Guard elimination
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool GuardElimination::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool GuardElimination::run(Function& fn) {
+    if (fn.blocks.empty()) return false;
+
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    RangeAnalysis ranges(fn, cfg, dom);
+
+    bool changed = false;
+    for (size_t b : cfg.rpo) {
+        for (auto& instr : fn.blocks[b].instrs) {
+            if (instr.op != OpCode::DIV || !instr.result.type.is_int()) continue;
+            if (!instr.operands[1].type.is_int()) continue;
+            if (!ranges.is_nonzero(instr.operands[1], b)) continue;
+
+            instr.op = OpCode::DIV_NZ;
+            ++eliminated_;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+} // namespace opt
+} // namespace zero
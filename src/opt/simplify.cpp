@@ -0,0 +1,424 @@
+/**
+ * @file simplify.cpp
+ * @brief Zero Compiler — Algebraic Simplifier Implementation
+ */
+
+#include "opt/simplify.hpp"
+
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Rule table
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+/**
+ * Operand patterns. The first ANY (or NEG_OF) binds X; POW2 and CONST
+ * bind the constant C.
+ */
+enum class Match {
+    NONE,       // No operand (unary instructions)
+    ANY,        // Any value, bound to X
+    SAME,       // The value already bound to X
+    ZERO,       // Integer constant 0
+    ONE,        // Integer constant 1
+    MINUS_ONE,  // Integer constant -1
+    POW2,       // Integer constant 2^k, k >= 1
+    CONST,      // Any other integer constant
+    NEG_OF,     // Result of a NEG; its operand is bound to X
+};
+
+/**
+ * What a matched instruction becomes.
+ */
+enum class Action {
+    X,              // Replaced by X
+    ZERO,           // const 0
+    ONE,            // const 1
+    NEGATE,         // neg X
+    SHIFT_LEFT,     // shl X, log2(C)
+    DIVIDE_POW2,    // Round-toward-zero shift sequence
+    DIVIDE_MAGIC,   // Multiply-high sequence
+};
+
+struct Rule {
+    const char* name;
+    OpCode op;
+    Match lhs;
+    Match rhs;
+    bool commutative;   // Also try with operands swapped
+    bool int_only;      // Not valid for floats (NaN, -0.0, rounding)
+    Action action;
+};
+
+const Rule kRules[] = {
+    // name                 op               lhs              rhs              comm   int    action
+    {"add-zero",            OpCode::ADD,     Match::ANY,      Match::ZERO,      true,  true,  Action::X},
+    {"sub-zero",            OpCode::SUB,     Match::ANY,      Match::ZERO,      false, true,  Action::X},
+    {"sub-self",            OpCode::SUB,     Match::ANY,      Match::SAME,      false, true,  Action::ZERO},
+    {"zero-sub",            OpCode::SUB,     Match::ZERO,     Match::ANY,       false, true,  Action::NEGATE},
+    {"mul-zero",            OpCode::MUL,     Match::ANY,      Match::ZERO,      true,  true,  Action::ZERO},
+    {"mul-one",             OpCode::MUL,     Match::ANY,      Match::ONE,       true,  true,  Action::X},
+    {"mul-minus-one",       OpCode::MUL,     Match::ANY,      Match::MINUS_ONE, true,  true,  Action::NEGATE},
+    {"mul-pow2",            OpCode::MUL,     Match::ANY,      Match::POW2,      true,  true,  Action::SHIFT_LEFT},
+    {"div-one",             OpCode::DIV,     Match::ANY,      Match::ONE,       false, true,  Action::X},
+    {"div-minus-one",       OpCode::DIV,     Match::ANY,      Match::MINUS_ONE, false, true,  Action::NEGATE},
+    {"div-pow2",            OpCode::DIV,     Match::ANY,      Match::POW2,      false, true,  Action::DIVIDE_POW2},
+    {"div-const",           OpCode::DIV,     Match::ANY,      Match::CONST,     false, true,  Action::DIVIDE_MAGIC},
+    {"neg-neg",             OpCode::NEG,     Match::NEG_OF,   Match::NONE,      false, false, Action::X},
+    {"shl-zero",            OpCode::SHL,     Match::ANY,      Match::ZERO,      false, true,  Action::X},
+    {"shr-zero",            OpCode::SHR,     Match::ANY,      Match::ZERO,      false, true,  Action::X},
+    {"and-zero",            OpCode::AND,     Match::ANY,      Match::ZERO,      true,  true,  Action::ZERO},
+    {"and-ones",            OpCode::AND,     Match::ANY,      Match::MINUS_ONE, true,  true,  Action::X},
+    {"and-self",            OpCode::AND,     Match::ANY,      Match::SAME,      false, true,  Action::X},
+    {"or-zero",             OpCode::OR,      Match::ANY,      Match::ZERO,      true,  true,  Action::X},
+    {"or-self",             OpCode::OR,      Match::ANY,      Match::SAME,      false, true,  Action::X},
+    {"eq-self",             OpCode::CMP_EQ,  Match::ANY,      Match::SAME,      false, true,  Action::ONE},
+    {"le-self",             OpCode::CMP_LE,  Match::ANY,      Match::SAME,      false, true,  Action::ONE},
+    {"ge-self",             OpCode::CMP_GE,  Match::ANY,      Match::SAME,      false, true,  Action::ONE},
+    {"ne-self",             OpCode::CMP_NE,  Match::ANY,      Match::SAME,      false, true,  Action::ZERO},
+    {"lt-self",             OpCode::CMP_LT,  Match::ANY,      Match::SAME,      false, true,  Action::ZERO},
+    {"gt-self",             OpCode::CMP_GT,  Match::ANY,      Match::SAME,      false, true,  Action::ZERO},
+};
+
+/**
+ * What the matcher needs to know about a value's definition.
+ */
+struct Def {
+    OpCode op = OpCode::NOP;
+    int64_t imm = 0;
+    Value operand;
+};
+
+struct Bindings {
+    Value x;
+    int64_t c = 0;
+};
+
+bool is_pow2(int64_t v) {
+    return v > 1 && (v & (v - 1)) == 0;
+}
+
+unsigned log2_of(int64_t v) {
+    unsigned k = 0;
+    while ((int64_t{1} << k) < v) ++k;
+    return k;
+}
+
+bool match(Match m, const Value& v, const std::unordered_map<uint32_t, Def>& defs,
+           Bindings& b) {
+    auto it = defs.find(v.id);
+    const Def* def = it != defs.end() ? &it->second : nullptr;
+    bool is_const = def && def->op == OpCode::CONST_INT;
+
+    switch (m) {
+        case Match::NONE:
+            return !v.valid();
+        case Match::ANY:
+            if (!b.x.valid()) b.x = v;
+            return true;
+        case Match::SAME:
+            return b.x.valid() && v == b.x;
+        case Match::ZERO:
+            return is_const && def->imm == 0;
+        case Match::ONE:
+            return is_const && def->imm == 1;
+        case Match::MINUS_ONE:
+            return is_const && def->imm == -1;
+        case Match::POW2:
+            if (!is_const || !is_pow2(def->imm)) return false;
+            b.c = def->imm;
+            return true;
+        case Match::CONST:
+            if (!is_const || def->imm == 0 || def->imm == 1 || def->imm == -1 ||
+                def->imm == INT64_MIN) {
+                return false;
+            }
+            b.c = def->imm;
+            return true;
+        case Match::NEG_OF:
+            if (!def || def->op != OpCode::NEG) return false;
+            b.x = def->operand;
+            return true;
+    }
+    return false;
+}
+
+bool match_rule(const Rule& rule, const Instruction& instr,
+                const std::unordered_map<uint32_t, Def>& defs, Bindings& b) {
+    if (instr.op != rule.op) return false;
+    if (rule.int_only && !instr.result.type.is_int()) return false;
+
+    Value lhs = instr.operands.size() > 0 ? instr.operands[0] : Value{};
+    Value rhs = instr.operands.size() > 1 ? instr.operands[1] : Value{};
+
+    b = Bindings{};
+    if (match(rule.lhs, lhs, defs, b) && match(rule.rhs, rhs, defs, b)) return true;
+    if (!rule.commutative) return false;
+
+    b = Bindings{};
+    return match(rule.lhs, rhs, defs, b) && match(rule.rhs, lhs, defs, b);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Constant folding (mirrors the interpreter's integer semantics)
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool fold(OpCode op, int64_t a, int64_t b, int64_t& out) {
+    uint64_t ua = static_cast<uint64_t>(a);
+    uint64_t ub = static_cast<uint64_t>(b);
+    switch (op) {
+        case OpCode::ADD: out = static_cast<int64_t>(ua + ub); return true;
+        case OpCode::SUB: out = static_cast<int64_t>(ua - ub); return true;
+        case OpCode::MUL: out = static_cast<int64_t>(ua * ub); return true;
+        case OpCode::MUL_HI: out = mul_high(a, b); return true;
+        case OpCode::DIV:
+            if (b == -1 && a == INT64_MIN) return false;
+            out = b != 0 ? a / b : 0;
+            return true;
+        case OpCode::SHL: out = static_cast<int64_t>(ua << (b & 63)); return true;
+        case OpCode::SHR: out = a >> (b & 63); return true;
+        case OpCode::AND: out = a & b; return true;
+        case OpCode::OR: out = a | b; return true;
+        case OpCode::CMP_EQ: out = a == b; return true;
+        case OpCode::CMP_NE: out = a != b; return true;
+        case OpCode::CMP_LT: out = a < b; return true;
+        case OpCode::CMP_LE: out = a <= b; return true;
+        case OpCode::CMP_GT: out = a > b; return true;
+        case OpCode::CMP_GE: out = a >= b; return true;
+        default: return false;
+    }
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Division magic numbers
+// ─────────────────────────────────────────────────────────────────────────────
+
+DivisionMagic signed_division_magic(int64_t d) {
+    const uint64_t two63 = uint64_t{1} << 63;
+    uint64_t ad = d < 0 ? uint64_t{0} - static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
+    uint64_t t = two63 + (static_cast<uint64_t>(d) >> 63);
+    uint64_t anc = t - 1 - t % ad;          // |nc|
+    unsigned p = 63;
+    uint64_t q1 = two63 / anc, r1 = two63 - q1 * anc;
+    uint64_t q2 = two63 / ad, r2 = two63 - q2 * ad;
+    uint64_t delta;
+
+    do {
+        ++p;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) { ++q1; r1 -= anc; }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) { ++q2; r2 -= ad; }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    DivisionMagic magic;
+    magic.multiplier = static_cast<int64_t>(q2 + 1);
+    if (d < 0) magic.multiplier = -magic.multiplier;
+    magic.shift = p - 64;
+    return magic;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool AlgebraicSimplifier::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool AlgebraicSimplifier::run(Function& fn) {
+    bool changed = false;
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        std::unordered_map<uint32_t, Def> defs;
+        for (const auto& bb : fn.blocks) {
+            for (const auto& instr : bb.instrs) {
+                if (!instr.result.valid()) continue;
+                defs[instr.result.id] = {instr.op, instr.imm_int,
+                                         instr.operands.empty() ? Value{} : instr.operands[0]};
+            }
+        }
+
+        // Uses of removed instructions are redirected at the end of the sweep
+        std::unordered_map<uint32_t, Value> subst;
+        auto resolve = [&subst](Value v) {
+            for (auto it = subst.find(v.id); it != subst.end(); it = subst.find(v.id)) {
+                v = it->second;
+            }
+            return v;
+        };
+
+        for (auto& bb : fn.blocks) {
+            std::vector<Instruction> out;
+            out.reserve(bb.instrs.size());
+
+            auto emit = [&](OpCode op, OperandList operands) {
+                Instruction instr;
+                instr.op = op;
+                instr.result = fn.new_value(types::Type::make_int());
+                instr.operands = std::move(operands);
+                defs[instr.result.id] = {op, 0, instr.operands.empty() ? Value{} : instr.operands[0]};
+                out.push_back(instr);
+                return instr.result;
+            };
+            auto emit_const = [&](int64_t v) {
+                Instruction instr;
+                instr.op = OpCode::CONST_INT;
+                instr.result = fn.new_value(types::Type::make_int());
+                instr.imm_int = v;
+                defs[instr.result.id] = {OpCode::CONST_INT, v, Value{}};
+                out.push_back(instr);
+                return instr.result;
+            };
+
+            for (auto& instr : bb.instrs) {
+                for (auto& op : instr.operands) op = resolve(op);
+
+                if (!is_pure(instr.op) || instr.op == OpCode::CONST_INT ||
+                    instr.op == OpCode::CONST_FLOAT || instr.op == OpCode::CONST_STR) {
+                    out.push_back(std::move(instr));
+                    continue;
+                }
+
+                // Constant operands fold outright
+                if (instr.result.type.is_int() && !instr.operands.empty()) {
+                    int64_t vals[2] = {0, 0};
+                    bool all_const = instr.operands.size() <= 2;
+                    for (size_t i = 0; all_const && i < instr.operands.size(); ++i) {
+                        auto it = defs.find(instr.operands[i].id);
+                        all_const = it != defs.end() && it->second.op == OpCode::CONST_INT;
+                        if (all_const) vals[i] = it->second.imm;
+                    }
+                    int64_t folded = 0;
+                    bool ok = false;
+                    if (all_const && instr.op == OpCode::NEG) {
+                        folded = static_cast<int64_t>(0 - static_cast<uint64_t>(vals[0]));
+                        ok = true;
+                    } else if (all_const && instr.operands.size() == 2) {
+                        ok = fold(instr.op, vals[0], vals[1], folded);
+                    }
+                    if (ok) {
+                        instr.op = OpCode::CONST_INT;
+                        instr.operands.clear();
+                        instr.imm_int = folded;
+                        defs[instr.result.id] = {OpCode::CONST_INT, folded, Value{}};
+                        out.push_back(std::move(instr));
+                        ++folded_;
+                        progress = true;
+                        continue;
+                    }
+                }
+
+                const Rule* rule = nullptr;
+                Bindings b;
+                for (const Rule& r : kRules) {
+                    if ((r.action == Action::DIVIDE_POW2 || r.action == Action::DIVIDE_MAGIC) &&
+                        !opts_.expand_division) {
+                        continue;
+                    }
+                    if (match_rule(r, instr, defs, b)) {
+                        rule = &r;
+                        break;
+                    }
+                }
+                if (!rule) {
+                    out.push_back(std::move(instr));
+                    continue;
+                }
+
+                ++rewritten_;
+                progress = true;
+                Instruction& in = instr;
+                auto rewrite = [&](OpCode op, OperandList operands) {
+                    in.op = op;
+                    in.operands = std::move(operands);
+                    defs[in.result.id] = {op, 0, in.operands.empty() ? Value{} : in.operands[0]};
+                    out.push_back(std::move(in));
+                };
+                auto rewrite_const = [&](int64_t v) {
+                    in.op = OpCode::CONST_INT;
+                    in.operands.clear();
+                    in.imm_int = v;
+                    defs[in.result.id] = {OpCode::CONST_INT, v, Value{}};
+                    out.push_back(std::move(in));
+                };
+
+                switch (rule->action) {
+                    case Action::X:
+                        subst[in.result.id] = b.x;
+                        break;
+                    case Action::ZERO:
+                        rewrite_const(0);
+                        break;
+                    case Action::ONE:
+                        rewrite_const(1);
+                        break;
+                    case Action::NEGATE:
+                        rewrite(OpCode::NEG, {b.x});
+                        break;
+                    case Action::SHIFT_LEFT:
+                        rewrite(OpCode::SHL, {b.x, emit_const(log2_of(b.c))});
+                        break;
+                    case Action::DIVIDE_POW2: {
+                        // Bias negative dividends by 2^k - 1 so the shift
+                        // rounds toward zero like DIV
+                        Value sign = emit(OpCode::SHR, {b.x, emit_const(63)});
+                        Value bias = emit(OpCode::AND, {sign, emit_const(b.c - 1)});
+                        Value biased = emit(OpCode::ADD, {b.x, bias});
+                        rewrite(OpCode::SHR, {biased, emit_const(log2_of(b.c))});
+                        break;
+                    }
+                    case Action::DIVIDE_MAGIC: {
+                        DivisionMagic magic = signed_division_magic(b.c);
+                        Value q = emit(OpCode::MUL_HI, {b.x, emit_const(magic.multiplier)});
+                        if (b.c > 0 && magic.multiplier < 0) q = emit(OpCode::ADD, {q, b.x});
+                        if (b.c < 0 && magic.multiplier > 0) q = emit(OpCode::SUB, {q, b.x});
+                        if (magic.shift > 0) {
+                            q = emit(OpCode::SHR, {q, emit_const(magic.shift)});
+                        }
+                        // Add one for negative quotients: q - (q >> 63)
+                        Value sign = emit(OpCode::SHR, {q, emit_const(63)});
+                        rewrite(OpCode::SUB, {q, sign});
+                        break;
+                    }
+                }
+            }
+
+            bb.instrs = std::move(out);
+        }
+
+        if (!subst.empty()) {
+            for (auto& bb : fn.blocks) {
+                for (auto& instr : bb.instrs) {
+                    for (auto& op : instr.operands) op = resolve(op);
+                }
+            }
+        }
+
+        changed |= progress;
+    }
+
+    return changed;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,302 @@
+/**
+ * @file simplify_cfg.cpp
+ * @brief Zero Compiler — CFG Simplification Implementation
+ */
+
+#include "opt/simplify_cfg.hpp"
+#include "opt/analysis.hpp"
+
+#include <unordered_map>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+Instruction* terminator(BasicBlock& bb) {
+    size_t t = bb.terminator_index();
+    return t < bb.instrs.size() ? &bb.instrs[t] : nullptr;
+}
+
+void make_branch(Instruction& term, uint32_t target) {
+    term.op = OpCode::BR;
+    term.operands.clear();
+    term.target_block = target;
+    term.else_block = 0;
+}
+
+/**
+ * If `bb` is only reachable through a chain of single-predecessor blocks
+ * that starts at a cond_br on `cond`, the taken edge decides the value:
+ * 1 or 0, or -1 if unknown.
+ */
+int known_condition(Function& fn, const CFG& cfg, size_t bb, const Value& cond) {
+    size_t cur = bb;
+    for (size_t steps = 0; steps < fn.blocks.size(); ++steps) {
+        if (cfg.preds[cur].size() != 1) return -1;
+        size_t p = cfg.preds[cur][0];
+        if (p == bb) return -1;
+
+        const Instruction* term = terminator(fn.blocks[p]);
+        if (term && term->op == OpCode::COND_BR && term->operands[0] == cond &&
+            term->target_block != term->else_block) {
+            return cfg.index_of.at(term->target_block) == cur ? 1 : 0;
+        }
+        cur = p;
+    }
+    return -1;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool CFGSimplifier::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool CFGSimplifier::run(Function& fn) {
+    if (fn.blocks.empty()) return false;
+
+    // Reordering blocks would change what falls through where, so spell
+    // fall-through out as br first. A last block that runs off the end of
+    // the function has no explicit equivalent; leave such functions alone.
+    if (!terminator(fn.blocks.back())) return false;
+    for (size_t i = 0; i < fn.blocks.size(); ++i) {
+        BasicBlock& bb = fn.blocks[i];
+        size_t t = bb.terminator_index();
+        if (t < bb.instrs.size()) {
+            bb.instrs.resize(t + 1);
+        } else {
+            Instruction br;
+            br.op = OpCode::BR;
+            br.target_block = fn.blocks[i + 1].id;
+            br.profile_count = bb.profile_count;
+            fn.blocks[i].add(br);
+        }
+    }
+
+    bool changed = false;
+    bool progress = true;
+    while (progress) {
+        // Dead blocks would count as predecessors below, so drop them first
+        progress = remove_unreachable(fn);
+        progress |= fold_branches(fn);
+        progress |= thread_jumps(fn);
+        progress |= merge_blocks(fn);
+        progress |= remove_unreachable(fn);
+        changed |= progress;
+    }
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Branch folding
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool CFGSimplifier::fold_branches(Function& fn) {
+    CFG cfg = CFG::build(fn);
+
+    std::unordered_map<uint32_t, int64_t> int_consts;
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::CONST_INT) int_consts[instr.result.id] = instr.imm_int;
+        }
+    }
+
+    bool changed = false;
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        Instruction* term = terminator(fn.blocks[b]);
+        if (!term || term->op != OpCode::COND_BR) continue;
+
+        int known = -1;
+        if (term->target_block == term->else_block) {
+            known = 1;
+        } else {
+            auto it = int_consts.find(term->operands[0].id);
+            known = it != int_consts.end() ? (it->second != 0)
+                                           : known_condition(fn, cfg, b, term->operands[0]);
+        }
+        if (known < 0) continue;
+
+        make_branch(*term, known ? term->target_block : term->else_block);
+        ++branches_folded_;
+        changed = true;
+    }
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Jump threading
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool CFGSimplifier::thread_jumps(Function& fn) {
+    CFG cfg = CFG::build(fn);
+    bool changed = false;
+
+    auto is_hop = [&fn](size_t b) {
+        return b != 0 && fn.blocks[b].instrs.size() == 1 &&
+               fn.blocks[b].instrs[0].op == OpCode::BR;
+    };
+
+    for (size_t e = 1; e < fn.blocks.size(); ++e) {
+        BasicBlock& empty = fn.blocks[e];
+        if (empty.instrs.size() != 1) continue;
+        Instruction hop = empty.instrs[0];
+
+        if (hop.op == OpCode::BR) {
+            // Follow a chain of hops to the first real block; a chain that
+            // loops back on itself is an infinite loop and stays as is.
+            std::vector<bool> seen(fn.blocks.size(), false);
+            size_t cur = e;
+            while (is_hop(cur) && !seen[cur]) {
+                seen[cur] = true;
+                cur = cfg.index_of.at(fn.blocks[cur].instrs[0].target_block);
+            }
+            if (is_hop(cur)) continue;
+            hop.target_block = fn.blocks[cur].id;
+        }
+
+        for (size_t p : cfg.preds[e]) {
+            Instruction* term = terminator(fn.blocks[p]);
+            if (!term) continue;
+
+            if (hop.op == OpCode::BR) {
+                // Edge into a block that only jumps on
+                bool threaded = false;
+                if (term->target_block == empty.id) {
+                    term->target_block = hop.target_block;
+                    threaded = true;
+                }
+                if (term->op == OpCode::COND_BR && term->else_block == empty.id) {
+                    term->else_block = hop.target_block;
+                    threaded = true;
+                }
+                if (threaded) {
+                    ++jumps_threaded_;
+                    changed = true;
+                }
+            } else if (hop.op == OpCode::COND_BR && term->op == OpCode::COND_BR &&
+                       term->operands[0] == hop.operands[0] &&
+                       term->target_block != term->else_block) {
+                // Edge into a block that re-tests the condition that chose it
+                if (term->target_block == empty.id && hop.target_block != empty.id) {
+                    term->target_block = hop.target_block;
+                    ++jumps_threaded_;
+                    changed = true;
+                } else if (term->else_block == empty.id && hop.else_block != empty.id) {
+                    term->else_block = hop.else_block;
+                    ++jumps_threaded_;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Block merging
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool CFGSimplifier::merge_blocks(Function& fn) {
+    CFG cfg = CFG::build(fn);
+    const size_t n = fn.blocks.size();
+
+    // Blocks already folded into another one; the CFG still names them
+    std::vector<size_t> owner(n);
+    for (size_t i = 0; i < n; ++i) owner[i] = i;
+    auto find = [&owner](size_t b) {
+        while (owner[b] != b) b = owner[b];
+        return b;
+    };
+
+    bool changed = false;
+    for (size_t a = 0; a < n; ++a) {
+        if (owner[a] != a) continue;
+
+        while (true) {
+            BasicBlock& head = fn.blocks[a];
+            size_t t = head.terminator_index();
+            if (t == head.instrs.size() || head.instrs[t].op != OpCode::BR) break;
+
+            size_t b = cfg.index_of.at(head.instrs[t].target_block);
+            if (b == 0 || find(b) == a || owner[b] != b) break;
+            if (cfg.preds[b].size() != 1 || find(cfg.preds[b][0]) != a) break;
+
+            // The tail's values stay dominated by their definitions: b was
+            // only ever entered from here.
+            head.instrs.resize(t);
+            auto& tail = fn.blocks[b].instrs;
+            head.instrs.insert(head.instrs.end(),
+                               std::make_move_iterator(tail.begin()),
+                               std::make_move_iterator(tail.end()));
+            tail.clear();
+            owner[b] = a;
+            ++blocks_merged_;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Unreachable blocks and renumbering
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool CFGSimplifier::remove_unreachable(Function& fn) {
+    CFG cfg = CFG::build(fn);
+    const size_t n = fn.blocks.size();
+
+    // Merged blocks are empty and no longer branched to
+    std::vector<bool> keep(n);
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        keep[i] = cfg.reachable(i);
+        if (keep[i]) ++kept;
+    }
+    if (kept == n) return false;
+
+    std::unordered_map<uint32_t, uint32_t> new_id;
+    std::vector<size_t> order;
+    order.reserve(kept);
+    for (size_t i = 0; i < n; ++i) {
+        if (!keep[i]) continue;
+        new_id[fn.blocks[i].id] = static_cast<uint32_t>(order.size());
+        order.push_back(i);
+    }
+    fn.blocks.retain(order);
+
+    for (auto& bb : fn.blocks) {
+        bb.id = new_id.at(bb.id);
+        for (auto& instr : bb.instrs) {
+            if (instr.op == OpCode::BR || instr.op == OpCode::COND_BR) {
+                auto it = new_id.find(instr.target_block);
+                if (it != new_id.end()) instr.target_block = it->second;
+            }
+            if (instr.op == OpCode::COND_BR) {
+                auto it = new_id.find(instr.else_block);
+                if (it != new_id.end()) instr.else_block = it->second;
+            }
+        }
+    }
+
+    blocks_removed_ += n - kept;
+    fn.next_block_id = static_cast<uint32_t>(fn.blocks.size());
+    return true;
+}
+
+} // namespace opt
+} // namespace zero
@@ -0,0 +1,312 @@
+/**
+ * @file unroll.cpp
+ * @brief Zero Compiler — Loop Unrolling Implementation
+ */
+
+#include "opt/unroll.hpp"
+#include "opt/induction.hpp"
+#include "ir/profile.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace zero {
+namespace opt {
+
+using namespace ir;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Pass driver
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool LoopUnroller::run(Module& mod) {
+    bool changed = false;
+    for (auto& fn : mod.functions) {
+        changed |= run(fn);
+    }
+    return changed;
+}
+
+bool LoopUnroller::run(Function& fn) {
+    if (fn.blocks.empty() || opts_.factor < 2) return false;
+
+    // The remainder keeps its header, so remember which loops were tried
+    std::unordered_set<uint32_t> visited;
+    bool changed = false;
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        CFG cfg = CFG::build(fn);
+        DominatorTree dom(cfg);
+        LoopInfo loops(cfg, dom);
+
+        for (Loop* loop : loops.postorder()) {
+            if (!visited.insert(fn.blocks[loop->header].id).second) continue;
+            if (unroll(fn, cfg, dom, *loop)) {
+                // Blocks were added; recompute the analyses
+                ++unrolled_;
+                changed = progress = true;
+                break;
+            }
+        }
+    }
+
+    return changed;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Unrolling
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool LoopUnroller::unroll(Function& fn, const CFG& cfg, const DominatorTree& dom,
+                          const Loop& loop) {
+    if (!loop.children.empty() || loop.latches.size() != 1) return false;
+    long ph = loop.preheader(cfg);
+    if (ph < 0) return false;
+
+    InductionAnalysis ind(fn, cfg, dom, loop);
+    const ExitTest* test = ind.exit_test();
+    if (!test || test->body == loop.header) return false;
+
+    // The guard checks only the last of the `factor` iterations, which
+    // covers the others when the variable moves toward the bound.
+    int64_t step = test->iv->step;
+    bool monotonic = ((test->pred == OpCode::CMP_LT || test->pred == OpCode::CMP_LE) && step > 0) ||
+                     ((test->pred == OpCode::CMP_GT || test->pred == OpCode::CMP_GE) && step < 0);
+    if (!monotonic) return false;
+
+    // i + ahead could wrap past the bound, so the guard compares i with
+    // bound - ahead instead. Give up when that cannot be computed: ahead
+    // itself overflows, or a constant bound has no room for it.
+    constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+    constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+    const int64_t span = static_cast<int64_t>(opts_.factor - 1);
+    if (step > 0 ? step > kMax / span : step < kMin / span) return false;
+    const int64_t ahead = span * step;
+    // Smallest (counting up) or largest bound that bound - ahead fits
+    const int64_t room = step > 0 ? kMin + ahead : kMax + ahead;
+    if (test->bound_is_const && (step > 0 ? test->bound_const < room : test->bound_const > room)) {
+        return false;
+    }
+
+    long trips = ind.trip_count();
+    if (trips >= 0 && trips < static_cast<long>(opts_.factor)) return false;
+
+    // With a profile: skip loops that never ran, and loops that average
+    // fewer iterations per entry than the factor, which would only ever
+    // take the remainder
+    uint64_t entries = 0;
+    if (fn.has_profile) {
+        uint32_t header_id = fn.blocks[loop.header].id;
+        for (size_t p : cfg.preds[loop.header]) {
+            if (!loop.contains(p)) entries += edge_count(fn.blocks[p], header_id);
+        }
+        uint64_t header_runs = fn.blocks[loop.header].profile_count;
+        if (entries == 0 || header_runs - std::min(header_runs, entries) < entries * opts_.factor) {
+            return false;
+        }
+    }
+
+    size_t size = 0;
+    std::unordered_set<uint32_t> defined_in_loop;
+    for (size_t b : loop.blocks) {
+        const BasicBlock& bb = fn.blocks[b];
+        size_t end = bb.terminator_index();
+        size += end;
+        for (size_t i = 0; i < end; ++i) {
+            if (bb.instrs[i].result.valid()) defined_in_loop.insert(bb.instrs[i].result.id);
+        }
+    }
+    if (size * opts_.factor > opts_.max_unrolled_size) return false;
+
+    // Copies get fresh values, so nothing outside may refer to loop values
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        if (loop.contains(b)) continue;
+        for (const auto& instr : fn.blocks[b].instrs) {
+            for (const auto& op : instr.operands) {
+                if (defined_in_loop.count(op.id)) return false;
+            }
+        }
+    }
+
+    // The header only computes the exit test unless it has side effects or
+    // feeds the body; in that case each copy keeps a header without the test.
+    const BasicBlock& header = fn.blocks[loop.header];
+    size_t header_end = header.terminator_index();
+    std::unordered_set<uint32_t> header_values;
+    bool keep_header = false;
+    for (size_t i = 0; i < header_end; ++i) {
+        const Instruction& instr = header.instrs[i];
+        if (!is_pure(instr.op) && instr.op != OpCode::LOAD) keep_header = true;
+        if (instr.result.valid()) header_values.insert(instr.result.id);
+    }
+    for (size_t b : loop.blocks) {
+        if (b == loop.header) continue;
+        for (const auto& instr : fn.blocks[b].instrs) {
+            for (const auto& op : instr.operands) {
+                if (header_values.count(op.id)) keep_header = true;
+            }
+        }
+    }
+
+    const uint32_t header_id = header.id;
+    const std::string header_label = header.label;
+    const unsigned factor = opts_.factor;
+
+    // Guard block: does iteration `factor - 1` from here still pass the test?
+    const size_t guard = fn.blocks.size();
+    fn.new_block(header_label + ".unroll").profile_count =
+        fn.blocks[loop.header].profile_count / factor;
+
+    std::vector<std::unordered_map<size_t, uint32_t>> copies(factor);
+    for (unsigned j = 0; j < factor; ++j) {
+        for (size_t b : loop.blocks) {
+            if (b == loop.header && !keep_header) continue;
+            copies[j][b] = fn.new_block(fn.blocks[b].label + ".u" + std::to_string(j)).id;
+        }
+    }
+    auto copy_entry = [&](unsigned j) -> uint32_t {
+        if (j == factor) return fn.blocks[guard].id;
+        return copies[j].at(keep_header ? loop.header : test->body);
+    };
+
+    {
+        auto emit = [&](std::vector<Instruction>& instrs, OpCode op, std::vector<Value> operands,
+                        int64_t imm = 0) {
+            Instruction instr;
+            instr.op = op;
+            instr.result = fn.new_value(types::Type::make_int());
+            instr.operands = std::move(operands);
+            instr.imm_int = imm;
+            instrs.push_back(instr);
+            return instr.result;
+        };
+        auto cond_br = [&](size_t block, std::vector<Instruction>& instrs, Value cond,
+                           uint32_t target) {
+            Instruction br;
+            br.op = OpCode::COND_BR;
+            br.operands = {cond};
+            br.target_block = target;
+            br.else_block = header_id;
+            instrs.push_back(br);
+            fn.blocks[block].instrs = std::move(instrs);
+        };
+
+        // A variable bound first needs room for bound - ahead; without
+        // it the loop is about to end anyway, so the remainder runs it
+        size_t test_block = guard;
+        Value limit;
+        if (test->bound_is_const) {
+            std::vector<Instruction> g;
+            limit = emit(g, OpCode::CONST_INT, {}, test->bound_const - ahead);
+            fn.blocks[guard].instrs = std::move(g);
+        } else {
+            test_block = fn.blocks.size();
+            fn.new_block(header_label + ".unroll.test").profile_count = fn.blocks[guard].profile_count;
+            std::vector<Instruction> g;
+            Value lowest = emit(g, OpCode::CONST_INT, {}, room);
+            Value fits = emit(g, step > 0 ? OpCode::CMP_GE : OpCode::CMP_LE, {test->bound, lowest});
+            cond_br(guard, g, fits, fn.blocks[test_block].id);
+
+            std::vector<Instruction> t;
+            Value offset = emit(t, OpCode::CONST_INT, {}, ahead);
+            limit = emit(t, OpCode::SUB, {test->bound, offset});
+            fn.blocks[test_block].instrs = std::move(t);
+        }
+
+        std::vector<Instruction> t = std::move(fn.blocks[test_block].instrs);
+        Instruction load;
+        load.op = OpCode::LOAD;
+        load.result = fn.new_value(test->iv->slot.type);
+        load.operands = {test->iv->slot};
+        t.push_back(load);
+        Value pass = emit(t, test->pred, {load.result, limit});
+        cond_br(test_block, t, pass, copy_entry(0));
+    }
+
+    // Body copies, chained back edge to entry of the next copy
+    for (unsigned j = 0; j < factor; ++j) {
+        std::unordered_map<uint32_t, Value> value_map;
+        auto remap = [&](const Value& v) -> Value {
+            if (!v.valid() || !defined_in_loop.count(v.id)) return v;
+            auto it = value_map.find(v.id);
+            if (it != value_map.end()) return it->second;
+            Value nv = fn.new_value(v.type);
+            value_map[v.id] = nv;
+            return nv;
+        };
+        auto retarget = [&](uint32_t target) -> uint32_t {
+            size_t t = cfg.index_of.at(target);
+            if (t == loop.header) return copy_entry(j + 1);
+            auto it = copies[j].find(t);
+            return it != copies[j].end() ? it->second : target;
+        };
+
+        for (size_t b : loop.blocks) {
+            auto it = copies[j].find(b);
+            if (it == copies[j].end()) continue;
+
+            const BasicBlock& src = fn.blocks[b];
+            std::vector<Instruction> out;
+            size_t end = src.terminator_index();
+            for (size_t i = 0; i < end; ++i) {
+                Instruction copy = src.instrs[i];
+                for (auto& op : copy.operands) op = remap(op);
+                copy.result = remap(copy.result);
+                out.push_back(std::move(copy));
+            }
+
+            Instruction br;
+            br.op = OpCode::BR;
+            if (b == loop.header) {
+                // The test was hoisted into the guard
+                br.target_block = copies[j].at(test->body);
+                out.push_back(br);
+            } else if (end == src.instrs.size()) {
+                br.target_block = retarget(fn.blocks[cfg.succs[b][0]].id);
+                out.push_back(br);
+            } else {
+                Instruction term = src.instrs[end];
+                for (auto& op : term.operands) op = remap(op);
+                if (term.op == OpCode::BR || term.op == OpCode::COND_BR) {
+                    term.target_block = retarget(term.target_block);
+                }
+                if (term.op == OpCode::COND_BR) {
+                    term.else_block = retarget(term.else_block);
+                }
+                out.push_back(std::move(term));
+            }
+
+            // Each copy runs for one in `factor` of the iterations
+            BasicBlock& dst = fn.blocks[it->second];
+            dst.instrs = std::move(out);
+            dst.profile_count = fn.blocks[b].profile_count / factor;
+            for (auto& instr : dst.instrs) instr.profile_count /= factor;
+        }
+    }
+
+    // Enter through the guard; the original loop is now the remainder
+    BasicBlock& pre = fn.blocks[static_cast<size_t>(ph)];
+    size_t t = pre.terminator_index();
+    if (t == pre.instrs.size()) {
+        Instruction br;
+        br.op = OpCode::BR;
+        br.target_block = fn.blocks[guard].id;
+        pre.add(br);
+    } else {
+        Instruction& term = pre.instrs[t];
+        if (term.target_block == header_id) term.target_block = fn.blocks[guard].id;
+        if (term.op == OpCode::COND_BR && term.else_block == header_id) {
+            term.else_block = fn.blocks[guard].id;
+        }
+    }
+
+    return true;
+}
+
+} // namespace opt
+} // namespace zero
@@ -82,6 +82,7 @@ void Parser::synchronize() {
         if (previous_.type == TokenType::NEWLINE) return;
         
         switch (current_.type) {
+            case TokenType::AT:
             case TokenType::FN:
             case TokenType::LET:
             case TokenType::IF:
@@ -115,7 +116,17 @@ Program Parser::parse() {
             continue;
         }
         
-        if (check(TokenType::FN)) {
+        if (check(TokenType::AT)) {
+            std::vector<Attribute> attrs = parse_attributes();
+            if (check(TokenType::FN)) {
+                FnDecl fn = parse_fn_decl();
+                fn.attributes = std::move(attrs);
+                program.functions.push_back(std::move(fn));
+            } else {
+                error("Expected function declaration after attribute");
+                synchronize();
+            }
+        } else if (check(TokenType::FN)) {
             program.functions.push_back(parse_fn_decl());
         } else {
             error("Expected function declaration");
@@ -172,6 +183,27 @@ FnDecl Parser::parse_fn_decl() {
     return fn;
 }
 
+std::vector<Attribute> Parser::parse_attributes() {
+    std::vector<Attribute> attrs;
+    
+    // One or more `@name`, optionally on separate lines
+    while (match(TokenType::AT)) {
+        Span start = previous_.span;
+        if (!check(TokenType::IDENT)) {
+            error("Expected attribute name after '@'");
+            break;
+        }
+        Attribute attr;
+        attr.name = std::string(current_.text);
+        attr.span = start.merge(current_.span);
+        advance();
+        attrs.push_back(std::move(attr));
+        skip_newlines();
+    }
+    
+    return attrs;
+}
+
 std::vector<Param> Parser::parse_params() {
     std::vector<Param> params;
     
@@ -211,6 +243,8 @@ Type Parser::parse_type() {
         else if (name == "void") t.kind = TypeKind::VOID;
         else if (name == "tensor") t.kind = TypeKind::TENSOR;
         else t.kind = TypeKind::UNKNOWN;
+        
+        if (t.kind == TypeKind::TENSOR) parse_tensor_type(t);
     } else {
         error("Expected type");
     }
@@ -218,6 +252,39 @@ Type Parser::parse_type() {
     return t;
 }
 
+void Parser::parse_tensor_type(Type& t) {
+    // tensor<f32>[2, _]: both parts optional, `_` is a dynamic dimension
+    if (match(TokenType::LT)) {
+        if (check(TokenType::IDENT)) {
+            t.dtype = std::string(current_.text);
+            advance();
+        } else {
+            error("Expected element type after 'tensor<'");
+        }
+        consume(TokenType::GT, "Expected '>' after tensor element type");
+    }
+    
+    if (!match(TokenType::LBRACKET)) return;
+    t.has_dims = true;
+    if (!check(TokenType::RBRACKET)) {
+        do {
+            if (match(TokenType::INT_LIT)) {
+                int64_t dim = 0;
+                std::from_chars(previous_.text.data(),
+                                previous_.text.data() + previous_.text.size(), dim);
+                t.dims.push_back(dim);
+            } else if (check(TokenType::IDENT) && current_.text == "_") {
+                advance();
+                t.dims.push_back(-1);
+            } else {
+                error("Expected dimension size or '_'");
+                break;
+            }
+        } while (match(TokenType::COMMA));
+    }
+    consume(TokenType::RBRACKET, "Expected ']' after tensor dimensions");
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Statements
 // ─────────────────────────────────────────────────────────────────────────────
@@ -231,6 +298,11 @@ std::unique_ptr<Stmt> Parser::parse_stmt() {
     if (check(TokenType::WHILE)) return parse_while_stmt();
     if (check(TokenType::LBRACE)) return parse_block();
     
+    // Assignment: name = expr
+    if (check(TokenType::IDENT) && lexer_.peek().type == TokenType::EQ) {
+        return parse_assign_stmt();
+    }
+    
     return parse_expr_stmt();
 }
 
@@ -262,6 +334,22 @@ std::unique_ptr<Stmt> Parser::parse_let_stmt() {
     return make_stmt(std::move(let));
 }
 
+std::unique_ptr<Stmt> Parser::parse_assign_stmt() {
+    AssignStmt assign;
+    assign.span = current_.span;
+    assign.name = std::string(current_.text);
+    advance();  // consume identifier
+    
+    consume(TokenType::EQ, "Expected '=' in assignment");
+    assign.value = parse_expr();
+    
+    // Optional semicolon
+    match(TokenType::SEMICOLON);
+    
+    assign.span = assign.span.merge(previous_.span);
+    return make_stmt(std::move(assign));
+}
+
 std::unique_ptr<Stmt> Parser::parse_return_stmt() {
     ReturnStmt ret;
     ret.span = current_.span;
@@ -5,6 +5,8 @@
 
 #include "sema/sema.hpp"
 
+#include <unordered_set>
+
 namespace zero {
 namespace sema {
 
@@ -12,15 +14,20 @@ namespace sema {
 // conflicts between ast::Type and types::Type
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Helper: Convert ast::TypeKind to types::Type
+// Helper: Convert ast::Type to types::Type
 // ─────────────────────────────────────────────────────────────────────────────
 
-static types::Type ast_to_types(ast::TypeKind kind) {
-    switch (kind) {
+static types::Type ast_to_types(const ast::Type& t) {
+    switch (t.kind) {
         case ast::TypeKind::INT: return types::Type::make_int();
         case ast::TypeKind::FLOAT: return types::Type::make_float();
         case ast::TypeKind::VOID: return types::Type::make_void();
-        case ast::TypeKind::TENSOR: return types::Type::make_tensor();
+        case ast::TypeKind::TENSOR: {
+            // An unknown element type is reported by check_type
+            auto dtype = types::parse_dtype(t.dtype);
+            if (!dtype) return types::Type::make_tensor();
+            return types::Type::make_tensor(types::TensorType{*dtype, t.has_dims, t.dims});
+        }
         default: return types::Type::make_unknown();
     }
 }
@@ -72,6 +79,18 @@ void Sema::error(ErrorKind kind, const std::string& msg, source::Span span) {
     errors_.push_back(SemanticError{kind, msg, span});
 }
 
+void Sema::check_type(const ast::Type& t) {
+    if (t.kind != ast::TypeKind::TENSOR) return;
+    if (!t.dtype.empty() && !types::parse_dtype(t.dtype)) {
+        error(ErrorKind::TYPE_MISMATCH,
+              "Unknown tensor element type '" + t.dtype + "' (expected f32, f64 or i64)", t.span);
+    }
+    if (t.has_dims && t.dtype.empty()) {
+        error(ErrorKind::TYPE_MISMATCH, "Tensor dimensions need an element type, e.g. tensor<f32>[2, 3]",
+              t.span);
+    }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main analysis
 // ─────────────────────────────────────────────────────────────────────────────
@@ -83,10 +102,16 @@ void Sema::analyze(ast::Program& prog) {
     // First pass: collect all function signatures
     collect_functions(prog);
     
+    // Tensor built-ins; a program's own function of the same name wins
+    register_tensor_builtins();
+    
     // Second pass: check each function body
     for (auto& fn : prog.functions) {
         check_fn(fn);
     }
+    
+    // Purity needs every body's calls, so it is checked last
+    check_memo(prog);
 }
 
 void Sema::collect_functions(ast::Program& prog) {
@@ -95,11 +120,13 @@ void Sema::collect_functions(ast::Program& prog) {
         sig.name = fn.name;
         
         for (const auto& param : fn.params) {
-            sig.param_types.push_back(ast_to_types(param.type.kind));
+            check_type(param.type);
+            sig.param_types.push_back(ast_to_types(param.type));
         }
         
         if (fn.return_type) {
-            sig.return_type = ast_to_types(fn.return_type->kind);
+            check_type(*fn.return_type);
+            sig.return_type = ast_to_types(*fn.return_type);
         } else {
             sig.return_type = types::Type::make_void();
         }
@@ -122,6 +149,7 @@ void Sema::register_builtins() {
     // Empty param_types = accepts any number of arguments
     print_sig.return_type = types::Type::make_void();
     print_sig.is_variadic = true;
+    print_sig.has_effects = true;
     functions_["print"] = print_sig;
     
     // log(msg, color=...) - logging function with optional color
@@ -129,23 +157,64 @@ void Sema::register_builtins() {
     log_sig.name = "log";
     log_sig.return_type = types::Type::make_void();
     log_sig.is_variadic = true;
+    log_sig.has_effects = true;
     functions_["log"] = log_sig;
 }
 
+void Sema::register_tensor_builtins() {
+    auto add = [this](const std::string& name, std::vector<types::Type> params, bool variadic) {
+        if (functions_.count(name)) return;
+        tensor_builtins_.insert(name);
+        FnSignature sig;
+        sig.name = name;
+        sig.param_types = std::move(params);
+        sig.return_type = types::Type::make_tensor();
+        sig.is_variadic = variadic;
+        functions_[name] = sig;
+    };
+    
+    // tensor(d0, d1, ...) - zeros; fill(value, d0, d1, ...) - every element value
+    add("tensor", {}, true);
+    add("fill", {}, true);
+    add("relu", {types::Type::make_tensor()}, false);
+    add("matmul", {types::Type::make_tensor(), types::Type::make_tensor()}, false);
+    
+    // Activations on floating-point tensors
+    for (const char* name : {"exp", "tanh", "sigmoid", "gelu"}) {
+        add(name, {types::Type::make_tensor()}, false);
+    }
+    
+    // Views: reshape(x, d0, ...), broadcast(x, d0, ...), transpose(x) or
+    // transpose(x, d0, d1), slice(x, dim, start, stop) with optional step
+    add("reshape", {types::Type::make_tensor()}, true);
+    add("broadcast", {types::Type::make_tensor()}, true);
+    add("transpose", {types::Type::make_tensor()}, true);
+    add("slice", {types::Type::make_tensor()}, true);
+    
+    // Reductions over every element or along an axis: sum(x[, axis]),
+    // mean, max, argmax; softmax(x[, axis]), layernorm(x[, gamma, beta])
+    for (const char* name : {"sum", "mean", "max", "argmax", "softmax", "layernorm"}) {
+        add(name, {types::Type::make_tensor()}, true);
+    }
+}
+
 void Sema::check_fn(ast::FnDecl& fn) {
+    check_attributes(fn);
+    current_fn_ = fn.name;
+    calls_[fn.name];
     push_scope();
     
     // Set current return type for return statement checking
     // If no annotation, use UNKNOWN to skip strict checking (MPP lenient)
     if (fn.return_type) {
-        current_return_type_ = ast_to_types(fn.return_type->kind);
+        current_return_type_ = ast_to_types(*fn.return_type);
     } else {
         current_return_type_ = types::Type::make_unknown();
     }
     
     // Declare parameters
     for (const auto& param : fn.params) {
-        declare(param.name, ast_to_types(param.type.kind), param.span);
+        declare(param.name, ast_to_types(param.type), param.span);
     }
     
     // Check body statements
@@ -156,6 +225,78 @@ void Sema::check_fn(ast::FnDecl& fn) {
     pop_scope();
 }
 
+void Sema::check_attributes(ast::FnDecl& fn) {
+    for (const auto& attr : fn.attributes) {
+        if (attr.name != "inline" && attr.name != "noinline" && attr.name != "export" &&
+            attr.name != "memo") {
+            error(ErrorKind::INVALID_ATTRIBUTE,
+                  "Unknown attribute '@" + attr.name + "'", attr.span);
+        }
+    }
+    
+    if (fn.has_attribute("inline") && fn.has_attribute("noinline")) {
+        error(ErrorKind::INVALID_ATTRIBUTE,
+              "Function '" + fn.name + "' cannot be both @inline and @noinline", fn.span);
+    }
+    
+    if (!fn.has_attribute("memo")) return;
+    
+    // Memoized calls are keyed on argument values, so they must be scalars
+    if (fn.has_attribute("inline")) {
+        error(ErrorKind::INVALID_ATTRIBUTE,
+              "Function '" + fn.name + "' cannot be both @inline and @memo", fn.span);
+    }
+    for (const auto& param : fn.params) {
+        types::Type t = ast_to_types(param.type);
+        if (!t.is_numeric()) {
+            error(ErrorKind::INVALID_ATTRIBUTE,
+                  "@memo function '" + fn.name + "' parameter '" + param.name +
+                  "' must be int or float", param.span);
+        }
+    }
+    types::Type ret = fn.return_type ? ast_to_types(*fn.return_type)
+                                     : types::Type::make_void();
+    if (!ret.is_numeric()) {
+        error(ErrorKind::INVALID_ATTRIBUTE,
+              "@memo function '" + fn.name + "' must return int or float", fn.span);
+    }
+}
+
+void Sema::check_memo(ast::Program& prog) {
+    // A function is impure if it calls an effectful built-in (print, log)
+    // or anything impure; iterate to a fixpoint so call cycles settle
+    std::unordered_set<std::string> impure;
+    for (const auto& [name, sig] : functions_) {
+        if (sig.has_effects) impure.insert(name);
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& [name, sites] : calls_) {
+            if (impure.count(name)) continue;
+            for (const auto& site : sites) {
+                if (impure.count(site.callee)) {
+                    impure.insert(name);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    
+    for (const auto& fn : prog.functions) {
+        if (!fn.has_attribute("memo") || !impure.count(fn.name)) continue;
+        for (const auto& site : calls_[fn.name]) {
+            if (impure.count(site.callee)) {
+                error(ErrorKind::INVALID_ATTRIBUTE,
+                      "@memo function '" + fn.name + "' is not pure: it calls '" +
+                      site.callee + "'", site.span);
+                break;
+            }
+        }
+    }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Statement checking
 // ─────────────────────────────────────────────────────────────────────────────
@@ -172,17 +313,33 @@ void Sema::check_stmt(ast::Stmt& stmt) {
             
             types::Type var_type = init_type;
             if (s.type_annot) {
-                var_type = ast_to_types(s.type_annot->kind);
+                check_type(*s.type_annot);
+                var_type = ast_to_types(*s.type_annot);
                 // Check type compatibility
                 if (!init_type.is_unknown() && !types::types_compatible(var_type, init_type)) {
                     error(ErrorKind::TYPE_MISMATCH,
                           "Type mismatch: expected " + var_type.to_string() + 
                           ", got " + init_type.to_string(), s.span);
+                } else if (var_type.is_tensor() && init_type.is_tensor()) {
+                    // Keep whatever the initializer adds to the annotation
+                    var_type = *types::unify_tensor(var_type, init_type);
                 }
             }
             
             declare(s.name, var_type, s.span);
         }
+        else if constexpr (std::is_same_v<T, ast::AssignStmt>) {
+            types::Type value_type = s.value ? check_expr(*s.value) : types::Type::make_unknown();
+            auto var_type = lookup(s.name);
+            if (!var_type) {
+                error(ErrorKind::UNDEFINED_VARIABLE,
+                      "Undefined variable: " + s.name, s.span);
+            } else if (!types::types_compatible(*var_type, value_type)) {
+                error(ErrorKind::TYPE_MISMATCH,
+                      "Type mismatch: cannot assign " + value_type.to_string() +
+                      " to " + var_type->to_string(), s.span);
+            }
+        }
         else if constexpr (std::is_same_v<T, ast::ReturnStmt>) {
             types::Type ret_type = types::Type::make_void();
             if (s.value) {
@@ -268,6 +425,9 @@ types::Type Sema::check_expr(ast::Expr& expr) {
         else if constexpr (std::is_same_v<T, ast::BinaryExpr>) {
             types::Type left = e.left ? check_expr(*e.left) : types::Type::make_unknown();
             types::Type right = e.right ? check_expr(*e.right) : types::Type::make_unknown();
+            if (left.is_tensor() && right.is_tensor()) {
+                return check_tensor_binary(e, left, right);
+            }
             return types::binary_result_type(left, right);
         }
         else if constexpr (std::is_same_v<T, ast::UnaryExpr>) {
@@ -280,6 +440,7 @@ types::Type Sema::check_expr(ast::Expr& expr) {
                       "Undefined function: " + e.callee, e.span);
                 return types::Type::make_unknown();
             }
+            calls_[current_fn_].push_back({e.callee, e.span});
             
             const FnSignature& sig = it->second;
             
@@ -292,15 +453,24 @@ types::Type Sema::check_expr(ast::Expr& expr) {
             }
             
             // Check argument types
-            for (size_t i = 0; i < e.args.size() && i < sig.param_types.size(); ++i) {
+            std::vector<types::Type> arg_types;
+            for (size_t i = 0; i < e.args.size(); ++i) {
                 types::Type arg_type = check_expr(*e.args[i]);
-                if (!types::types_compatible(sig.param_types[i], arg_type)) {
-                    error(ErrorKind::TYPE_MISMATCH,
-                          "Argument " + std::to_string(i + 1) + " type mismatch", 
-                          e.args[i]->span());
+                arg_types.push_back(arg_type);
+                if (i < sig.param_types.size() &&
+                    !types::types_compatible(sig.param_types[i], arg_type)) {
+                    std::string msg = "Argument " + std::to_string(i + 1) + " type mismatch";
+                    if (arg_type.is_tensor()) {
+                        msg += ": expected " + sig.param_types[i].to_string() +
+                               ", got " + arg_type.to_string();
+                    }
+                    error(ErrorKind::TYPE_MISMATCH, msg, e.args[i]->span());
                 }
             }
             
+            if (tensor_builtins_.count(e.callee)) {
+                return check_tensor_builtin(e, arg_types);
+            }
             return sig.return_type;
         }
         else if constexpr (std::is_same_v<T, ast::GroupExpr>) {
@@ -312,5 +482,212 @@ types::Type Sema::check_expr(ast::Expr& expr) {
     }, expr.data);
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor shape inference
+// ─────────────────────────────────────────────────────────────────────────────
+
+types::Type Sema::check_tensor_binary(ast::BinaryExpr& e, const types::Type& left,
+                                      const types::Type& right) {
+    if (e.op != ast::BinOp::ADD && e.op != ast::BinOp::SUB && e.op != ast::BinOp::MUL) {
+        error(ErrorKind::TYPE_MISMATCH,
+              std::string("Operator '") + ast::binop_str(e.op) + "' is not defined on tensors",
+              e.span);
+        return types::Type::make_unknown();
+    }
+    auto result = types::elementwise_type(left, right);
+    if (!result) {
+        error(ErrorKind::TYPE_MISMATCH,
+              std::string("Tensor shape mismatch: ") + left.to_string() + " " +
+              ast::binop_str(e.op) + " " + right.to_string(), e.span);
+        return types::Type::make_tensor();
+    }
+    return *result;
+}
+
+types::Type Sema::check_tensor_builtin(ast::CallExpr& e, const std::vector<types::Type>& args) {
+    if (e.callee == "tensor" || e.callee == "fill") {
+        // Literal dimensions are static; anything else is known at run time
+        const size_t first = e.callee == "fill" ? 1 : 0;
+        std::vector<int64_t> dims;
+        for (size_t i = first; i < e.args.size(); ++i) {
+            if (!args[i].is_unknown() && !args[i].is_int()) {
+                error(ErrorKind::TYPE_MISMATCH,
+                      "Tensor dimension must be an int, got " + args[i].to_string(),
+                      e.args[i]->span());
+            }
+            auto size = e.args[i]->int_constant();
+            if (size && *size < 0) {
+                error(ErrorKind::TYPE_MISMATCH,
+                      "Tensor dimension must not be negative", e.args[i]->span());
+                size.reset();
+            }
+            dims.push_back(size ? *size : types::DYNAMIC_DIM);
+        }
+        return types::Type::make_tensor(types::DType::F32, std::move(dims));
+    }
+    if (e.callee == "relu" && args.size() == 1) {
+        return args[0].is_tensor() ? args[0] : types::Type::make_tensor();
+    }
+    if ((e.callee == "exp" || e.callee == "tanh" || e.callee == "sigmoid" || e.callee == "gelu") &&
+        args.size() == 1) {
+        const types::TensorType* source = args[0].tensor_type();
+        if (source && source->dtype == types::DType::I64) {
+            error(ErrorKind::TYPE_MISMATCH,
+                  "Function '" + e.callee + "' needs a floating-point tensor, got " +
+                  args[0].to_string(), e.args[0]->span());
+        }
+        return args[0].is_tensor() ? args[0] : types::Type::make_tensor();
+    }
+    if (e.callee == "matmul" && args.size() == 2) {
+        auto result = types::matmul_type(args[0], args[1]);
+        if (!result) {
+            error(ErrorKind::TYPE_MISMATCH,
+                  "Cannot multiply " + args[0].to_string() + " by " + args[1].to_string(),
+                  e.span);
+            return types::Type::make_tensor();
+        }
+        return *result;
+    }
+    if (e.callee == "reshape" || e.callee == "broadcast" || e.callee == "transpose" ||
+        e.callee == "slice") {
+        return check_tensor_view(e, args);
+    }
+    if (e.callee == "sum" || e.callee == "mean" || e.callee == "max" || e.callee == "argmax" ||
+        e.callee == "softmax" || e.callee == "layernorm") {
+        return check_tensor_reduce(e, args);
+    }
+    return types::Type::make_tensor();
+}
+
+types::Type Sema::check_tensor_view(ast::CallExpr& e, const std::vector<types::Type>& args) {
+    const bool transpose = e.callee == "transpose", slice = e.callee == "slice";
+    const bool count_ok = transpose ? args.size() == 1 || args.size() == 3
+                        : slice ? args.size() == 4 || args.size() == 5
+                        : args.size() >= 2;
+    if (!count_ok) {
+        const char* expected = transpose ? "1 or 3" : slice ? "4 or 5" : "at least 2";
+        error(ErrorKind::WRONG_ARG_COUNT,
+              "Function '" + e.callee + "' expects " + expected + " arguments, got " +
+              std::to_string(args.size()), e.span);
+        return types::Type::make_tensor();
+    }
+    
+    // Everything after the tensor is an int; constants refine the shape
+    std::vector<std::optional<int64_t>> constants;
+    for (size_t i = 1; i < e.args.size(); ++i) {
+        if (!args[i].is_unknown() && !args[i].is_int()) {
+            error(ErrorKind::TYPE_MISMATCH,
+                  "Argument " + std::to_string(i + 1) + " of '" + e.callee +
+                  "' must be an int, got " + args[i].to_string(), e.args[i]->span());
+        }
+        constants.push_back(e.args[i]->int_constant());
+    }
+    
+    const types::TensorType* source = args[0].tensor_type();
+    const types::DType dtype = source ? source->dtype : types::DType::F32;
+    std::optional<types::Type> result;
+    if (e.callee == "reshape" || e.callee == "broadcast") {
+        // -1 infers a reshaped dimension and is as good as unknown
+        std::vector<int64_t> dims;
+        for (const auto& c : constants) {
+            dims.push_back(c && *c >= 0 ? *c : types::DYNAMIC_DIM);
+        }
+        const types::Type target = types::Type::make_tensor(dtype, dims);
+        if (e.callee == "reshape") {
+            result = types::reshape_type(args[0], dims);
+        } else {
+            // The source must broadcast to the target, not widen it
+            auto merged = types::elementwise_type(args[0], target);
+            const types::TensorType* tm = merged ? merged->tensor_type() : nullptr;
+            if (merged && (!tm || !tm->ranked)) {
+                result = target;
+            } else if (merged && tm->dims.size() == dims.size()) {
+                result = merged;
+                for (size_t i = 0; i < dims.size(); ++i) {
+                    if (dims[i] != types::DYNAMIC_DIM && tm->dims[i] != dims[i]) result.reset();
+                }
+            }
+        }
+        if (!result) {
+            error(ErrorKind::TYPE_MISMATCH,
+                  std::string("Cannot ") + e.callee + " " + args[0].to_string() + " to " +
+                  target.to_string(), e.span);
+            return target;
+        }
+        return *result;
+    }
+    
+    if (transpose) {
+        result = args.size() == 1 ? types::transpose_type(args[0], -2, -1)
+                                  : types::transpose_type(args[0], constants[0], constants[1]);
+    } else {
+        result = types::slice_type(args[0], constants[0], constants[1], constants[2],
+                                   args.size() == 5 ? constants[3] : std::optional<int64_t>(1));
+    }
+    if (!result) {
+        error(ErrorKind::TYPE_MISMATCH,
+              std::string("Invalid ") + e.callee + " of " + args[0].to_string(), e.span);
+        return types::Type::make_tensor();
+    }
+    return *result;
+}
+
+types::Type Sema::check_tensor_reduce(ast::CallExpr& e, const std::vector<types::Type>& args) {
+    const bool layernorm = e.callee == "layernorm";
+    if (layernorm ? args.size() != 1 && args.size() != 3 : args.size() != 1 && args.size() != 2) {
+        error(ErrorKind::WRONG_ARG_COUNT,
+              "Function '" + e.callee + "' expects " + (layernorm ? "1 or 3" : "1 or 2") +
+              " arguments, got " + std::to_string(args.size()), e.span);
+        return types::Type::make_tensor();
+    }
+    
+    const types::TensorType* source = args[0].tensor_type();
+    if (source && source->dtype == types::DType::I64 && e.callee != "sum" && e.callee != "max" &&
+        e.callee != "argmax") {
+        error(ErrorKind::TYPE_MISMATCH,
+              "Function '" + e.callee + "' needs a floating-point tensor, got " +
+              args[0].to_string(), e.args[0]->span());
+    }
+    
+    if (layernorm) {
+        // gamma and beta scale and shift each row
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (!args[i].is_unknown() && !args[i].is_tensor()) {
+                error(ErrorKind::TYPE_MISMATCH,
+                      "Argument " + std::to_string(i + 1) + " of 'layernorm' must be a tensor, got " +
+                      args[i].to_string(), e.args[i]->span());
+            }
+        }
+        return args[0].is_tensor() ? args[0] : types::Type::make_tensor();
+    }
+    
+    std::optional<int64_t> axis;
+    if (args.size() == 2) {
+        if (!args[1].is_unknown() && !args[1].is_int()) {
+            error(ErrorKind::TYPE_MISMATCH,
+                  "Argument 2 of '" + e.callee + "' must be an int, got " + args[1].to_string(),
+                  e.args[1]->span());
+        }
+        axis = e.args[1]->int_constant();
+    }
+    
+    std::optional<types::Type> result;
+    if (e.callee == "softmax") {
+        // Same shape; only the axis can be wrong
+        result = types::reduce_type(args[0], false, args.size() == 2 ? axis : std::optional<int64_t>(-1));
+        if (result) result = args[0].is_tensor() ? args[0] : types::Type::make_tensor();
+    } else {
+        result = types::reduce_type(args[0], args.size() == 1, axis,
+                                    e.callee == "argmax" ? std::optional<types::DType>(types::DType::I64)
+                                                         : std::nullopt);
+    }
+    if (!result) {
+        error(ErrorKind::TYPE_MISMATCH,
+              "Invalid axis for " + e.callee + " of " + args[0].to_string(), e.span);
+        return types::Type::make_tensor();
+    }
+    return *result;
+}
+
 } // namespace sema
 } // namespace zero
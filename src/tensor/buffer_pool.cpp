@@ -0,0 +1,115 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief Zero Compiler — Tensor Buffer Pool Implementation
+ */
+
+#include "tensor/buffer_pool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+size_t bucket(size_t bytes) {
+    return (std::max<size_t>(bytes, 1) + BufferPool::ALIGNMENT - 1) / BufferPool::ALIGNMENT *
+           BufferPool::ALIGNMENT;
+}
+
+size_t default_pool_bytes() {
+    if (const char* env = std::getenv("ZERO_TENSOR_POOL_MB")) {
+        char* end = nullptr;
+        unsigned long long mb = std::strtoull(env, &end, 10);
+        if (end != env) return static_cast<size_t>(mb) << 20;
+    }
+    return size_t(256) << 20;
+}
+
+} // anonymous namespace
+
+BufferPool::BufferPool(size_t max_pooled_bytes) : max_pooled_(max_pooled_bytes) {}
+
+BufferPool::~BufferPool() {
+    trim();
+}
+
+BufferPool& BufferPool::global() {
+    static BufferPool pool(default_pool_bytes());
+    return pool;
+}
+
+void* BufferPool::acquire(size_t bytes) {
+    const size_t size = bucket(bytes);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.allocations;
+        stats_.live_bytes += size;
+        stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.live_bytes);
+
+        auto it = free_.find(size);
+        if (it != free_.end() && !it->second.empty()) {
+            void* p = it->second.back();
+            it->second.pop_back();
+            stats_.pooled_bytes -= size;
+            ++stats_.reused;
+            return p;
+        }
+    }
+    try {
+        return ::operator new(size, std::align_val_t(ALIGNMENT));
+    } catch (...) {
+        // Give the pool back to the system and try once more
+        trim();
+        try {
+            return ::operator new(size, std::align_val_t(ALIGNMENT));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --stats_.allocations;
+            stats_.live_bytes -= size;
+            throw;
+        }
+    }
+}
+
+void BufferPool::release(void* p, size_t bytes) {
+    if (!p) return;
+    const size_t size = bucket(bytes);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.live_bytes -= size;
+        if (stats_.pooled_bytes + size <= max_pooled_) {
+            free_[size].push_back(p);
+            stats_.pooled_bytes += size;
+            return;
+        }
+    }
+    ::operator delete(p, std::align_val_t(ALIGNMENT));
+}
+
+void BufferPool::trim() {
+    std::unordered_map<size_t, std::vector<void*>> free;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free.swap(free_);
+        stats_.pooled_bytes = 0;
+    }
+    for (auto& [size, buffers] : free) {
+        for (void* p : buffers) ::operator delete(p, std::align_val_t(ALIGNMENT));
+    }
+}
+
+MemoryStats BufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void BufferPool::reset_peak() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.peak_bytes = stats_.live_bytes;
+}
+
+} // namespace tensor
+} // namespace zero
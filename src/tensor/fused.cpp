@@ -0,0 +1,284 @@
+/**
+ * @file fused.cpp
+ * @brief Zero Compiler — Fused Elementwise Kernels Implementation
+ */
+
+#include "tensor/fused.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+// Bytes per slot per block: a few scratch slots plus the inputs' and
+// output's current blocks stay well inside L1
+constexpr size_t BLOCK_BYTES = 4096;
+
+[[noreturn]] void bad_program(const std::string& program, const std::string& why) {
+    throw TensorError("tensor.fused: " + why + " in \"" + program + "\"");
+}
+
+/**
+ * The input index of an "xK" token, or -1 if it is not one.
+ */
+long input_index(const std::string& token) {
+    if (token.size() < 2 || token[0] != 'x') return -1;
+    if (!std::all_of(token.begin() + 1, token.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return -1;
+    }
+    return token.size() > 7 ? -1 : std::stol(token.substr(1));
+}
+
+/**
+ * The UnaryOp a token names; false if it names none.
+ */
+bool unary_op(const std::string& token, UnaryOp& op) {
+    static const char* const NAMES[] = {"relu", "exp", "tanh", "sigmoid", "gelu"};
+    static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == static_cast<size_t>(UnaryOp::COUNT),
+                  "one token per UnaryOp");
+    for (size_t i = 0; i < static_cast<size_t>(UnaryOp::COUNT); ++i) {
+        if (token == NAMES[i]) {
+            op = static_cast<UnaryOp>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Reads a strided or broadcast view in row-major order, a block at a
+ * time, into contiguous scratch.
+ */
+class BlockReader {
+public:
+    explicit BlockReader(const Tensor& t)
+        : base_(static_cast<const char*>(t.raw_data())),
+          size_(types::dtype_size(t.dtype())),
+          shape_(t.shape()),
+          strides_(t.strides()),
+          index_(t.ndim(), 0) {}
+
+    /**
+     * Copy the next `n` elements to `dst`.
+     */
+    void read(char* dst, size_t n) {
+        if (shape_.empty()) {
+            for (size_t i = 0; i < n; ++i) std::memcpy(dst + i * size_, base_, size_);
+            return;
+        }
+        const size_t last = shape_.size() - 1;
+        const int64_t stride = strides_[last];
+        while (n) {
+            // The rest of the current innermost row, or as much as fits
+            const size_t run = std::min(n, static_cast<size_t>(shape_[last] - index_[last]));
+            const char* src = base_ + (offset_ + index_[last] * stride) * static_cast<int64_t>(size_);
+            if (stride == 1) {
+                std::memcpy(dst, src, run * size_);
+            } else {
+                for (size_t i = 0; i < run; ++i) {
+                    std::memcpy(dst + i * size_, src + static_cast<int64_t>(i) * stride *
+                                static_cast<int64_t>(size_), size_);
+                }
+            }
+            dst += run * size_;
+            n -= run;
+            index_[last] += static_cast<int64_t>(run);
+            if (index_[last] == shape_[last]) next_row();
+        }
+    }
+
+private:
+    void next_row() {
+        index_.back() = 0;
+        for (size_t d = shape_.size() - 1; d-- > 0;) {
+            offset_ += strides_[d];
+            if (++index_[d] < shape_[d]) return;
+            offset_ -= strides_[d] * shape_[d];
+            index_[d] = 0;
+        }
+    }
+
+    const char* base_;
+    size_t size_;
+    Tensor::Shape shape_;
+    Tensor::Shape strides_;
+    std::vector<int64_t> index_;
+    int64_t offset_ = 0;        // Of the current row's first element
+};
+
+} // anonymous namespace
+
+FusedKernel::FusedKernel(const std::string& program) : program_(program) {
+    std::vector<std::string> tokens;
+    std::istringstream in(program);
+    for (std::string t; in >> t;) tokens.push_back(t);
+
+    for (const std::string& t : tokens) {
+        long k = input_index(t);
+        if (k >= 0) inputs_ = std::max(inputs_, static_cast<size_t>(k) + 1);
+    }
+
+    // Slot ids: inputs are 0 .. inputs_ - 1, scratch slots follow. A
+    // step writes over the first scratch operand it consumes, so the
+    // scratch needed is the deepest run of pending intermediate values.
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> free_slots;
+    auto release = [&](uint32_t slot) {
+        if (slot >= inputs_) free_slots.push_back(slot);
+    };
+    auto pop = [&]() {
+        if (stack.empty()) bad_program(program, "operand stack underflow");
+        uint32_t slot = stack.back();
+        stack.pop_back();
+        return slot;
+    };
+
+    for (const std::string& t : tokens) {
+        long k = input_index(t);
+        if (k >= 0) {
+            stack.push_back(static_cast<uint32_t>(k));
+            continue;
+        }
+
+        Step step{};
+        UnaryOp unary;
+        if (t == "add" || t == "sub" || t == "mul") {
+            step.op = static_cast<uint8_t>(t == "add" ? BinaryOp::ADD
+                                           : t == "sub" ? BinaryOp::SUB : BinaryOp::MUL);
+            step.b = pop();
+            step.a = pop();
+            release(step.b);
+        } else if (unary_op(t, unary)) {
+            step.unary = true;
+            step.op = static_cast<uint8_t>(unary);
+            step.a = pop();
+        } else {
+            bad_program(program, "unknown operation '" + t + "'");
+        }
+        release(step.a);
+
+        if (free_slots.empty()) {
+            free_slots.push_back(static_cast<uint32_t>(inputs_ + scratch_++));
+        }
+        // Reuse the slot released last; for a binary op that is its
+        // left operand, so running sums stay in one slot
+        step.dst = free_slots.back();
+        free_slots.pop_back();
+        stack.push_back(step.dst);
+        steps_.push_back(step);
+    }
+
+    if (steps_.empty()) bad_program(program, "no operations");
+    if (stack.size() != 1 || stack.back() != steps_.back().dst) {
+        bad_program(program, "program must leave exactly one computed value");
+    }
+    steps_.back().dst = OUTPUT;
+}
+
+Tensor FusedKernel::run(const std::vector<const Tensor*>& inputs, const KernelTable* kernels,
+                        Tensor dst) const {
+    if (inputs.size() != inputs_) {
+        throw TensorError("tensor.fused: expected " + std::to_string(inputs_) +
+                          " inputs, got " + std::to_string(inputs.size()));
+    }
+    for (const Tensor* t : inputs) {
+        if (!t || !t->defined()) throw TensorError("tensor.fused: undefined tensor");
+    }
+
+    const DType dtype = inputs[0]->dtype();
+    Tensor::Shape shape = inputs[0]->shape();
+    for (const Tensor* t : inputs) {
+        if (t->dtype() != dtype) {
+            throw TensorError(std::string("tensor.fused: dtype mismatch (") +
+                              types::dtype_name(dtype) + " vs " +
+                              types::dtype_name(t->dtype()) + ")");
+        }
+        if (broadcasts_to(t->shape(), shape)) continue;
+        try {
+            shape = broadcast_shapes(shape, t->shape());
+        } catch (const TensorError&) {
+            throw TensorError("tensor.fused: shape mismatch (" + shape_string(shape) +
+                              " vs " + shape_string(t->shape()) + ")");
+        }
+    }
+
+    const KernelTable& table = kernels ? *kernels : active_kernels();
+    Tensor out = fits(dst, shape, dtype) ? std::move(dst) : Tensor::empty(shape, dtype);
+    const size_t n = out.numel();
+    if (n == 0) return out;
+
+    // Inputs of the full shape, laid out contiguously, are walked in
+    // place; broadcast or strided ones are gathered a block at a time
+    std::vector<const char*> base(inputs.size(), nullptr);
+    std::vector<BlockReader> readers;
+    std::vector<size_t> gathered;
+    for (size_t k = 0; k < inputs.size(); ++k) {
+        if (inputs[k]->shape() == shape && inputs[k]->is_contiguous()) {
+            base[k] = static_cast<const char*>(inputs[k]->raw_data());
+        } else {
+            readers.emplace_back(inputs[k]->broadcast_to(shape));
+            gathered.push_back(k);
+        }
+    }
+
+    struct Resolved {
+        BinaryKernel binary;
+        UnaryKernel unary;
+    };
+    std::vector<Resolved> fns(steps_.size());
+    for (size_t s = 0; s < steps_.size(); ++s) {
+        const Step& st = steps_[s];
+        if (st.unary) {
+            fns[s].unary = table.get(static_cast<UnaryOp>(st.op), dtype);
+            if (!fns[s].unary) {
+                throw TensorError(std::string("tensor.fused: \"") + program_ +
+                                  "\" needs a floating-point dtype, got " + types::dtype_name(dtype));
+            }
+        } else {
+            fns[s].binary = table.get(static_cast<BinaryOp>(st.op), dtype);
+        }
+    }
+
+    const size_t size = types::dtype_size(dtype);
+    const size_t block = BLOCK_BYTES / size;
+    thread_local std::vector<uint64_t> scratch;
+    scratch.resize((scratch_ + gathered.size()) * BLOCK_BYTES / sizeof(uint64_t));
+    char* const blocks = reinterpret_cast<char*>(scratch.data());
+
+    std::vector<char*> slots(inputs_ + scratch_);
+    for (size_t s = 0; s < scratch_; ++s) {
+        slots[inputs_ + s] = blocks + s * BLOCK_BYTES;
+    }
+    for (size_t g = 0; g < gathered.size(); ++g) {
+        slots[gathered[g]] = blocks + (scratch_ + g) * BLOCK_BYTES;
+    }
+    char* po = static_cast<char*>(out.raw_data());
+
+    for (size_t i = 0; i < n; i += block) {
+        const size_t len = std::min(block, n - i);
+        for (size_t k = 0; k < inputs_; ++k) {
+            if (base[k]) slots[k] = const_cast<char*>(base[k] + i * size);
+        }
+        for (size_t g = 0; g < gathered.size(); ++g) {
+            readers[g].read(slots[gathered[g]], len);
+        }
+        for (size_t s = 0; s < steps_.size(); ++s) {
+            const Step& st = steps_[s];
+            char* target = st.dst == OUTPUT ? po + i * size : slots[st.dst];
+            if (st.unary) {
+                fns[s].unary(slots[st.a], target, len);
+            } else {
+                fns[s].binary(slots[st.a], slots[st.b], target, len);
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace tensor
+} // namespace zero
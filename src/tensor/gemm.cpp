@@ -0,0 +1,197 @@
+/**
+ * @file gemm.cpp
+ * @brief Zero Compiler — Blocked Matrix Multiplication Implementation
+ */
+
+#include "tensor/gemm.hpp"
+#include "tensor/tensor.hpp"
+#include "tensor/thread_pool.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+// Block sizes: a KC x NR panel of B stays in L1, an MC x KC block of A in
+// L2 and a KC x NC block of B in L3. MC and NC are rounded up to whole
+// micro-panels.
+constexpr size_t KC = 256;
+constexpr size_t MC = 96;
+constexpr size_t NC = 2048;
+
+// Largest mr x nr tile any micro-kernel uses
+constexpr size_t MAX_TILE = 384;
+
+// Products smaller than this (in flops) are not worth waking the pool
+constexpr double PARALLEL_FLOPS = 4e6;
+
+size_t round_up(size_t x, size_t multiple) {
+    return (x + multiple - 1) / multiple * multiple;
+}
+
+size_t ceil_div(size_t x, size_t y) {
+    return (x + y - 1) / y;
+}
+
+/**
+ * Copy rows [0, rows) x columns [0, kc) of `a` into MR-tall panels, each
+ * stored k-major and zero-padded to MR rows.
+ */
+template <typename T>
+void pack_a(T* dst, const T* a, int64_t rs, int64_t cs, size_t rows, size_t kc, size_t mr) {
+    for (size_t i0 = 0; i0 < rows; i0 += mr) {
+        const size_t h = std::min(mr, rows - i0);
+        for (size_t p = 0; p < kc; ++p) {
+            const T* src = a + static_cast<int64_t>(i0) * rs + static_cast<int64_t>(p) * cs;
+            size_t i = 0;
+            for (; i < h; ++i) dst[i] = src[static_cast<int64_t>(i) * rs];
+            for (; i < mr; ++i) dst[i] = T(0);
+            dst += mr;
+        }
+    }
+}
+
+/**
+ * Copy one NR-wide panel (columns [0, cols) of `b`, rows [0, kc)) row by
+ * row, zero-padded to NR columns.
+ */
+template <typename T>
+void pack_b_panel(T* dst, const T* b, int64_t rs, int64_t cs, size_t kc, size_t cols, size_t nr) {
+    for (size_t p = 0; p < kc; ++p) {
+        const T* src = b + static_cast<int64_t>(p) * rs;
+        size_t j = 0;
+        if (cs == 1) {
+            std::copy(src, src + cols, dst);
+            j = cols;
+        } else {
+            for (; j < cols; ++j) dst[j] = src[static_cast<int64_t>(j) * cs];
+        }
+        for (; j < nr; ++j) dst[j] = T(0);
+        dst += nr;
+    }
+}
+
+template <typename T>
+void gemm_typed(size_t m, size_t n, size_t k, const MatrixView& a, const MatrixView& b,
+                T* c, size_t ldc, const GemmMicroKernel& uk, ThreadPool& pool, size_t threads) {
+    const size_t mr = uk.mr, nr = uk.nr;
+    if (mr * nr > MAX_TILE) throw TensorError("tensor.matmul: micro-kernel tile too large");
+    const size_t mc = round_up(MC, mr);
+    const size_t nc = round_up(NC, nr);
+    const T* pa = static_cast<const T*>(a.data);
+    const T* pb = static_cast<const T*>(b.data);
+
+    // Per call rather than per thread: while it waits for the pool, this
+    // thread may run tasks of another product, and that one's packing
+    // must not resize the panels our tasks are still reading
+    std::vector<T> b_pack(ceil_div(std::min(nc, n), nr) * std::min(KC, k) * nr);
+
+    for (size_t jc = 0; jc < n; jc += nc) {
+        const size_t ncur = std::min(nc, n - jc);
+        const size_t panels = ceil_div(ncur, nr);
+
+        for (size_t pc = 0; pc < k; pc += KC) {
+            const size_t kcur = std::min(KC, k - pc);
+            const bool accumulate = pc > 0;
+
+            const T* bblock = pb + static_cast<int64_t>(pc) * b.row_stride +
+                              static_cast<int64_t>(jc) * b.col_stride;
+            T* bpacked = b_pack.data();
+            pool.parallel_for(panels, [&](size_t jp) {
+                pack_b_panel(bpacked + jp * kcur * nr,
+                             bblock + static_cast<int64_t>(jp * nr) * b.col_stride,
+                             b.row_stride, b.col_stride, kcur, std::min(nr, ncur - jp * nr), nr);
+            }, threads);
+
+            // Tasks are MC-row blocks times runs of B panels; skinny
+            // products with a single row block still split by columns
+            const size_t mblocks = ceil_div(m, mc);
+            size_t chunks = threads > 1 ? std::min(panels, ceil_div(2 * threads, mblocks)) : 1;
+            const size_t per_chunk = ceil_div(panels, chunks);
+            chunks = ceil_div(panels, per_chunk);
+
+            pool.parallel_for(mblocks * chunks, [&](size_t task) {
+                const size_t ic = task / chunks * mc;
+                const size_t mcur = std::min(mc, m - ic);
+                const size_t jp_end = std::min(panels, (task % chunks + 1) * per_chunk);
+
+                // Nothing in here waits, so no other task runs on this
+                // thread while the A block is packed
+                thread_local std::vector<T> a_pack;
+                a_pack.resize(round_up(mcur, mr) * kcur);
+                pack_a(a_pack.data(),
+                       pa + static_cast<int64_t>(ic) * a.row_stride +
+                           static_cast<int64_t>(pc) * a.col_stride,
+                       a.row_stride, a.col_stride, mcur, kcur, mr);
+
+                alignas(64) T tile[MAX_TILE];
+                for (size_t jp = task % chunks * per_chunk; jp < jp_end; ++jp) {
+                    const size_t j0 = jc + jp * nr;
+                    const size_t w = std::min(nr, n - j0);
+                    const T* bp = bpacked + jp * kcur * nr;
+                    for (size_t ir = 0; ir < mcur; ir += mr) {
+                        const size_t h = std::min(mr, mcur - ir);
+                        const T* ap = a_pack.data() + ir * kcur;
+                        T* cp = c + (ic + ir) * ldc + j0;
+                        if (h == mr && w == nr) {
+                            uk.fn(kcur, ap, bp, cp, ldc, accumulate);
+                            continue;
+                        }
+                        // Edge tile: compute it whole, keep the part inside c
+                        uk.fn(kcur, ap, bp, tile, nr, false);
+                        for (size_t i = 0; i < h; ++i) {
+                            T* row = cp + i * ldc;
+                            const T* t = tile + i * nr;
+                            for (size_t j = 0; j < w; ++j) row[j] = accumulate ? row[j] + t[j] : t[j];
+                        }
+                    }
+                }
+            }, threads);
+        }
+    }
+}
+
+} // anonymous namespace
+
+void gemm(types::DType dtype, int64_t m, int64_t n, int64_t k,
+          const MatrixView& a, const MatrixView& b, void* c, int64_t ldc,
+          const GemmOptions& options) {
+    if (m <= 0 || n <= 0) return;
+    const size_t um = static_cast<size_t>(m), un = static_cast<size_t>(n);
+    const size_t uk = static_cast<size_t>(std::max<int64_t>(k, 0));
+    const size_t uldc = static_cast<size_t>(ldc);
+    const size_t size = types::dtype_size(dtype);
+
+    if (uk == 0) {
+        for (size_t i = 0; i < um; ++i) {
+            std::fill_n(static_cast<unsigned char*>(c) + i * uldc * size, un * size, 0);
+        }
+        return;
+    }
+
+    const KernelTable& table = options.kernels ? *options.kernels : active_kernels();
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::global();
+    size_t threads = options.max_threads ? std::min(options.max_threads, pool.size()) : pool.size();
+    if (2.0 * static_cast<double>(um) * static_cast<double>(un) * static_cast<double>(uk) < PARALLEL_FLOPS) {
+        threads = 1;
+    }
+
+    switch (dtype) {
+        case types::DType::F32:
+            gemm_typed(um, un, uk, a, b, static_cast<float*>(c), uldc,
+                       table.get_gemm(dtype), pool, threads);
+            break;
+        case types::DType::F64:
+            gemm_typed(um, un, uk, a, b, static_cast<double*>(c), uldc,
+                       table.get_gemm(dtype), pool, threads);
+            break;
+        default:
+            throw TensorError(std::string("tensor.matmul: no GEMM for ") + types::dtype_name(dtype));
+    }
+}
+
+} // namespace tensor
+} // namespace zero
@@ -0,0 +1,231 @@
+#ifndef ZERO_TENSOR_KERNEL_TEMPLATES_HPP
+#define ZERO_TENSOR_KERNEL_TEMPLATES_HPP
+
+/**
+ * @file kernel_templates.hpp
+ * @brief Zero Compiler — Elementwise, Reduction and GEMM Kernel Loops
+ *
+ * The loops behind every KernelTable entry, written once over an ISA's
+ * vector struct S (see kernels_sse2.cpp), for the per-ISA kernel files
+ * only. Like vector_math.hpp it all lives in an anonymous namespace, so
+ * each of those translation units compiles its own copy with its own
+ * target flags.
+ *
+ * An S with a mask type M (AVX-512) finishes each loop with masked
+ * loads and stores and reduces with its own hadd and hmax; any other S
+ * finishes with a scalar loop that wraps i64 like the vector lanes.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace zero {
+namespace tensor {
+namespace {
+
+// Scalar tails: i64 wraps around like the vector lanes
+template <typename T> struct Wrap { using U = T; };
+template <> struct Wrap<int64_t> { using U = uint64_t; };
+template <typename T> using W = typename Wrap<T>::U;
+
+template <typename S, typename = void> struct Masked : std::false_type {};
+template <typename S> struct Masked<S, std::void_t<typename S::M>> : std::true_type {};
+
+struct Add {
+    template <typename S> static typename S::V vec(typename S::V a, typename S::V b) { return S::add(a, b); }
+    template <typename T> static T one(T a, T b) { return T(W<T>(a) + W<T>(b)); }
+};
+struct Sub {
+    template <typename S> static typename S::V vec(typename S::V a, typename S::V b) { return S::sub(a, b); }
+    template <typename T> static T one(T a, T b) { return T(W<T>(a) - W<T>(b)); }
+};
+struct Mul {
+    template <typename S> static typename S::V vec(typename S::V a, typename S::V b) { return S::mul(a, b); }
+    template <typename T> static T one(T a, T b) { return T(W<T>(a) * W<T>(b)); }
+};
+struct Relu {
+    template <typename S> static typename S::V vec(typename S::V a) { return S::relu(a); }
+    template <typename T> static T one(T a) { return a > T(0) ? a : T(0); }
+};
+struct Max {
+    template <typename S> static typename S::V vec(typename S::V a, typename S::V b) { return S::max(a, b); }
+    template <typename T> static T one(T a, T b) { return b > a ? b : a; }
+};
+
+// Longest run summed directly; longer ones are split in half
+constexpr size_t PAIRWISE_BLOCK = 256;
+
+/**
+ * Mask of the lanes from p + i up to p + n, at most S::W of them.
+ */
+template <typename S>
+typename S::M tail_mask(size_t i, size_t n) {
+    return n - i >= S::W ? typename S::M(~0u) : static_cast<typename S::M>((1u << (n - i)) - 1);
+}
+
+/**
+ * Combine the lanes of `v` with Op, lowest lane first.
+ */
+template <typename S, typename Op>
+typename S::T fold_lanes(typename S::V v) {
+    typename S::T lanes[S::W];
+    S::store(lanes, v);
+    typename S::T r = lanes[0];
+    for (size_t i = 1; i < S::W; ++i) r = Op::one(r, lanes[i]);
+    return r;
+}
+
+template <typename S, bool SQUARES>
+typename S::V term(typename S::V x) {
+    return SQUARES ? S::mul(x, x) : x;
+}
+
+template <typename S, bool SQUARES>
+typename S::T pairwise_sum(const typename S::T* p, size_t n) {
+    using V = typename S::V;
+    if (n > PAIRWISE_BLOCK) {
+        // Halves of whole vectors, so only the last run has a tail
+        const size_t half = n / 2 / S::W * S::W;
+        return Add::one(pairwise_sum<S, SQUARES>(p, half), pairwise_sum<S, SQUARES>(p + half, n - half));
+    }
+    V acc[4] = {S::zero(), S::zero(), S::zero(), S::zero()};
+    size_t i = 0;
+    for (; i + 4 * S::W <= n; i += 4 * S::W) {
+        for (size_t j = 0; j < 4; ++j) acc[j] = S::add(acc[j], term<S, SQUARES>(S::load(p + i + j * S::W)));
+    }
+    if constexpr (Masked<S>::value) {
+        // Masked-off lanes load as zero and add nothing
+        for (; i < n; i += S::W) acc[0] = S::add(acc[0], term<S, SQUARES>(S::load(tail_mask<S>(i, n), p + i)));
+        return S::hadd(S::add(S::add(acc[0], acc[1]), S::add(acc[2], acc[3])));
+    } else {
+        for (; i + S::W <= n; i += S::W) acc[0] = S::add(acc[0], term<S, SQUARES>(S::load(p + i)));
+        typename S::T s = fold_lanes<S, Add>(S::add(S::add(acc[0], acc[1]), S::add(acc[2], acc[3])));
+        for (; i < n; ++i) s = Add::one(s, SQUARES ? Mul::one(p[i], p[i]) : p[i]);
+        return s;
+    }
+}
+
+template <typename S, bool SQUARES>
+void sum(const void* a, size_t n, void* out) {
+    using T = typename S::T;
+    *static_cast<T*>(out) = pairwise_sum<S, SQUARES>(static_cast<const T*>(a), n);
+}
+
+template <typename S>
+void reduce_max(const void* a, size_t n, void* out) {
+    using T = typename S::T;
+    const T* pa = static_cast<const T*>(a);
+    size_t i = 0;
+    T m = pa[0];
+    if (n >= S::W) {
+        typename S::V acc = S::load(pa);
+        for (i = S::W; i + S::W <= n; i += S::W) acc = S::max(acc, S::load(pa + i));
+        if constexpr (Masked<S>::value) {
+            m = S::hmax(acc);
+        } else {
+            m = fold_lanes<S, Max>(acc);
+        }
+    }
+    for (; i < n; ++i) m = Max::one(m, pa[i]);
+    *static_cast<T*>(out) = m;
+}
+
+template <typename S>
+void affine(const void* a, void* out, size_t n, double shift, double scale) {
+    using T = typename S::T;
+    const T* pa = static_cast<const T*>(a);
+    T* po = static_cast<T*>(out);
+    const T s = static_cast<T>(shift), k = static_cast<T>(scale);
+    const typename S::V vs = S::set1(s), vk = S::set1(k);
+    size_t i = 0;
+    for (; i + S::W <= n; i += S::W) S::store(po + i, S::mul(S::add(S::load(pa + i), vs), vk));
+    if constexpr (Masked<S>::value) {
+        if (i < n) {
+            const typename S::M m = tail_mask<S>(i, n);
+            S::store(m, po + i, S::mul(S::add(S::load(m, pa + i), vs), vk));
+        }
+    } else {
+        for (; i < n; ++i) po[i] = (pa[i] + s) * k;
+    }
+}
+
+template <typename S, typename Op>
+void binary(const void* a, const void* b, void* out, size_t n) {
+    using T = typename S::T;
+    const T* pa = static_cast<const T*>(a);
+    const T* pb = static_cast<const T*>(b);
+    T* po = static_cast<T*>(out);
+    size_t i = 0;
+    for (; i + 2 * S::W <= n; i += 2 * S::W) {
+        typename S::V x0 = Op::template vec<S>(S::load(pa + i), S::load(pb + i));
+        typename S::V x1 = Op::template vec<S>(S::load(pa + i + S::W), S::load(pb + i + S::W));
+        S::store(po + i, x0);
+        S::store(po + i + S::W, x1);
+    }
+    if constexpr (Masked<S>::value) {
+        for (; i < n; i += S::W) {
+            const typename S::M m = tail_mask<S>(i, n);
+            S::store(m, po + i, Op::template vec<S>(S::load(m, pa + i), S::load(m, pb + i)));
+        }
+    } else {
+        for (; i < n; ++i) po[i] = Op::one(pa[i], pb[i]);
+    }
+}
+
+template <typename S, typename Op>
+void unary(const void* a, void* out, size_t n) {
+    using T = typename S::T;
+    const T* pa = static_cast<const T*>(a);
+    T* po = static_cast<T*>(out);
+    size_t i = 0;
+    for (; i + 2 * S::W <= n; i += 2 * S::W) {
+        typename S::V x0 = Op::template vec<S>(S::load(pa + i));
+        typename S::V x1 = Op::template vec<S>(S::load(pa + i + S::W));
+        S::store(po + i, x0);
+        S::store(po + i + S::W, x1);
+    }
+    if constexpr (Masked<S>::value) {
+        for (; i < n; i += S::W) {
+            const typename S::M m = tail_mask<S>(i, n);
+            S::store(m, po + i, Op::template vec<S>(S::load(m, pa + i)));
+        }
+    } else {
+        for (; i < n; ++i) po[i] = Op::one(pa[i]);
+    }
+}
+
+// Register-blocked GEMM tile: MR rows by NV vectors of accumulators
+template <typename S, size_t MR, size_t NV>
+void gemm_micro(size_t kc, const void* a, const void* b, void* c, size_t ldc, bool accumulate) {
+    using T = typename S::T;
+    using V = typename S::V;
+    constexpr size_t NR = NV * S::W;
+    const T* pa = static_cast<const T*>(a);
+    const T* pb = static_cast<const T*>(b);
+    T* pc = static_cast<T*>(c);
+    V acc[MR][NV];
+    for (size_t i = 0; i < MR; ++i) {
+        for (size_t v = 0; v < NV; ++v) acc[i][v] = S::zero();
+    }
+    for (size_t p = 0; p < kc; ++p, pa += MR, pb += NR) {
+        V bv[NV];
+        for (size_t v = 0; v < NV; ++v) bv[v] = S::load(pb + v * S::W);
+        for (size_t i = 0; i < MR; ++i) {
+            const V ai = S::set1(pa[i]);
+            for (size_t v = 0; v < NV; ++v) acc[i][v] = S::fma(ai, bv[v], acc[i][v]);
+        }
+    }
+    for (size_t i = 0; i < MR; ++i) {
+        for (size_t v = 0; v < NV; ++v) {
+            T* dst = pc + i * ldc + v * S::W;
+            S::store(dst, accumulate ? S::add(acc[i][v], S::load(dst)) : acc[i][v]);
+        }
+    }
+}
+
+} // anonymous namespace
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_KERNEL_TEMPLATES_HPP
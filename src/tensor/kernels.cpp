@@ -0,0 +1,249 @@
+/**
+ * @file kernels.cpp
+ * @brief Zero Compiler — Scalar Kernels and ISA Dispatch
+ */
+
+#include "tensor/kernels.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if ZERO_TENSOR_SIMD && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace zero {
+namespace tensor {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scalar kernels
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+// i64 arithmetic wraps around, as it does in the SIMD kernels
+template <typename T> struct Wrap { using U = T; };
+template <> struct Wrap<int64_t> { using U = uint64_t; };
+template <typename T> using W = typename Wrap<T>::U;
+
+struct Add { template <typename T> static T apply(T x, T y) { return T(W<T>(x) + W<T>(y)); } };
+struct Sub { template <typename T> static T apply(T x, T y) { return T(W<T>(x) - W<T>(y)); } };
+struct Mul { template <typename T> static T apply(T x, T y) { return T(W<T>(x) * W<T>(y)); } };
+struct Max { template <typename T> static T apply(T x, T y) { return y > x ? y : x; } };
+struct Relu { template <typename T> static T apply(T x) { return x > T(0) ? x : T(0); } };
+struct Exp { template <typename T> static T apply(T x) { return std::exp(x); } };
+struct Tanh { template <typename T> static T apply(T x) { return std::tanh(x); } };
+struct Sigmoid {
+    // Like vector_math.hpp, never e^-x for x < 0, which could overflow
+    template <typename T> static T apply(T x) {
+        const T e = std::exp(-std::fabs(x));
+        return (x < T(0) ? e : T(1)) / (T(1) + e);
+    }
+};
+struct Gelu {
+    // Same tanh form as vector_math.hpp: x / (1 + e^-2u)
+    template <typename T> static T apply(T x) {
+        if (std::isinf(x)) return x > 0 ? x : T(-0.0);
+        const T u = x * (T(0.7978845608028654) + T(0.7978845608028654 * 0.044715) * x * x);
+        return x / (T(1) + std::exp(T(-2) * u));
+    }
+};
+
+// Longest run summed directly; longer ones are split in half
+constexpr size_t PAIRWISE_BLOCK = 256;
+
+template <typename T, typename Op>
+void binary(const void* a, const void* b, void* out, size_t n) {
+    const T* pa = static_cast<const T*>(a);
+    const T* pb = static_cast<const T*>(b);
+    T* po = static_cast<T*>(out);
+    for (size_t i = 0; i < n; ++i) po[i] = Op::apply(pa[i], pb[i]);
+}
+
+template <typename T, typename Op>
+void unary(const void* a, void* out, size_t n) {
+    const T* pa = static_cast<const T*>(a);
+    T* po = static_cast<T*>(out);
+    for (size_t i = 0; i < n; ++i) po[i] = Op::apply(pa[i]);
+}
+
+template <typename T, bool SQUARES>
+T pairwise_sum(const T* p, size_t n) {
+    if (n > PAIRWISE_BLOCK) {
+        const size_t half = n / 2;
+        return Add::apply(pairwise_sum<T, SQUARES>(p, half), pairwise_sum<T, SQUARES>(p + half, n - half));
+    }
+    // Four accumulators, as the vector kernels have lanes
+    T acc[4] = {};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (size_t j = 0; j < 4; ++j) {
+            acc[j] = Add::apply(acc[j], SQUARES ? Mul::apply(p[i + j], p[i + j]) : p[i + j]);
+        }
+    }
+    T s = Add::apply(Add::apply(acc[0], acc[1]), Add::apply(acc[2], acc[3]));
+    for (; i < n; ++i) s = Add::apply(s, SQUARES ? Mul::apply(p[i], p[i]) : p[i]);
+    return s;
+}
+
+template <typename T, bool SQUARES>
+void sum(const void* a, size_t n, void* out) {
+    *static_cast<T*>(out) = pairwise_sum<T, SQUARES>(static_cast<const T*>(a), n);
+}
+
+template <typename T>
+void reduce_max(const void* a, size_t n, void* out) {
+    const T* pa = static_cast<const T*>(a);
+    T m = pa[0];
+    for (size_t i = 1; i < n; ++i) m = Max::apply(m, pa[i]);
+    *static_cast<T*>(out) = m;
+}
+
+template <typename T>
+void affine(const void* a, void* out, size_t n, double shift, double scale) {
+    const T* pa = static_cast<const T*>(a);
+    T* po = static_cast<T*>(out);
+    const T s = static_cast<T>(shift), k = static_cast<T>(scale);
+    for (size_t i = 0; i < n; ++i) po[i] = (pa[i] + s) * k;
+}
+
+template <typename T, size_t MR, size_t NR>
+void gemm_micro(size_t kc, const void* a, const void* b, void* c, size_t ldc, bool accumulate) {
+    const T* pa = static_cast<const T*>(a);
+    const T* pb = static_cast<const T*>(b);
+    T* pc = static_cast<T*>(c);
+    T acc[MR][NR] = {};
+    for (size_t p = 0; p < kc; ++p, pa += MR, pb += NR) {
+        for (size_t i = 0; i < MR; ++i) {
+            for (size_t j = 0; j < NR; ++j) acc[i][j] += pa[i] * pb[j];
+        }
+    }
+    for (size_t i = 0; i < MR; ++i) {
+        T* row = pc + i * ldc;
+        for (size_t j = 0; j < NR; ++j) row[j] = accumulate ? row[j] + acc[i][j] : acc[i][j];
+    }
+}
+
+const KernelTable SCALAR_TABLE = {
+    Isa::SCALAR,
+    {
+        {binary<float, Add>, binary<double, Add>, binary<int64_t, Add>},
+        {binary<float, Sub>, binary<double, Sub>, binary<int64_t, Sub>},
+        {binary<float, Mul>, binary<double, Mul>, binary<int64_t, Mul>},
+        {binary<float, Max>, binary<double, Max>, binary<int64_t, Max>},
+    },
+    {
+        {unary<float, Relu>, unary<double, Relu>, unary<int64_t, Relu>},
+        {unary<float, Exp>, unary<double, Exp>, nullptr},
+        {unary<float, Tanh>, unary<double, Tanh>, nullptr},
+        {unary<float, Sigmoid>, unary<double, Sigmoid>, nullptr},
+        {unary<float, Gelu>, unary<double, Gelu>, nullptr},
+    },
+    {
+        {gemm_micro<float, 4, 4>, 4, 4},
+        {gemm_micro<double, 4, 4>, 4, 4},
+    },
+    {
+        {sum<float, false>, sum<double, false>, sum<int64_t, false>},
+        {sum<float, true>, sum<double, true>, sum<int64_t, true>},
+        {reduce_max<float>, reduce_max<double>, reduce_max<int64_t>},
+    },
+    {affine<float>, affine<double>},
+};
+
+} // anonymous namespace
+
+const KernelTable& scalar_kernels() { return SCALAR_TABLE; }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dispatch
+// ─────────────────────────────────────────────────────────────────────────────
+
+const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR: return "scalar";
+        case Isa::SSE2:   return "sse2";
+        case Isa::AVX2:   return "avx2";
+        case Isa::AVX512: return "avx512";
+        default:          return "?";
+    }
+}
+
+Isa detect_isa() {
+#if ZERO_TENSOR_SIMD && (defined(__GNUC__) || defined(__clang__))
+    // These also check that the OS saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Isa::AVX2;
+    return Isa::SSE2;
+#elif ZERO_TENSOR_SIMD && defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool fma = (regs[2] >> 12) & 1;
+    if (!osxsave) return Isa::SSE2;
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(regs, 7, 0);
+    const bool avx2 = (regs[1] >> 5) & 1;
+    const bool avx512f = (regs[1] >> 16) & 1;
+    if (avx512f && (xcr0 & 0xE6) == 0xE6) return Isa::AVX512;
+    if (avx2 && fma && (xcr0 & 0x6) == 0x6) return Isa::AVX2;
+    return Isa::SSE2;
+#else
+    return Isa::SCALAR;
+#endif
+}
+
+bool isa_supported(Isa isa) {
+    static const Isa best = detect_isa();
+    return isa <= best;
+}
+
+const KernelTable& kernel_table(Isa isa) {
+#if ZERO_TENSOR_SIMD
+    switch (isa) {
+        case Isa::AVX512: return avx512_kernels();
+        case Isa::AVX2:   return avx2_kernels();
+        case Isa::SSE2:   return sse2_kernels();
+        default:          break;
+    }
+#else
+    (void)isa;
+#endif
+    return scalar_kernels();
+}
+
+namespace {
+
+Isa initial_isa() {
+    Isa isa = detect_isa();
+    if (const char* env = std::getenv("ZERO_TENSOR_ISA")) {
+        for (Isa want : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            if (std::strcmp(env, isa_name(want)) == 0 && want < isa) isa = want;
+        }
+    }
+    return isa;
+}
+
+std::atomic<const KernelTable*>& active_table() {
+    static std::atomic<const KernelTable*> table{&kernel_table(initial_isa())};
+    return table;
+}
+
+} // anonymous namespace
+
+const KernelTable& active_kernels() {
+    return *active_table().load(std::memory_order_relaxed);
+}
+
+Isa set_active_isa(Isa isa) {
+    while (!isa_supported(isa)) isa = static_cast<Isa>(static_cast<int>(isa) - 1);
+    active_table().store(&kernel_table(isa), std::memory_order_relaxed);
+    return isa;
+}
+
+} // namespace tensor
+} // namespace zero
@@ -0,0 +1,142 @@
+/**
+ * @file kernels_avx2.cpp
+ * @brief Zero Compiler — AVX2 Elementwise Kernels
+ *
+ * Compiled with -mavx2 -mfma (or /arch:AVX2); only called after CPUID
+ * has confirmed AVX2 and FMA.
+ */
+
+#include "tensor/kernels.hpp"
+#include "kernel_templates.hpp"
+#include "vector_math.hpp"
+
+#include <cstdint>
+#include <immintrin.h>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+struct F32 {
+    using T = float;
+    using V = __m256;
+    static constexpr size_t W = 8;
+    static V load(const T* p) { return _mm256_loadu_ps(p); }
+    static void store(T* p, V v) { _mm256_storeu_ps(p, v); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V relu(V a) { return _mm256_max_ps(a, _mm256_setzero_ps()); }
+    static V max(V a, V b) { return _mm256_max_ps(b, a); }
+    static V zero() { return _mm256_setzero_ps(); }
+    static V set1(T x) { return _mm256_set1_ps(x); }
+    static V fma(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V min(V a, V b) { return _mm256_min_ps(b, a); }
+    static V abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static V copysign(V mag, V sign) {
+        const V s = _mm256_set1_ps(-0.0f);
+        return _mm256_or_ps(_mm256_andnot_ps(s, mag), _mm256_and_ps(s, sign));
+    }
+    static V blend_lt(V a, V b, V x, V y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    static V ldexp(V p, V n) {
+        // 2^n as two halves built in the exponent field, each normal
+        const __m256i k = _mm256_cvtps_epi32(n);
+        const __m256i h = _mm256_srai_epi32(k, 1);
+        const __m256i bias = _mm256_set1_epi32(127);
+        const V s1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(h, bias), 23));
+        const V s2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(k, h), bias), 23));
+        return _mm256_mul_ps(_mm256_mul_ps(p, s1), s2);
+    }
+};
+
+struct F64 {
+    using T = double;
+    using V = __m256d;
+    static constexpr size_t W = 4;
+    static V load(const T* p) { return _mm256_loadu_pd(p); }
+    static void store(T* p, V v) { _mm256_storeu_pd(p, v); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V relu(V a) { return _mm256_max_pd(a, _mm256_setzero_pd()); }
+    static V max(V a, V b) { return _mm256_max_pd(b, a); }
+    static V zero() { return _mm256_setzero_pd(); }
+    static V set1(T x) { return _mm256_set1_pd(x); }
+    static V fma(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V min(V a, V b) { return _mm256_min_pd(b, a); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V copysign(V mag, V sign) {
+        const V s = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_andnot_pd(s, mag), _mm256_and_pd(s, sign));
+    }
+    static V blend_lt(V a, V b, V x, V y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+    static V ldexp(V p, V n) {
+        const __m128i k = _mm256_cvtpd_epi32(n);
+        const __m128i h = _mm_srai_epi32(k, 1);
+        const __m128i bias = _mm_set1_epi32(1023);
+        const V s1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_add_epi32(h, bias)), 52));
+        const V s2 = _mm256_castsi256_pd(
+            _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm_add_epi32(_mm_sub_epi32(k, h), bias)), 52));
+        return _mm256_mul_pd(_mm256_mul_pd(p, s1), s2);
+    }
+};
+
+struct I64 {
+    using T = int64_t;
+    using V = __m256i;
+    static constexpr size_t W = 4;
+    static V load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const V*>(p)); }
+    static void store(T* p, V v) { _mm256_storeu_si256(reinterpret_cast<V*>(p), v); }
+    static V add(V a, V b) { return _mm256_add_epi64(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_epi64(a, b); }
+    static V mul(V a, V b) {
+        // Low 64 bits of the product from 32x32 pieces
+        V lo = _mm256_mul_epu32(a, b);
+        V cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+    }
+    static V relu(V a) {
+        V negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+        return _mm256_andnot_si256(negative, a);
+    }
+    static V max(V a, V b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a)); }
+    static V zero() { return _mm256_setzero_si256(); }
+};
+
+const KernelTable AVX2_TABLE = {
+    Isa::AVX2,
+    {
+        {binary<F32, Add>, binary<F64, Add>, binary<I64, Add>},
+        {binary<F32, Sub>, binary<F64, Sub>, binary<I64, Sub>},
+        {binary<F32, Mul>, binary<F64, Mul>, binary<I64, Mul>},
+        {binary<F32, Max>, binary<F64, Max>, binary<I64, Max>},
+    },
+    {
+        {unary<F32, Relu>, unary<F64, Relu>, unary<I64, Relu>},
+        {math_unary<F32, Exp>, math_unary<F64, Exp>, nullptr},
+        {math_unary<F32, Tanh>, math_unary<F64, Tanh>, nullptr},
+        {math_unary<F32, Sigmoid>, math_unary<F64, Sigmoid>, nullptr},
+        {math_unary<F32, Gelu>, math_unary<F64, Gelu>, nullptr},
+    },
+    {
+        {gemm_micro<F32, 6, 2>, 6, 16},
+        {gemm_micro<F64, 6, 2>, 6, 8},
+    },
+    {
+        {sum<F32, false>, sum<F64, false>, sum<I64, false>},
+        {sum<F32, true>, sum<F64, true>, sum<I64, true>},
+        {reduce_max<F32>, reduce_max<F64>, reduce_max<I64>},
+    },
+    {affine<F32>, affine<F64>},
+};
+
+} // anonymous namespace
+
+const KernelTable& avx2_kernels() { return AVX2_TABLE; }
+
+} // namespace tensor
+} // namespace zero
@@ -0,0 +1,154 @@
+/**
+ * @file kernels_avx512.cpp
+ * @brief Zero Compiler — AVX-512 Elementwise Kernels
+ *
+ * Compiled with -mavx512f (or /arch:AVX512); only called after CPUID has
+ * confirmed AVX-512F. Tails use masked loads and stores instead of a
+ * scalar loop.
+ */
+
+#include "tensor/kernels.hpp"
+#include "kernel_templates.hpp"
+#include "vector_math.hpp"
+
+#include <cstdint>
+#include <immintrin.h>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+struct F32 {
+    using T = float;
+    using V = __m512;
+    using M = __mmask16;
+    static constexpr size_t W = 16;
+    static V load(const T* p) { return _mm512_loadu_ps(p); }
+    static V load(M m, const T* p) { return _mm512_maskz_loadu_ps(m, p); }
+    static void store(T* p, V v) { _mm512_storeu_ps(p, v); }
+    static void store(M m, T* p, V v) { _mm512_mask_storeu_ps(p, m, v); }
+    static V add(V a, V b) { return _mm512_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_ps(a, b); }
+    static V relu(V a) { return _mm512_max_ps(a, _mm512_setzero_ps()); }
+    static V max(V a, V b) { return _mm512_max_ps(b, a); }
+    static T hadd(V a) { return _mm512_reduce_add_ps(a); }
+    static T hmax(V a) { return _mm512_reduce_max_ps(a); }
+    static V zero() { return _mm512_setzero_ps(); }
+    static V set1(T x) { return _mm512_set1_ps(x); }
+    static V fma(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+    static V div(V a, V b) { return _mm512_div_ps(a, b); }
+    static V min(V a, V b) { return _mm512_min_ps(b, a); }
+    // The float and/or forms need AVX-512DQ; go through the integer ones
+    static V abs(V a) {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x7fffffff)));
+    }
+    static V copysign(V mag, V sign) {
+        const __m512i s = _mm512_set1_epi32(INT32_MIN);
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_andnot_si512(s, _mm512_castps_si512(mag)),
+                                                   _mm512_and_si512(s, _mm512_castps_si512(sign))));
+    }
+    static V blend_lt(V a, V b, V x, V y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), y, x); }
+    static V ldexp(V p, V n) { return _mm512_scalef_ps(p, n); }
+};
+
+struct F64 {
+    using T = double;
+    using V = __m512d;
+    using M = __mmask8;
+    static constexpr size_t W = 8;
+    static V load(const T* p) { return _mm512_loadu_pd(p); }
+    static V load(M m, const T* p) { return _mm512_maskz_loadu_pd(m, p); }
+    static void store(T* p, V v) { _mm512_storeu_pd(p, v); }
+    static void store(M m, T* p, V v) { _mm512_mask_storeu_pd(p, m, v); }
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V relu(V a) { return _mm512_max_pd(a, _mm512_setzero_pd()); }
+    static V max(V a, V b) { return _mm512_max_pd(b, a); }
+    static T hadd(V a) { return _mm512_reduce_add_pd(a); }
+    static T hmax(V a) { return _mm512_reduce_max_pd(a); }
+    static V zero() { return _mm512_setzero_pd(); }
+    static V set1(T x) { return _mm512_set1_pd(x); }
+    static V fma(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V min(V a, V b) { return _mm512_min_pd(b, a); }
+    static V abs(V a) {
+        return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(INT64_MAX)));
+    }
+    static V copysign(V mag, V sign) {
+        const __m512i s = _mm512_set1_epi64(INT64_MIN);
+        return _mm512_castsi512_pd(_mm512_or_si512(_mm512_andnot_si512(s, _mm512_castpd_si512(mag)),
+                                                   _mm512_and_si512(s, _mm512_castpd_si512(sign))));
+    }
+    static V blend_lt(V a, V b, V x, V y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ), y, x); }
+    static V ldexp(V p, V n) { return _mm512_scalef_pd(p, n); }
+};
+
+struct I64 {
+    using T = int64_t;
+    using V = __m512i;
+    using M = __mmask8;
+    static constexpr size_t W = 8;
+    static V load(const T* p) { return _mm512_loadu_si512(p); }
+    static V load(M m, const T* p) { return _mm512_maskz_loadu_epi64(m, p); }
+    static void store(T* p, V v) { _mm512_storeu_si512(p, v); }
+    static void store(M m, T* p, V v) { _mm512_mask_storeu_epi64(p, m, v); }
+    static V add(V a, V b) { return _mm512_add_epi64(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_epi64(a, b); }
+    static V mul(V a, V b) {
+        // 64-bit mullo needs AVX-512DQ; build it from 32x32 pieces
+        V lo = _mm512_mul_epu32(a, b);
+        V cross = _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), b),
+                                   _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+        return _mm512_add_epi64(lo, _mm512_slli_epi64(cross, 32));
+    }
+    static V relu(V a) { return _mm512_max_epi64(a, _mm512_setzero_si512()); }
+    static V max(V a, V b) { return _mm512_max_epi64(a, b); }
+    static V zero() { return _mm512_setzero_si512(); }
+    static T hadd(V a) {
+        // GCC's _mm512_reduce_add_epi64 adds signed lanes, which may
+        // overflow; wrap around as the vector adds do
+        alignas(64) uint64_t lanes[W];
+        _mm512_store_si512(lanes, a);
+        uint64_t s = 0;
+        for (uint64_t x : lanes) s += x;
+        return static_cast<T>(s);
+    }
+    static T hmax(V a) { return _mm512_reduce_max_epi64(a); }
+};
+
+const KernelTable AVX512_TABLE = {
+    Isa::AVX512,
+    {
+        {binary<F32, Add>, binary<F64, Add>, binary<I64, Add>},
+        {binary<F32, Sub>, binary<F64, Sub>, binary<I64, Sub>},
+        {binary<F32, Mul>, binary<F64, Mul>, binary<I64, Mul>},
+        {binary<F32, Max>, binary<F64, Max>, binary<I64, Max>},
+    },
+    {
+        {unary<F32, Relu>, unary<F64, Relu>, unary<I64, Relu>},
+        {unary<F32, Exp>, unary<F64, Exp>, nullptr},
+        {unary<F32, Tanh>, unary<F64, Tanh>, nullptr},
+        {unary<F32, Sigmoid>, unary<F64, Sigmoid>, nullptr},
+        {unary<F32, Gelu>, unary<F64, Gelu>, nullptr},
+    },
+    {
+        {gemm_micro<F32, 12, 2>, 12, 32},
+        {gemm_micro<F64, 12, 2>, 12, 16},
+    },
+    {
+        {sum<F32, false>, sum<F64, false>, sum<I64, false>},
+        {sum<F32, true>, sum<F64, true>, sum<I64, true>},
+        {reduce_max<F32>, reduce_max<F64>, reduce_max<I64>},
+    },
+    {affine<F32>, affine<F64>},
+};
+
+} // anonymous namespace
+
+const KernelTable& avx512_kernels() { return AVX512_TABLE; }
+
+} // namespace tensor
+} // namespace zero
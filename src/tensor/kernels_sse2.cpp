@@ -0,0 +1,159 @@
+/**
+ * @file kernels_sse2.cpp
+ * @brief Zero Compiler — SSE2 Elementwise Kernels
+ *
+ * Compiled with SSE2 enabled (the x86-64 baseline). Like the other
+ * per-ISA files it includes nothing that instantiates shared inline
+ * code, so no wider instructions leak into the rest of the library.
+ */
+
+#include "tensor/kernels.hpp"
+#include "kernel_templates.hpp"
+#include "vector_math.hpp"
+
+#include <cstdint>
+#include <immintrin.h>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+struct F32 {
+    using T = float;
+    using V = __m128;
+    static constexpr size_t W = 4;
+    static V load(const T* p) { return _mm_loadu_ps(p); }
+    static void store(T* p, V v) { _mm_storeu_ps(p, v); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V relu(V a) { return _mm_max_ps(a, _mm_setzero_ps()); }
+    static V max(V a, V b) { return _mm_max_ps(b, a); }
+    static V zero() { return _mm_setzero_ps(); }
+    static V set1(T x) { return _mm_set1_ps(x); }
+    static V fma(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V min(V a, V b) { return _mm_min_ps(b, a); }
+    static V abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static V copysign(V mag, V sign) {
+        const V s = _mm_set1_ps(-0.0f);
+        return _mm_or_ps(_mm_andnot_ps(s, mag), _mm_and_ps(s, sign));
+    }
+    static V blend_lt(V a, V b, V x, V y) {
+        const V m = _mm_cmplt_ps(a, b);
+        return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y));
+    }
+    static V ldexp(V p, V n) {
+        // 2^n as two halves built in the exponent field, each normal
+        const __m128i k = _mm_cvtps_epi32(n);
+        const __m128i h = _mm_srai_epi32(k, 1);
+        const __m128i bias = _mm_set1_epi32(127);
+        const V s1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(h, bias), 23));
+        const V s2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(k, h), bias), 23));
+        return _mm_mul_ps(_mm_mul_ps(p, s1), s2);
+    }
+};
+
+struct F64 {
+    using T = double;
+    using V = __m128d;
+    static constexpr size_t W = 2;
+    static V load(const T* p) { return _mm_loadu_pd(p); }
+    static void store(T* p, V v) { _mm_storeu_pd(p, v); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V relu(V a) { return _mm_max_pd(a, _mm_setzero_pd()); }
+    static V max(V a, V b) { return _mm_max_pd(b, a); }
+    static V zero() { return _mm_setzero_pd(); }
+    static V set1(T x) { return _mm_set1_pd(x); }
+    static V fma(V a, V b, V c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V min(V a, V b) { return _mm_min_pd(b, a); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static V copysign(V mag, V sign) {
+        const V s = _mm_set1_pd(-0.0);
+        return _mm_or_pd(_mm_andnot_pd(s, mag), _mm_and_pd(s, sign));
+    }
+    static V blend_lt(V a, V b, V x, V y) {
+        const V m = _mm_cmplt_pd(a, b);
+        return _mm_or_pd(_mm_and_pd(m, x), _mm_andnot_pd(m, y));
+    }
+    static V ldexp(V p, V n) {
+        // No 64-bit shifts needed: the exponent field is in the high
+        // 32 bits of each lane, which get the halves of n
+        const __m128i k = _mm_cvtpd_epi32(n);
+        const __m128i h = _mm_srai_epi32(k, 1);
+        const __m128i bias = _mm_set1_epi32(1023);
+        const __m128i e1 = _mm_slli_epi32(_mm_add_epi32(h, bias), 20);
+        const __m128i e2 = _mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(k, h), bias), 20);
+        const V s1 = _mm_castsi128_pd(_mm_unpacklo_epi32(_mm_setzero_si128(), e1));
+        const V s2 = _mm_castsi128_pd(_mm_unpacklo_epi32(_mm_setzero_si128(), e2));
+        return _mm_mul_pd(_mm_mul_pd(p, s1), s2);
+    }
+};
+
+struct I64 {
+    using T = int64_t;
+    using V = __m128i;
+    static constexpr size_t W = 2;
+    static V load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const V*>(p)); }
+    static void store(T* p, V v) { _mm_storeu_si128(reinterpret_cast<V*>(p), v); }
+    static V add(V a, V b) { return _mm_add_epi64(a, b); }
+    static V sub(V a, V b) { return _mm_sub_epi64(a, b); }
+    static V mul(V a, V b) {
+        // Low 64 bits of the product from 32x32 pieces
+        V lo = _mm_mul_epu32(a, b);
+        V cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+        return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+    }
+    static V relu(V a) {
+        // No 64-bit compare: spread each lane's sign over the whole lane
+        V sign = _mm_shuffle_epi32(_mm_srai_epi32(a, 31), 0xF5);
+        return _mm_andnot_si128(sign, a);
+    }
+    static V max(V a, V b) {
+        // Nor a 64-bit max; compare the two lanes one at a time
+        alignas(16) T x[2], y[2];
+        _mm_store_si128(reinterpret_cast<V*>(x), a);
+        _mm_store_si128(reinterpret_cast<V*>(y), b);
+        return _mm_set_epi64x(y[1] > x[1] ? y[1] : x[1], y[0] > x[0] ? y[0] : x[0]);
+    }
+    static V zero() { return _mm_setzero_si128(); }
+};
+
+const KernelTable SSE2_TABLE = {
+    Isa::SSE2,
+    {
+        {binary<F32, Add>, binary<F64, Add>, binary<I64, Add>},
+        {binary<F32, Sub>, binary<F64, Sub>, binary<I64, Sub>},
+        {binary<F32, Mul>, binary<F64, Mul>, binary<I64, Mul>},
+        {binary<F32, Max>, binary<F64, Max>, binary<I64, Max>},
+    },
+    {
+        {unary<F32, Relu>, unary<F64, Relu>, unary<I64, Relu>},
+        {math_unary<F32, Exp>, math_unary<F64, Exp>, nullptr},
+        {math_unary<F32, Tanh>, math_unary<F64, Tanh>, nullptr},
+        {math_unary<F32, Sigmoid>, math_unary<F64, Sigmoid>, nullptr},
+        {math_unary<F32, Gelu>, math_unary<F64, Gelu>, nullptr},
+    },
+    {
+        {gemm_micro<F32, 4, 2>, 4, 8},
+        {gemm_micro<F64, 4, 2>, 4, 4},
+    },
+    {
+        {sum<F32, false>, sum<F64, false>, sum<I64, false>},
+        {sum<F32, true>, sum<F64, true>, sum<I64, true>},
+        {reduce_max<F32>, reduce_max<F64>, reduce_max<I64>},
+    },
+    {affine<F32>, affine<F64>},
+};
+
+} // anonymous namespace
+
+const KernelTable& sse2_kernels() { return SSE2_TABLE; }
+
+} // namespace tensor
+} // namespace zero
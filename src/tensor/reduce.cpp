@@ -0,0 +1,396 @@
+/**
+ * @file reduce.cpp
+ * @brief Zero Compiler — Tensor Reductions Implementation
+ */
+
+#include "tensor/reduce.hpp"
+#include "tensor/kernels.hpp"
+#include "tensor/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+// Work (elements read) below which a reduction stays on the calling thread
+constexpr size_t PARALLEL_ELEMENTS = 32768;
+
+// Rows of a column sum added in order before halves are paired
+constexpr size_t COLUMN_BLOCK = 8;
+
+// Columns per task of a column reduction
+constexpr size_t COLUMN_CHUNK = 1024;
+
+[[noreturn]] void fail(const char* op, const std::string& why) {
+    throw TensorError(std::string("tensor.") + op + ": " + why);
+}
+
+void check_float(const Tensor& a, const char* op) {
+    if (!a.defined()) fail(op, "undefined tensor");
+    if (a.dtype() == DType::I64) fail(op, "needs a floating-point tensor, got i64");
+}
+
+size_t axis_index(int64_t axis, size_t ndim, const char* op) {
+    const int64_t rank = static_cast<int64_t>(ndim);
+    if (axis < -rank || axis >= rank) {
+        fail(op, "dimension " + std::to_string(axis) + " out of range for rank " +
+                 std::to_string(ndim));
+    }
+    return static_cast<size_t>(axis < 0 ? axis + rank : axis);
+}
+
+/**
+ * A contiguous tensor around one axis, as [outer, len, inner].
+ */
+struct Axis {
+    size_t outer = 1;
+    size_t len = 1;
+    size_t inner = 1;
+};
+
+Axis split(const Tensor::Shape& shape, size_t d) {
+    Axis ax;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        const size_t n = static_cast<size_t>(shape[i]);
+        if (i < d) ax.outer *= n;
+        else if (i == d) ax.len = n;
+        else ax.inner *= n;
+    }
+    return ax;
+}
+
+Tensor::Shape reduced_shape(const Tensor::Shape& shape, size_t d, bool keepdims) {
+    Tensor::Shape out = shape;
+    if (keepdims) out[d] = 1;
+    else out.erase(out.begin() + static_cast<std::ptrdiff_t>(d));
+    return out;
+}
+
+/**
+ * One element of any dtype, as a double.
+ */
+double to_double(const void* p, DType dtype) {
+    switch (dtype) {
+        case DType::F32: return *static_cast<const float*>(p);
+        case DType::F64: return *static_cast<const double*>(p);
+        default: return static_cast<double>(*static_cast<const int64_t*>(p));
+    }
+}
+
+/**
+ * Call fn(first, last) over pieces of [0, n), each item reading
+ * `per_item` elements; on the thread pool once that adds up to enough.
+ */
+void parallel_ranges(size_t n, size_t per_item, const std::function<void(size_t, size_t)>& fn) {
+    ThreadPool& pool = ThreadPool::global();
+    const size_t work = n * std::max<size_t>(per_item, 1);
+    if (n < 2 || pool.size() < 2 || work < PARALLEL_ELEMENTS) {
+        fn(0, n);
+        return;
+    }
+    // A few pieces per thread evens out uneven progress
+    const size_t pieces = std::min({n, pool.size() * 4, work / (PARALLEL_ELEMENTS / 4)});
+    const size_t chunk = (n + pieces - 1) / pieces;
+    pool.parallel_for((n + chunk - 1) / chunk, [&](size_t t) {
+        fn(t * chunk, std::min(n, (t + 1) * chunk));
+    });
+}
+
+/**
+ * kernel over one run; a long run is cut into a part per thread, the
+ * parts reduced on their own and the partial results by `combine`.
+ */
+void reduce_run(ReduceKernel kernel, ReduceKernel combine, const char* p, size_t n,
+                size_t size, void* out) {
+    ThreadPool& pool = ThreadPool::global();
+    const size_t parts = std::min(pool.size(), n / PARALLEL_ELEMENTS);
+    if (parts < 2) {
+        kernel(p, n, out);
+        return;
+    }
+    std::vector<uint64_t> storage(parts);   // Room for `parts` elements of any dtype
+    char* partial = reinterpret_cast<char*>(storage.data());
+    const size_t chunk = (n + parts - 1) / parts;
+    pool.parallel_for(parts, [&](size_t t) {
+        const size_t first = t * chunk;
+        kernel(p + first * size, std::min(chunk, n - first), partial + t * size);
+    });
+    combine(partial, parts, out);
+}
+
+/**
+ * out[j] = sum over r < len of p[r * stride + j] for j < cols, in bytes
+ * of `size`-byte elements, pairing halves above COLUMN_BLOCK rows.
+ * `scratch` holds one row of cols elements per level below this one.
+ */
+void column_sum(BinaryKernel add, const char* p, size_t len, size_t cols, size_t stride,
+                size_t size, char* out, char* scratch) {
+    if (len <= COLUMN_BLOCK) {
+        std::memcpy(out, p, cols * size);
+        for (size_t r = 1; r < len; ++r) add(out, p + r * stride, out, cols);
+        return;
+    }
+    const size_t half = len / 2;
+    column_sum(add, p, half, cols, stride, size, out, scratch);
+    column_sum(add, p + half * stride, len - half, cols, stride, size, scratch, scratch + cols * size);
+    add(out, scratch, out, cols);
+}
+
+size_t column_sum_levels(size_t len) {
+    size_t levels = 0;
+    for (; len > COLUMN_BLOCK; len = (len + 1) / 2) ++levels;
+    return levels;
+}
+
+/**
+ * Reduce `src` (contiguous) along ax into `out`; ax.len > 0.
+ */
+void reduce_into(const Tensor& src, const Axis& ax, ReduceOp op, Tensor& out) {
+    const KernelTable& k = active_kernels();
+    const DType dtype = src.dtype();
+    const size_t size = types::dtype_size(dtype);
+    const char* ps = static_cast<const char*>(src.raw_data());
+    char* po = static_cast<char*>(out.raw_data());
+
+    if (ax.inner == 1) {
+        const ReduceKernel kernel = k.get(op, dtype);
+        if (ax.outer == 1) {
+            const ReduceKernel combine = k.get(op == ReduceOp::MAX ? ReduceOp::MAX : ReduceOp::SUM, dtype);
+            reduce_run(kernel, combine, ps, ax.len, size, po);
+            return;
+        }
+        parallel_ranges(ax.outer, ax.len, [&](size_t first, size_t last) {
+            for (size_t o = first; o < last; ++o) kernel(ps + o * ax.len * size, ax.len, po + o * size);
+        });
+        return;
+    }
+
+    // Whole rows at a time, so the vector lanes run along the kept columns
+    const BinaryKernel fold = k.get(op == ReduceOp::MAX ? BinaryOp::MAX : BinaryOp::ADD, dtype);
+    const size_t chunks = (ax.inner + COLUMN_CHUNK - 1) / COLUMN_CHUNK;
+    const size_t stride = ax.inner * size;
+    parallel_ranges(ax.outer * chunks, ax.len * std::min(ax.inner, COLUMN_CHUNK), [&](size_t first, size_t last) {
+        std::vector<uint64_t> scratch;
+        if (op != ReduceOp::MAX) {
+            scratch.resize((column_sum_levels(ax.len) * COLUMN_CHUNK * size + 7) / 8);
+        }
+        for (size_t t = first; t < last; ++t) {
+            const size_t o = t / chunks, j = t % chunks * COLUMN_CHUNK;
+            const size_t cols = std::min(COLUMN_CHUNK, ax.inner - j);
+            const char* p = ps + (o * ax.len * ax.inner + j) * size;
+            char* dst = po + (o * ax.inner + j) * size;
+            if (op == ReduceOp::MAX) {
+                std::memcpy(dst, p, cols * size);
+                for (size_t r = 1; r < ax.len; ++r) fold(dst, p + r * stride, dst, cols);
+            } else {
+                column_sum(fold, p, ax.len, cols, stride, size, dst, reinterpret_cast<char*>(scratch.data()));
+            }
+        }
+    });
+}
+
+Tensor reduce(const Tensor& a, int64_t axis, bool keepdims, const char* name, ReduceOp op) {
+    if (!a.defined()) fail(name, "undefined tensor");
+    const size_t d = axis_index(axis, a.ndim(), name);
+    const Axis ax = split(a.shape(), d);
+    const Tensor::Shape shape = reduced_shape(a.shape(), d, keepdims);
+    if (ax.len == 0) {
+        if (op == ReduceOp::MAX) fail(name, "empty dimension " + std::to_string(axis));
+        return Tensor::zeros(shape, a.dtype());
+    }
+    Tensor out = Tensor::empty(shape, a.dtype());
+    if (out.numel() == 0) return out;
+    reduce_into(a.is_contiguous() ? a : a.contiguous(), ax, op, out);
+    return out;
+}
+
+/**
+ * The row of the first element equal to m[j] in each column j; a NaN
+ * maximum matches the first NaN.
+ */
+template <typename T>
+void first_max(const T* p, size_t len, size_t inner, const T* m, int64_t* idx) {
+    std::fill(idx, idx + inner, int64_t(-1));
+    size_t found = 0;
+    for (size_t r = 0; r < len && found < inner; ++r, p += inner) {
+        for (size_t j = 0; j < inner; ++j) {
+            if (idx[j] < 0 && (p[j] == m[j] || (p[j] != p[j] && m[j] != m[j]))) {
+                idx[j] = static_cast<int64_t>(r);
+                ++found;
+            }
+        }
+    }
+}
+
+/**
+ * a flattened to one dimension, for the whole-tensor reductions.
+ */
+Tensor flat(const Tensor& a, const char* name) {
+    if (!a.defined()) fail(name, "undefined tensor");
+    return a.reshape({static_cast<int64_t>(a.numel())});
+}
+
+} // anonymous namespace
+
+Tensor sum(const Tensor& a, int64_t axis, bool keepdims) {
+    return reduce(a, axis, keepdims, "sum", ReduceOp::SUM);
+}
+
+Tensor mean(const Tensor& a, int64_t axis, bool keepdims) {
+    check_float(a, "mean");
+    Tensor out = reduce(a, axis, keepdims, "mean", ReduceOp::SUM);
+    const size_t len = static_cast<size_t>(a.dim(axis_index(axis, a.ndim(), "mean")));
+    // An empty axis gives 0 * inf = NaN, as in NumPy
+    active_kernels().get_affine(a.dtype())(out.raw_data(), out.raw_data(), out.numel(), 0.0,
+                                           1.0 / static_cast<double>(len));
+    return out;
+}
+
+Tensor max(const Tensor& a, int64_t axis, bool keepdims) {
+    return reduce(a, axis, keepdims, "max", ReduceOp::MAX);
+}
+
+Tensor argmax(const Tensor& a, int64_t axis, bool keepdims) {
+    const Tensor m = reduce(a, axis, keepdims, "argmax", ReduceOp::MAX);
+    const size_t d = axis_index(axis, a.ndim(), "argmax");
+    const Axis ax = split(a.shape(), d);
+    Tensor out = Tensor::empty(m.shape(), DType::I64);
+    if (out.numel() == 0) return out;
+
+    const Tensor src = a.is_contiguous() ? a : a.contiguous();
+    const size_t size = types::dtype_size(a.dtype());
+    const char* ps = static_cast<const char*>(src.raw_data());
+    const char* pm = static_cast<const char*>(m.raw_data());
+    int64_t* po = out.data<int64_t>();
+    parallel_ranges(ax.outer, ax.len * ax.inner, [&](size_t first, size_t last) {
+        for (size_t o = first; o < last; ++o) {
+            const char* p = ps + o * ax.len * ax.inner * size;
+            const char* mo = pm + o * ax.inner * size;
+            int64_t* idx = po + o * ax.inner;
+            switch (a.dtype()) {
+                case DType::F32:
+                    first_max(reinterpret_cast<const float*>(p), ax.len, ax.inner,
+                              reinterpret_cast<const float*>(mo), idx);
+                    break;
+                case DType::F64:
+                    first_max(reinterpret_cast<const double*>(p), ax.len, ax.inner,
+                              reinterpret_cast<const double*>(mo), idx);
+                    break;
+                default:
+                    first_max(reinterpret_cast<const int64_t*>(p), ax.len, ax.inner,
+                              reinterpret_cast<const int64_t*>(mo), idx);
+                    break;
+            }
+        }
+    });
+    return out;
+}
+
+Tensor sum(const Tensor& a) { return sum(flat(a, "sum"), 0); }
+Tensor mean(const Tensor& a) { return mean(flat(a, "mean"), 0); }
+Tensor max(const Tensor& a) { return max(flat(a, "max"), 0); }
+Tensor argmax(const Tensor& a) { return argmax(flat(a, "argmax"), 0); }
+
+Tensor softmax(const Tensor& a, int64_t axis) {
+    check_float(a, "softmax");
+    const size_t d = axis_index(axis, a.ndim(), "softmax");
+    if (d + 1 != a.ndim()) {
+        // Move the axis last, where its elements are contiguous
+        const int64_t last = static_cast<int64_t>(a.ndim()) - 1;
+        const int64_t dim = static_cast<int64_t>(d);
+        return softmax(a.transpose(dim, last).contiguous(), -1).transpose(dim, last).contiguous();
+    }
+
+    const Tensor src = a.is_contiguous() ? a : a.contiguous();
+    Tensor out = Tensor::empty(a.shape(), a.dtype());
+    const size_t len = static_cast<size_t>(a.dim(d));
+    if (out.numel() == 0) return out;
+
+    const KernelTable& k = active_kernels();
+    const DType dtype = a.dtype();
+    const ReduceKernel row_max = k.get(ReduceOp::MAX, dtype);
+    const ReduceKernel row_sum = k.get(ReduceOp::SUM, dtype);
+    const AffineKernel affine = k.get_affine(dtype);
+    const UnaryKernel row_exp = k.get(UnaryOp::EXP, dtype);
+    const size_t size = types::dtype_size(dtype);
+    const char* ps = static_cast<const char*>(src.raw_data());
+    char* po = static_cast<char*>(out.raw_data());
+    parallel_ranges(out.numel() / len, len, [&](size_t first, size_t last) {
+        for (size_t r = first; r < last; ++r) {
+            const char* x = ps + r * len * size;
+            char* y = po + r * len * size;
+            uint64_t m = 0, s = 0;
+            // Subtracting the max keeps exp from overflowing
+            row_max(x, len, &m);
+            affine(x, y, len, -to_double(&m, dtype), 1.0);
+            row_exp(y, y, len);
+            row_sum(y, len, &s);
+            affine(y, y, len, 0.0, 1.0 / to_double(&s, dtype));
+        }
+    });
+    return out;
+}
+
+Tensor layernorm(const Tensor& a, const Tensor& gamma, const Tensor& beta, double eps) {
+    check_float(a, "layernorm");
+    if (a.ndim() == 0) fail("layernorm", "needs at least one dimension");
+    const int64_t n = a.dim(a.ndim() - 1);
+    const DType dtype = a.dtype();
+
+    // gamma and beta as contiguous rows of the last dimension's length
+    auto row_param = [&](const Tensor& t, const char* what) {
+        if (!t.defined()) return Tensor();
+        if (t.dtype() != dtype) {
+            fail("layernorm", std::string(what) + " dtype mismatch (" + types::dtype_name(dtype) +
+                              " vs " + types::dtype_name(t.dtype()) + ")");
+        }
+        if (!broadcasts_to(t.shape(), {n})) {
+            fail("layernorm", std::string(what) + " of shape " + shape_string(t.shape()) +
+                              " does not match the last dimension " + std::to_string(n));
+        }
+        return t.broadcast_to({n}).contiguous();
+    };
+    const Tensor g = row_param(gamma, "gamma");
+    const Tensor b = row_param(beta, "beta");
+
+    const Tensor src = a.is_contiguous() ? a : a.contiguous();
+    Tensor out = Tensor::empty(a.shape(), dtype);
+    if (out.numel() == 0) return out;
+
+    const KernelTable& k = active_kernels();
+    const ReduceKernel row_sum = k.get(ReduceOp::SUM, dtype);
+    const ReduceKernel row_sum_squares = k.get(ReduceOp::SUM_SQUARES, dtype);
+    const AffineKernel affine = k.get_affine(dtype);
+    const BinaryKernel scale = k.get(BinaryOp::MUL, dtype);
+    const BinaryKernel shift = k.get(BinaryOp::ADD, dtype);
+    const size_t len = static_cast<size_t>(n);
+    const size_t size = types::dtype_size(dtype);
+    const char* ps = static_cast<const char*>(src.raw_data());
+    char* po = static_cast<char*>(out.raw_data());
+    parallel_ranges(out.numel() / len, len, [&](size_t first, size_t last) {
+        for (size_t r = first; r < last; ++r) {
+            const char* x = ps + r * len * size;
+            char* y = po + r * len * size;
+            uint64_t s = 0, ss = 0;
+            // Variance of the centred row, not E[x^2] - E[x]^2, which cancels
+            row_sum(x, len, &s);
+            affine(x, y, len, -to_double(&s, dtype) / static_cast<double>(len), 1.0);
+            row_sum_squares(y, len, &ss);
+            const double var = to_double(&ss, dtype) / static_cast<double>(len);
+            affine(y, y, len, 0.0, 1.0 / std::sqrt(var + eps));
+            if (g.defined()) scale(y, g.raw_data(), y, len);
+            if (b.defined()) shift(y, b.raw_data(), y, len);
+        }
+    });
+    return out;
+}
+
+} // namespace tensor
+} // namespace zero
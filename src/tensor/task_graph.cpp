@@ -0,0 +1,107 @@
+/**
+ * @file task_graph.cpp
+ * @brief Zero Compiler — Task Graph Implementation
+ */
+
+#include "tensor/task_graph.hpp"
+#include "tensor/tensor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace zero {
+namespace tensor {
+
+size_t TaskGraph::add_node() {
+    successors_.emplace_back();
+    inputs_.push_back(0);
+    return successors_.size() - 1;
+}
+
+void TaskGraph::add_edge(size_t before, size_t node) {
+    if (node >= size() || before >= node) {
+        throw TensorError("task graph edge " + std::to_string(before) + " -> " +
+                          std::to_string(node) + " does not point forward");
+    }
+    std::vector<uint32_t>& next = successors_[before];
+    if (std::find(next.begin(), next.end(), node) != next.end()) return;
+    next.push_back(static_cast<uint32_t>(node));
+    ++inputs_[node];
+    ++edges_;
+}
+
+struct TaskGraph::RunState {
+    const std::function<void(size_t)>& fn;
+    ThreadPool& pool;
+    ThreadPool::TaskGroup group;
+    std::unique_ptr<std::atomic<uint32_t>[]> waiting;    // Unfinished inputs per node
+    std::unique_ptr<std::atomic<bool>[]> skipped;
+
+    std::mutex mutex;                   // Guards the fields below
+    size_t failed = SIZE_MAX;           // Lowest node that threw
+    std::exception_ptr error;
+
+    RunState(const std::function<void(size_t)>& f, ThreadPool& p, size_t n)
+        : fn(f), pool(p), waiting(new std::atomic<uint32_t>[n]), skipped(new std::atomic<bool>[n]) {}
+};
+
+void TaskGraph::run(const std::function<void(size_t)>& fn, ThreadPool& pool) const {
+    const size_t n = size();
+    if (pool.size() < 2) {
+        for (size_t node = 0; node < n; ++node) fn(node);
+        return;
+    }
+
+    RunState state(fn, pool, n);
+    for (size_t node = 0; node < n; ++node) {
+        state.waiting[node].store(inputs_[node], std::memory_order_relaxed);
+        state.skipped[node].store(false, std::memory_order_relaxed);
+    }
+    for (size_t node = 0; node < n; ++node) {
+        if (inputs_[node] == 0) pool.spawn(state.group, [this, node, &state] { run_from(node, state); });
+    }
+    pool.wait(state.group);
+    if (state.error) std::rethrow_exception(state.error);
+}
+
+/**
+ * Run `node`, then release its successors: the first one to become
+ * ready runs next on this thread, the others go to the pool.
+ */
+void TaskGraph::run_from(size_t node, RunState& state) const {
+    for (;;) {
+        bool ok = !state.skipped[node].load(std::memory_order_relaxed);
+        if (ok) {
+            try {
+                state.fn(node);
+            } catch (...) {
+                ok = false;
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (node < state.failed) {
+                    state.failed = node;
+                    state.error = std::current_exception();
+                }
+            }
+        }
+
+        size_t next = SIZE_MAX;
+        for (uint32_t succ : successors_[node]) {
+            // Published to whoever runs succ by the release below
+            if (!ok) state.skipped[succ].store(true, std::memory_order_relaxed);
+            if (state.waiting[succ].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+            if (next == SIZE_MAX) {
+                next = succ;
+            } else {
+                state.pool.spawn(state.group, [this, succ, &state] { run_from(succ, state); });
+            }
+        }
+        if (next == SIZE_MAX) return;
+        node = next;
+    }
+}
+
+} // namespace tensor
+} // namespace zero
@@ -0,0 +1,640 @@
+/**
+ * @file tensor.cpp
+ * @brief Zero Compiler — CPU Tensor Runtime Implementation
+ */
+
+#include "tensor/tensor.hpp"
+#include "tensor/buffer_pool.hpp"
+#include "tensor/gemm.hpp"
+#include "tensor/kernels.hpp"
+#include "tensor/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <utility>
+
+namespace zero {
+namespace tensor {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Storage
+// ─────────────────────────────────────────────────────────────────────────────
+
+Storage::Storage(size_t bytes)
+    : data_(BufferPool::global().acquire(bytes)),
+      bytes_(bytes) {}
+
+Storage::~Storage() {
+    BufferPool::global().release(data_, bytes_);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+
+// Contiguous elementwise runs at least this long are split over the
+// thread pool
+constexpr size_t PARALLEL_ELEMENTS = 1 << 16;
+
+/**
+ * fn(first, count) over pieces covering [0, n) elements of `size`
+ * bytes, one per thread once n is long enough. Pieces start on 64-byte
+ * boundaries, so threads do not share cache lines of the output.
+ */
+template <typename Fn>
+void split_run(size_t n, size_t size, const Fn& fn) {
+    ThreadPool& pool = ThreadPool::global();
+    const size_t parts = std::min(pool.size(), n / PARALLEL_ELEMENTS);
+    if (parts < 2) {
+        fn(0, n);
+        return;
+    }
+    const size_t align = 64 / size;
+    const size_t chunk = ((n + parts - 1) / parts + align - 1) / align * align;
+    pool.parallel_for((n + chunk - 1) / chunk, [&](size_t t) {
+        const size_t first = t * chunk;
+        fn(first, std::min(chunk, n - first));
+    });
+}
+
+/**
+ * Walks the row-major positions of a shape, keeping the element offset
+ * under a set of strides up to date.
+ */
+class StridedWalk {
+public:
+    StridedWalk(const Tensor::Shape& shape, const Tensor::Shape& strides)
+        : shape_(shape), strides_(strides), index_(shape.size(), 0) {}
+
+    int64_t offset() const { return offset_; }
+
+    void next() {
+        for (size_t d = shape_.size(); d-- > 0;) {
+            offset_ += strides_[d];
+            if (++index_[d] < shape_[d]) return;
+            offset_ -= strides_[d] * shape_[d];
+            index_[d] = 0;
+        }
+    }
+
+private:
+    const Tensor::Shape& shape_;
+    const Tensor::Shape& strides_;
+    std::vector<int64_t> index_;
+    int64_t offset_ = 0;
+};
+
+template <typename T>
+double load(const void* base, int64_t off) {
+    return static_cast<double>(static_cast<const T*>(base)[off]);
+}
+
+template <typename T>
+void store(void* base, int64_t off, double v) {
+    static_cast<T*>(base)[off] = static_cast<T>(v);
+}
+
+/**
+ * Copy `n` elements of `size` bytes, `stride` elements apart, to `dst`.
+ */
+void gather(const char* src, int64_t stride, size_t size, size_t n, char* dst) {
+    if (size == 4) {
+        const uint32_t* s = reinterpret_cast<const uint32_t*>(src);
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        for (size_t i = 0; i < n; ++i) d[i] = s[static_cast<int64_t>(i) * stride];
+    } else {
+        const uint64_t* s = reinterpret_cast<const uint64_t*>(src);
+        uint64_t* d = reinterpret_cast<uint64_t*>(dst);
+        for (size_t i = 0; i < n; ++i) d[i] = s[static_cast<int64_t>(i) * stride];
+    }
+}
+
+/**
+ * Splits a tensor into its innermost rows for the contiguous kernels.
+ * Rows that are not unit-stride are gathered into a scratch buffer
+ * first, so every ISA's kernels serve strided inputs too.
+ */
+class RowReader {
+public:
+    explicit RowReader(const Tensor& t)
+        : base_(static_cast<const char*>(t.raw_data())),
+          size_(types::dtype_size(t.dtype())),
+          outer_shape_(t.shape().begin(), t.shape().end() - 1),
+          outer_strides_(t.strides().begin(), t.strides().end() - 1),
+          inner_(static_cast<size_t>(t.shape().back())),
+          stride_(t.strides().back()),
+          walk_(outer_shape_, outer_strides_) {
+        if (stride_ != 1) scratch_.resize(inner_ * size_);
+    }
+
+    size_t row_length() const { return inner_; }
+
+    /**
+     * The current row, then advance to the next one.
+     */
+    const void* next() {
+        const char* row = base_ + walk_.offset() * static_cast<int64_t>(size_);
+        walk_.next();
+        if (stride_ == 1) return row;
+        gather(row, stride_, size_, inner_, scratch_.data());
+        return scratch_.data();
+    }
+
+private:
+    const char* base_;
+    size_t size_;
+    Tensor::Shape outer_shape_;
+    Tensor::Shape outer_strides_;
+    size_t inner_;
+    int64_t stride_;
+    StridedWalk walk_;
+    std::vector<char> scratch_;
+};
+
+void run_binary(BinaryOp op, const Tensor& a, const Tensor& b, Tensor& out) {
+    const BinaryKernel kernel = active_kernels().get(op, out.dtype());
+    const size_t n = out.numel();
+    if (n == 0) return;
+    if (a.is_contiguous() && b.is_contiguous()) {
+        const size_t size = types::dtype_size(out.dtype());
+        const char* pa = static_cast<const char*>(a.raw_data());
+        const char* pb = static_cast<const char*>(b.raw_data());
+        char* po = static_cast<char*>(out.raw_data());
+        split_run(n, size, [&](size_t first, size_t count) {
+            kernel(pa + first * size, pb + first * size, po + first * size, count);
+        });
+        return;
+    }
+    RowReader ra(a), rb(b);
+    const size_t row_bytes = ra.row_length() * types::dtype_size(out.dtype());
+    char* po = static_cast<char*>(out.raw_data());
+    for (size_t r = 0; r < n / ra.row_length(); ++r) {
+        kernel(ra.next(), rb.next(), po + r * row_bytes, ra.row_length());
+    }
+}
+
+void run_unary(UnaryOp op, const Tensor& a, Tensor& out) {
+    const UnaryKernel kernel = active_kernels().get(op, out.dtype());
+    const size_t n = out.numel();
+    if (n == 0) return;
+    if (a.is_contiguous()) {
+        const size_t size = types::dtype_size(out.dtype());
+        const char* pa = static_cast<const char*>(a.raw_data());
+        char* po = static_cast<char*>(out.raw_data());
+        split_run(n, size, [&](size_t first, size_t count) {
+            kernel(pa + first * size, po + first * size, count);
+        });
+        return;
+    }
+    RowReader ra(a);
+    const size_t row_bytes = ra.row_length() * types::dtype_size(out.dtype());
+    char* po = static_cast<char*>(out.raw_data());
+    for (size_t r = 0; r < n / ra.row_length(); ++r) {
+        kernel(ra.next(), po + r * row_bytes, ra.row_length());
+    }
+}
+
+/**
+ * NumPy broadcasting of two shapes into `out`; false if they clash.
+ */
+bool broadcast_into(const Tensor::Shape& a, const Tensor::Shape& b, Tensor::Shape& out) {
+    const size_t n = std::max(a.size(), b.size());
+    out.assign(n, 1);
+    for (size_t i = 0; i < n; ++i) {
+        const int64_t da = i < a.size() ? a[a.size() - 1 - i] : 1;
+        const int64_t db = i < b.size() ? b[b.size() - 1 - i] : 1;
+        if (da != db && da != 1 && db != 1) return false;
+        out[n - 1 - i] = da == 1 ? db : da;
+    }
+    return true;
+}
+
+/**
+ * `dim` counted from the end when negative, checked against the rank.
+ */
+size_t normalize_dim(int64_t dim, size_t ndim, const char* op) {
+    const int64_t rank = static_cast<int64_t>(ndim);
+    if (dim < -rank || dim >= rank) {
+        throw TensorError(std::string("tensor.") + op + ": dimension " + std::to_string(dim) +
+                          " out of range for rank " + std::to_string(ndim));
+    }
+    return static_cast<size_t>(dim < 0 ? dim + rank : dim);
+}
+
+Tensor elementwise(const Tensor& a, const Tensor& b, const char* name, BinaryOp op, Tensor out = {}) {
+    if (!a.defined() || !b.defined()) {
+        throw TensorError(std::string("tensor.") + name + ": undefined tensor");
+    }
+    if (a.dtype() != b.dtype()) {
+        throw TensorError(std::string("tensor.") + name + ": dtype mismatch (" +
+                          types::dtype_name(a.dtype()) + " vs " +
+                          types::dtype_name(b.dtype()) + ")");
+    }
+    Tensor::Shape shape;
+    if (!broadcast_into(a.shape(), b.shape(), shape)) {
+        throw TensorError(std::string("tensor.") + name + ": shape mismatch (" +
+                          shape_string(a.shape()) + " vs " + shape_string(b.shape()) + ")");
+    }
+    if (!fits(out, shape, a.dtype())) out = Tensor::empty(shape, a.dtype());
+    // Broadcast operands become stride-0 views; the row walk reads them
+    // without materializing the repeats
+    if (a.shape() == shape && b.shape() == shape) {
+        run_binary(op, a, b, out);
+    } else {
+        run_binary(op, a.broadcast_to(shape), b.broadcast_to(shape), out);
+    }
+    return out;
+}
+
+Tensor activation(const Tensor& a, const char* name, UnaryOp op, Tensor out) {
+    if (!a.defined()) throw TensorError(std::string("tensor.") + name + ": undefined tensor");
+    if (!active_kernels().get(op, a.dtype())) {
+        throw TensorError(std::string("tensor.") + name + ": needs a floating-point tensor, got " +
+                          types::dtype_name(a.dtype()));
+    }
+    if (!fits(out, a.shape(), a.dtype())) out = Tensor::empty(a.shape(), a.dtype());
+    run_unary(op, a, out);
+    return out;
+}
+
+// i64 only; f32 and f64 go through gemm()
+void matmul_kernel(const int64_t* a, const int64_t* b, int64_t* c, int64_t m, int64_t k, int64_t n) {
+    // i-k-j order streams rows of b and c; products wrap like the
+    // elementwise kernels
+    std::fill(c, c + m * n, int64_t(0));
+    for (int64_t i = 0; i < m; ++i) {
+        uint64_t* crow = reinterpret_cast<uint64_t*>(c + i * n);
+        for (int64_t p = 0; p < k; ++p) {
+            const uint64_t aip = static_cast<uint64_t>(a[i * k + p]);
+            const int64_t* brow = b + p * n;
+            for (int64_t j = 0; j < n; ++j) crow[j] += aip * static_cast<uint64_t>(brow[j]);
+        }
+    }
+}
+
+} // anonymous namespace
+
+std::string shape_string(const Tensor::Shape& shape) {
+    std::string s = "[";
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (i) s += "x";
+        s += std::to_string(shape[i]);
+    }
+    return s + "]";
+}
+
+Tensor::Shape broadcast_shapes(const Tensor::Shape& a, const Tensor::Shape& b) {
+    Tensor::Shape out;
+    if (!broadcast_into(a, b, out)) {
+        throw TensorError("tensor: cannot broadcast " + shape_string(a) + " with " + shape_string(b));
+    }
+    return out;
+}
+
+bool broadcasts_to(const Tensor::Shape& from, const Tensor::Shape& to) {
+    Tensor::Shape out;
+    return broadcast_into(from, to, out) && out == to;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor
+// ─────────────────────────────────────────────────────────────────────────────
+
+Tensor Tensor::empty(const Shape& shape, DType dtype) {
+    Tensor t;
+    t.shape_ = shape;
+    t.strides_.assign(shape.size(), 1);
+    t.dtype_ = dtype;
+
+    size_t n = 1;
+    const size_t limit = std::numeric_limits<size_t>::max() / types::dtype_size(dtype);
+    for (size_t d = shape.size(); d-- > 0;) {
+        if (shape[d] < 0) {
+            throw TensorError("tensor: negative dimension in shape " + shape_string(shape));
+        }
+        t.strides_[d] = static_cast<int64_t>(n);
+        if (shape[d] && n > limit / static_cast<size_t>(shape[d])) {
+            throw TensorError("tensor: shape " + shape_string(shape) + " is too large");
+        }
+        n *= static_cast<size_t>(shape[d]);
+    }
+    t.numel_ = n;
+    t.storage_ = std::make_shared<Storage>(n * types::dtype_size(dtype));
+    return t;
+}
+
+Tensor Tensor::full(const Shape& shape, double value, DType dtype) {
+    Tensor t = empty(shape, dtype);
+    void* p = t.raw_data();
+    switch (dtype) {
+        case DType::F32:
+            std::fill_n(static_cast<float*>(p), t.numel_, static_cast<float>(value));
+            break;
+        case DType::F64:
+            std::fill_n(static_cast<double*>(p), t.numel_, value);
+            break;
+        case DType::I64:
+            std::fill_n(static_cast<int64_t*>(p), t.numel_, static_cast<int64_t>(value));
+            break;
+    }
+    return t;
+}
+
+bool Tensor::is_contiguous() const {
+    int64_t expected = 1;
+    for (size_t d = shape_.size(); d-- > 0;) {
+        if (shape_[d] != 1 && strides_[d] != expected) return false;
+        expected *= shape_[d];
+    }
+    return true;
+}
+
+void* Tensor::raw_data() {
+    if (!storage_) return nullptr;
+    return static_cast<char*>(storage_->data()) + offset_ * types::dtype_size(dtype_);
+}
+
+const void* Tensor::raw_data() const {
+    if (!storage_) return nullptr;
+    return static_cast<const char*>(storage_->data()) + offset_ * types::dtype_size(dtype_);
+}
+
+int64_t Tensor::element_offset(size_t i) const {
+    int64_t off = 0;
+    for (size_t d = shape_.size(); d-- > 0;) {
+        const size_t extent = static_cast<size_t>(shape_[d]);
+        off += static_cast<int64_t>(i % extent) * strides_[d];
+        i /= extent;
+    }
+    return off;
+}
+
+double Tensor::get(size_t i) const {
+    const int64_t off = element_offset(i);
+    switch (dtype_) {
+        case DType::F32: return load<float>(raw_data(), off);
+        case DType::F64: return load<double>(raw_data(), off);
+        case DType::I64: return load<int64_t>(raw_data(), off);
+    }
+    return 0.0;
+}
+
+void Tensor::set(size_t i, double value) {
+    const int64_t off = element_offset(i);
+    switch (dtype_) {
+        case DType::F32: store<float>(raw_data(), off, value); break;
+        case DType::F64: store<double>(raw_data(), off, value); break;
+        case DType::I64: store<int64_t>(raw_data(), off, value); break;
+    }
+}
+
+Tensor Tensor::contiguous() const {
+    Tensor out = empty(shape_, dtype_);
+    const size_t size = types::dtype_size(dtype_);
+    if (is_contiguous()) {
+        std::memcpy(out.raw_data(), raw_data(), numel_ * size);
+        return out;
+    }
+    if (numel_ == 0) return out;
+    RowReader rows(*this);
+    const size_t row_bytes = rows.row_length() * size;
+    char* po = static_cast<char*>(out.raw_data());
+    for (size_t r = 0; r < numel_ / rows.row_length(); ++r) {
+        std::memcpy(po + r * row_bytes, rows.next(), row_bytes);
+    }
+    return out;
+}
+
+Tensor Tensor::as_strided(const Shape& shape, const Shape& strides, int64_t offset) const {
+    if (!storage_) throw TensorError("tensor: view of an undefined tensor");
+    if (shape.size() != strides.size()) {
+        throw TensorError("tensor: view needs one stride per dimension");
+    }
+    // Every element the view can reach must lie inside the storage
+    int64_t lo = offset_ + offset, hi = offset_ + offset;
+    size_t n = 1;
+    for (size_t d = 0; d < shape.size(); ++d) {
+        if (shape[d] < 0) {
+            throw TensorError("tensor: negative dimension in shape " + shape_string(shape));
+        }
+        n *= static_cast<size_t>(shape[d]);
+        if (shape[d] == 0) continue;
+        int64_t reach = (shape[d] - 1) * strides[d];
+        (reach < 0 ? lo : hi) += reach;
+    }
+    const int64_t capacity = static_cast<int64_t>(storage_->bytes() / types::dtype_size(dtype_));
+    if (n && (lo < 0 || hi >= capacity)) {
+        throw TensorError("tensor: view " + shape_string(shape) + " is out of bounds");
+    }
+    Tensor t = *this;
+    t.shape_ = shape;
+    t.strides_ = strides;
+    t.offset_ = offset_ + offset;
+    t.numel_ = n;
+    return t;
+}
+
+Tensor Tensor::reshape(const Shape& shape) const {
+    if (!storage_) throw TensorError("tensor.reshape: undefined tensor");
+
+    // Resolve the inferred dimension
+    Shape dims = shape;
+    size_t known = 1;
+    size_t infer = dims.size();
+    for (size_t d = 0; d < dims.size(); ++d) {
+        if (dims[d] == -1 && infer == dims.size()) {
+            infer = d;
+        } else if (dims[d] < 0) {
+            throw TensorError("tensor.reshape: invalid shape " + shape_string(shape));
+        } else {
+            known *= static_cast<size_t>(dims[d]);
+        }
+    }
+    if (infer < dims.size()) {
+        if (known == 0 || numel_ % known) {
+            throw TensorError("tensor.reshape: cannot infer a dimension of " +
+                              shape_string(shape) + " for " + std::to_string(numel_) + " elements");
+        }
+        dims[infer] = static_cast<int64_t>(numel_ / known);
+        known = numel_;
+    }
+    if (known != numel_) {
+        throw TensorError("tensor.reshape: cannot view " + shape_string(shape_) + " as " +
+                          shape_string(dims));
+    }
+    if (numel_ == 0) return empty(dims, dtype_);
+
+    // Match runs of old and new dimensions with equal products; each old
+    // run must be one evenly strided block, which the new run then
+    // splits again (NumPy's no-copy reshape). Size-1 dimensions are left
+    // out of the old side and get any stride on the new one.
+    Shape old_dims, old_strides;
+    for (size_t d = 0; d < shape_.size(); ++d) {
+        if (shape_[d] == 1) continue;
+        old_dims.push_back(shape_[d]);
+        old_strides.push_back(strides_[d]);
+    }
+    Shape strides(dims.size(), 1);
+    size_t oi = 0, ni = 0;
+    while (oi < old_dims.size() && ni < dims.size()) {
+        if (dims[ni] == 1) {
+            ++ni;
+            continue;
+        }
+        size_t oj = oi + 1, nj = ni + 1;
+        int64_t op = old_dims[oi], np = dims[ni];
+        while (op != np) {
+            if (np < op) np *= dims[nj++];
+            else op *= old_dims[oj++];
+        }
+        for (size_t k = oi; k + 1 < oj; ++k) {
+            if (old_strides[k] != old_dims[k + 1] * old_strides[k + 1]) return contiguous().reshape(dims);
+        }
+        strides[nj - 1] = old_strides[oj - 1];
+        for (size_t k = nj - 1; k > ni; --k) strides[k - 1] = strides[k] * dims[k];
+        oi = oj;
+        ni = nj;
+    }
+    return as_strided(dims, strides);
+}
+
+Tensor Tensor::transpose(int64_t dim0, int64_t dim1) const {
+    if (!storage_) throw TensorError("tensor.transpose: undefined tensor");
+    const size_t a = normalize_dim(dim0, ndim(), "transpose");
+    const size_t b = normalize_dim(dim1, ndim(), "transpose");
+    Shape shape = shape_, strides = strides_;
+    std::swap(shape[a], shape[b]);
+    std::swap(strides[a], strides[b]);
+    return as_strided(shape, strides);
+}
+
+Tensor Tensor::slice(int64_t dim, int64_t start, int64_t stop, int64_t step) const {
+    if (!storage_) throw TensorError("tensor.slice: undefined tensor");
+    if (step <= 0) throw TensorError("tensor.slice: step must be positive");
+    const size_t d = normalize_dim(dim, ndim(), "slice");
+    const int64_t n = shape_[d];
+    auto clamp = [n](int64_t i) { return std::min(std::max(i < 0 ? i + n : i, int64_t(0)), n); };
+    start = clamp(start);
+    stop = clamp(stop);
+
+    Shape shape = shape_, strides = strides_;
+    shape[d] = stop > start ? (stop - start + step - 1) / step : 0;
+    strides[d] *= step;
+    if (shape[d] == 0) return empty(shape, dtype_);
+    return as_strided(shape, strides, start * strides_[d]);
+}
+
+Tensor Tensor::broadcast_to(const Shape& shape) const {
+    if (!storage_) throw TensorError("tensor.broadcast: undefined tensor");
+    if (!broadcasts_to(shape_, shape)) {
+        throw TensorError("tensor.broadcast: cannot broadcast " + shape_string(shape_) + " to " +
+                          shape_string(shape));
+    }
+    Shape strides(shape.size(), 0);
+    const size_t lead = shape.size() - shape_.size();
+    for (size_t d = 0; d < shape_.size(); ++d) {
+        if (shape_[d] != 1) strides[lead + d] = strides_[d];
+    }
+    return as_strided(shape, strides);
+}
+
+std::string Tensor::to_string(size_t max_elements) const {
+    std::ostringstream ss;
+    ss << "tensor<" << types::dtype_name(dtype_) << ">" << shape_string(shape_) << " ";
+
+    const size_t shown = std::min(numel_, max_elements);
+    for (size_t i = 0; i < shown; ++i) {
+        // Open a bracket for every dimension starting here
+        size_t rest = i;
+        for (size_t d = shape_.size(); d-- > 0;) {
+            if (rest % static_cast<size_t>(shape_[d])) break;
+            ss << "[";
+            rest /= static_cast<size_t>(shape_[d]);
+        }
+        if (dtype_ == DType::I64) {
+            ss << static_cast<int64_t>(get(i));
+        } else {
+            ss << get(i);
+        }
+        // Close a bracket for every dimension ending here
+        rest = i + 1;
+        for (size_t d = shape_.size(); d-- > 0;) {
+            if (rest % static_cast<size_t>(shape_[d])) break;
+            ss << "]";
+            rest /= static_cast<size_t>(shape_[d]);
+        }
+        if (i + 1 < shown) ss << ", ";
+    }
+    if (shown < numel_) ss << ", ...";
+    if (numel_ == 0) ss << "[]";
+    return ss.str();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Operations
+// ─────────────────────────────────────────────────────────────────────────────
+
+Tensor add(const Tensor& a, const Tensor& b) { return elementwise(a, b, "add", BinaryOp::ADD); }
+Tensor sub(const Tensor& a, const Tensor& b) { return elementwise(a, b, "sub", BinaryOp::SUB); }
+Tensor mul(const Tensor& a, const Tensor& b) { return elementwise(a, b, "mul", BinaryOp::MUL); }
+
+Tensor relu(const Tensor& a) { return activation(a, "relu", UnaryOp::RELU, {}); }
+Tensor exp(const Tensor& a) { return activation(a, "exp", UnaryOp::EXP, {}); }
+Tensor tanh(const Tensor& a) { return activation(a, "tanh", UnaryOp::TANH, {}); }
+Tensor sigmoid(const Tensor& a) { return activation(a, "sigmoid", UnaryOp::SIGMOID, {}); }
+Tensor gelu(const Tensor& a) { return activation(a, "gelu", UnaryOp::GELU, {}); }
+
+Tensor add(const Tensor& a, const Tensor& b, Tensor dst) {
+    return elementwise(a, b, "add", BinaryOp::ADD, std::move(dst));
+}
+Tensor sub(const Tensor& a, const Tensor& b, Tensor dst) {
+    return elementwise(a, b, "sub", BinaryOp::SUB, std::move(dst));
+}
+Tensor mul(const Tensor& a, const Tensor& b, Tensor dst) {
+    return elementwise(a, b, "mul", BinaryOp::MUL, std::move(dst));
+}
+
+Tensor relu(const Tensor& a, Tensor dst) { return activation(a, "relu", UnaryOp::RELU, std::move(dst)); }
+Tensor exp(const Tensor& a, Tensor dst) { return activation(a, "exp", UnaryOp::EXP, std::move(dst)); }
+Tensor tanh(const Tensor& a, Tensor dst) { return activation(a, "tanh", UnaryOp::TANH, std::move(dst)); }
+Tensor sigmoid(const Tensor& a, Tensor dst) {
+    return activation(a, "sigmoid", UnaryOp::SIGMOID, std::move(dst));
+}
+Tensor gelu(const Tensor& a, Tensor dst) { return activation(a, "gelu", UnaryOp::GELU, std::move(dst)); }
+
+bool fits(const Tensor& dst, const Tensor::Shape& shape, DType dtype) {
+    return dst.defined() && dst.dtype() == dtype && dst.shape() == shape && dst.is_contiguous();
+}
+
+Tensor matmul(const Tensor& a, const Tensor& b) {
+    if (!a.defined() || !b.defined()) throw TensorError("tensor.matmul: undefined tensor");
+    if (a.dtype() != b.dtype()) {
+        throw TensorError(std::string("tensor.matmul: dtype mismatch (") +
+                          types::dtype_name(a.dtype()) + " vs " +
+                          types::dtype_name(b.dtype()) + ")");
+    }
+    if (a.ndim() != 2 || b.ndim() != 2 || a.dim(1) != b.dim(0)) {
+        throw TensorError("tensor.matmul: cannot multiply " + shape_string(a.shape()) +
+                          " by " + shape_string(b.shape()));
+    }
+    const int64_t m = a.dim(0), k = a.dim(1), n = b.dim(1);
+    Tensor out = Tensor::empty({m, n}, a.dtype());
+    if (a.dtype() != DType::I64) {
+        // Packing reads the operands' strides directly
+        gemm(a.dtype(), m, n, k, {a.raw_data(), a.strides()[0], a.strides()[1]},
+             {b.raw_data(), b.strides()[0], b.strides()[1]}, out.raw_data(), n);
+        return out;
+    }
+    const Tensor ac = a.is_contiguous() ? a : a.contiguous();
+    const Tensor bc = b.is_contiguous() ? b : b.contiguous();
+    matmul_kernel(ac.data<int64_t>(), bc.data<int64_t>(), out.data<int64_t>(), m, k, n);
+    return out;
+}
+
+} // namespace tensor
+} // namespace zero
@@ -0,0 +1,184 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Zero Compiler — Thread Pool Implementation
+ */
+
+#include "tensor/thread_pool.hpp"
+
+#include <cstdlib>
+
+namespace zero {
+namespace tensor {
+
+namespace {
+
+// The pool a worker thread belongs to, and its queue there
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_queue = 0;
+
+size_t default_threads() {
+    if (const char* env = std::getenv("ZERO_TENSOR_THREADS")) {
+        long n = std::strtol(env, nullptr, 10);
+        if (n > 0) return static_cast<size_t>(n);
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+} // anonymous namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) threads = default_threads();
+    for (size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+    workers_.reserve(threads - 1);
+    for (size_t i = 0; i + 1 < threads; ++i) workers_.emplace_back([this, i] { worker_loop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_) t.join();
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+size_t ThreadPool::own_queue() const {
+    return current_pool == this ? current_queue : queues_.size() - 1;
+}
+
+void ThreadPool::spawn(TaskGroup& group, std::function<void()> task) {
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+    Queue& queue = *queues_[own_queue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{std::move(task), &group});
+    }
+    queued_.fetch_add(1);
+    {
+        // Pairs with the predicate check of a thread about to sleep
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::take(size_t self, Task& task) {
+    if (queued_.load(std::memory_order_relaxed) == 0) return false;
+
+    // Newest first from our own queue
+    {
+        Queue& queue = *queues_[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    // Oldest first from the others
+    for (size_t k = 1; k < queues_.size(); ++k) {
+        Queue& queue = *queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::run_one(size_t self) {
+    Task task;
+    if (!take(self, task)) return false;
+    TaskGroup& group = *task.group;
+    try {
+        task.fn();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group.mutex_);
+        if (!group.error_) group.error_ = std::current_exception();
+    }
+    task.fn = nullptr;
+    // The group may be gone as soon as its count reaches zero
+    if (group.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        wake_.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    const size_t self = own_queue();
+    while (group.pending_.load(std::memory_order_acquire) != 0) {
+        if (run_one(self)) continue;
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [&] {
+            return group.pending_.load(std::memory_order_acquire) == 0 || queued_.load() > 0;
+        });
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(group.mutex_);
+        std::swap(error, group.error_);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::parallel_for(size_t n, const std::function<void(size_t)>& fn, size_t max_threads) {
+    if (max_threads == 0 || max_threads > size()) max_threads = size();
+    if (max_threads > n) max_threads = n;
+    if (max_threads <= 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+
+    // Helpers and the caller take indices from one counter, so a helper
+    // that starts late, or never, costs nothing
+    std::atomic<size_t> next{0};
+    auto drain = [&] {
+        for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) {
+            try {
+                fn(i);
+            } catch (...) {
+                next.store(n, std::memory_order_relaxed);
+                throw;
+            }
+        }
+    };
+
+    TaskGroup group;
+    for (size_t t = 1; t < max_threads; ++t) spawn(group, drain);
+    std::exception_ptr error;
+    try {
+        drain();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    try {
+        wait(group);
+    } catch (...) {
+        if (!error) error = std::current_exception();
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_queue = index;
+    for (;;) {
+        if (run_one(index)) continue;
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0) return;
+    }
+}
+
+} // namespace tensor
+} // namespace zero
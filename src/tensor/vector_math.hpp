@@ -0,0 +1,195 @@
+#ifndef ZERO_TENSOR_VECTOR_MATH_HPP
+#define ZERO_TENSOR_VECTOR_MATH_HPP
+
+/**
+ * @file vector_math.hpp
+ * @brief Zero Compiler — Vectorized Transcendental Functions
+ *
+ * exp, tanh, sigmoid and gelu written once over an ISA's vector struct
+ * S (see kernels_sse2.cpp), for the per-ISA kernel files only. It all
+ * lives in an anonymous namespace, so each of those translation units
+ * compiles its own copy with its own target flags.
+ *
+ * exp reduces x = n ln2 + r with |r| <= ln2 / 2 (Cody-Waite, ln2 in two
+ * parts so n ln2 is exact), evaluates a polynomial for e^r, adding the
+ * rounding error of r back in with its small terms, and scales by 2^n
+ * in two halves, so results that are subnormal round once and large
+ * ones overflow to inf. tanh uses an odd polynomial (f32) or rational
+ * function (f64) below |x| = 0.625, where 1 - 2 / (e^2x + 1) would
+ * cancel, and that formula above. sigmoid is 1 / (1 + e^-x), or
+ * e^x / (1 + e^x) for x < 0, where e^-x could overflow; gelu is
+ * the tanh form x / (1 + e^-2u), u = sqrt(2/pi) (x + 0.044715 x^3),
+ * which is x (1 + tanh u) / 2 without the cancellation for x < 0.
+ *
+ * S provides, besides the arithmetic the elementwise kernels use:
+ * div; min and max, which return their first operand if either is NaN;
+ * abs; copysign(mag, sign); blend_lt(a, b, x, y) = a < b ? x : y; and
+ * ldexp(p, n) = p * 2^n for integral n in roughly [-1100, 1100].
+ */
+
+#include <cstddef>
+#include <cstring>
+
+namespace zero {
+namespace tensor {
+namespace {
+
+template <typename T> struct MathConstants;
+
+template <> struct MathConstants<float> {
+    static constexpr float LOG2E = 1.44269504088896341f;
+    static constexpr float LN2_HI = 0.693359375f;
+    static constexpr float LN2_LO = -2.12194440e-4f;
+    static constexpr float SHIFTER = 12582912.0f;       // 1.5 * 2^23: adding it rounds to an integer
+    static constexpr float EXP_MIN = -104.0f;           // e^x rounds to 0 below
+    static constexpr float EXP_MAX = 89.5f;             // and to inf above
+    static constexpr float MAX_FINITE = 3.40282347e38f;
+
+    // e^r = 1 + r + r^2 * p(r), highest power first
+    static constexpr size_t EXP_TERMS = 6;
+    static constexpr float EXP_POLY[EXP_TERMS] = {
+        1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+        4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f,
+    };
+
+    // tanh(x) = x + x^3 * p(x^2) for |x| < 0.625
+    static constexpr size_t TANH_TERMS = 5;
+    static constexpr float TANH_POLY[TANH_TERMS] = {
+        -5.70498872745e-3f, 2.06390887954e-2f, -5.37397155531e-2f,
+        1.33314422036e-1f, -3.33332819422e-1f,
+    };
+};
+
+template <> struct MathConstants<double> {
+    static constexpr double LOG2E = 1.4426950408889634074;
+    static constexpr double LN2_HI = 6.93145751953125e-1;
+    static constexpr double LN2_LO = 1.42860682030941723212e-6;
+    static constexpr double SHIFTER = 6755399441055744.0;  // 1.5 * 2^52
+    static constexpr double EXP_MIN = -746.0;
+    static constexpr double EXP_MAX = 710.0;
+    static constexpr double MAX_FINITE = 1.7976931348623157e308;
+
+    // Taylor coefficients 1/13! .. 1/2!; the first one left out is
+    // below 2^-57 on |r| <= ln2 / 2
+    static constexpr size_t EXP_TERMS = 12;
+    static constexpr double EXP_POLY[EXP_TERMS] = {
+        1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+        1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+        1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 1.0 / 2.0,
+    };
+
+    // tanh(x) = x + x^3 * p(x^2) / q(x^2) for |x| < 0.625; q is monic
+    static constexpr size_t TANH_TERMS = 3;
+    static constexpr double TANH_P[TANH_TERMS] = {
+        -9.64399179425052238628e-1, -9.92877231001918586564e1, -1.61468768441708447952e3,
+    };
+    static constexpr double TANH_Q[TANH_TERMS] = {
+        1.12811678491632931402e2, 2.23548839060100448583e3, 4.84406305325125486048e3,
+    };
+};
+
+template <typename S>
+typename S::V vexp(typename S::V x) {
+    using T = typename S::T;
+    using V = typename S::V;
+    using C = MathConstants<T>;
+    x = S::min(S::max(x, S::set1(C::EXP_MIN)), S::set1(C::EXP_MAX));
+    const V n = S::sub(S::fma(x, S::set1(C::LOG2E), S::set1(C::SHIFTER)), S::set1(C::SHIFTER));
+    const V hi = S::fma(n, S::set1(-C::LN2_HI), x);
+    const V r = S::fma(n, S::set1(-C::LN2_LO), hi);
+    const V lo = S::fma(n, S::set1(-C::LN2_LO), S::sub(hi, r));    // What rounding r lost
+    V p = S::set1(C::EXP_POLY[0]);
+    for (size_t i = 1; i < C::EXP_TERMS; ++i) p = S::fma(p, r, S::set1(C::EXP_POLY[i]));
+    p = S::add(S::add(S::fma(p, S::mul(r, r), lo), r), S::set1(T(1)));
+    return S::ldexp(p, n);
+}
+
+template <typename S>
+typename S::V vtanh(typename S::V x) {
+    using T = typename S::T;
+    using V = typename S::V;
+    using C = MathConstants<T>;
+    const V one = S::set1(T(1));
+    const V a = S::abs(x);
+
+    // Above 0.625: 1 - 2 / (e^2|x| + 1), with x's sign
+    const V e = vexp<S>(S::add(a, a));
+    const V large = S::copysign(S::sub(one, S::div(S::set1(T(2)), S::add(e, one))), x);
+
+    const V z = S::mul(x, x);
+    V p;
+    if constexpr (sizeof(T) == 4) {
+        p = S::set1(C::TANH_POLY[0]);
+        for (size_t i = 1; i < C::TANH_TERMS; ++i) p = S::fma(p, z, S::set1(C::TANH_POLY[i]));
+    } else {
+        V num = S::set1(C::TANH_P[0]);
+        V den = S::add(z, S::set1(C::TANH_Q[0]));
+        for (size_t i = 1; i < C::TANH_TERMS; ++i) {
+            num = S::fma(num, z, S::set1(C::TANH_P[i]));
+            den = S::fma(den, z, S::set1(C::TANH_Q[i]));
+        }
+        p = S::div(num, den);
+    }
+    const V small = S::fma(S::mul(p, z), x, x);
+    return S::blend_lt(a, S::set1(T(0.625)), small, large);
+}
+
+template <typename S>
+typename S::V vsigmoid(typename S::V x) {
+    using T = typename S::T;
+    using V = typename S::V;
+    // e^-|x| cannot overflow, so tiny results for x < 0 stay subnormal
+    const V one = S::set1(T(1));
+    const V e = vexp<S>(S::sub(S::zero(), S::abs(x)));
+    return S::div(S::blend_lt(x, S::zero(), e, one), S::add(one, e));
+}
+
+template <typename S>
+typename S::V vgelu(typename S::V x) {
+    using T = typename S::T;
+    using V = typename S::V;
+    // -inf would give -inf / inf; the most negative finite value gives -0
+    x = S::max(x, S::set1(-MathConstants<T>::MAX_FINITE));
+    const V u = S::mul(x, S::fma(S::mul(x, x), S::set1(T(0.7978845608028654 * 0.044715)),
+                                 S::set1(T(0.7978845608028654))));
+    return S::div(x, S::add(S::set1(T(1)), vexp<S>(S::mul(u, S::set1(T(-2))))));
+}
+
+struct Exp {
+    template <typename S> static typename S::V vec(typename S::V a) { return vexp<S>(a); }
+};
+struct Tanh {
+    template <typename S> static typename S::V vec(typename S::V a) { return vtanh<S>(a); }
+};
+struct Sigmoid {
+    template <typename S> static typename S::V vec(typename S::V a) { return vsigmoid<S>(a); }
+};
+struct Gelu {
+    template <typename S> static typename S::V vec(typename S::V a) { return vgelu<S>(a); }
+};
+
+/**
+ * out[i] = Op(a[i]) for i < n. The tail goes through a padded vector
+ * rather than a scalar loop, so every element gets the same
+ * approximation.
+ */
+template <typename S, typename Op>
+void math_unary(const void* a, void* out, size_t n) {
+    using T = typename S::T;
+    const T* pa = static_cast<const T*>(a);
+    T* po = static_cast<T*>(out);
+    size_t i = 0;
+    for (; i + S::W <= n; i += S::W) S::store(po + i, Op::template vec<S>(S::load(pa + i)));
+    if (i < n) {
+        T tail[S::W] = {};
+        std::memcpy(tail, pa + i, (n - i) * sizeof(T));
+        S::store(tail, Op::template vec<S>(S::load(tail)));
+        std::memcpy(po + i, tail, (n - i) * sizeof(T));
+    }
+}
+
+} // anonymous namespace
+} // namespace tensor
+} // namespace zero
+
+#endif // ZERO_TENSOR_VECTOR_MATH_HPP
@@ -7,9 +7,12 @@
 #include "ir/ir.hpp"
 #include "ir/builder.hpp"
 #include "ir/lowering.hpp"
+#include "ir/profile.hpp"
 #include "parser/parser.hpp"
 #include "source/source.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <cassert>
@@ -98,6 +101,27 @@ TEST(test_arithmetic) {
     assert(result.as_int() == 3);
 }
 
+TEST(test_bitwise) {
+    Module mod;
+    Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
+    IRBuilder builder(fn);
+    
+    Value a = builder.const_int(-20);
+    Value shifted = builder.shr(a, builder.const_int(2));                  // -5
+    Value masked = builder.bit_and(builder.const_int(0xff), builder.const_int(0x3c));  // 0x3c
+    Value merged = builder.bit_or(masked, builder.const_int(1));           // 61
+    Value big = builder.shl(builder.const_int(1), builder.const_int(40));  // 2^40
+    Value high = builder.mul_hi(big, big);                                 // 2^16
+    Value sum = builder.add(builder.add(shifted, merged), high);           // 65592
+    builder.ret(sum);
+    
+    Interpreter interp;
+    RuntimeValue result = interp.execute(mod);
+    
+    assert(result.is_int());
+    assert(result.as_int() == 65592);
+}
+
 TEST(test_comparison) {
     Module mod;
     Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
@@ -168,6 +192,35 @@ TEST(test_lowering_and_execute) {
     assert(result.as_int() == 7);
 }
 
+TEST(test_lowering_shadowing) {
+    auto run = [](const char* code) {
+        SourceManager sm;
+        SourceID id = sm.load_from_string("test.zero", code);
+        Parser parser(sm, id);
+        auto prog = parser.parse();
+        assert(!parser.had_error());
+        
+        Lowering lowering;
+        Module mod = lowering.lower(prog);
+        Interpreter interp;
+        return interp.execute(mod).as_int();
+    };
+    
+    // An inner `let` gets its own slot and ends with its block
+    assert(run("fn main() -> int { let x = 1\n if 1 < 2 { let x = 5\n x = x + 1 }\n return x }") == 1);
+    assert(run("fn main() -> int { let x = 1\n x = 2\n if 1 < 2 { let x = 5 }\n return x }") == 2);
+    
+    // Its initializer and anything before it still see the outer one
+    assert(run("fn main() -> int { let x = 3\n let y = 0\n"
+               "  if 1 < 2 { x = x + 1\n let x = x * 10\n x = x + 1\n y = x }\n"
+               "  return x * 100 + y }") == 441);
+    
+    // Likewise in a loop body, on every iteration
+    assert(run("fn main() -> int { let i = 0\n let acc = 0\n"
+               "  while i < 3 { let acc = 100\n acc = acc + i\n i = i + 1 }\n"
+               "  return acc }") == 0);
+}
+
 TEST(test_exit_code) {
     Module mod;
     Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
@@ -182,6 +235,339 @@ TEST(test_exit_code) {
     assert(interp.exit_code() == 0);
 }
 
+TEST(test_execution_limits) {
+    // An infinite loop: entry branches to itself
+    Module mod;
+    Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
+    IRBuilder builder(fn);
+    builder.const_int(1);
+    builder.br(fn.blocks[0]);
+    
+    Interpreter interp;
+    interp.set_instruction_budget(100);
+    bool stopped = false;
+    try {
+        interp.execute(mod);
+    } catch (const ExecutionLimitExceeded&) {
+        stopped = true;
+    }
+    assert(stopped);
+    assert(interp.instructions_executed() == 101);
+    
+    // Call a function directly; deep recursion trips the depth limit
+    Module rec;
+    Function& down = rec.add_function("down", {}, zero::types::Type::make_int());
+    IRBuilder rb(down);
+    rb.ret(rb.call("down", {}, zero::types::Type::make_int()));
+    
+    Interpreter limited;
+    limited.set_max_call_depth(64);
+    stopped = false;
+    try {
+        limited.call(rec, "down", {});
+    } catch (const ExecutionLimitExceeded&) {
+        stopped = true;
+    }
+    assert(stopped);
+}
+
+TEST(test_profile_counts) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn inc(x: int) -> int { return x + 1; }\n"
+        "fn main() { let i = 0; while i < 5 { i = inc(i); } return i; }");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    Profile profile;
+    Interpreter interp;
+    interp.set_profile(&profile);
+    RuntimeValue result = interp.execute(mod);
+    assert(result.as_int() == 5);
+    
+    const FunctionProfile& inc = profile.functions().at("inc");
+    assert(inc.blocks.at(0) == 5);
+    
+    // The loop header is entered once from outside and once per iteration
+    const Function* main_fn = mod.get_function("main");
+    size_t applied = profile.apply(mod);
+    assert(applied == 2);
+    uint64_t calls = 0;
+    uint64_t max_block = 0;
+    for (const auto& bb : main_fn->blocks) {
+        max_block = std::max(max_block, bb.profile_count);
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::CALL) calls += instr.profile_count;
+        }
+    }
+    assert(calls == 5);
+    assert(max_block == 6);
+}
+
+TEST(test_memo_calls) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "@memo fn fib(n: int) -> int { if n < 2 { return n; } return fib(n - 1) + fib(n - 2); }\n"
+        "fn main() -> int { return fib(25); }");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    Interpreter memoized;
+    assert(memoized.execute(mod).as_int() == 75025);
+    assert(memoized.memo_misses() == 26);
+    assert(memoized.memo_hits() == 23);
+    
+    MemoOptions off;
+    off.capacity = 0;
+    Interpreter plain;
+    plain.set_memo_options(off);
+    assert(plain.execute(mod).as_int() == 75025);
+    assert(plain.memo_hits() == 0);
+    assert(memoized.instructions_executed() * 100 < plain.instructions_executed());
+    
+    // A tiny cache that keeps its first entries is still transparent
+    MemoOptions tiny;
+    tiny.capacity = 2;
+    tiny.eviction = MemoEviction::KEEP;
+    Interpreter small;
+    small.set_memo_options(tiny);
+    assert(small.call(mod, "fib", {RuntimeValue(int64_t(20))}).as_int() == 6765);
+}
+
+TEST(test_tensor_ops) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn layer(x: tensor, w: tensor) -> tensor { return relu(matmul(x, w) - fill(7.0, 2, 4)); }\n"
+        "fn main() -> tensor { return layer(fill(2.0, 2, 3), fill(1.5, 3, 4)) * fill(2.0, 2, 4); }");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    Interpreter interp;
+    RuntimeValue result = interp.execute(mod);
+    assert(result.is_tensor());
+    const zero::tensor::Tensor& t = result.as_tensor();
+    assert(t.shape() == (zero::tensor::Tensor::Shape{2, 4}));
+    assert(t.get(0) == 4.0);
+    
+    // Shape errors surface as exceptions from the run
+    bool threw = false;
+    try {
+        interp.call(mod, "layer", {RuntimeValue(zero::tensor::Tensor::zeros({2, 2})),
+                                   RuntimeValue(zero::tensor::Tensor::zeros({3, 4}))});
+    } catch (const zero::tensor::TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_tensor_views) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn main(x: tensor, row: tensor) -> tensor {\n"
+        "    let t = transpose(reshape(x, 3, -1))\n"
+        "    return slice(t, 1, 1, 3) + slice(row, 0, 0, 2)\n"
+        "}");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    // x = 0 .. 5 as [6]: reshape to [3x2], transpose to [2x3], keep
+    // columns 1 and 2 and add a broadcast row
+    zero::tensor::Tensor x = zero::tensor::Tensor::empty({6});
+    for (size_t i = 0; i < 6; ++i) x.set(i, static_cast<double>(i));
+    zero::tensor::Tensor row = zero::tensor::Tensor::full({3}, 10.0);
+    row.set(1, 20.0);
+    Interpreter interp;
+    RuntimeValue result = interp.call(mod, "main", {RuntimeValue(x), RuntimeValue(row)});
+    assert(result.as_tensor().to_string() == "tensor<f32>[2x2] [[12, 24], [13, 25]]");
+    
+    // Five elements do not split into three rows
+    bool threw = false;
+    try {
+        interp.call(mod, "main", {RuntimeValue(zero::tensor::Tensor::zeros({5})), RuntimeValue(row)});
+    } catch (const zero::tensor::TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_tensor_reductions) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn main(x: tensor) -> tensor {\n"
+        "    return sum(softmax(x), 1)\n"
+        "}\n"
+        "fn pick(x: tensor) -> tensor {\n"
+        "    return argmax(layernorm(x), 1)\n"
+        "}\n"
+        "fn total(x: tensor) -> tensor {\n"
+        "    return sum(x) + mean(x, 0)\n"
+        "}");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    zero::tensor::Tensor x = zero::tensor::Tensor::empty({2, 3});
+    for (size_t i = 0; i < 6; ++i) x.set(i, static_cast<double>(i));
+    Interpreter interp;
+    RuntimeValue total = interp.call(mod, "total", {RuntimeValue(x)});
+    assert(total.as_tensor().to_string() == "tensor<f32>[3] [16.5, 17.5, 18.5]");
+    
+    // Each softmax row sums to one
+    RuntimeValue rows = interp.call(mod, "main", {RuntimeValue(x)});
+    assert(rows.as_tensor().numel() == 2);
+    for (size_t i = 0; i < 2; ++i) assert(std::fabs(rows.as_tensor().get(i) - 1) < 1e-6);
+    assert(interp.call(mod, "pick", {RuntimeValue(x)}).as_tensor().to_string() == "tensor<i64>[2] [2, 2]");
+    
+    // No axis 2 in a matrix
+    SourceID bad = sm.load_from_string("bad.zero",
+        "fn main(x: tensor) -> tensor {\n"
+        "    return sum(x, 2)\n"
+        "}");
+    Parser bad_parser(sm, bad);
+    auto bad_prog = bad_parser.parse();
+    Module bad_mod = lowering.lower(bad_prog);
+    bool threw = false;
+    try {
+        interp.call(bad_mod, "main", {RuntimeValue(x)});
+    } catch (const zero::tensor::TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_tensor_activations) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn main(x: tensor) -> tensor {\n"
+        "    return sigmoid(x) + tanh(x) + gelu(x) - exp(x)\n"
+        "}\n"
+        "fn bad(x: tensor) -> tensor {\n"
+        "    return exp(argmax(x, 1))\n"
+        "}");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    zero::tensor::Tensor x = zero::tensor::Tensor::empty({2, 3});
+    for (size_t i = 0; i < 6; ++i) x.set(i, static_cast<double>(i) - 2.5);
+    Interpreter interp;
+    zero::tensor::Tensor y = interp.call(mod, "main", {RuntimeValue(x)}).as_tensor();
+    for (size_t i = 0; i < 6; ++i) {
+        const double v = x.get(i);
+        const double gelu = 0.5 * v * (1 + std::tanh(0.7978845608 * (v + 0.044715 * v * v * v)));
+        assert(std::fabs(y.get(i) - (1 / (1 + std::exp(-v)) + std::tanh(v) + gelu - std::exp(v))) < 1e-5);
+    }
+    
+    // argmax gives i64 indices, which exp does not take
+    bool threw = false;
+    try {
+        interp.call(mod, "bad", {RuntimeValue(x)});
+    } catch (const zero::tensor::TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_tensor_graph_mode) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn wide(x: tensor, w: tensor) -> tensor {\n"
+        "    let a = relu(matmul(x, w))\n"
+        "    let b = sigmoid(matmul(x, w + w))\n"
+        "    let c = gelu(matmul(x * x, w) - fill(1.0, 4, 5))\n"
+        "    let d = exp(x) * x\n"
+        "    return softmax(a + b + c, 1) + sum(d)\n"
+        "}\n"
+        "fn bad(x: tensor, w: tensor) -> tensor {\n"
+        "    let p = tanh(x)\n"
+        "    let q = matmul(x, x)\n"
+        "    return p + (x + w) + q\n"
+        "}");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    zero::tensor::Tensor x = zero::tensor::Tensor::empty({4, 3});
+    zero::tensor::Tensor w = zero::tensor::Tensor::empty({3, 5});
+    for (size_t i = 0; i < 12; ++i) x.set(i, static_cast<double>(i % 5) * 0.25 - 0.5);
+    for (size_t i = 0; i < 15; ++i) w.set(i, static_cast<double>(i % 4) * 0.5 - 0.75);
+    auto args = [&] { return std::vector<RuntimeValue>{RuntimeValue(x), RuntimeValue(w)}; };
+    auto error = [&](Interpreter& interp) {
+        try {
+            interp.call(mod, "bad", args());
+        } catch (const std::exception& e) {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    
+    Interpreter in_order;
+    const std::string expected = in_order.call(mod, "wide", args()).as_tensor().to_string();
+    const uint64_t executed = in_order.instructions_executed();
+    const std::string expected_error = error(in_order);
+    assert(!expected_error.empty() && in_order.graph_runs() == 0);
+    
+    // Same values and the same first error, from one graph per function
+    Interpreter graph;
+    graph.set_graph_mode(true);
+    for (int round = 0; round < 20; ++round) {
+        assert(graph.call(mod, "wide", args()).as_tensor().to_string() == expected);
+        assert(graph.instructions_executed() == executed);
+        assert(graph.graph_runs() == 1 && graph.graph_ops() >= 15);
+        assert(error(graph) == expected_error);
+    }
+    
+    // A graph the budget cannot cover runs in order up to the limit
+    graph.set_instruction_budget(executed - 1);
+    bool threw = false;
+    try {
+        graph.call(mod, "wide", args());
+    } catch (const ExecutionLimitExceeded&) {
+        threw = true;
+    }
+    assert(threw && graph.instructions_executed() == executed);
+}
+
+TEST(test_memo_cache_eviction) {
+    MemoOptions opts;
+    opts.capacity = 4;
+    MemoCache cache(1, opts);
+    for (int64_t i = 0; i < 64; ++i) {
+        cache.insert({RuntimeValue(i)}, RuntimeValue(i * 2));
+    }
+    assert(cache.size() == 4);
+    assert(cache.evictions() == 60);
+    
+    // Float and int arguments with the same bits are different keys
+    MemoCache mixed(1, opts);
+    mixed.insert({RuntimeValue(int64_t(0))}, RuntimeValue(1.5));
+    RuntimeValue out;
+    assert(!mixed.lookup({RuntimeValue(0.0)}, out));
+    assert(mixed.lookup({RuntimeValue(int64_t(0))}, out));
+    assert(out.as_float() == 1.5);
+    
+    opts.eviction = MemoEviction::CLEAR;
+    MemoCache cleared(1, opts);
+    for (int64_t i = 0; i < 5; ++i) {
+        cleared.insert({RuntimeValue(i)}, RuntimeValue(i));
+    }
+    assert(cleared.size() == 1);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────────────────────
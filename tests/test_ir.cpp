@@ -6,10 +6,13 @@
 #include "ir/ir.hpp"
 #include "ir/builder.hpp"
 #include "ir/lowering.hpp"
+#include "ir/profile.hpp"
+#include "ir/uses.hpp"
 #include "parser/parser.hpp"
 #include "source/source.hpp"
 
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <cassert>
 
@@ -124,6 +127,14 @@ TEST(test_builder_arithmetic) {
     assert(fn.entry().instrs.size() == 4);
 }
 
+TEST(test_mul_high) {
+    assert(mul_high(int64_t{1} << 40, int64_t{1} << 40) == int64_t{1} << 16);
+    assert(mul_high(INT64_MAX, 2) == 0);
+    assert(mul_high(-1, 1) == -1);
+    assert(mul_high(INT64_MIN, INT64_MIN) == int64_t{1} << 62);
+    assert(mul_high(INT64_MIN, -1) == 0);
+}
+
 TEST(test_builder_ret) {
     Module mod;
     Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
@@ -177,6 +188,36 @@ TEST(test_lowering_variables) {
     assert(mod.functions.size() == 1);
 }
 
+TEST(test_lowering_tensor_types) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn f(x: tensor<f32>[_, 3]) -> tensor { return relu(matmul(x, fill(0.5, 3, 8)) + x); }");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    
+    // Static shapes propagate into the result values
+    const auto& instrs = mod.functions[0].blocks[0].instrs;
+    bool saw_matmul = false;
+    for (const auto& instr : instrs) {
+        if (instr.op == OpCode::TENSOR_ALLOC) {
+            assert(instr.result.type.to_string() == "tensor<f32>[3x8]");
+        } else if (instr.op == OpCode::TENSOR_MATMUL) {
+            assert(instr.result.type.to_string() == "tensor<f32>[?x8]");
+            saw_matmul = true;
+        } else if (instr.op == OpCode::TENSOR_ADD) {
+            // [?x8] + [?x3] cannot match; Sema reports it, lowering gives up
+            assert(instr.result.type == zero::types::Type::make_tensor());
+        }
+    }
+    assert(saw_matmul);
+    std::string text = print_module(mod);
+    assert(text.find("fn @f(tensor<f32>[?x3]) -> tensor {") != std::string::npos);
+    assert(text.find(" : tensor<f32>[?x8]\n") != std::string::npos);
+}
+
 TEST(test_print_module) {
     Module mod;
     Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
@@ -191,6 +232,162 @@ TEST(test_print_module) {
     assert(output.find("const.i64 42") != std::string::npos);
 }
 
+TEST(test_stable_references) {
+    Module mod;
+    Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
+    IRBuilder builder(fn);
+    BasicBlock& first = builder.create_block("first");
+    
+    // Neither more blocks nor more functions move what came before
+    for (int i = 0; i < 200; ++i) builder.create_block();
+    for (int i = 0; i < 50; ++i) mod.add_function("f" + std::to_string(i), {}, zero::types::Type::make_int());
+    assert(&fn == &mod.functions[0]);
+    assert(&first == &fn.blocks[1] && first.label == "first");
+    assert(fn.blocks.arena().chunks() > 1);
+    
+    builder.set_insert_point(first);
+    builder.ret(builder.const_int(1));
+    
+    // retain() reorders and drops without moving the survivors
+    fn.blocks.retain({1, 0});
+    assert(fn.blocks.size() == 2);
+    assert(&fn.blocks[0] == &first);
+    
+    // Copies are deep
+    Function copy = fn;
+    copy.blocks[0].instrs.clear();
+    assert(first.instrs.size() == 2);
+}
+
+TEST(test_use_def_chains) {
+    Module mod;
+    Function& fn = mod.add_function("main", {}, zero::types::Type::make_int());
+    IRBuilder builder(fn);
+    UseDefChains chains(fn);
+    builder.track_uses(&chains);
+    
+    Value a = builder.const_int(2);
+    Value b = builder.const_int(3);
+    Value sum = builder.add(a, a);
+    Value prod = builder.mul(sum, a);
+    builder.ret(prod);
+    
+    // The builder kept the chains current
+    assert(chains.use_count(a) == 3);
+    assert(chains.use_count(sum) == 1);
+    assert(chains.def(prod) && chains.def(prod)->op == OpCode::MUL);
+    
+    // Replacing touches only the uses of `a`, and moves them to `b`
+    assert(chains.replace_all_uses_with(a, b) == 3);
+    assert(chains.use_count(a) == 0 && chains.use_count(b) == 3);
+    assert(fn.blocks[0].instrs[2].operands[0] == b);
+    
+    // Erase leaves a NOP until compact(); the chains follow the renumbering
+    size_t block = 0, index = 0;
+    assert(chains.def_site(a, block, index));
+    chains.erase_instruction(block, index);
+    assert(!chains.def(a));
+    assert(chains.compact() == 1);
+    assert(fn.blocks[0].instrs.size() == 4);
+    assert(chains.def_site(prod, block, index) && index == 2);
+    assert(chains.uses(prod).size() == 1 && chains.at(chains.uses(prod)[0]).op == OpCode::RET);
+    
+    // Erasing uses of a heavily used value, in an order that keeps
+    // moving other uses around its list, leaves the rest findable
+    Function& many = mod.add_function("many", {}, zero::types::Type::make_int());
+    IRBuilder many_builder(many);
+    UseDefChains many_chains(many);
+    many_builder.track_uses(&many_chains);
+    Value slot = many_builder.alloca(zero::types::Type::make_int());
+    std::vector<Value> loads;
+    for (int i = 0; i < 1000; ++i) loads.push_back(many_builder.load(slot));
+    many_builder.ret(loads.back());
+    for (size_t i = 0; i < 999; i += 2) {
+        assert(many_chains.def_site(loads[i], block, index));
+        many_chains.erase_instruction(block, index);
+    }
+    assert(many_chains.use_count(slot) == 500);
+    for (const Use& u : many_chains.uses(slot)) {
+        const Instruction& load = many_chains.at(u);
+        assert(load.op == OpCode::LOAD && load.operands[u.operand] == slot);
+        assert((load.result.id - loads[0].id) % 2 == 1);
+    }
+    assert(many_chains.compact() == 500 && many_chains.use_count(slot) == 500);
+}
+
+TEST(test_compact_instruction) {
+    // Two operands inline, more spill to the heap; copies are independent
+    OperandList ops{Value{1, zero::types::Type::make_int()}, Value{2, zero::types::Type::make_int()}};
+    assert(ops.size() == 2);
+    for (uint32_t id = 3; id <= 5; ++id) ops.push_back(Value{id, zero::types::Type::make_int()});
+    assert(ops.size() == 5 && ops[4].id == 5);
+    
+    OperandList copy = ops;
+    copy[0].id = 9;
+    assert(ops[0].id == 1 && copy[0].id == 9);
+    
+    OperandList moved = std::move(copy);
+    assert(moved.size() == 5 && moved.back().id == 5);
+    assert(copy.empty());
+    
+    // Interned names compare by identity and against plain strings
+    Symbol a("print");
+    Symbol b(std::string("pri") + "nt");
+    assert(a == b && a.id() == b.id());
+    assert(a == "print" && a != std::string("log"));
+    assert(Symbol().empty());
+    
+    // No instruction owns heap memory until a call passes 3+ arguments
+    assert(sizeof(Instruction) <= 96);
+}
+
+TEST(test_profile_round_trip) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero",
+        "fn main() { let x = 0; while x < 3 { x = x + 1; } return x; }");
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    
+    Lowering lowering;
+    Module mod = lowering.lower(prog);
+    const Function& fn = mod.functions[0];
+    
+    Profile profile;
+    FunctionProfile& fp = profile.function(fn);
+    fp.blocks[0] = 1;
+    fp.blocks[1] = 4;
+    fp.sites[{0, 0}] = 7;
+    
+    std::stringstream text;
+    profile.write(text);
+    Profile back = Profile::read(text);
+    assert(back.functions().size() == 1);
+    const FunctionProfile& read_fp = back.functions().at("main");
+    assert(read_fp.checksum == Profile::checksum(fn));
+    assert(read_fp.blocks.at(1) == 4);
+    assert(read_fp.sites.at({0, 0}) == 7);
+    
+    assert(back.apply(mod) == 1);
+    assert(mod.functions[0].has_profile);
+    assert(mod.functions[0].blocks[1].profile_count == 4);
+    assert(mod.functions[0].blocks[0].instrs[0].profile_count == 7);
+    
+    // A profile for differently shaped IR is stale and ignored
+    Module other = lowering.lower(prog);
+    other.functions[0].blocks[0].instrs.erase(other.functions[0].blocks[0].instrs.begin());
+    assert(back.apply(other) == 0);
+    assert(!other.functions[0].has_profile);
+    
+    std::stringstream bad("zero-profile 1\nblock 0 3\n");
+    bool threw = false;
+    try {
+        Profile::read(bad);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────────────────────
@@ -0,0 +1,1341 @@
+/**
+ * @file test_opt.cpp
+ * @brief Unit tests for Zero IR Optimizations
+ */
+
+#include "opt/analysis.hpp"
+#include "opt/buffer_plan.hpp"
+#include "opt/dce.hpp"
+#include "opt/dead_functions.hpp"
+#include "opt/fusion.hpp"
+#include "opt/induction.hpp"
+#include "opt/layout.hpp"
+#include "opt/licm.hpp"
+#include "opt/inliner.hpp"
+#include "opt/partial_eval.hpp"
+#include "opt/purity.hpp"
+#include "opt/range.hpp"
+#include "opt/simplify.hpp"
+#include "opt/simplify_cfg.hpp"
+#include "opt/unroll.hpp"
+#include "backend/interpreter.hpp"
+#include "ir/ir.hpp"
+#include "ir/builder.hpp"
+#include "ir/lowering.hpp"
+#include "ir/profile.hpp"
+#include "parser/parser.hpp"
+#include "source/source.hpp"
+#include "tensor/buffer_pool.hpp"
+
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <limits>
+#include <string>
+
+using namespace zero::opt;
+using namespace zero::ir;
+using namespace zero::backend;
+using zero::types::Type;
+using zero::parser::Parser;
+using zero::source::SourceManager;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test utilities
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define TEST(name) void name(); \
+    static struct name##_register { \
+        name##_register() { tests.push_back({#name, name}); } \
+    } name##_instance; \
+    void name()
+
+struct TestCase {
+    const char* name;
+    void (*func)();
+};
+
+static std::vector<TestCase> tests;
+
+static int run_all_tests() {
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& test : tests) {
+        std::cout << "  Running " << test.name << "... ";
+        try {
+            test.func();
+            std::cout << "\033[32mPASS\033[0m\n";
+            ++passed;
+        } catch (const std::exception& e) {
+            std::cout << "\033[31mFAIL\033[0m: " << e.what() << "\n";
+            ++failed;
+        } catch (...) {
+            std::cout << "\033[31mFAIL\033[0m: unknown exception\n";
+            ++failed;
+        }
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
+
+static Module lower_source(const char* code) {
+    SourceManager sm;
+    auto id = sm.load_from_string("test.zero", code);
+    Parser parser(sm, id);
+    auto prog = parser.parse();
+    assert(!parser.had_error());
+    Lowering lowering;
+    return lowering.lower(prog);
+}
+
+static size_t count_calls(const Function& fn, const std::string& callee) {
+    size_t n = 0;
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::CALL && instr.callee == callee) ++n;
+        }
+    }
+    return n;
+}
+
+static int64_t run_main(Module& mod) {
+    Interpreter interp;
+    RuntimeValue result = interp.execute(mod);
+    assert(result.is_int());
+    return result.as_int();
+}
+
+/**
+ * Builds:
+ *   acc = 0; i = 0
+ *   while i < 10 { acc = acc + 6 * 7; i = i + 1 }
+ *   return acc
+ * Blocks: entry(0), while.cond(1), while.body(2), while.end(3)
+ */
+static void build_counting_loop(Module& mod) {
+    Function& fn = mod.add_function("main", {}, Type::make_int());
+    IRBuilder b(fn);
+    fn.new_block("while.cond");
+    fn.new_block("while.body");
+    fn.new_block("while.end");
+    b.set_insert_point(fn.blocks[0]);
+
+    Value i_slot = b.alloca(Type::make_int());
+    Value acc_slot = b.alloca(Type::make_int());
+    Value zero = b.const_int(0);
+    b.store(i_slot, zero);
+    b.store(acc_slot, zero);
+    b.br(fn.blocks[1]);
+
+    b.set_insert_point(fn.blocks[1]);
+    Value i = b.load(i_slot);
+    Value n = b.const_int(10);
+    b.cond_br(b.cmp_lt(i, n), fn.blocks[2], fn.blocks[3]);
+
+    b.set_insert_point(fn.blocks[2]);
+    Value prod = b.mul(b.const_int(6), b.const_int(7));
+    b.store(acc_slot, b.add(b.load(acc_slot), prod));
+    b.store(i_slot, b.add(b.load(i_slot), b.const_int(1)));
+    b.br(fn.blocks[1]);
+
+    b.set_insert_point(fn.blocks[3]);
+    b.ret(b.load(acc_slot));
+}
+
+static size_t count_op(const BasicBlock& bb, OpCode op) {
+    size_t n = 0;
+    for (const auto& instr : bb.instrs) {
+        if (instr.op == op) ++n;
+    }
+    return n;
+}
+
+static size_t count_op(const Function& fn, OpCode op) {
+    size_t n = 0;
+    for (const auto& bb : fn.blocks) n += count_op(bb, op);
+    return n;
+}
+
+// acc = sum of 3*i for i in [0, n)
+static std::string sum_loop_source(int n) {
+    return "fn main() -> int {\n"
+           "  let i = 0\n"
+           "  let acc = 0\n"
+           "  while i < " + std::to_string(n) + " {\n"
+           "    acc = acc + i * 3\n"
+           "    i = i + 1\n"
+           "  }\n"
+           "  return acc\n"
+           "}";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Analysis tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_cfg_and_dominators) {
+    Module mod;
+    build_counting_loop(mod);
+    const Function& fn = mod.functions[0];
+
+    CFG cfg = CFG::build(fn);
+    assert(cfg.succs[0].size() == 1 && cfg.succs[0][0] == 1);
+    assert(cfg.succs[1].size() == 2);
+    assert(cfg.preds[1].size() == 2);
+
+    DominatorTree dom(cfg);
+    assert(dom.dominates(0, 3));
+    assert(dom.dominates(1, 2));
+    assert(!dom.dominates(2, 3));
+}
+
+TEST(test_loop_nest) {
+    Module mod;
+    Function& fn = mod.add_function("main", {}, Type::make_void());
+    IRBuilder b(fn);
+    for (const char* label : {"outer.cond", "inner.cond", "inner.body", "outer.latch", "end"}) {
+        fn.new_block(label);
+    }
+    b.set_insert_point(fn.blocks[0]);
+
+    Value c = b.const_int(1);
+    b.br(fn.blocks[1]);
+    b.set_insert_point(fn.blocks[1]);
+    b.cond_br(c, fn.blocks[2], fn.blocks[5]);
+    b.set_insert_point(fn.blocks[2]);
+    b.cond_br(c, fn.blocks[3], fn.blocks[4]);
+    b.set_insert_point(fn.blocks[3]);
+    b.br(fn.blocks[2]);
+    b.set_insert_point(fn.blocks[4]);
+    b.br(fn.blocks[1]);
+    b.set_insert_point(fn.blocks[5]);
+    b.ret();
+
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    LoopInfo loops(cfg, dom);
+
+    assert(loops.top_level().size() == 1);
+    Loop* outer = loops.top_level()[0];
+    assert(outer->header == 1);
+    assert(outer->children.size() == 1);
+
+    Loop* inner = outer->children[0];
+    assert(inner->header == 2);
+    assert(inner->depth == 2);
+    assert(loops.loop_for(3) == inner);
+    assert(loops.loop_for(4) == outer);
+    assert(loops.postorder().front() == inner);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// LICM tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_licm_hoists_invariants) {
+    Module mod;
+    build_counting_loop(mod);
+    assert(run_main(mod) == 420);
+
+    LoopInvariantCodeMotion licm;
+    assert(licm.run(mod));
+
+    const Function& fn = mod.functions[0];
+    // entry already is a dedicated preheader
+    assert(licm.preheaders_created() == 0);
+    assert(count_op(fn.blocks[2], OpCode::MUL) == 0);
+    assert(count_op(fn.blocks[2], OpCode::CONST_INT) == 0);
+    assert(count_op(fn.blocks[1], OpCode::CONST_INT) == 0);
+    assert(count_op(fn.blocks[0], OpCode::MUL) == 1);
+
+    // Loads and stores carry loop state and must stay put
+    assert(count_op(fn.blocks[2], OpCode::LOAD) == 2);
+    assert(count_op(fn.blocks[2], OpCode::STORE) == 2);
+
+    assert(run_main(mod) == 420);
+}
+
+TEST(test_licm_creates_preheader) {
+    Module mod;
+    build_counting_loop(mod);
+    Function& fn = mod.functions[0];
+
+    // Give the loop header a second entry edge: entry -> {left, right} -> cond
+    fn.new_block("left");
+    fn.new_block("right");
+    IRBuilder b(fn);
+    auto& entry = fn.blocks[0].instrs;
+    entry.pop_back();
+    b.set_insert_point(fn.blocks[0]);
+    b.cond_br(b.const_int(1), fn.blocks[4], fn.blocks[5]);
+    b.set_insert_point(fn.blocks[4]);
+    b.br(fn.blocks[1]);
+    b.set_insert_point(fn.blocks[5]);
+    b.br(fn.blocks[1]);
+
+    LoopInvariantCodeMotion licm;
+    assert(licm.run(fn));
+    assert(licm.preheaders_created() == 1);
+
+    const BasicBlock& ph = fn.blocks.back();
+    assert(ph.label == "while.cond.preheader");
+    assert(count_op(ph, OpCode::MUL) == 1);
+    assert(ph.instrs.back().op == OpCode::BR);
+    assert(ph.instrs.back().target_block == fn.blocks[1].id);
+    assert(fn.blocks[4].instrs.back().target_block == ph.id);
+
+    assert(run_main(mod) == 420);
+}
+
+TEST(test_licm_keeps_unsafe_division) {
+    Module mod;
+    build_counting_loop(mod);
+    Function& fn = mod.functions[0];
+
+    // Add `x = 1 / 0` to the body; hoisting it could trap where the
+    // original program would not.
+    IRBuilder b(fn);
+    auto& body = fn.blocks[2].instrs;
+    Instruction term = body.back();
+    body.pop_back();
+    b.set_insert_point(fn.blocks[2]);
+    b.div(b.const_int(1), b.const_int(0));
+    b.div(b.const_int(1), b.const_int(4));
+    fn.blocks[2].add(term);
+
+    LoopInvariantCodeMotion licm;
+    licm.run(fn);
+    assert(count_op(fn.blocks[2], OpCode::DIV) == 1);
+    assert(count_op(fn.blocks[0], OpCode::DIV) == 1);
+    assert(run_main(mod) == 420);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Inliner tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_inline_small_callee) {
+    Module mod = lower_source(
+        "fn sq(x: int) -> int { return x * x }\n"
+        "fn main() -> int { return sq(7) + sq(2) }");
+    assert(run_main(mod) == 53);
+
+    Inliner inliner;
+    assert(inliner.run(mod));
+    assert(inliner.inlined() == 2);
+    assert(count_calls(*mod.get_function("main"), "sq") == 0);
+    assert(run_main(mod) == 53);
+}
+
+TEST(test_inline_attributes) {
+    Module mod = lower_source(
+        "@noinline fn sq(x: int) -> int { return x * x }\n"
+        "@inline fn big(x: int) -> int { return x + x + x + x + x + x + x + x }\n"
+        "fn main() -> int { return sq(3) + big(1) }");
+
+    InlineOptions opts;
+    opts.threshold = 0;
+    opts.always_inline_size = 0;
+    Inliner inliner(opts);
+    inliner.run(mod);
+
+    const Function& main_fn = *mod.get_function("main");
+    assert(count_calls(main_fn, "sq") == 1);
+    assert(count_calls(main_fn, "big") == 0);
+    assert(run_main(mod) == 17);
+}
+
+TEST(test_inline_recursion_limit) {
+    Module mod = lower_source(
+        "fn fact(n: int) -> int {\n"
+        "  if n < 2 { return 1 }\n"
+        "  return n * fact(n - 1)\n"
+        "}\n"
+        "fn main() -> int { return fact(6) }");
+    assert(run_main(mod) == 720);
+
+    InlineOptions opts;
+    opts.max_recursive_inlines = 2;
+    Inliner inliner(opts);
+    inliner.run(mod);
+
+    // Two levels unrolled into main, the rest still recurses
+    const Function& main_fn = *mod.get_function("main");
+    assert(count_calls(main_fn, "fact") == 1);
+    assert(run_main(mod) == 720);
+}
+
+TEST(test_inline_hot_call_site) {
+    Module mod = lower_source("fn f(x: int) -> int { return x * x + x }");
+    Module caller;
+    build_counting_loop(caller);
+    Function& fn = caller.functions[0];
+
+    // Call f once before the loop and once per iteration
+    auto add_call = [&fn](size_t bb) {
+        auto& instrs = fn.blocks[bb].instrs;
+        Instruction term = instrs.back();
+        instrs.pop_back();
+        IRBuilder b(fn);
+        b.set_insert_point(fn.blocks[bb]);
+        b.call("f", {b.const_int(3)}, Type::make_int());
+        fn.blocks[bb].add(term);
+    };
+    add_call(0);
+    add_call(2);
+    mod.functions.push_back(std::move(fn));
+
+    InlineOptions opts;
+    opts.threshold = 1;
+    opts.loop_bonus = 8;
+    opts.always_inline_size = 0;
+    Inliner inliner(opts);
+    inliner.run(mod);
+
+    // Only the call inside the loop fits the budget
+    assert(inliner.inlined() == 1);
+    assert(count_calls(*mod.get_function("main"), "f") == 1);
+    assert(count_op(mod.get_function("main")->blocks[0], OpCode::CALL) == 1);
+    assert(run_main(mod) == 420);
+}
+
+TEST(test_inline_uses_profile) {
+    Module mod = lower_source(
+        "fn sq(x: int) -> int { return x * x }\n"
+        "fn main() -> int { return sq(7) + sq(2) }");
+
+    // As if a training run took the first call 500 times, the second never
+    Function& main_fn = *mod.get_function("main");
+    main_fn.has_profile = true;
+    uint64_t counts[] = {500, 0};
+    size_t seen = 0;
+    for (auto& instr : main_fn.blocks[0].instrs) {
+        if (instr.op == OpCode::CALL) instr.profile_count = counts[seen++];
+    }
+
+    InlineOptions opts;
+    opts.threshold = 1;
+    opts.always_inline_size = 0;
+    Inliner inliner(opts);
+    inliner.run(mod);
+
+    // The hot site earns the bonus, the cold one is left alone
+    assert(inliner.inlined() == 1);
+    assert(count_calls(*mod.get_function("main"), "sq") == 1);
+    assert(run_main(mod) == 53);
+}
+
+TEST(test_inline_hoists_allocas) {
+    // clamp has a mutable local and two returns, so both its own slot and
+    // the merge slot need an ALLOCA; the call sits in a loop
+    Module mod = lower_source(
+        "fn clamp(x: int) -> int {\n"
+        "  let y = x\n"
+        "  if y > 5 { y = 5 }\n"
+        "  if y < 0 { return 0 }\n"
+        "  return y\n"
+        "}\n"
+        "fn main() -> int {\n"
+        "  let i = 0\n"
+        "  let acc = 0\n"
+        "  while i < 10 {\n"
+        "    acc = acc + clamp(i - 2)\n"
+        "    i = i + 1\n"
+        "  }\n"
+        "  return acc\n"
+        "}");
+    assert(run_main(mod) == 25);
+
+    InlineOptions opts;
+    opts.always_inline_size = 1000;
+    Inliner inliner(opts);
+    inliner.run(mod);
+
+    const Function& main_fn = *mod.get_function("main");
+    assert(count_calls(main_fn, "clamp") == 0);
+    assert(count_op(main_fn, OpCode::ALLOCA) == 4);
+    assert(count_op(main_fn.blocks[0], OpCode::ALLOCA) == 4);
+    for (size_t i = 0; i < 4; ++i) assert(main_fn.blocks[0].instrs[i].op == OpCode::ALLOCA);
+    assert(run_main(mod) == 25);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Induction variable and unrolling tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_induction_variables) {
+    Module mod = lower_source(sum_loop_source(10).c_str());
+    Function& fn = mod.functions[0];
+    assert(run_main(mod) == 135);
+
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    LoopInfo loops(cfg, dom);
+    assert(loops.top_level().size() == 1);
+
+    // acc is updated by a non-constant amount, so only i qualifies
+    InductionAnalysis ind(fn, cfg, dom, *loops.top_level()[0]);
+    assert(ind.variables().size() == 1);
+    assert(ind.variables()[0].step == 1);
+    assert(ind.variables()[0].init_is_const && ind.variables()[0].init_const == 0);
+
+    const ExitTest* test = ind.exit_test();
+    assert(test && test->pred == OpCode::CMP_LT);
+    assert(test->bound_is_const && test->bound_const == 10);
+    assert(ind.trip_count() == 10);
+
+    // Counting down by two, exiting when the test fails
+    Module down = lower_source(
+        "fn main() -> int {\n"
+        "  let n = 7\n"
+        "  let k = 0\n"
+        "  while 0 < n { n = n - 2\n k = k + 1 }\n"
+        "  return k\n"
+        "}");
+    Function& dfn = down.functions[0];
+    CFG dcfg = CFG::build(dfn);
+    DominatorTree ddom(dcfg);
+    LoopInfo dloops(dcfg, ddom);
+    InductionAnalysis dind(dfn, dcfg, ddom, *dloops.top_level()[0]);
+    assert(dind.variables().size() == 2);
+    assert(dind.exit_test()->pred == OpCode::CMP_GT);
+    assert(dind.trip_count() == 4);
+    assert(run_main(down) == 4);
+
+    // Near the int64 limits, where init - bound or bound - init + step
+    // would overflow; a count past LONG_MAX is unknown
+    auto trips = [](const char* cond, const char* update, const char* init) {
+        Module m = lower_source((std::string("fn main() -> int {\n  let i = ") + init +
+                                 "\n  while " + cond + " { i = " + update + " }\n  return 0\n}").c_str());
+        Function& f = m.functions[0];
+        CFG c = CFG::build(f);
+        DominatorTree d(c);
+        LoopInfo l(c, d);
+        InductionAnalysis a(f, c, d, *l.top_level()[0]);
+        assert(a.exit_test());
+        return a.trip_count();
+    };
+    assert(trips("i < 9223372036854775807", "i + 1000000000000000000", "0") == 10);
+    assert(trips("i > 0", "i - 1000000000000000000", "9223372036854775807") == 10);
+    assert(trips("i <= 9223372036854775807", "i + 1", "0") == -1);
+    assert(trips("i <= 9223372036854775806", "i + 1", "0") == 9223372036854775807);
+    assert(trips("i != 9000000000000000000", "i + 1000000000000000000", "0") == 9);
+}
+
+TEST(test_strength_reduction) {
+    Module mod = lower_source(sum_loop_source(10).c_str());
+    Function& fn = mod.functions[0];
+    assert(count_op(fn, OpCode::MUL) == 1);
+
+    StrengthReduction sr;
+    assert(sr.run(mod));
+    assert(sr.reduced() == 1);
+
+    // init * 3 and step * 3 fold to constants in the preheader
+    assert(count_op(fn, OpCode::MUL) == 0);
+    assert(run_main(mod) == 135);
+}
+
+TEST(test_unroll_with_remainder) {
+    // 10 iterations: two unrolled trips of 4, then 2 in the remainder loop
+    Module mod = lower_source(sum_loop_source(10).c_str());
+    UnrollOptions opts;
+    opts.factor = 4;
+    LoopUnroller unroller(opts);
+    assert(unroller.run(mod));
+    assert(unroller.unrolled() == 1);
+    assert(run_main(mod) == 135);
+
+    // The copies carry no compare of their own: one in the guard, one in
+    // the remainder header
+    DeadCodeElimination dce;
+    dce.run(mod);
+    assert(count_op(mod.functions[0], OpCode::CMP_LT) == 2);
+    assert(run_main(mod) == 135);
+
+    // Known trip count below the factor: left alone
+    Module small = lower_source(sum_loop_source(3).c_str());
+    LoopUnroller small_unroller(opts);
+    assert(!small_unroller.run(small));
+    assert(run_main(small) == 9);
+}
+
+TEST(test_unroll_unknown_trip_count) {
+    Module mod = lower_source(
+        "fn sum(n: int) -> int {\n"
+        "  let i = 0\n"
+        "  let acc = 0\n"
+        "  while i < n { acc = acc + i\n i = i + 1 }\n"
+        "  return acc\n"
+        "}\n"
+        "fn main() -> int { return sum(0) + sum(3) * 1000 + sum(11) * 100000 }");
+    assert(run_main(mod) == 5503000);
+
+    UnrollOptions opts;
+    opts.factor = 4;
+    LoopUnroller unroller(opts);
+    assert(unroller.run(mod));
+    assert(run_main(mod) == 5503000);
+
+    // Near the ends of int64, i + 3 wraps; the guard must still send
+    // these short loops to the remainder
+    const int64_t kMax = std::numeric_limits<int64_t>::max();
+    const int64_t kMin = std::numeric_limits<int64_t>::min();
+    Module edges = lower_source(
+        "fn up(i: int, n: int) -> int {\n"
+        "  let c = 0\n"
+        "  while i < n { c = c + 1\n i = i + 1 }\n"
+        "  return c\n"
+        "}\n"
+        "fn down(i: int, n: int) -> int {\n"
+        "  let c = 0\n"
+        "  while i > n { c = c + 1\n i = i - 1 }\n"
+        "  return c\n"
+        "}\n");
+    LoopUnroller edge_unroller(opts);
+    assert(edge_unroller.run(edges) && edge_unroller.unrolled() == 2);
+    auto count = [&](const char* fn, int64_t i, int64_t n) {
+        Interpreter interp;
+        interp.set_instruction_budget(100000);
+        return interp.call(edges, fn, {RuntimeValue(i), RuntimeValue(n)}).as_int();
+    };
+    assert(count("up", kMax - 2, kMax) == 2);
+    assert(count("up", kMin, kMin + 9) == 9);
+    assert(count("down", kMin + 2, kMin) == 2);
+    assert(count("down", kMax, kMax - 9) == 9);
+    assert(count("up", 0, 10) == 10 && count("down", 10, 0) == 10);
+
+    // A constant bound without room for the guard's offset: left alone
+    std::string near_max = "fn f(n: int) -> int {\n"
+                           "  let i = n\n"
+                           "  while i > " + std::to_string(kMax - 2) + " { i = i - 1 }\n"
+                           "  return i\n"
+                           "}\n";
+    Module skipped = lower_source(near_max.c_str());
+    LoopUnroller skipped_unroller(opts);
+    assert(!skipped_unroller.run(skipped));
+}
+
+TEST(test_dead_code_elimination) {
+    Module mod;
+    Function& fn = mod.add_function("main", {}, Type::make_int());
+    IRBuilder b(fn);
+
+    Value slot = b.alloca(Type::make_int());
+    b.store(slot, b.const_int(1));              // Never loaded
+    b.add(b.const_int(2), b.const_int(3));      // Never used
+    Value live = b.const_int(42);
+    b.ret(live);
+    b.const_int(7);                             // After the terminator
+
+    DeadCodeElimination dce;
+    assert(dce.run(mod));
+    assert(fn.blocks[0].instrs.size() == 2);
+    assert(run_main(mod) == 42);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Simplifier tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_simplify_identities) {
+    Module mod = lower_source(
+        "fn f(x: int) -> int { return (x + 0) * 1 - (x - x) + -(-x) * 8 }\n"
+        "fn main() -> int { return f(5) }");
+    assert(run_main(mod) == 45);
+
+    AlgebraicSimplifier simplifier;
+    assert(simplifier.run(mod));
+    DeadCodeElimination dce;
+    dce.run(mod);
+
+    // Left with x - 0 folded away, x + (x << 3)
+    const Function& f = *mod.get_function("f");
+    assert(count_op(f, OpCode::MUL) == 0);
+    assert(count_op(f, OpCode::NEG) == 0);
+    assert(count_op(f, OpCode::SHL) == 1);
+    assert(count_op(f, OpCode::ADD) == 1);
+    assert(run_main(mod) == 45);
+}
+
+TEST(test_simplify_constant_folding) {
+    Module mod = lower_source("fn main() -> int { return 6 * 7 - 8 / 4 + -(3) }");
+    AlgebraicSimplifier simplifier;
+    simplifier.run(mod);
+    DeadCodeElimination dce;
+    dce.run(mod);
+
+    const BasicBlock& entry = mod.functions[0].blocks[0];
+    assert(entry.instrs.size() == 2);
+    assert(entry.instrs[0].op == OpCode::CONST_INT);
+    assert(entry.instrs[0].imm_int == 37);
+    assert(run_main(mod) == 37);
+}
+
+TEST(test_simplify_division_by_constant) {
+    const int64_t divisors[] = {2, 3, 7, 10, 16, 641, 1000003, -2, -5, -16, INT64_MAX};
+    const int64_t dividends[] = {0, 1, -1, 17, -17, 1000, -1001, 123456789,
+                                 -987654321, INT64_MAX, INT64_MIN + 1, INT64_MIN};
+
+    for (int64_t d : divisors) {
+        for (int64_t n : dividends) {
+            // Load the dividend from a slot so it is not folded
+            Module mod;
+            Function& fn = mod.add_function("main", {}, Type::make_int());
+            IRBuilder b(fn);
+            Value slot = b.alloca(Type::make_int());
+            b.store(slot, b.const_int(n));
+            b.ret(b.div(b.load(slot), b.const_int(d)));
+
+            SimplifyOptions opts;
+            opts.expand_division = true;
+            AlgebraicSimplifier simplifier(opts);
+            simplifier.run(mod);
+
+            assert(count_op(fn, OpCode::DIV) == 0);
+            if (run_main(mod) != n / d) {
+                throw std::runtime_error(std::to_string(n) + " / " + std::to_string(d));
+            }
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// CFG simplification tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void assert_ids_match_indices(const Function& fn) {
+    for (size_t i = 0; i < fn.blocks.size(); ++i) {
+        assert(fn.blocks[i].id == i);
+    }
+}
+
+TEST(test_cfg_simplify_lowered_ifs) {
+    Module mod = lower_source(
+        "fn main() -> int {\n"
+        "  let i = 0\n"
+        "  let acc = 0\n"
+        "  while i < 6 {\n"
+        "    if i < 3 { if i == 1 { acc = acc + 10 } } else { acc = acc + i }\n"
+        "    i = i + 1\n"
+        "  }\n"
+        "  return acc\n"
+        "}");
+    Function& fn = mod.functions[0];
+    size_t before = fn.blocks.size();
+    assert(run_main(mod) == 22);
+
+    CFGSimplifier simplify;
+    assert(simplify.run(mod));
+    assert(fn.blocks.size() < before);
+    assert(simplify.jumps_threaded() + simplify.blocks_merged() > 0);
+    assert_ids_match_indices(fn);
+
+    // No block is left that only forwards to another
+    for (size_t i = 1; i < fn.blocks.size(); ++i) {
+        const auto& instrs = fn.blocks[i].instrs;
+        assert(!(instrs.size() == 1 && instrs[0].op == OpCode::BR));
+    }
+    assert(run_main(mod) == 22);
+}
+
+TEST(test_cfg_simplify_folds_branches) {
+    // entry: cond_br c, then, else (c unknown)
+    // then:  cond_br c, yes, no   -- c is known true here
+    // else:  cond_br 1, no, yes   -- constant
+    Module mod;
+    Function& fn = mod.add_function("main", {}, Type::make_int());
+    IRBuilder b(fn);
+    for (const char* label : {"then", "else", "yes", "no"}) fn.new_block(label);
+    b.set_insert_point(fn.blocks[0]);
+    Value slot = b.alloca(Type::make_int());
+    b.store(slot, b.const_int(1));
+    Value c = b.cmp_ne(b.load(slot), b.const_int(0));
+    b.cond_br(c, fn.blocks[1], fn.blocks[2]);
+
+    b.set_insert_point(fn.blocks[1]);
+    b.cond_br(c, fn.blocks[3], fn.blocks[4]);
+    b.set_insert_point(fn.blocks[2]);
+    b.cond_br(b.const_int(1), fn.blocks[4], fn.blocks[3]);
+    b.set_insert_point(fn.blocks[3]);
+    b.ret(b.const_int(7));
+    b.set_insert_point(fn.blocks[4]);
+    b.ret(b.const_int(9));
+
+    CFGSimplifier simplify;
+    simplify.run(mod);
+    assert(simplify.branches_folded() >= 2);
+    assert_ids_match_indices(fn);
+
+    // entry still tests c; each side is now a straight line to its return
+    assert(count_op(fn, OpCode::COND_BR) == 1);
+    assert(fn.blocks.size() == 3);
+    assert(run_main(mod) == 7);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Purity tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_purity_classification) {
+    Module mod = lower_source(
+        "fn square(x: int) -> int { return x * x }\n"
+        "fn twice(x: int) -> int { return square(x) + square(x) }\n"
+        "fn noisy(x: int) -> int { print(\"hi\")\n return x }\n"
+        "fn fact(n: int) -> int { if n < 2 { return 1 }\n return n * fact(n - 1) }\n"
+        "fn spin(n: int) -> int { let i = 0\n while i < n { i = i + 1 }\n return i }\n"
+        "fn half(x: int) -> int { return x / 2 }\n"
+        "fn ratio(x: int, y: int) -> int { return half(x) / y }\n"
+        "fn outer(x: int) -> int { return ratio(x, x) + 1 }\n"
+        "fn plus(a: tensor<f32>[_, 8], b: tensor<f32>[_, 8]) -> tensor<f32>[_, 8] { return a + b }\n"
+        "fn main() -> int { return twice(noisy(2)) + fact(3) + spin(4) }");
+
+    PurityAnalysis purity(mod, {{"clock", Effect::READONLY}});
+    assert(purity.effect("square") == Effect::PURE);
+    assert(purity.effect("twice") == Effect::PURE);
+    assert(purity.effect("noisy") == Effect::EFFECTFUL);
+    assert(purity.effect("main") == Effect::EFFECTFUL);
+    assert(purity.effect("fact") == Effect::PURE);
+    assert(purity.effect("spin") == Effect::PURE);
+    assert(purity.effect("print") == Effect::EFFECTFUL);
+    assert(purity.effect("clock") == Effect::READONLY);
+    assert(purity.effect("unknown_ffi") == Effect::EFFECTFUL);
+
+    // Recursion and loops may not terminate, so those calls must stay
+    assert(purity.will_return("twice"));
+    assert(!purity.will_return("fact"));
+    assert(!purity.will_return("spin"));
+
+    // Division by a variable and tensor operations may fail, and so may
+    // their callers; the functions stay pure all the same
+    assert(!purity.may_throw("square") && !purity.may_throw("half"));
+    assert(purity.may_throw("ratio") && purity.may_throw("outer"));
+    assert(purity.may_throw("plus"));
+    assert(purity.effect("outer") == Effect::PURE && purity.will_return("outer"));
+    assert(!purity.may_throw("clock"));
+}
+
+TEST(test_dce_long_dead_chain) {
+    // Each add only feeds the next, so removing one exposes the one before;
+    // the worklist clears the chain in a single run
+    Module mod;
+    Function& fn = mod.add_function("main", {}, Type::make_int());
+    IRBuilder b(fn);
+    Value v = b.const_int(1);
+    Value one = b.const_int(1);
+    for (int i = 0; i < 5000; ++i) v = b.add(v, one);
+    b.ret(b.const_int(0));
+
+    DeadCodeElimination dce;
+    assert(dce.run(fn));
+    assert(dce.removed() == 5002);
+    assert(fn.blocks[0].instrs.size() == 2);
+    assert(run_main(mod) == 0);
+}
+
+TEST(test_dce_removes_pure_calls) {
+    Module mod = lower_source(
+        "fn square(x: int) -> int { return x * x }\n"
+        "fn noisy(x: int) -> int { print(\"hi\")\n return x }\n"
+        "fn ratio(x: int, y: int) -> int { return x / y }\n"
+        "fn main() -> int { let a = square(3)\n let b = noisy(4)\n let c = ratio(1, 0)\n return 5 }");
+
+    DeadCodeElimination dce;
+    assert(dce.run(mod));
+
+    // A call that may throw stays even when unused
+    const Function& main_fn = *mod.get_function("main");
+    assert(count_op(main_fn, OpCode::CALL) == 2);
+    for (const auto& instr : main_fn.blocks[0].instrs) {
+        if (instr.op == OpCode::CALL) assert(instr.callee == "noisy" || instr.callee == "ratio");
+    }
+    assert(run_main(mod) == 5);
+}
+
+TEST(test_licm_hoists_pure_calls) {
+    Module mod = lower_source(
+        "fn square(x: int) -> int { return x * x }\n"
+        "fn main() -> int {\n"
+        "  let i = 0\n"
+        "  let acc = 0\n"
+        "  while i < 10 { acc = acc + square(7)\n i = i + 1 }\n"
+        "  return acc\n"
+        "}");
+    assert(run_main(mod) == 490);
+
+    LoopInvariantCodeMotion licm;
+    assert(licm.run(mod));
+
+    // The call now sits in the entry block, outside the loop
+    const Function& main_fn = *mod.get_function("main");
+    assert(count_op(main_fn, OpCode::CALL) == 1);
+    bool in_entry = false;
+    for (const auto& instr : main_fn.blocks[0].instrs) {
+        if (instr.op == OpCode::CALL) in_entry = true;
+    }
+    assert(in_entry);
+    assert(run_main(mod) == 490);
+
+    // Calls with effects never move
+    Module noisy = lower_source(
+        "fn noisy(x: int) -> int { print(\"hi\")\n return x }\n"
+        "fn main() -> int { let i = 0\n while i < 3 { noisy(1)\n i = i + 1 }\n return i }");
+    LoopInvariantCodeMotion licm2;
+    licm2.run(noisy);
+    for (const auto& instr : noisy.get_function("main")->blocks[0].instrs) {
+        assert(instr.op != OpCode::CALL);
+    }
+
+    // Nor do calls that may throw, which the loop might never have made
+    Module div = lower_source(
+        "fn ratio(x: int, y: int) -> int { return x / y }\n"
+        "fn main() -> int { let i = 0\n let acc = 0\n"
+        "  while i < 3 { acc = acc + ratio(7, 1)\n i = i + 1 }\n return acc }");
+    LoopInvariantCodeMotion licm3;
+    licm3.run(div);
+    for (const auto& instr : div.get_function("main")->blocks[0].instrs) {
+        assert(instr.op != OpCode::CALL);
+    }
+    assert(run_main(div) == 21);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Partial evaluation tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_partial_eval_folds_constant_calls) {
+    Module mod = lower_source(
+        "fn fact(n: int) -> int { if n < 2 { return 1 }\n return n * fact(n - 1) }\n"
+        "fn scale(x: int) -> int { return x * 3 }\n"
+        "fn noisy(x: int) -> int { print(\"hi\")\n return x }\n"
+        "fn main() -> int { return fact(5) + fact(5) + scale(fact(3)) + noisy(1) }");
+    assert(run_main(mod) == 259);
+
+    PartialEvaluator evaluator;
+    assert(evaluator.run(mod));
+
+    // fact(5) runs once, its twin hits the cache, scale(6) folds next
+    assert(evaluator.evaluated() == 3);
+    assert(evaluator.cache_hits() == 1);
+
+    const Function& main_fn = *mod.get_function("main");
+    assert(count_op(main_fn, OpCode::CALL) == 1);
+    assert(run_main(mod) == 259);
+}
+
+TEST(test_partial_eval_respects_budget) {
+    Module mod = lower_source(
+        "fn forever(n: int) -> int { let i = 0\n while n > 0 { i = i + 1 }\n return i }\n"
+        "fn deep(n: int) -> int { if n == 0 { return 0 }\n return deep(n - 1) + 1 }\n"
+        "fn main() -> int { return forever(0) + deep(100000) * 0 + forever(1) * 0 }");
+
+    PartialEvalOptions opts;
+    opts.instruction_budget = 1000;
+    PartialEvaluator evaluator(opts);
+    evaluator.run(mod);
+
+    // forever(0) finishes; forever(1) and deep(100000) are left for run time
+    assert(evaluator.evaluated() == 1);
+    assert(evaluator.gave_up() == 2);
+    assert(count_op(*mod.get_function("main"), OpCode::CALL) == 2);
+}
+
+TEST(test_partial_eval_skips_tensor_work) {
+    // big would allocate 32 TB if run; the call sits on a path never taken
+    Module mod = lower_source(
+        "fn big(n: int) -> int { let t = tensor(n, n)\n return 1 }\n"
+        "fn half(n: int) -> int { return n / 2 }\n"
+        "fn main() -> int { if 1 == 0 { return big(2000000) }\n return half(14) }");
+
+    PartialEvaluator evaluator;
+    evaluator.run(mod);
+
+    // big may throw and is left alone; half still folds
+    assert(evaluator.evaluated() == 1);
+    assert(evaluator.gave_up() == 0);
+    assert(count_calls(*mod.get_function("main"), "big") == 1);
+    assert(count_calls(*mod.get_function("main"), "half") == 0);
+    assert(run_main(mod) == 7);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Range analysis tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_range_analysis) {
+    Module mod = lower_source(
+        "fn f(x: int) -> int {\n"
+        "  let a = x * 0 + 7\n"
+        "  let b = a * 3 - 1\n"
+        "  if x > 5 { if x < 100 { return b + x } }\n"
+        "  return b\n"
+        "}\n"
+        "fn main() -> int { return f(50) }");
+    Function& fn = *mod.get_function("f");
+    CFG cfg = CFG::build(fn);
+    DominatorTree dom(cfg);
+    RangeAnalysis ranges(fn, cfg, dom);
+
+    // The parameter is unknown everywhere but inside both ifs
+    Value x = fn.params[0];
+    assert(ranges.range(x).is_full());
+
+    // The block computing b + x
+    size_t inner = 0;
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        for (const auto& instr : fn.blocks[b].instrs) {
+            if (instr.op == OpCode::ADD && instr.operands[1] == x) inner = b;
+        }
+    }
+    assert(inner != 0);
+    Range rx = ranges.range_at(x, inner);
+    assert(rx.lo == 6 && rx.hi == 99);
+
+    // b = 20 whatever x is
+    for (const auto& bb : fn.blocks) {
+        for (const auto& instr : bb.instrs) {
+            if (instr.op == OpCode::SUB) {
+                assert(ranges.range(instr.result) == Range::constant(20));
+                assert(ranges.is_nonzero(instr.result, 0));
+                // 0 <= 20 < 21, but not 21 < 20
+                assert(ranges.in_bounds(instr.result, instr.operands[0], 0));
+                assert(!ranges.in_bounds(instr.operands[0], instr.result, 0));
+            }
+        }
+    }
+}
+
+TEST(test_guard_elimination) {
+    Module mod = lower_source(
+        "fn f(x: int, d: int) -> int {\n"
+        "  let i = 0\n"
+        "  let acc = 0\n"
+        "  while i < 10 { acc = acc + x / (i + 1)\n i = i + 1 }\n"
+        "  if d != 0 { acc = acc + x / d }\n"
+        "  return acc + x / d\n"
+        "}\n"
+        "fn main() -> int { return f(2520, 7) + f(60, 0) }");
+    int64_t expected = run_main(mod);
+
+    GuardElimination guards;
+    assert(guards.run(mod));
+
+    // The loop's divisor is at least 1 and the guarded one is non-zero;
+    // the unguarded division keeps its check
+    const Function& f = *mod.get_function("f");
+    assert(guards.eliminated() == 2);
+    assert(count_op(f, OpCode::DIV_NZ) == 2);
+    assert(count_op(f, OpCode::DIV) == 1);
+    assert(run_main(mod) == expected);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Dead function tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_dead_function_elimination) {
+    Module mod = lower_source(
+        "fn leaf() -> int { return 1 }\n"
+        "fn used() -> int { return leaf() + 1 }\n"
+        "fn unused() -> int { return used() * 2 }\n"
+        "fn orphan_a() -> int { return orphan_b() }\n"
+        "fn orphan_b() -> int { return orphan_a() }\n"
+        "@export fn api() -> int { return helper() }\n"
+        "fn helper() -> int { return 3 }\n"
+        "fn main() -> int { return used() }");
+
+    DeadFunctionElimination dfe;
+    assert(dfe.run(mod));
+    assert(dfe.removed() == 3);
+
+    // Survivors keep their order
+    std::vector<std::string> names;
+    for (const auto& fn : mod.functions) names.push_back(fn.name);
+    assert((names == std::vector<std::string>{"leaf", "used", "api", "helper", "main"}));
+    assert(run_main(mod) == 2);
+    assert(!dfe.run(mod));
+    assert(mod.functions.size() == 5 && mod.get_function("main"));
+
+    // Without main or exports there is no root; nothing is removed
+    Module library = lower_source("fn a() -> int { return 1 }\nfn b() -> int { return a() }");
+    DeadFunctionElimination lib_dfe;
+    assert(!lib_dfe.run(library));
+    assert(library.functions.size() == 2);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Block layout tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+static const char* error_path_source(const char* test) {
+    static std::string code;
+    code = std::string(
+        "fn fail(x: int) -> int { return 0 - x }\n"
+        "fn main() -> int {\n"
+        "  let s = 0\n"
+        "  let i = 0\n"
+        "  while i < 10 {\n"
+        "    if ") + test + " { s = fail(s) }\n"
+        "    s = s + i\n"
+        "    i = i + 1\n"
+        "  }\n"
+        "  return s\n"
+        "}";
+    return code.c_str();
+}
+
+static size_t block_calling(const Function& fn, const std::string& callee) {
+    for (size_t b = 0; b < fn.blocks.size(); ++b) {
+        for (const auto& instr : fn.blocks[b].instrs) {
+            if (instr.op == OpCode::CALL && instr.callee == callee) return b;
+        }
+    }
+    return fn.blocks.size();
+}
+
+TEST(test_block_layout_static) {
+    Module mod = lower_source(error_path_source("i == 50"));
+    Function& fn = *mod.get_function("main");
+    CFGSimplifier simplify;
+    simplify.run(fn);
+    assert(block_calling(fn, "fail") + 1 < fn.blocks.size());
+
+    // The call makes the branch unlikely; its block moves past the return
+    BlockLayout layout;
+    assert(layout.run(fn));
+    assert(layout.blocks_moved() > 0);
+    assert(layout.fall_throughs() > 0);
+    assert(block_calling(fn, "fail") == fn.blocks.size() - 1);
+    assert(run_main(mod) == 45);
+}
+
+TEST(test_block_layout_profile) {
+    Module mod = lower_source(error_path_source("i < 50"));
+    Function& fn = *mod.get_function("main");
+    CFGSimplifier simplify;
+    simplify.run(fn);
+
+    // A training run calls fail() every iteration, so it stays inline
+    Profile profile;
+    Interpreter interp;
+    interp.set_profile(&profile);
+    Module copy = mod;
+    interp.execute(copy);
+    assert(profile.apply(mod) == 2);
+
+    BlockLayout layout;
+    layout.run(fn);
+    size_t call = block_calling(fn, "fail");
+    assert(call + 1 < fn.blocks.size());
+    assert(layout.cold_blocks() == 0);
+    assert(run_main(mod) == 5);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tensor fusion tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+static std::string call_tensor(Module& mod, const char* name, const std::vector<double>& fills) {
+    std::vector<RuntimeValue> args;
+    for (size_t i = 0; i < fills.size(); ++i) {
+        zero::tensor::Tensor t = zero::tensor::Tensor::empty({3, 8});
+        for (size_t k = 0; k < t.numel(); ++k) t.set(k, fills[i] * (static_cast<double>(k) - 11));
+        args.push_back(RuntimeValue(t));
+    }
+    Interpreter interp;
+    return interp.call(mod, name, std::move(args)).as_tensor().to_string();
+}
+
+TEST(test_tensor_fusion) {
+    Module mod = lower_source(
+        "fn noisy(x: tensor<f32>[_, 8]) -> tensor<f32>[_, 8] { print(\"hi\")\n return x }\n"
+        "fn chain(a: tensor<f32>[_, 8], b: tensor<f32>[_, 8], c: tensor<f32>[_, 8]) -> tensor<f32>[_, 8] {\n"
+        "  return relu(a * b + c) - b\n"
+        "}\n"
+        "fn fenced(a: tensor<f32>[_, 8], b: tensor<f32>[_, 8]) -> tensor<f32>[_, 8] {\n"
+        "  return relu(a * b) + noisy(a)\n"
+        "}\n"
+        "fn act(a: tensor<f32>[_, 8], b: tensor<f32>[_, 8]) -> tensor<f32>[_, 8] {\n"
+        "  return gelu(sigmoid(a * b) + tanh(exp(b)))\n"
+        "}\n");
+    const std::string chain = call_tensor(mod, "chain", {0.5, -2, 3});
+    const std::string fenced = call_tensor(mod, "fenced", {0.5, -2});
+    const std::string act = call_tensor(mod, "act", {0.5, -2});
+
+    TensorFusion fusion;
+    assert(fusion.run(mod));
+    assert(fusion.fused() == 9);
+
+    // One op over the three parameters, b read twice from the same input
+    const Function& chain_fn = *mod.get_function("chain");
+    assert(count_op(chain_fn, OpCode::TENSOR_FUSED) == 1);
+    assert(count_op(chain_fn, OpCode::TENSOR_MUL) == 0);
+    for (const auto& instr : chain_fn.blocks[0].instrs) {
+        if (instr.op != OpCode::TENSOR_FUSED) continue;
+        assert(instr.imm_str == "x0 x1 mul x2 add relu x1 sub");
+        assert(instr.operands.size() == 3);
+        assert(instr.result.type.to_string() == "tensor<f32>[?x8]");
+    }
+    assert(call_tensor(mod, "chain", {0.5, -2, 3}) == chain);
+
+    // The print inside noisy() must still come after relu(a * b) runs
+    const Function& fenced_fn = *mod.get_function("fenced");
+    assert(count_op(fenced_fn, OpCode::TENSOR_FUSED) == 1);
+    assert(count_op(fenced_fn, OpCode::TENSOR_ADD) == 1);
+    assert(call_tensor(mod, "fenced", {0.5, -2}) == fenced);
+
+    // Activations fuse like relu, one pass for the whole expression
+    const Function& act_fn = *mod.get_function("act");
+    assert(count_op(act_fn, OpCode::TENSOR_FUSED) == 1);
+    for (const auto& instr : act_fn.blocks[0].instrs) {
+        if (instr.op == OpCode::TENSOR_FUSED) {
+            assert(instr.imm_str == "x0 x1 mul sigmoid x1 exp tanh add gelu");
+        }
+    }
+    assert(call_tensor(mod, "act", {0.5, -2}) == act);
+
+    // Values read twice are computed once, fused ops grow by absorbing
+    Module built;
+    Function& fn = built.add_function("main", {}, Type::make_int());
+    IRBuilder b(fn);
+    Value three = b.const_int(3);
+    Value x = b.tensor_alloc(b.const_float(1.5), {three});
+    Value y = b.tensor_alloc(b.const_float(-4.0), {three});
+    Value twice = b.tensor_sub(x, y);
+    Value sq = b.tensor_fused("x0 x0 mul", {twice});
+    Value shared = b.tensor_add(sq, y);
+    b.tensor_relu(b.tensor_mul(shared, shared));
+    b.ret(b.const_int(0));
+
+    TensorFusion again;
+    assert(again.run(fn));
+    assert(again.fused() == 2);
+    assert(count_op(fn, OpCode::TENSOR_SUB) == 1);
+    assert(count_op(fn, OpCode::TENSOR_MUL) == 0);
+    assert(count_op(fn, OpCode::TENSOR_FUSED) == 2);
+    for (const auto& instr : fn.blocks[0].instrs) {
+        if (instr.result.id == shared.id) assert(instr.imm_str == "x0 x0 mul x1 add");
+        if (instr.op == OpCode::TENSOR_RELU) assert(false);
+    }
+    assert(run_main(built) == 0);
+}
+
+TEST(test_buffer_planner) {
+    // relu(a * b) - b: every op can take the buffer of its dying left operand
+    Module built;
+    const Type t = Type::make_tensor(zero::types::DType::F32, {-1, 8});
+    Function& fn = built.add_function("f", {t, t}, t);
+    fn.params = {fn.new_value(t), fn.new_value(t)};
+    IRBuilder b(fn);
+    Value prod = b.tensor_mul(fn.params[0], fn.params[1]);
+    Value act = b.tensor_relu(prod);
+    Value diff = b.tensor_sub(act, fn.params[1]);
+    b.ret(diff);
+
+    BufferPlanner planner;
+    MemoryPlan plan = planner.plan(built);
+    const FunctionMemoryPlan* fp = plan.find(fn);
+    assert(fp && planner.tensor_values() == 5 && planner.in_place_sites() == 3);
+    auto released = [&](size_t index) {
+        std::vector<uint32_t> ids;
+        for (uint32_t id : fp->released_after(0, index)) ids.push_back(id);
+        return ids;
+    };
+    assert(released(0) == std::vector<uint32_t>{fn.params[0].id});
+    assert(released(1) == std::vector<uint32_t>{prod.id});
+    assert((released(2) == std::vector<uint32_t>{act.id, fn.params[1].id}));
+    assert(fp->in_place_operand(0, 0) == 0 && fp->in_place_operand(0, 2) == 0);
+    assert(fp->released_on_entry(0).empty());
+
+    // Values used inside a loop stay alive across it; intermediates of
+    // each iteration are freed or overwritten in place
+    Module mod = lower_source(
+        "fn layers(x: tensor<f32>[_, 8], n: int) -> tensor<f32>[_, 8] {\n"
+        "  let h = x * x\n"
+        "  let i = 0\n"
+        "  while i < n {\n"
+        "    h = relu(h - x) * x + x\n"
+        "    i = i + 1\n"
+        "  }\n"
+        "  return h\n"
+        "}\n");
+    auto run = [&](const MemoryPlan* memory_plan, uint64_t& in_place, size_t& peak) {
+        zero::tensor::Tensor x = zero::tensor::Tensor::empty({256, 8});
+        for (size_t k = 0; k < x.numel(); ++k) x.set(k, static_cast<double>(k % 7) - 3);
+        std::vector<RuntimeValue> args;
+        args.push_back(RuntimeValue(std::move(x)));
+        args.push_back(RuntimeValue(int64_t(4)));
+        zero::tensor::BufferPool::global().reset_peak();
+        Interpreter interp;
+        interp.set_memory_plan(memory_plan);
+        std::string out = interp.call(mod, "layers", std::move(args)).as_tensor().to_string();
+        in_place = interp.in_place_ops();
+        peak = zero::tensor::BufferPool::global().stats().peak_bytes;
+        return out;
+    };
+    uint64_t plain_in_place = 0, planned_in_place = 0;
+    size_t plain_peak = 0, planned_peak = 0;
+    const std::string expected = run(nullptr, plain_in_place, plain_peak);
+    MemoryPlan layers_plan = BufferPlanner().plan(mod);
+    assert(run(&layers_plan, planned_in_place, planned_peak) == expected);
+    assert(plain_in_place == 0 && planned_in_place >= 8);
+    assert(planned_peak < plain_peak);
+}
+
+TEST(test_graph_mode_with_plan) {
+    // Three independent branches, each freeing and overwriting values
+    // the others read; the matmuls keep fusion from merging them
+    const char* source =
+        "fn branches(x: tensor<f32>[_, 8], w: tensor<f32>[8, 8]) -> tensor<f32>[_, 8] {\n"
+        "  let a = relu(matmul(x * x, w)) - x\n"
+        "  let b = tanh(matmul(x + x, w)) * x\n"
+        "  let c = sigmoid(matmul(x - x, w)) + exp(x)\n"
+        "  return a * b + c\n"
+        "}\n";
+    zero::tensor::Tensor x = zero::tensor::Tensor::empty({512, 8});
+    zero::tensor::Tensor w = zero::tensor::Tensor::empty({8, 8});
+    for (size_t k = 0; k < x.numel(); ++k) x.set(k, static_cast<double>(k % 11) * 0.25 - 1.25);
+    for (size_t k = 0; k < w.numel(); ++k) w.set(k, static_cast<double>(k % 5) * 0.125 - 0.25);
+    auto run = [&](Module& mod, bool graph_mode, uint64_t& in_place) {
+        MemoryPlan plan = BufferPlanner().plan(mod);
+        Interpreter interp;
+        interp.set_memory_plan(&plan);
+        interp.set_graph_mode(graph_mode);
+        std::string out = interp.call(mod, "branches", {RuntimeValue(x), RuntimeValue(w)}).as_tensor().to_string();
+        assert(interp.graph_runs() == (graph_mode ? 1u : 0u));
+        in_place = interp.in_place_ops();
+        return out;
+    };
+
+    for (bool fuse : {false, true}) {
+        Module mod = lower_source(source);
+        if (fuse) {
+            TensorFusion fusion;
+            assert(fusion.run(mod));
+        }
+        uint64_t in_order_in_place = 0;
+        const std::string expected = run(mod, false, in_order_in_place);
+        assert(in_order_in_place > 0);
+        for (int round = 0; round < 20; ++round) {
+            uint64_t in_place = 0;
+            assert(run(mod, true, in_place) == expected);
+            assert(in_place == in_order_in_place);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Main
+// ─────────────────────────────────────────────────────────────────────────────
+
+int main() {
+    std::cout << "\n";
+    std::cout << "============================================\n";
+    std::cout << "  Zero Optimizer Tests\n";
+    std::cout << "============================================\n\n";
+
+    return run_all_tests();
+}
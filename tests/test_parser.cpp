@@ -117,6 +117,23 @@ TEST(test_let_statement) {
     assert(let.init->is<IntLiteral>());
 }
 
+TEST(test_assign_statement) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero", "fn main() { let x = 10; x = x - 1; }");
+    Parser parser(sm, id);
+    
+    Program prog = parser.parse();
+    assert(!parser.had_error());
+    assert(prog.functions[0].body.size() == 2);
+    
+    auto& stmt = prog.functions[0].body[1];
+    assert(stmt->is<AssignStmt>());
+    
+    auto& assign = stmt->as<AssignStmt>();
+    assert(assign.name == "x");
+    assert(assign.value->is<BinaryExpr>());
+}
+
 TEST(test_binary_expression) {
     SourceManager sm;
     SourceID id = sm.load_from_string("test.zero", "fn main() { return 1 + 2 * 3; }");
@@ -201,6 +218,22 @@ TEST(test_function_params) {
     assert(fn.params[1].name == "b");
 }
 
+TEST(test_tensor_type_annotation) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero", 
+        "fn f(a: tensor, b: tensor<f64>, c: tensor<f32>[_, 16]) { }");
+    Parser parser(sm, id);
+    
+    Program prog = parser.parse();
+    assert(!parser.had_error());
+    
+    auto& params = prog.functions[0].params;
+    assert(params[0].type.kind == TypeKind::TENSOR && params[0].type.dtype.empty());
+    assert(params[1].type.dtype == "f64" && !params[1].type.has_dims);
+    assert(params[2].type.has_dims);
+    assert(params[2].type.dims == (std::vector<int64_t>{-1, 16}));
+}
+
 TEST(test_multiple_functions) {
     SourceManager sm;
     SourceID id = sm.load_from_string("test.zero", 
@@ -255,6 +288,22 @@ TEST(test_grouped_expression) {
     assert(mul.left->is<GroupExpr>());
 }
 
+TEST(test_function_attributes) {
+    SourceManager sm;
+    SourceID id = sm.load_from_string("test.zero", 
+        "@inline\n"
+        "fn sq(x: int) -> int { return x * x; }\n"
+        "fn main() { }");
+    Parser parser(sm, id);
+    
+    Program prog = parser.parse();
+    assert(!parser.had_error());
+    assert(prog.functions.size() == 2);
+    assert(prog.functions[0].attributes.size() == 1);
+    assert(prog.functions[0].has_attribute("inline"));
+    assert(prog.functions[1].attributes.empty());
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────────────────────
@@ -148,6 +148,173 @@ TEST(test_scoped_variable) {
     assert(errors[0].kind == ErrorKind::UNDEFINED_VARIABLE);
 }
 
+TEST(test_assignment) {
+    auto [ok_error, ok_errors] = analyze_code("fn main() { let x = 1; x = x + 1; }");
+    assert(!ok_error);
+    
+    auto [had_error, errors] = analyze_code("fn main() { y = 1; }");
+    assert(had_error);
+    assert(errors[0].kind == ErrorKind::UNDEFINED_VARIABLE);
+}
+
+TEST(test_function_attributes) {
+    auto [ok_error, ok_errors] = analyze_code("@noinline fn foo() { }");
+    assert(!ok_error);
+    
+    auto [export_error, export_errors] = analyze_code("@export @inline fn foo() { }");
+    assert(!export_error);
+    
+    auto [had_error, errors] = analyze_code("@fast fn foo() { }");
+    assert(had_error);
+    assert(errors[0].kind == ErrorKind::INVALID_ATTRIBUTE);
+    
+    auto [conflict, conflict_errors] = analyze_code("@inline @noinline fn foo() { }");
+    assert(conflict);
+    assert(conflict_errors[0].kind == ErrorKind::INVALID_ATTRIBUTE);
+}
+
+TEST(test_memo_attribute) {
+    auto [ok_error, ok_errors] = analyze_code(
+        "fn sq(x: float) -> float { return x * x; }\n"
+        "@memo fn f(n: int, x: float) -> float { if n < 1 { return x; } return sq(f(n - 1, x)); }");
+    assert(!ok_error);
+    
+    // Impure through a helper
+    auto [impure, impure_errors] = analyze_code(
+        "fn show(x: int) { print(x); }\n"
+        "@memo fn f(n: int) -> int { show(n); return n; }");
+    assert(impure);
+    assert(impure_errors.size() == 1);
+    assert(impure_errors[0].kind == ErrorKind::INVALID_ATTRIBUTE);
+    
+    auto [tensor_arg, tensor_errors] = analyze_code("@memo fn f(t: tensor) -> int { return 0; }");
+    assert(tensor_arg);
+    assert(tensor_errors[0].kind == ErrorKind::INVALID_ATTRIBUTE);
+    
+    auto [no_result, no_result_errors] = analyze_code("@memo fn f(n: int) { }");
+    assert(no_result);
+    assert(no_result_errors[0].kind == ErrorKind::INVALID_ATTRIBUTE);
+}
+
+TEST(test_tensor_shapes) {
+    // Shapes flow through fill, matmul, elementwise ops and annotations
+    auto [ok, ok_errors] = analyze_code(
+        "fn layer(x: tensor<f32>[_, 3], w: tensor<f32>[3, 4]) -> tensor<f32>[_, 4] {\n"
+        "    return relu(matmul(x, w) - fill(1.0, 2, 4));\n"
+        "}\n"
+        "fn main() { let y: tensor<f32>[2, 4] = layer(fill(2.0, 2, 3), tensor(3, 4)); }");
+    assert(!ok);
+    
+    auto [add, add_errors] = analyze_code(
+        "fn main() { let a = fill(1.0, 2, 3); let b = tensor(3, 2); let c = a + b; }");
+    assert(add);
+    assert(add_errors.size() == 1);
+    assert(add_errors[0].kind == ErrorKind::TYPE_MISMATCH);
+    assert(add_errors[0].message.find("[2x3] + tensor<f32>[3x2]") != std::string::npos);
+    
+    auto [mm, mm_errors] = analyze_code("fn main() { let c = matmul(tensor(2, 3), tensor(2, 3)); }");
+    assert(mm && mm_errors.size() == 1);
+    
+    // Only sizes known on both sides are compared
+    auto [dyn, dyn_errors] = analyze_code(
+        "fn main(n: int) { let a = tensor(n, 3) * tensor(2, 3); let b = matmul(a, tensor(3, n)); }");
+    assert(!dyn);
+    
+    auto [arg, arg_errors] = analyze_code(
+        "fn f(x: tensor<f32>[4]) -> int { return 0; }\n"
+        "fn main() { return f(tensor(5)); }");
+    assert(arg);
+    assert(arg_errors[0].message.find("expected tensor<f32>[4], got tensor<f32>[5]") != std::string::npos);
+    
+    auto [dtype, dtype_errors] = analyze_code("fn f(x: tensor<f16>) { }");
+    assert(dtype && dtype_errors[0].kind == ErrorKind::TYPE_MISMATCH);
+    
+    auto [div, div_errors] = analyze_code("fn main() { let a = tensor(2) / tensor(2); }");
+    assert(div && div_errors.size() == 1);
+}
+
+TEST(test_tensor_views) {
+    // Broadcasting, views and the shapes they give
+    auto [ok, ok_errors] = analyze_code(
+        "fn f(x: tensor<f32>[_, 3], b: tensor<f32>[3]) -> tensor<f32>[3, _] {\n"
+        "    return transpose(x * b + fill(1.0, 1, 3));\n"
+        "}\n"
+        "fn main() {\n"
+        "    let a: tensor<f32>[3, 2] = reshape(fill(2.0, 2, 3), -1, 2);\n"
+        "    let s: tensor<f32>[1, _] = slice(f(tensor(4, 3), tensor(3)), 0, 1, 4, 2);\n"
+        "    let w: tensor<f32>[5, 2] = broadcast(slice(a, 0, 0, 1), 5, 2);\n"
+        "}");
+    assert(!ok);
+    
+    auto [bad, bad_errors] = analyze_code(
+        "fn main() {\n"
+        "    let a = reshape(tensor(2, 3), 4);\n"
+        "    let b = broadcast(tensor(2, 3), 3);\n"
+        "    let c = transpose(tensor(2, 3), 0, 2);\n"
+        "    let d = slice(tensor(2, 3), 0, 1);\n"
+        "    let e = slice(tensor(2, 3), 0, 0, 1, 0);\n"
+        "    let f = reshape(tensor(6), 2.5);\n"
+        "}");
+    assert(bad);
+    assert(bad_errors.size() == 6);
+    assert(bad_errors[0].message.find("Cannot reshape tensor<f32>[2x3] to tensor<f32>[4]") !=
+           std::string::npos);
+    assert(bad_errors[1].message.find("Cannot broadcast") != std::string::npos);
+    assert(bad_errors[3].kind == ErrorKind::WRONG_ARG_COUNT);
+    assert(bad_errors[5].message.find("must be an int") != std::string::npos);
+}
+
+TEST(test_tensor_reductions) {
+    auto [ok, ok_errors] = analyze_code(
+        "fn main() {\n"
+        "    let x = tensor(4, 3);\n"
+        "    let s: tensor<f32>[3] = sum(x, 0);\n"
+        "    let m: tensor<f32>[4] = max(mean(reshape(x, 4, 3, 1), -1), 1);\n"
+        "    let i: tensor<i64>[4] = argmax(x, 1);\n"
+        "    let p: tensor<f32>[4, 3] = softmax(x) + softmax(x, 0);\n"
+        "    let n: tensor<f32>[4, 3] = layernorm(x, fill(1.0, 3), tensor(3));\n"
+        "    let t = sum(x) + mean(n);\n"
+        "}");
+    assert(!ok);
+    
+    auto [bad, bad_errors] = analyze_code(
+        "fn main() {\n"
+        "    let a = sum(tensor(2, 3), 2);\n"
+        "    let b = softmax(tensor(2, 3), -3);\n"
+        "    let c = mean(argmax(tensor(2, 3), 1));\n"
+        "    let d = max(tensor(2), 0, 1);\n"
+        "    let e = layernorm(tensor(2, 3), tensor(3));\n"
+        "    let f: tensor<f32>[2] = sum(tensor(2, 3), 0);\n"
+        "}");
+    assert(bad);
+    assert(bad_errors.size() == 6);
+    assert(bad_errors[0].message.find("Invalid axis for sum") != std::string::npos);
+    assert(bad_errors[1].message.find("Invalid axis for softmax") != std::string::npos);
+    assert(bad_errors[2].message.find("floating-point") != std::string::npos);
+    assert(bad_errors[3].kind == ErrorKind::WRONG_ARG_COUNT);
+    assert(bad_errors[4].kind == ErrorKind::WRONG_ARG_COUNT);
+}
+
+TEST(test_tensor_activations) {
+    auto [ok, ok_errors] = analyze_code(
+        "fn main() {\n"
+        "    let x = tensor(4, 3);\n"
+        "    let y: tensor<f32>[4, 3] = gelu(sigmoid(tanh(exp(x))) + x);\n"
+        "}");
+    assert(!ok);
+    
+    auto [bad, bad_errors] = analyze_code(
+        "fn main() {\n"
+        "    let a = exp(argmax(tensor(2, 3), 1));\n"
+        "    let b = tanh(tensor(2), tensor(2));\n"
+        "    let c: tensor<f32>[3] = sigmoid(tensor(2));\n"
+        "}");
+    assert(bad);
+    assert(bad_errors.size() == 3);
+    assert(bad_errors[0].message.find("'exp' needs a floating-point tensor") != std::string::npos);
+    assert(bad_errors[1].kind == ErrorKind::WRONG_ARG_COUNT);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────────────────────
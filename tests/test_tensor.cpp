@@ -0,0 +1,876 @@
+/**
+ * @file test_tensor.cpp
+ * @brief Unit tests for the Zero CPU Tensor Runtime
+ */
+
+#include "tensor/tensor.hpp"
+#include "tensor/buffer_pool.hpp"
+#include "tensor/fused.hpp"
+#include "tensor/gemm.hpp"
+#include "tensor/kernels.hpp"
+#include "tensor/reduce.hpp"
+#include "tensor/task_graph.hpp"
+#include "tensor/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+using namespace zero::tensor;
+using zero::types::DType;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test utilities
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define TEST(name) void name(); \
+    static struct name##_register { \
+        name##_register() { tests.push_back({#name, name}); } \
+    } name##_instance; \
+    void name()
+
+struct TestCase {
+    const char* name;
+    void (*func)();
+};
+
+static std::vector<TestCase> tests;
+
+static int run_all_tests() {
+    int passed = 0;
+    int failed = 0;
+    
+    for (const auto& test : tests) {
+        std::cout << "  Running " << test.name << "... ";
+        try {
+            test.func();
+            std::cout << "\033[32mPASS\033[0m\n";
+            ++passed;
+        } catch (const std::exception& e) {
+            std::cout << "\033[31mFAIL\033[0m: " << e.what() << "\n";
+            ++failed;
+        } catch (...) {
+            std::cout << "\033[31mFAIL\033[0m: unknown exception\n";
+            ++failed;
+        }
+    }
+    
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
+
+/**
+ * Distance of `got` from `want` in units in the last place of T.
+ */
+template <typename T>
+static double ulp_error(T got, long double want) {
+    if (std::isnan(want)) return std::isnan(got) ? 0 : HUGE_VAL;
+    if (std::isinf(static_cast<T>(want))) return got == static_cast<T>(want) ? 0 : HUGE_VAL;
+    int e;
+    std::frexp(std::max(std::fabs(want), static_cast<long double>(std::numeric_limits<T>::min())), &e);
+    return static_cast<double>(std::fabs(got - want) /
+                               std::ldexp(1.0L, e - std::numeric_limits<T>::digits));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+TEST(test_alloc_and_layout) {
+    Tensor t = Tensor::full({2, 3, 4}, 1.5);
+    assert(t.ndim() == 3);
+    assert(t.numel() == 24);
+    assert(t.strides() == (Tensor::Shape{12, 4, 1}));
+    assert(t.is_contiguous());
+    assert(reinterpret_cast<uintptr_t>(t.raw_data()) % Storage::ALIGNMENT == 0);
+    assert(t.get(23) == 1.5);
+    
+    Tensor z = Tensor::zeros({0, 5}, DType::F64);
+    assert(z.numel() == 0);
+    
+    bool threw = false;
+    try {
+        Tensor::empty({2, -1});
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_elementwise) {
+    Tensor a = Tensor::empty({2, 2}, DType::I64);
+    Tensor b = Tensor::empty({2, 2}, DType::I64);
+    for (size_t i = 0; i < 4; ++i) {
+        a.set(i, static_cast<double>(i));
+        b.set(i, 10.0);
+    }
+    Tensor s = add(a, b);
+    Tensor d = sub(a, b);
+    Tensor p = mul(a, b);
+    assert(s.get(3) == 13 && d.get(0) == -10 && p.get(2) == 20);
+    assert(relu(d).get(1) == 0);
+    assert(s.to_string() == "tensor<i64>[2x2] [[10, 11], [12, 13]]");
+    
+    bool threw = false;
+    try {
+        add(a, Tensor::zeros({4}, DType::I64));
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    threw = false;
+    try {
+        add(a, Tensor::zeros({2, 2}, DType::F32));
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_matmul) {
+    // [2x3] x [3x2]
+    Tensor a = Tensor::empty({2, 3}, DType::F64);
+    Tensor b = Tensor::empty({3, 2}, DType::F64);
+    for (size_t i = 0; i < 6; ++i) {
+        a.set(i, static_cast<double>(i + 1));
+        b.set(i, static_cast<double>(6 - i));
+    }
+    Tensor c = matmul(a, b);
+    assert(c.shape() == (Tensor::Shape{2, 2}));
+    assert(c.get(0) == 1 * 6 + 2 * 4 + 3 * 2);
+    assert(c.get(1) == 1 * 5 + 2 * 3 + 3 * 1);
+    assert(c.get(2) == 4 * 6 + 5 * 4 + 6 * 2);
+    assert(c.get(3) == 4 * 5 + 5 * 3 + 6 * 1);
+    
+    bool threw = false;
+    try {
+        matmul(a, a);
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_kernels_agree_across_isas) {
+    // Odd lengths exercise the tails of every vector width
+    for (size_t n : {1u, 3u, 7u, 17u, 33u, 100u}) {
+        std::vector<int64_t> ia(n), ib(n);
+        std::vector<double> fa(n), fb(n);
+        std::vector<float> sa(n), sb(n);
+        for (size_t i = 0; i < n; ++i) {
+            ia[i] = (static_cast<int64_t>(i) - 5) * 0x10000001LL;
+            ib[i] = -3 * static_cast<int64_t>(i) + 0x7fffffff;
+            fa[i] = static_cast<double>(i) - 4.5;
+            fb[i] = 0.25 * static_cast<double>(i);
+            sa[i] = static_cast<float>(fa[i]);
+            sb[i] = static_cast<float>(fb[i]);
+        }
+        
+        const KernelTable& ref = scalar_kernels();
+        for (Isa isa : {Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            if (!isa_supported(isa)) continue;
+            const KernelTable& k = kernel_table(isa);
+            for (BinaryOp op : {BinaryOp::ADD, BinaryOp::SUB, BinaryOp::MUL, BinaryOp::MAX}) {
+                std::vector<int64_t> i1(n), i2(n);
+                ref.get(op, DType::I64)(ia.data(), ib.data(), i1.data(), n);
+                k.get(op, DType::I64)(ia.data(), ib.data(), i2.data(), n);
+                assert(i1 == i2);
+                
+                std::vector<double> f1(n), f2(n);
+                ref.get(op, DType::F64)(fa.data(), fb.data(), f1.data(), n);
+                k.get(op, DType::F64)(fa.data(), fb.data(), f2.data(), n);
+                assert(f1 == f2);
+                
+                std::vector<float> s1(n), s2(n);
+                ref.get(op, DType::F32)(sa.data(), sb.data(), s1.data(), n);
+                k.get(op, DType::F32)(sa.data(), sb.data(), s2.data(), n);
+                assert(s1 == s2);
+            }
+            
+            std::vector<int64_t> r1(n), r2(n);
+            ref.get(UnaryOp::RELU, DType::I64)(ia.data(), r1.data(), n);
+            k.get(UnaryOp::RELU, DType::I64)(ia.data(), r2.data(), n);
+            assert(r1 == r2);
+            
+            std::vector<float> q1(n), q2(n);
+            ref.get(UnaryOp::RELU, DType::F32)(sa.data(), q1.data(), n);
+            k.get(UnaryOp::RELU, DType::F32)(sa.data(), q2.data(), n);
+            assert(q1 == q2);
+            
+            // Integer sums and every max are exact; float sums may only
+            // differ by the order the lanes were added in
+            int64_t is1, is2;
+            ref.get(ReduceOp::SUM_SQUARES, DType::I64)(ia.data(), n, &is1);
+            k.get(ReduceOp::SUM_SQUARES, DType::I64)(ia.data(), n, &is2);
+            assert(is1 == is2);
+            float m1, m2;
+            ref.get(ReduceOp::MAX, DType::F32)(sa.data(), n, &m1);
+            k.get(ReduceOp::MAX, DType::F32)(sa.data(), n, &m2);
+            assert(m1 == m2);
+            double d1, d2;
+            ref.get(ReduceOp::SUM, DType::F64)(fa.data(), n, &d1);
+            k.get(ReduceOp::SUM, DType::F64)(fa.data(), n, &d2);
+            assert(std::fabs(d1 - d2) < 1e-9);
+            std::vector<double> f1(n), f2(n);
+            ref.get_affine(DType::F64)(fa.data(), f1.data(), n, 0.5, 2.0);
+            k.get_affine(DType::F64)(fa.data(), f2.data(), n, 0.5, 2.0);
+            assert(f1 == f2);
+        }
+    }
+    
+    assert(set_active_isa(Isa::AVX512) == detect_isa());
+}
+
+TEST(test_strided_views) {
+    // A 3x5 matrix and its transpose as a view of the same storage
+    Tensor m = Tensor::empty({3, 5}, DType::F32);
+    for (size_t i = 0; i < 15; ++i) m.set(i, static_cast<double>(i));
+    Tensor t = m.as_strided({5, 3}, {1, 5});
+    assert(!t.is_contiguous());
+    assert(t.get(1) == 5 && t.get(3) == 1);
+    
+    Tensor sum = add(t, t);
+    assert(sum.is_contiguous());
+    assert(sum.get(4) == 12);
+    assert(relu(sub(t, Tensor::full({5, 3}, 7.0))).get(2) == 3);
+    
+    // Every other column of m, starting at column 1
+    Tensor cols = m.as_strided({3, 2}, {5, 2}, 1);
+    assert(cols.contiguous().get(5) == 13);
+    
+    bool threw = false;
+    try {
+        m.as_strided({3, 5}, {5, 1}, 1);
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+TEST(test_view_ops) {
+    Tensor m = Tensor::empty({4, 6});
+    for (size_t i = 0; i < 24; ++i) m.set(i, static_cast<double>(i));
+    
+    // Reshapes of contiguous data are views; -1 is inferred
+    Tensor r = m.reshape({2, -1, 3});
+    assert(r.shape() == (Tensor::Shape{2, 4, 3}) && r.raw_data() == m.raw_data());
+    assert(r.get(23) == 23 && m.reshape({24}).get(7) == 7);
+    
+    // Transposes swap strides; reshaping one copies unless dims stay whole
+    Tensor t = m.transpose(0, -1);
+    assert(t.shape() == (Tensor::Shape{6, 4}) && t.strides() == (Tensor::Shape{1, 6}));
+    assert(t.get(1) == 6 && t.get(4) == 1);
+    Tensor flat = t.reshape({-1});
+    assert(flat.raw_data() != m.raw_data() && flat.get(1) == 6);
+    Tensor split = t.reshape({3, 2, 4});
+    assert(split.raw_data() == m.raw_data() && split.get(5) == 7);
+    
+    // Slices move the offset and scale the stride
+    Tensor s = m.slice(1, 1, -1, 2);
+    assert(s.shape() == (Tensor::Shape{4, 2}) && s.strides() == (Tensor::Shape{6, 2}));
+    assert(s.get(0) == 1 && s.get(3) == 9 && s.get(7) == 21);
+    assert(m.slice(0, -2, 100).get(0) == 12);
+    assert(m.slice(0, 3, 1).numel() == 0);
+    Tensor rows = m.slice(0, 1, 3);
+    assert(rows.is_contiguous() && rows.reshape({12}).raw_data() == rows.raw_data());
+    
+    // Broadcast dimensions have stride 0
+    Tensor b = m.slice(0, 0, 1).broadcast_to({3, 4, 6});
+    assert(b.strides() == (Tensor::Shape{0, 0, 1}) && b.get(6 * 4 * 2 + 6 + 5) == 5);
+    assert(broadcast_shapes({4, 1}, {3}) == (Tensor::Shape{4, 3}));
+    assert(broadcasts_to({1, 6}, {4, 6}) && !broadcasts_to({4, 6}, {1, 6}));
+    
+    // Elementwise ops broadcast their operands
+    Tensor col = m.slice(1, 0, 1);
+    Tensor sum = add(m, col);
+    assert(sum.shape() == m.shape() && sum.get(7) == 13 && sum.get(23) == 41);
+    Tensor outer = mul(col, m.slice(0, 0, 1).reshape({6}));
+    assert(outer.shape() == (Tensor::Shape{4, 6}) && outer.get(23) == 18 * 5);
+    Tensor x = Tensor::full({4, 6}, 1.0);
+    assert(sub(x, col, x).raw_data() == x.raw_data() && x.get(6) == -5);
+    
+    for (auto bad : std::vector<std::function<void()>>{
+             [&] { m.reshape({5, -1}); },
+             [&] { m.reshape({-1, -1}); },
+             [&] { m.transpose(0, 2); },
+             [&] { m.slice(0, 0, 2, 0); },
+             [&] { m.broadcast_to({6}); },
+             [&] { add(m, Tensor::zeros({4})); }}) {
+        bool threw = false;
+        try {
+            bad();
+        } catch (const TensorError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+}
+
+TEST(test_gemm_matches_naive) {
+    // Small integers keep every sum exact, so results must match exactly.
+    // The shapes cross the micro-tile, MC, KC and NC block edges.
+    struct Shape { int64_t m, k, n; };
+    ThreadPool pool(3);
+    for (Shape s : {Shape{1, 1, 1}, Shape{5, 3, 7}, Shape{13, 300, 37},
+                    Shape{130, 70, 260}, Shape{3, 257, 2050}}) {
+        std::vector<double> a(s.m * s.k), b(s.k * s.n), want(s.m * s.n, 0.0);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<double>(static_cast<int64_t>(i % 7) - 3);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<double>(static_cast<int64_t>(i % 5) - 2);
+        for (int64_t i = 0; i < s.m; ++i) {
+            for (int64_t p = 0; p < s.k; ++p) {
+                for (int64_t j = 0; j < s.n; ++j) want[i * s.n + j] += a[i * s.k + p] * b[p * s.n + j];
+            }
+        }
+        std::vector<float> af(a.begin(), a.end()), bf(b.begin(), b.end());
+        
+        for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            if (!isa_supported(isa)) continue;
+            GemmOptions options;
+            options.kernels = &kernel_table(isa);
+            options.pool = &pool;
+            
+            std::vector<double> c(s.m * s.n, -1.0);
+            gemm(DType::F64, s.m, s.n, s.k, {a.data(), s.k, 1}, {b.data(), s.n, 1},
+                 c.data(), s.n, options);
+            assert(c == want);
+            
+            std::vector<float> cf(s.m * s.n, -1.0f);
+            gemm(DType::F32, s.m, s.n, s.k, {af.data(), s.k, 1}, {bf.data(), s.n, 1},
+                 cf.data(), s.n, options);
+            for (size_t i = 0; i < cf.size(); ++i) assert(cf[i] == static_cast<float>(want[i]));
+        }
+    }
+    
+    // Transposed operands go straight to the packing routines
+    Tensor x = Tensor::empty({4, 6}, DType::F64);
+    for (size_t i = 0; i < 24; ++i) x.set(i, static_cast<double>(i));
+    Tensor xt = x.as_strided({6, 4}, {1, 6});
+    Tensor gram = matmul(xt, x);
+    assert(gram.dim(0) == 6 && gram.dim(1) == 6);
+    assert(gram.get(0) == 0 + 36 + 144 + 324);
+    assert(gram.get(7) == 1 + 49 + 169 + 361);
+    assert(matmul(Tensor::full({2, 0}, 1.0), Tensor::full({0, 3}, 1.0)).get(5) == 0);
+}
+
+TEST(test_thread_pool) {
+    ThreadPool pool(4);
+    assert(pool.size() == 4);
+    
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for(hits.size(), [&](size_t i) {
+        // Nested loops spread over whichever threads are idle
+        pool.parallel_for(2, [&](size_t) { hits[i].fetch_add(1); });
+    });
+    for (auto& h : hits) assert(h.load() == 2);
+    
+    bool threw = false;
+    try {
+        pool.parallel_for(100, [](size_t i) {
+            if (i == 42) throw std::runtime_error("task failed");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::atomic<size_t> count{0};
+    pool.parallel_for(7, [&](size_t) { count.fetch_add(1); }, 2);
+    assert(count.load() == 7);
+    
+    // Tasks spawning tasks into the group they belong to
+    ThreadPool::TaskGroup group;
+    std::atomic<int> spawned{0};
+    std::function<void(int)> tree = [&](int depth) {
+        spawned.fetch_add(1);
+        if (depth == 0) return;
+        pool.spawn(group, [&, depth] { tree(depth - 1); });
+        pool.spawn(group, [&, depth] { tree(depth - 1); });
+    };
+    pool.spawn(group, [&] { tree(6); });
+    pool.wait(group);
+    assert(spawned.load() == 127);
+    
+    pool.spawn(group, [] { throw std::runtime_error("spawned task failed"); });
+    threw = false;
+    try {
+        pool.wait(group);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    pool.wait(group);   // The error is reported once
+    
+    // Long elementwise runs are split over the global pool
+    Tensor a = Tensor::empty({300001}), b = Tensor::empty({300001});
+    for (size_t i = 0; i < a.numel(); ++i) {
+        a.set(i, static_cast<double>(i % 1000));
+        b.set(i, 0.5);
+    }
+    Tensor c = add(a, b), g = gelu(a, a);
+    for (size_t i = 0; i < c.numel(); i += 997) assert(c.get(i) == static_cast<double>(i % 1000) + 0.5);
+    assert(c.get(300000) == 0.5 && g.get(300000) == 0.0 && g.get(299999) == 999.0);
+}
+
+TEST(test_task_graph) {
+    ThreadPool pool(4);
+    
+    // 0 -> {1, 2} -> 3, and 4 on its own
+    TaskGraph graph;
+    for (int i = 0; i < 5; ++i) graph.add_node();
+    graph.add_edge(0, 1);
+    graph.add_edge(0, 2);
+    graph.add_edge(1, 3);
+    graph.add_edge(2, 3);
+    graph.add_edge(2, 3);
+    assert(graph.size() == 5 && graph.edge_count() == 4);
+    
+    bool threw = false;
+    try {
+        graph.add_edge(3, 1);
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    for (int round = 0; round < 50; ++round) {
+        std::atomic<int> clock{0};
+        std::vector<std::atomic<int>> started(5), finished(5);
+        graph.run([&](size_t node) {
+            started[node] = clock.fetch_add(1);
+            // Splitting work inside a node
+            std::atomic<int> parts{0};
+            pool.parallel_for(8, [&](size_t) { parts.fetch_add(1); });
+            assert(parts.load() == 8);
+            finished[node] = clock.fetch_add(1);
+        }, pool);
+        assert(clock.load() == 10);
+        assert(started[1] > finished[0] && started[2] > finished[0]);
+        assert(started[3] > finished[1] && started[3] > finished[2]);
+    }
+    
+    // Independent nodes overlap: each waits until the other has started
+    TaskGraph pair;
+    pair.add_node();
+    pair.add_node();
+    std::atomic<int> arrived{0};
+    bool overlapped = true;
+    pair.run([&](size_t) {
+        arrived.fetch_add(1);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (arrived.load() < 2) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                overlapped = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }, pool);
+    assert(overlapped);
+    
+    // 1 and 3 throw; 4 waits for 1 and is skipped, 5 still runs, and the
+    // error reported is 1's, as in order
+    TaskGraph failing;
+    for (int i = 0; i < 6; ++i) failing.add_node();
+    failing.add_edge(1, 4);
+    for (ThreadPool* p : {&pool, &ThreadPool::global()}) {
+        std::vector<std::atomic<int>> ran(6);
+        std::string message;
+        try {
+            failing.run([&](size_t node) {
+                ran[node] = 1;
+                if (node == 1 || node == 3) throw std::runtime_error("node " + std::to_string(node));
+            }, *p);
+        } catch (const std::runtime_error& e) {
+            message = e.what();
+        }
+        assert(message == "node 1");
+        assert(ran[0] && ran[1] && !ran[4]);
+        if (p->size() > 1) assert(ran[3] && ran[5]);
+    }
+    
+    // Matmuls in independent nodes: a thread waiting inside one product
+    // may run another, so neither may keep its packed panels per thread
+    ThreadPool wide(6);
+    TaskGraph products;
+    const int64_t m = 96;
+    std::vector<std::vector<double>> as, bs, cs, wants;
+    for (int64_t node = 0; node < 8; ++node) {
+        products.add_node();
+        const int64_t k = 200 + 40 * node, n = 300 + 70 * node;
+        std::vector<double> a(m * k), b(k * n), want(m * n, 0.0);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<double>(static_cast<int64_t>(i % 7) - 3);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<double>(static_cast<int64_t>((i + node) % 5) - 2);
+        for (int64_t i = 0; i < m; ++i) {
+            for (int64_t p = 0; p < k; ++p) {
+                for (int64_t j = 0; j < n; ++j) want[i * n + j] += a[i * k + p] * b[p * n + j];
+            }
+        }
+        as.push_back(std::move(a));
+        bs.push_back(std::move(b));
+        wants.push_back(std::move(want));
+        cs.emplace_back(m * n);
+    }
+    GemmOptions options;
+    options.pool = &wide;
+    for (int round = 0; round < 5; ++round) {
+        products.run([&](size_t node) {
+            const int64_t k = 200 + 40 * static_cast<int64_t>(node), n = 300 + 70 * static_cast<int64_t>(node);
+            std::fill(cs[node].begin(), cs[node].end(), -1.0);
+            gemm(DType::F64, m, n, k, {as[node].data(), k, 1}, {bs[node].data(), n, 1},
+                 cs[node].data(), n, options);
+        }, wide);
+        for (size_t node = 0; node < cs.size(); ++node) assert(cs[node] == wants[node]);
+    }
+    
+    // A pool of one runs the nodes in order
+    ThreadPool single(1);
+    std::vector<size_t> order;
+    graph.run([&](size_t node) { order.push_back(node); }, single);
+    assert((order == std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(test_fused_kernel) {
+    // Lengths cross the block size for every dtype
+    for (DType dtype : {DType::F32, DType::F64, DType::I64}) {
+        Tensor a = Tensor::empty({3, 700}, dtype);
+        Tensor b = Tensor::empty({3, 700}, dtype);
+        Tensor c = Tensor::empty({700, 3}, dtype);
+        for (size_t i = 0; i < a.numel(); ++i) {
+            a.set(i, static_cast<double>(i % 13) - 6);
+            b.set(i, static_cast<double>(i % 5) - 1);
+            c.set(i, static_cast<double>(i % 7) - 4);
+        }
+        // A transposed third input is gathered a block at a time
+        Tensor ct = c.as_strided({3, 700}, {1, 3});
+        Tensor want = sub(relu(add(mul(a, b), ct)), mul(b, b));
+        
+        FusedKernel k("x0 x1 mul x2 add relu x1 x1 mul sub");
+        assert(k.inputs() == 3 && k.steps() == 5);
+        for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            if (!isa_supported(isa)) continue;
+            Tensor got = k.run({&a, &b, &ct}, &kernel_table(isa));
+            assert(got.same_shape(want) && got.dtype() == dtype);
+            for (size_t i = 0; i < want.numel(); ++i) assert(got.get(i) == want.get(i));
+        }
+        
+        // Broadcast inputs: a row of a, a column of c, a single element
+        Tensor row = a.slice(0, 1, 2).reshape({700});
+        Tensor col = c.slice(0, 0, 3).slice(1, 2, 3);
+        Tensor one = Tensor::full({1, 1}, 3.0, dtype);
+        Tensor bcast = FusedKernel("x0 x1 mul x2 add x3 sub").run({&a, &row, &col, &one});
+        Tensor expect = sub(add(mul(a, row), col), one);
+        assert(bcast.shape() == a.shape());
+        for (size_t i = 0; i < expect.numel(); ++i) assert(bcast.get(i) == expect.get(i));
+    }
+    
+    for (const char* bad : {"", "x0", "x0 add", "x0 x1", "x0 x1 div", "x0 relu x1"}) {
+        bool threw = false;
+        try {
+            FusedKernel k(bad);
+        } catch (const TensorError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    
+    Tensor x = Tensor::full({2, 3}, 1.0), y = Tensor::full({3, 2}, 1.0);
+    bool threw = false;
+    try {
+        FusedKernel("x0 x1 add").run({&x, &y});
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(FusedKernel("x0 relu").run({&x}).get(5) == 1);
+}
+
+/**
+ * Worst error of `op` over points spread evenly over [lo, hi] and as many
+ * again drawn at random, in ulp, or as |error| / |x| when `relative_to_x`.
+ */
+template <typename T>
+static double activation_error(const KernelTable& k, UnaryOp op, double lo, double hi,
+                               bool relative_to_x = false) {
+    const size_t even = 20001, n = 2 * even;
+    std::vector<T> x(n), y(n);
+    for (size_t i = 0; i < even; ++i) x[i] = static_cast<T>(lo + (hi - lo) * static_cast<double>(i) / (even - 1));
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> uniform(lo, hi);
+    for (size_t i = even; i < n; ++i) x[i] = static_cast<T>(uniform(rng));
+    k.get(op, sizeof(T) == 4 ? DType::F32 : DType::F64)(x.data(), y.data(), n);
+    double worst = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const long double v = x[i];
+        long double want;
+        switch (op) {
+            case UnaryOp::EXP: want = std::exp(v); break;
+            case UnaryOp::TANH: want = std::tanh(v); break;
+            case UnaryOp::SIGMOID: want = 1 / (1 + std::exp(-v)); break;
+            default: {
+                const long double u = 0.797884560802865355879892119869L * (v + 0.044715L * v * v * v);
+                want = v / (1 + std::exp(-2 * u));
+                break;
+            }
+        }
+        const double e = relative_to_x ? static_cast<double>(std::fabs(y[i] - want) / std::fabs(v))
+                                       : ulp_error(y[i], want);
+        worst = std::max(worst, e);
+    }
+    return worst;
+}
+
+TEST(test_activations) {
+    // The bounds documented in kernels.hpp, for every table
+    for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (!isa_supported(isa)) continue;
+        const KernelTable& k = kernel_table(isa);
+        const double tanh_bound = isa == Isa::SCALAR ? 2.5 : 1.5;
+        assert(activation_error<float>(k, UnaryOp::EXP, -104, 89.5) <= 1);
+        assert(activation_error<double>(k, UnaryOp::EXP, -746, 710) <= 1);
+        assert(activation_error<float>(k, UnaryOp::EXP, -2, 2) <= 1);
+        assert(activation_error<double>(k, UnaryOp::EXP, -2, 2) <= 1);
+        assert(activation_error<float>(k, UnaryOp::TANH, -20, 20) <= tanh_bound);
+        assert(activation_error<double>(k, UnaryOp::TANH, -20, 20) <= tanh_bound);
+        assert(activation_error<float>(k, UnaryOp::TANH, -1, 1) <= tanh_bound);
+        assert(activation_error<double>(k, UnaryOp::TANH, -1, 1) <= tanh_bound);
+        assert(activation_error<float>(k, UnaryOp::SIGMOID, -80, 80) <= 2.5);
+        assert(activation_error<double>(k, UnaryOp::SIGMOID, -700, 700) <= 2.5);
+        // Where e^-x overflows but the result is still subnormal
+        assert(activation_error<float>(k, UnaryOp::SIGMOID, -103.9, -87) <= 2.5);
+        assert(activation_error<double>(k, UnaryOp::SIGMOID, -745, -708) <= 2.5);
+        assert(activation_error<float>(k, UnaryOp::GELU, -1, 20) <= 3);
+        assert(activation_error<double>(k, UnaryOp::GELU, -1, 20) <= 3);
+        assert(activation_error<float>(k, UnaryOp::GELU, -30, -1, true) <= std::ldexp(1.0, -24));
+        assert(activation_error<double>(k, UnaryOp::GELU, -30, -1, true) <= std::ldexp(1.0, -53));
+        
+        const double inf = HUGE_VAL, nan = std::nan("");
+        const std::vector<double> special = {-inf, inf, nan, 0, 1000, -1000, 1e-300};
+        std::vector<double> out(special.size());
+        auto apply = [&](UnaryOp op) { k.get(op, DType::F64)(special.data(), out.data(), special.size()); };
+        apply(UnaryOp::EXP);
+        assert(out[0] == 0 && out[1] == inf && std::isnan(out[2]) && out[3] == 1 && out[4] == inf &&
+               out[5] == 0 && out[6] == 1);
+        apply(UnaryOp::TANH);
+        assert(out[0] == -1 && out[1] == 1 && std::isnan(out[2]) && out[3] == 0 && out[4] == 1 &&
+               out[5] == -1 && out[6] == 1e-300);
+        apply(UnaryOp::SIGMOID);
+        assert(out[0] == 0 && out[1] == 1 && std::isnan(out[2]) && out[3] == 0.5 && out[5] == 0);
+        apply(UnaryOp::GELU);
+        assert(out[0] == 0 && std::signbit(out[0]) && out[1] == inf && std::isnan(out[2]) &&
+               out[3] == 0 && out[4] == 1000 && out[5] == 0);
+        
+        assert(!k.get(UnaryOp::EXP, DType::I64) && !k.get(UnaryOp::GELU, DType::I64));
+    }
+    
+    // Tensor ops on strided views; odd lengths reach the tails
+    Tensor x = Tensor::empty({7, 5});
+    for (size_t i = 0; i < x.numel(); ++i) x.set(i, static_cast<double>(i) * 0.25 - 4);
+    Tensor xt = x.transpose(0, 1);
+    Tensor e = exp(xt), t = tanh(xt), s = sigmoid(xt), g = gelu(xt);
+    for (size_t i = 0; i < xt.numel(); ++i) {
+        const double v = xt.get(i);
+        assert(std::fabs(e.get(i) - std::exp(v)) <= 1e-6 * std::exp(v));
+        assert(std::fabs(t.get(i) - std::tanh(v)) <= 1e-6);
+        assert(std::fabs(s.get(i) - 1 / (1 + std::exp(-v))) <= 1e-6);
+        assert(std::fabs(g.get(i) - 0.5 * v * (1 + std::tanh(0.7978845608 * (v + 0.044715 * v * v * v)))) <= 1e-6);
+    }
+    
+    // In place, and fused after the op they follow
+    Tensor y = Tensor::full({3, 33}, 0.5, DType::F64);
+    Tensor same = sigmoid(y, y);
+    assert(same.raw_data() == y.raw_data() && std::fabs(y.get(40) - 1 / (1 + std::exp(-0.5))) < 1e-15);
+    Tensor a = Tensor::full({2, 700}, 0.25), b = Tensor::full({700}, -0.5);
+    for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (!isa_supported(isa)) continue;
+        set_active_isa(isa);
+        Tensor want = gelu(tanh(exp(add(a, b))));
+        Tensor got = FusedKernel("x0 x1 add exp tanh gelu").run({&a, &b});
+        for (size_t i = 0; i < want.numel(); ++i) assert(got.get(i) == want.get(i));
+    }
+    set_active_isa(Isa::AVX512);
+    
+    Tensor ints = Tensor::zeros({4}, DType::I64);
+    for (int which = 0; which < 2; ++which) {
+        bool threw = false;
+        try {
+            if (which == 0) exp(ints);
+            else FusedKernel("x0 gelu").run({&ints});
+        } catch (const TensorError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(relu(ints).get(3) == 0);
+}
+
+TEST(test_buffer_pool) {
+    BufferPool pool(1000);
+    void* a = pool.acquire(100);
+    void* b = pool.acquire(100);
+    assert(reinterpret_cast<uintptr_t>(a) % BufferPool::ALIGNMENT == 0);
+    assert(pool.stats().live_bytes == 256 && pool.stats().peak_bytes == 256);
+    
+    // Freed buffers come back for requests in the same size class
+    pool.release(a, 100);
+    assert(pool.stats().live_bytes == 128 && pool.stats().pooled_bytes == 128);
+    void* again = pool.acquire(70);
+    assert(again == a);
+    assert(pool.stats().reused == 1 && pool.stats().allocations == 3);
+    
+    // Past the cap, buffers go straight back to the system
+    void* big = pool.acquire(2000);
+    pool.release(big, 2000);
+    assert(pool.stats().pooled_bytes == 0);
+    pool.release(a, 70);
+    pool.release(b, 100);
+    assert(pool.stats().live_bytes == 0 && pool.stats().peak_bytes == 2304);
+    pool.reset_peak();
+    assert(pool.stats().peak_bytes == 0);
+    pool.trim();
+    assert(pool.stats().pooled_bytes == 0);
+    
+    // Elementwise ops write into a destination that fits, even an input
+    Tensor x = Tensor::full({2, 3}, 2.0), y = Tensor::full({2, 3}, 5.0);
+    const void* storage = x.raw_data();
+    Tensor z = mul(x, y, x);
+    assert(z.raw_data() == storage && x.get(4) == 10);
+    assert(relu(sub(x, y), x).raw_data() == storage && x.get(0) == 5);
+    assert(add(x, y, Tensor::zeros({3, 2})).raw_data() != storage);
+    assert(add(x, y, y.as_strided({2, 3}, {1, 2})).get(0) == 10);
+}
+
+TEST(test_reductions) {
+    // [outer, len, inner] with both the row and the column paths, and
+    // columns past one task's chunk
+    for (const Tensor::Shape& shape : {Tensor::Shape{3, 5, 7}, Tensor::Shape{2, 20, 1100}}) {
+        Tensor a = Tensor::empty(shape, DType::I64);
+        for (size_t i = 0; i < a.numel(); ++i) a.set(i, static_cast<double>((i * 7919) % 101) - 50);
+        for (int64_t axis = 0; axis < 3; ++axis) {
+            Tensor s = sum(a, axis), m = max(a, axis), am = argmax(a, axis);
+            Tensor k = sum(a, axis - 3, true);
+            assert(s.ndim() == 2 && k.ndim() == 3 && k.dim(static_cast<size_t>(axis)) == 1);
+            assert(am.dtype() == DType::I64);
+            
+            const int64_t d0 = shape[0], d1 = shape[1], d2 = shape[2];
+            const int64_t n0 = axis == 0 ? d1 : d0, n1 = axis == 2 ? d1 : d2;
+            for (int64_t i = 0; i < n0; ++i) {
+                for (int64_t j = 0; j < n1; ++j) {
+                    double want_sum = 0, want_max = -1e9;
+                    int64_t want_arg = 0;
+                    for (int64_t r = 0; r < shape[static_cast<size_t>(axis)]; ++r) {
+                        const int64_t x = axis == 0 ? r : i, y = axis == 0 ? i : axis == 1 ? r : j;
+                        const int64_t z = axis == 2 ? r : j;
+                        const double v = a.get(static_cast<size_t>((x * d1 + y) * d2 + z));
+                        want_sum += v;
+                        if (v > want_max) { want_max = v; want_arg = r; }
+                    }
+                    const size_t o = static_cast<size_t>(i * n1 + j);
+                    assert(s.get(o) == want_sum && k.get(o) == want_sum);
+                    assert(m.get(o) == want_max && am.get(o) == static_cast<double>(want_arg));
+                }
+            }
+        }
+    }
+    
+    // Strided input, mean, and the whole-tensor forms
+    Tensor b = Tensor::empty({4, 6}, DType::F64);
+    for (size_t i = 0; i < b.numel(); ++i) b.set(i, static_cast<double>(i));
+    Tensor bt = b.transpose(0, 1);
+    assert(sum(bt, 1).get(2) == 2 + 8 + 14 + 20);
+    assert(mean(b, -1).get(1) == 8.5);
+    assert(sum(b).ndim() == 0 && sum(b).get(0) == 276);
+    assert(max(bt).get(0) == 23 && argmax(bt).get(0) == 23 && mean(b).get(0) == 11.5);
+    
+    // Pairwise summation: a million f32 tenths, where a running sum
+    // drifts by about a percent
+    Tensor tenths = Tensor::full({1 << 20}, 0.1);
+    assert(std::fabs(sum(tenths).get(0) / (0.1 * (1 << 20)) - 1) < 1e-5);
+    
+    bool threw = false;
+    try {
+        mean(Tensor::zeros({2}, DType::I64), 0);
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        max(Tensor::zeros({2, 0}), 1);
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(sum(Tensor::zeros({2, 0}), 1).get(1) == 0);
+}
+
+TEST(test_softmax_and_layernorm) {
+    Tensor x = Tensor::empty({3, 50});
+    for (size_t i = 0; i < x.numel(); ++i) x.set(i, static_cast<double>(i % 13) * 0.5);
+    x.set(3, 1000);     // exp(1000) would overflow without the max
+    
+    Tensor y = softmax(x);
+    for (size_t r = 0; r < 3; ++r) {
+        double total = 0;
+        for (size_t j = 0; j < 50; ++j) total += y.get(r * 50 + j);
+        assert(std::fabs(total - 1) < 1e-5);
+    }
+    assert(std::fabs(y.get(3) - 1) < 1e-6);
+    assert(std::fabs(y.get(53) / y.get(52) - std::exp(0.5)) < 1e-5);
+    
+    // Along axis 0, as softmax of the transpose
+    Tensor y0 = softmax(x, 0), yt = softmax(x.transpose(0, 1));
+    for (size_t i = 0; i < x.numel(); ++i) {
+        assert(std::fabs(y0.get(i) - yt.transpose(0, 1).get(i)) < 1e-7);
+    }
+    
+    Tensor n = layernorm(x);
+    for (size_t r = 1; r < 3; ++r) {
+        double m = 0, v = 0;
+        for (size_t j = 0; j < 50; ++j) m += n.get(r * 50 + j) / 50;
+        for (size_t j = 0; j < 50; ++j) v += (n.get(r * 50 + j) - m) * (n.get(r * 50 + j) - m) / 50;
+        assert(std::fabs(m) < 1e-5 && std::fabs(v - 1) < 1e-3);
+    }
+    Tensor g = Tensor::full({50}, 2.0), b = Tensor::full({1}, 1.0);
+    Tensor gb = layernorm(x, g, b);
+    assert(std::fabs(gb.get(70) - (2 * n.get(70) + 1)) < 1e-5);
+    
+    bool threw = false;
+    try {
+        layernorm(x, Tensor::full({49}, 1.0));
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        softmax(Tensor::zeros({2}, DType::I64));
+    } catch (const TensorError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Main
+// ─────────────────────────────────────────────────────────────────────────────
+
+int main() {
+    std::cout << "\n";
+    std::cout << "============================================\n";
+    std::cout << "  Zero Tensor Runtime Tests\n";
+    std::cout << "============================================\n\n";
+    
+    return run_all_tests();
+}
@@ -6,6 +6,7 @@
 #include "types/types.hpp"
 
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 #include <cassert>
 
@@ -133,6 +134,108 @@ TEST(test_parse_type) {
     assert(parse_type("invalid").is_unknown());
 }
 
+TEST(test_tensor_types) {
+    Type a = Type::make_tensor(DType::F32, {2, 3});
+    Type b = Type::make_tensor(DType::F32, {2, 3});
+    Type dyn = Type::make_tensor(DType::F32, {DYNAMIC_DIM, 3});
+    Type any = Type::make_tensor();
+    
+    // Interned: equal shapes give equal types, and Type stays small
+    assert(a == b && a != dyn && a != any);
+    assert(a.is_tensor() && any.tensor_type() == nullptr);
+    assert(a.tensor_type()->dims[1] == 3);
+    assert(a.to_string() == "tensor<f32>[2x3]");
+    assert(dyn.to_string() == "tensor<f32>[?x3]");
+    assert(any.to_string() == "tensor");
+    assert(sizeof(Type) <= 8);
+    
+    // Compatible when everything both sides know agrees
+    assert(types_compatible(a, dyn) && types_compatible(a, any));
+    assert(!types_compatible(a, Type::make_tensor(DType::F32, {3, 2})));
+    assert(!types_compatible(a, Type::make_tensor(DType::F64, {2, 3})));
+    assert(*unify_tensor(dyn, a) == a);
+    
+    // Shape inference
+    assert(*elementwise_type(dyn, b) == a);
+    assert(!elementwise_type(a, Type::make_tensor(DType::F32, {2})));
+    Type w = Type::make_tensor(DType::F32, {3, 4});
+    assert(matmul_type(a, w)->to_string() == "tensor<f32>[2x4]");
+    assert(matmul_type(any, w)->to_string() == "tensor<f32>[?x4]");
+    assert(!matmul_type(a, a));
+    assert(binary_result_type(a, dyn) == a);
+}
+
+TEST(test_tensor_type_table) {
+    detail::TensorTypeTable table(5);
+    std::vector<uint32_t> ids;
+    for (int64_t n = 1; n <= 5; ++n) ids.push_back(table.intern(TensorType{DType::F32, true, {n}}));
+    
+    // Ids count up from 1 across segments, and entries stay put
+    const TensorType* first = &table.get(ids[0]);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        assert(ids[i] == i + 1);
+        assert(table.get(ids[i]).dims[0] == static_cast<int64_t>(i + 1));
+    }
+    assert(table.intern(TensorType{DType::F32, true, {3}}) == 3);
+    assert(&table.get(ids[0]) == first);
+    
+    // A sixth type has no id left
+    bool threw = false;
+    try {
+        table.intern(TensorType{DType::F64, true, {1}});
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(table.intern(TensorType{DType::F32, true, {5}}) == 5);
+}
+
+TEST(test_broadcast_and_view_types) {
+    Type a = Type::make_tensor(DType::F32, {2, 3});
+    Type dyn = Type::make_tensor(DType::F32, {DYNAMIC_DIM, 3});
+    
+    // Broadcasting matches dimensions from the right; 1 stretches
+    assert(elementwise_type(a, Type::make_tensor(DType::F32, {3}))->to_string() == "tensor<f32>[2x3]");
+    assert(elementwise_type(Type::make_tensor(DType::F32, {4, 1}),
+                            Type::make_tensor(DType::F32, {1, 5}))->to_string() == "tensor<f32>[4x5]");
+    assert(elementwise_type(dyn, Type::make_tensor(DType::F32, {7, 1}))->to_string() == "tensor<f32>[7x3]");
+    assert(!elementwise_type(a, Type::make_tensor(DType::F32, {4, 3})));
+    assert(!elementwise_type(a, Type::make_tensor(DType::F64, {3})));
+    
+    // A single unknown reshaped dimension is inferred from the rest
+    assert(reshape_type(a, {DYNAMIC_DIM, 2})->to_string() == "tensor<f32>[3x2]");
+    assert(reshape_type(a, {6})->to_string() == "tensor<f32>[6]");
+    assert(reshape_type(dyn, {DYNAMIC_DIM, 3})->to_string() == "tensor<f32>[?x3]");
+    assert(!reshape_type(a, {4}));
+    assert(!reshape_type(a, {DYNAMIC_DIM, 4}));
+    
+    assert(transpose_type(a, -2, -1)->to_string() == "tensor<f32>[3x2]");
+    assert(transpose_type(a, 0, std::nullopt)->to_string() == "tensor<f32>[?x?]");
+    assert(!transpose_type(a, 0, 2));
+    
+    // Slices clamp like Python's
+    Type m = Type::make_tensor(DType::F32, {10, 4});
+    assert(slice_type(m, 0, 2, 8, 3)->to_string() == "tensor<f32>[2x4]");
+    assert(slice_type(m, -1, -3, 100, 1)->to_string() == "tensor<f32>[10x3]");
+    assert(slice_type(m, 0, 5, 2, 1)->to_string() == "tensor<f32>[0x4]");
+    assert(slice_type(m, 1, std::nullopt, 2, 1)->to_string() == "tensor<f32>[10x?]");
+    assert(!slice_type(m, 2, 0, 1, 1));
+    assert(!slice_type(m, 0, 0, 1, 0));
+}
+
+TEST(test_reduce_types) {
+    Type a = Type::make_tensor(DType::F32, {2, 3, 4});
+    assert(reduce_type(a, false, 1)->to_string() == "tensor<f32>[2x4]");
+    assert(reduce_type(a, false, -1)->to_string() == "tensor<f32>[2x3]");
+    assert(reduce_type(a, false, std::nullopt)->to_string() == "tensor<f32>[?x?]");
+    assert(reduce_type(a, false, 0, DType::I64)->to_string() == "tensor<i64>[3x4]");
+    assert(reduce_type(a, true, std::nullopt)->to_string() == reduce_type(a, true, 2)->to_string());
+    assert(reduce_type(a, true, std::nullopt)->tensor_type()->dims.empty());
+    assert(!reduce_type(a, false, 3));
+    assert(!reduce_type(Type::make_tensor(DType::F32, {}), false, std::nullopt));
+    assert(!reduce_type(Type::make_tensor(), false, 0)->tensor_type()->ranked);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Main
 // ─────────────────────────────────────────────────────────────────────────────